@@ -0,0 +1,209 @@
+/**
+ * @file AnalizadorMarquesina.cpp
+ * @brief Análisis del HTML de la marquesina, sin dependencias de la consola
+ */
+#include "AnalizadorMarquesina.h"
+#include <cstring>
+
+namespace
+{
+	/** @brief Entrada de la tabla de colores: nombre, longitud y código de consola */
+	struct EntradaColor
+	{
+		const char* nombre;
+		size_t longitud;
+		int codigo;
+	};
+
+	/**
+	 * @brief Hash perfecto de los ocho nombres de color
+	 *
+	 * Usa la primera letra, la última y la longitud; los ocho nombres caen en
+	 * casillas distintas de una tabla de 16.
+	 */
+	constexpr size_t hashColor(const char* nombre, size_t longitud)
+	{
+		return (static_cast<unsigned char>(nombre[0]) + 4u * static_cast<unsigned char>(nombre[longitud - 1]) + longitud) & 15u;
+	}
+
+	/** @brief Tabla indexada por hashColor; las casillas vacías tienen nombre nulo */
+	constexpr EntradaColor TABLA_COLORES[16] = {
+		{ "white", 5, 7 }, { nullptr, 0, 0 }, { nullptr, 0, 0 }, { "black", 5, 0 },
+		{ "green", 5, 2 }, { "red", 3, 4 }, { nullptr, 0, 0 }, { nullptr, 0, 0 },
+		{ "magenta", 7, 5 }, { nullptr, 0, 0 }, { "blue", 4, 1 }, { "yellow", 6, 6 },
+		{ nullptr, 0, 0 }, { nullptr, 0, 0 }, { nullptr, 0, 0 }, { "cyan", 4, 3 }
+	};
+
+	/** @brief Comprueba en compilación que cada color está en la casilla de su hash */
+	constexpr bool tablaColoresValida()
+	{
+		for (size_t i = 0; i < 16; ++i)
+		{
+			if (TABLA_COLORES[i].nombre && hashColor(TABLA_COLORES[i].nombre, TABLA_COLORES[i].longitud) != i)
+				return false;
+		}
+		return true;
+	}
+	static_assert(tablaColoresValida(), "TABLA_COLORES no coincide con hashColor");
+
+	/**
+	 * @brief Traduce un nombre de color a su código de consola
+	 *
+	 * @param nombre Inicio del nombre (no necesita terminar en nulo)
+	 * @param longitud Longitud del nombre, mayor que cero
+	 * @param predeterminado Código que se devuelve si el nombre no es un color conocido
+	 * @return int Código de color
+	 */
+	int buscarColor(const char* nombre, size_t longitud, int predeterminado)
+	{
+		const EntradaColor& entrada = TABLA_COLORES[hashColor(nombre, longitud)];
+		if (entrada.nombre && entrada.longitud == longitud && std::memcmp(entrada.nombre, nombre, longitud) == 0)
+			return entrada.codigo;
+		return predeterminado;
+	}
+
+	/** @brief Indica si el cursor empieza con el literal indicado sin pasar del límite */
+	bool empiezaCon(const char* cursor, const char* limite, const char* literal, size_t longitud)
+	{
+		return static_cast<size_t>(limite - cursor) >= longitud && std::memcmp(cursor, literal, longitud) == 0;
+	}
+
+	/** @brief Busca un literal en [desde, hasta); devuelve hasta si no aparece */
+	const char* buscarLiteral(const char* desde, const char* hasta, const char* literal, size_t longitud)
+	{
+		while (desde != hasta && (desde = static_cast<const char*>(std::memchr(desde, literal[0], hasta - desde))) != nullptr)
+		{
+			if (empiezaCon(desde, hasta, literal, longitud))
+				return desde;
+			++desde;
+		}
+		return hasta;
+	}
+
+	/** @brief Avanza sobre letras minúsculas y devuelve el final del nombre */
+	const char* leerNombre(const char* cursor, const char* limite)
+	{
+		while (cursor != limite && *cursor >= 'a' && *cursor <= 'z')
+			++cursor;
+		return cursor;
+	}
+
+	/** @brief Espacio en blanco según la clase \s de las etiquetas */
+	bool esEspacio(char c)
+	{
+		return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+	}
+}
+
+/**
+ * @brief Analiza el contenido HTML y extrae los elementos de la marquesina
+ *
+ * Recorre el texto una sola vez sin expresiones regulares. Reconoce el bloque
+ * <marquesina>, las etiquetas <color=nombre> y <color=nombre bg=nombre> cerradas
+ * por </color> en la misma línea, y un <b>…</b> dentro de ellas; el texto fuera
+ * de las etiquetas de color se ignora. Si no hay ninguna etiqueta de color, todo
+ * el bloque se muestra en blanco. Solo se reserva memoria para los textos de los
+ * elementos.
+ *
+ * @param contenido Contenido HTML a analizar
+ * @return std::vector<ElementoMarquesina> Lista de elementos extraídos del HTML
+ */
+std::vector<ElementoMarquesina> AnalizadorMarquesina::parsearHTML(const std::string& contenido)
+{
+	static const char APERTURA[] = "<marquesina>";
+	static const char CIERRE[] = "</marquesina>";
+	static const char COLOR[] = "<color=";
+	static const char FONDO[] = "bg=";
+	static const char FIN_COLOR[] = "</color>";
+	static const char NEGRITA[] = "<b>";
+	static const char FIN_NEGRITA[] = "</b>";
+
+	std::vector<ElementoMarquesina> resultado;
+
+	const char* texto = contenido.data();
+	const char* finTexto = texto + contenido.size();
+	const char* inicio = buscarLiteral(texto, finTexto, APERTURA, sizeof(APERTURA) - 1);
+	if (inicio == finTexto)
+		return resultado;
+	inicio += sizeof(APERTURA) - 1;
+	const char* limite = buscarLiteral(inicio, finTexto, CIERRE, sizeof(CIERRE) - 1);
+	if (limite == finTexto)
+		return resultado;
+
+	const char* cursor = inicio;
+	while ((cursor = buscarLiteral(cursor, limite, COLOR, sizeof(COLOR) - 1)) != limite)
+	{
+		// Si la etiqueta no es válida se sigue buscando desde el carácter siguiente
+		const char* etiqueta = cursor++;
+
+		const char* nombreTexto = etiqueta + sizeof(COLOR) - 1;
+		const char* finNombreTexto = leerNombre(nombreTexto, limite);
+		if (finNombreTexto == nombreTexto)
+			continue;
+
+		const char* p = finNombreTexto;
+		const char* nombreFondo = nullptr;
+		const char* finNombreFondo = nullptr;
+		if (p != limite && esEspacio(*p))
+		{
+			while (p != limite && esEspacio(*p))
+				++p;
+			if (!empiezaCon(p, limite, FONDO, sizeof(FONDO) - 1))
+				continue;
+			nombreFondo = p + sizeof(FONDO) - 1;
+			finNombreFondo = leerNombre(nombreFondo, limite);
+			if (finNombreFondo == nombreFondo)
+				continue;
+			p = finNombreFondo;
+		}
+		if (p == limite || *p != '>')
+			continue;
+
+		// El contenido termina en el primer </color> y no puede cruzar un salto de línea
+		const char* contenidoInicio = p + 1;
+		const char* contenidoFin = contenidoInicio;
+		while (contenidoFin != limite && *contenidoFin != '\n' && *contenidoFin != '\r' &&
+			!empiezaCon(contenidoFin, limite, FIN_COLOR, sizeof(FIN_COLOR) - 1))
+			++contenidoFin;
+		if (contenidoFin == limite || *contenidoFin != '<')
+			continue;
+
+		ElementoMarquesina elem;
+		elem.colorTexto = buscarColor(nombreTexto, finNombreTexto - nombreTexto, 7);
+		elem.colorFondo = nombreFondo ? buscarColor(nombreFondo, finNombreFondo - nombreFondo, 0) : 0;
+
+		const char* negrita = buscarLiteral(contenidoInicio, contenidoFin, NEGRITA, sizeof(NEGRITA) - 1);
+		const char* finNegrita = contenidoFin;
+		if (negrita != contenidoFin)
+		{
+			negrita += sizeof(NEGRITA) - 1;
+			finNegrita = buscarLiteral(negrita, contenidoFin, FIN_NEGRITA, sizeof(FIN_NEGRITA) - 1);
+		}
+		elem.negrita = finNegrita != contenidoFin;
+		if (elem.negrita)
+			elem.texto.assign(negrita, finNegrita);
+		else
+			elem.texto.assign(contenidoInicio, contenidoFin);
+
+		resultado.push_back(std::move(elem));
+		cursor = contenidoFin + sizeof(FIN_COLOR) - 1;
+	}
+
+	if (resultado.empty())
+	{
+		ElementoMarquesina elem;
+		elem.colorTexto = 7;
+		elem.colorFondo = 0;
+		elem.negrita = false;
+		// Sin etiquetas de color se muestra el bloque completo, sin aperturas <marquesina> anidadas
+		for (const char* tramo = inicio; tramo != limite;)
+		{
+			const char* siguiente = buscarLiteral(tramo, limite, APERTURA, sizeof(APERTURA) - 1);
+			elem.texto.append(tramo, siguiente);
+			tramo = siguiente == limite ? limite : siguiente + sizeof(APERTURA) - 1;
+		}
+		resultado.push_back(std::move(elem));
+	}
+
+	return resultado;
+}
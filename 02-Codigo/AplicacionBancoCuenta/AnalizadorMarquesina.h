@@ -0,0 +1,43 @@
+#pragma once
+
+#ifndef ANALIZADORMARQUESINA_H
+#define ANALIZADORMARQUESINA_H
+
+#include <string>
+#include <vector>
+
+/**
+ * @struct ElementoMarquesina
+ * @brief Estructura que representa un elemento individual en la marquesina
+ *
+ * Contiene información sobre el texto a mostrar y sus atributos de formato
+ * como color, fondo y estilo.
+ */
+struct ElementoMarquesina {
+    /** @brief Texto a mostrar en la marquesina */
+    std::string texto;
+    /** @brief Código de color del texto */
+    int colorTexto;
+    /** @brief Código de color del fondo */
+    int colorFondo;
+    /** @brief Indica si el texto debe mostrarse en negrita */
+    bool negrita;
+};
+
+/**
+ * @class AnalizadorMarquesina
+ * @brief Convierte el HTML de la marquesina en elementos con su formato
+ *
+ * Está separado de Marquesina para poder usarlo y medirlo sin la consola de Windows.
+ */
+class AnalizadorMarquesina {
+public:
+    /**
+     * @brief Analiza el contenido HTML y lo convierte en elementos de marquesina
+     * @param contenido Cadena con el contenido HTML a analizar
+     * @return Vector de elementos de marquesina formateados
+     */
+    static std::vector<ElementoMarquesina> parsearHTML(const std::string& contenido);
+};
+
+#endif // ANALIZADORMARQUESINA_H
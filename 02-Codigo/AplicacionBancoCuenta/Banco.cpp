@@ -10,11 +10,18 @@
 #include <iostream>
 #include <locale>
 #include <sstream>
+#ifdef _WIN32
 #include <conio.h>
 #include <windows.h>
+#else
+#include <cstdlib>
+#include <sys/stat.h>
+#endif
 #include <fstream>
 #include "Utilidades.h"
+#include "Pantalla.h"
 #include "NodoPersona.h"
+#include "Estadisticas.h"
 #include <iomanip>
 
  /**
@@ -39,6 +46,7 @@ Banco::~Banco() { // Destructor
 	}
 }
 
+#ifdef _WIN32 // Mens y captura por teclado de la consola de Windows
 /**
  * @brief Agrega una nueva persona con una cuenta asociada al sistema bancario
  *
@@ -55,38 +63,14 @@ void Banco::agregarPersonaConCuenta() {
 	int seleccion = 0;
 	// Creamos la persona dinamicamente
 	Persona* persona = new Persona();
-	int x = 5; // Posicion X inicial del menu
-	int y = 5; // Posicion Y inicial del menu
 	// Pasamos el puntero al constructor
 	NodoPersona* nuevo = new NodoPersona(persona);
 	nuevo->siguiente = listaPersonas;
 	listaPersonas = nuevo;
 
 	// Menu con cursor
-	while (true) {
-		system("cls");
-		std::cout << "\n\nSeleccione el tipo de cuenta a crear para la persona:\n\n";
-		for (int i = 0; i < numOpciones; i++) {
-			if (i == seleccion)
-				std::cout << " > " << opciones[i] << std::endl;
-			else
-				std::cout << "   " << opciones[i] << std::endl;
-		}
-		// Limpia cualquier linea sobrante si el menu se reduce
-		Utilidades::gotoxy(0, y + numOpciones);
-
-		int tecla = _getch();
-		if (tecla == 224) { // Teclas especiales
-			tecla = _getch();
-			if (tecla == 72) // Flecha arriba
-				seleccion = (seleccion - 1 + numOpciones) % numOpciones;
-			else if (tecla == 80) // Flecha abajo
-				seleccion = (seleccion + 1) % numOpciones;
-		}
-		else if (tecla == 13) { // ENTER
-			break;
-		}
-	}
+	MenuConsola menuTipoCuenta("\n\nSeleccione el tipo de cuenta a crear para la persona:\n\n", std::vector<std::string>(opciones, opciones + numOpciones));
+	seleccion = menuTipoCuenta.seleccionar();
 
 	if (seleccion == 2) {
 		std::cout << "Operacion cancelada.\n";
@@ -439,6 +423,7 @@ void Banco::agregarPersonaConCuenta() {
 		system("pause");
 	}
 }
+#endif
 
 /**
  * @brief Guarda todas las cuentas en un archivo con nombre especfico
@@ -449,47 +434,10 @@ void Banco::guardarCuentasEnArchivo(const std::string& nombreArchivo) const {
 	std::string rutaEscritorio = obtenerRutaEscritorio();
 	std::string rutaCompleta = rutaEscritorio + nombreArchivo + ".bak";
 
-	std::ofstream archivo(rutaCompleta, std::ios::out | std::ios::trunc);
-	if (!archivo.is_open()) {
+	if (guardarCuentasEnRuta(rutaCompleta) < 0) {
 		std::cout << "No se pudo abrir el archivo para guardar en: " << rutaCompleta << "\n";
 		return;
 	}
-
-	// Escribir cabecera
-	archivo << "BANCO_BACKUP_V1.0\n";
-
-	int contadorPersonas = 0;
-	NodoPersona* actual = listaPersonas;
-	while (actual) {
-		Persona* p = actual->persona;
-		if (p && p->isValidInstance()) {
-			archivo << "===PERSONA_INICIO===\n";
-			archivo << "CEDULA:" << p->getCedula() << "\n";
-			archivo << "NOMBRES:" << p->getNombres() << "\n";
-			archivo << "APELLIDOS:" << p->getApellidos() << "\n";
-			archivo << "FECHA_NACIMIENTO:" << p->getFechaNacimiento() << "\n";
-			archivo << "CORREO:" << p->getCorreo() << "\n";
-			archivo << "DIRECCION:" << p->getDireccion() << "\n";
-
-			archivo << "===CUENTAS_AHORRO_INICIO===\n";
-			int cuentasAhorro = p->guardarCuentas(archivo, "AHORROS");
-			archivo << "TOTAL_CUENTAS_AHORRO:" << cuentasAhorro << "\n";
-			archivo << "===CUENTAS_AHORRO_FIN===\n";
-
-			archivo << "===CUENTAS_CORRIENTE_INICIO===\n";
-			int cuentasCorriente = p->guardarCuentas(archivo, "CORRIENTE");
-			archivo << "TOTAL_CUENTAS_CORRIENTE:" << cuentasCorriente << "\n";
-			archivo << "===CUENTAS_CORRIENTE_FIN===\n";
-
-			archivo << "===PERSONA_FIN===\n\n";
-			contadorPersonas++;
-		}
-		actual = actual->siguiente;
-	}
-
-	archivo << "TOTAL_PERSONAS:" << contadorPersonas << "\n";
-	archivo << "FIN_BACKUP\n";
-	archivo.close();
 	std::cout << "Respaldo guardado correctamente en " << rutaCompleta << "\n";
 }
 
@@ -517,12 +465,48 @@ void Banco::guardarCuentasEnArchivo() {
 	std::string nombreArchivoUnico = Validar::generarNombreConIndice(rutaEscritorio, fechaFormateada);
 	std::string rutaCompleta = rutaEscritorio + nombreArchivoUnico + ".bak";
 
-	std::ofstream archivo(rutaCompleta, std::ios::out | std::ios::trunc);
-	if (!archivo.is_open()) {
+	if (guardarCuentasEnRuta(rutaCompleta) < 0) {
 		std::cout << "No se pudo abrir el archivo para guardar en: " << rutaCompleta << "\n";
 		return;
 	}
+	std::cout << "Respaldo guardado correctamente en " << rutaCompleta << "\n";
+}
 
+/**
+ * @brief Carga las cuentas desde un archivo de respaldo
+ *
+ * @param nombreArchivo Nombre del archivo desde donde cargar los datos
+ */
+void Banco::cargarCuentasDesdeArchivo(const std::string& nombreArchivo) {
+	std::string rutaEscritorio = obtenerRutaEscritorio();
+	std::string rutaCompleta = rutaEscritorio + nombreArchivo + ".bak";
+
+	int personas = cargarCuentasDesdeRuta(rutaCompleta);
+	if (personas == -1) {
+		std::cout << "No se pudo abrir el archivo para cargar desde: " << rutaCompleta << "\n";
+		return;
+	}
+	if (personas == -2) {
+		std::cout << "Formato de archivo invalido.\n";
+		return;
+	}
+	std::cout << "Se cargaron " << personas << " personas desde el archivo.\n";
+}
+
+/**
+ * @brief Escribe el respaldo de todas las cuentas en una ruta completa
+ *
+ * @param rutaCompleta Ruta del archivo de respaldo
+ * @return int Personas guardadas, o -1 si no se pudo escribir el archivo
+ */
+int Banco::guardarCuentasEnRuta(const std::string& rutaCompleta) const {
+	MEDIR_OPERACION(Operacion::GuardarRespaldo);
+	std::ofstream archivo(rutaCompleta, std::ios::out | std::ios::trunc);
+	if (!archivo.is_open()) {
+		return -1;
+	}
+
+	// Escribir cabecera
 	archivo << "BANCO_BACKUP_V1.0\n";
 
 	int contadorPersonas = 0;
@@ -557,37 +541,37 @@ void Banco::guardarCuentasEnArchivo() {
 	archivo << "TOTAL_PERSONAS:" << contadorPersonas << "\n";
 	archivo << "FIN_BACKUP\n";
 	archivo.close();
-	std::cout << "Respaldo guardado correctamente en " << rutaCompleta << "\n";
+	return archivo ? contadorPersonas : -1;
 }
 
 /**
- * @brief Carga las cuentas desde un archivo de respaldo
+ * @brief Reemplaza la lista de personas con el contenido de un respaldo
  *
- * @param nombreArchivo Nombre del archivo desde donde cargar los datos
+ * @param rutaCompleta Ruta del archivo de respaldo
+ * @return int Personas cargadas, -1 si no se pudo abrir el archivo o -2 si no es un respaldo
  */
-void Banco::cargarCuentasDesdeArchivo(const std::string& nombreArchivo) {
-	std::string rutaEscritorio = obtenerRutaEscritorio();
-	std::string rutaCompleta = rutaEscritorio + nombreArchivo + ".bak";
-
+int Banco::cargarCuentasDesdeRuta(const std::string& rutaCompleta) {
+	MEDIR_OPERACION(Operacion::CargarRespaldo);
 	std::ifstream archivo(rutaCompleta);
 	if (!archivo.is_open()) {
-		std::cout << "No se pudo abrir el archivo para cargar desde: " << rutaCompleta << "\n";
-		return;
-	}
-
-	while (listaPersonas) {
-		NodoPersona* temp = listaPersonas;
-		listaPersonas = listaPersonas->siguiente;
-		delete temp;
+		return -1;
 	}
 
 	std::string linea;
 	std::getline(archivo, linea);
+	if (!linea.empty() && linea.back() == '\r') {
+		linea.pop_back();
+	}
 
 	if (linea != "BANCO_BACKUP_V1.0") {
-		std::cout << "Formato de archivo invalido.\n";
 		archivo.close();
-		return;
+		return -2;
+	}
+
+	while (listaPersonas) {
+		NodoPersona* temp = listaPersonas;
+		listaPersonas = listaPersonas->siguiente;
+		delete temp;
 	}
 
 	Persona* personaActual = nullptr;
@@ -599,10 +583,13 @@ void Banco::cargarCuentasDesdeArchivo(const std::string& nombreArchivo) {
 	int contadorPersonas = 0;
 
 	std::string numCuenta = "";
-	int saldo = 0;
+	double saldo = 0;
 	std::string fechaApertura, estado;
 
 	while (std::getline(archivo, linea)) {
+		if (!linea.empty() && linea.back() == '\r') {
+			linea.pop_back();
+		}
 		if (linea == "===PERSONA_INICIO===") {
 			personaActual = new Persona();
 			enPersona = true;
@@ -665,36 +652,37 @@ void Banco::cargarCuentasDesdeArchivo(const std::string& nombreArchivo) {
 		}
 
 		if (enPersona && personaActual) {
-			if (linea.substr(0, 7) == "CEDULA:")
+			if (linea.compare(0, 7, "CEDULA:") == 0)
 				personaActual->setCedula(linea.substr(7));
-			else if (linea.substr(0, 8) == "NOMBRES:")
+			else if (linea.compare(0, 8, "NOMBRES:") == 0)
 				personaActual->setNombres(linea.substr(8));
-			else if (linea.substr(0, 10) == "APELLIDOS:")
+			else if (linea.compare(0, 10, "APELLIDOS:") == 0)
 				personaActual->setApellidos(linea.substr(10));
-			else if (linea.substr(0, 17) == "FECHA_NACIMIENTO:")
+			else if (linea.compare(0, 17, "FECHA_NACIMIENTO:") == 0)
 				personaActual->setFechaNacimiento(linea.substr(17));
-			else if (linea.substr(0, 7) == "CORREO:")
+			else if (linea.compare(0, 7, "CORREO:") == 0)
 				personaActual->setCorreo(linea.substr(7));
-			else if (linea.substr(0, 10) == "DIRECCION:")
+			else if (linea.compare(0, 10, "DIRECCION:") == 0)
 				personaActual->setDireccion(linea.substr(10));
 		}
 
 		if ((enCuentaAhorro || enCuentaCorriente) && (enCuentasAhorro || enCuentasCorriente)) {
-			if (linea.substr(0, 13) == "NUMERO_CUENTA:")
-				numCuenta = linea.substr(13);
-			else if (linea.substr(0, 6) == "SALDO:")
-				saldo = std::stoi(linea.substr(6));
-			else if (linea.substr(0, 14) == "FECHA_APERTURA:")
-				fechaApertura = linea.substr(14);
-			else if (linea.substr(0, 7) == "ESTADO:")
+			if (linea.compare(0, 14, "NUMERO_CUENTA:") == 0)
+				numCuenta = linea.substr(14);
+			else if (linea.compare(0, 6, "SALDO:") == 0)
+				saldo = std::stod(linea.substr(6));
+			else if (linea.compare(0, 15, "FECHA_APERTURA:") == 0)
+				fechaApertura = linea.substr(15);
+			else if (linea.compare(0, 7, "ESTADO:") == 0)
 				estado = linea.substr(7);
 		}
 	}
 
 	archivo.close();
-	std::cout << "Se cargaron " << contadorPersonas << " personas desde el archivo.\n";
+	return contadorPersonas;
 }
 
+#ifdef _WIN32
 /**
  * @brief Presenta un men para buscar cuentas segn diferentes criterios
  *
@@ -718,23 +706,8 @@ void Banco::buscarCuenta() {
 	int numOpcionesBusqueda = sizeof(opcionesBusqueda) / sizeof(opcionesBusqueda[0]);
 	int seleccionBusqueda = 0;
 
-	while (true) {
-		system("cls");
-		std::cout << "Seleccione el tipo de busqueda:\n\n";
-		for (int i = 0; i < numOpcionesBusqueda; i++) {
-			if (i == seleccionBusqueda)
-				std::cout << " > " << opcionesBusqueda[i] << std::endl;
-			else
-				std::cout << "   " << opcionesBusqueda[i] << std::endl;
-		}
-		int tecla = _getch();
-		if (tecla == 224) {
-			tecla = _getch();
-			if (tecla == 72) seleccionBusqueda = (seleccionBusqueda - 1 + numOpcionesBusqueda) % numOpcionesBusqueda;
-			else if (tecla == 80) seleccionBusqueda = (seleccionBusqueda + 1) % numOpcionesBusqueda;
-		}
-		else if (tecla == 13) break;
-	}
+	MenuConsola menuBusqueda("Seleccione el tipo de busqueda:\n\n", std::vector<std::string>(opcionesBusqueda, opcionesBusqueda + numOpcionesBusqueda));
+	seleccionBusqueda = menuBusqueda.seleccionar();
 	if (seleccionBusqueda == 4) return;
 
 	// Busqueda por fecha de creacion
@@ -901,57 +874,60 @@ void Banco::buscarCuenta() {
 		// Buscar la persona con esa cedula
 		bool encontrado = false;
 		NodoPersona* actual = listaPersonas;
-		while (actual) {
-			if (actual->persona && actual->persona->isValidInstance() && actual->persona->getCedula() == cedulaBuscar) 
-			{
-
-				// Encontramos la persona, mostrar sus datos y cuentas
-				cuentaAhorros = actual->persona->getCabezaAhorros();
-				cuentaCorriente = actual->persona->getCabezaCorriente();
-
-				// Mostrar datos basicos de la persona
-				std::cout << "\n----- DATOS DEL TITULAR -----\n";
-				std::cout << "Cedula: " << actual->persona->getCedula() << std::endl;
-				std::cout << "Nombre: " << actual->persona->getNombres() << " "
-					<< actual->persona->getApellidos() << std::endl;
-				std::cout << "Correo: " << actual->persona->getCorreo() << std::endl;
-
-				// Mostrar todas las cuentas de esta persona
-				std::cout << "\n----- CUENTAS ASOCIADAS -----\n";
+		{
+			MEDIR_OPERACION(Operacion::BuscarCedula);
+			while (actual && !(actual->persona && actual->persona->isValidInstance() && actual->persona->getCedula() == cedulaBuscar)) {
+				actual = actual->siguiente;
+			}
+		}
 
-				// Mostrar cuentas de ahorro
-				int contadorAhorros = 0;
-				while (cuentaAhorros) {
-					if (cuentaAhorros->getCuentaAhorros()) {
-						std::cout << "\nCUENTA DE AHORROS #" << ++contadorAhorros << std::endl;
-						// Pasar false para no limpiar pantalla entre cuentas
-						cuentaAhorros->getCuentaAhorros()->mostrarInformacion(cedulaBuscar, false);
-					}
-					cuentaAhorros = cuentaAhorros->getSiguiente();
-				}
+		if (actual)
+		{
 
-				// Mostrar cuentas corrientes
-				int contadorCorrientes = 0;
-				while (cuentaCorriente) {
-					if (cuentaCorriente->getCuentaCorriente()) {
-						std::cout << "\nCUENTA CORRIENTE #" << ++contadorCorrientes << std::endl;
-						// Pasar false para no limpiar pantalla entre cuentas
-						cuentaCorriente->getCuentaCorriente()->mostrarInformacion(cedulaBuscar, false);
-					}
-					cuentaCorriente = cuentaCorriente->getSiguiente();
+			// Encontramos la persona, mostrar sus datos y cuentas
+			cuentaAhorros = actual->persona->getCabezaAhorros();
+			cuentaCorriente = actual->persona->getCabezaCorriente();
+
+			// Mostrar datos basicos de la persona
+			std::cout << "\n----- DATOS DEL TITULAR -----\n";
+			std::cout << "Cedula: " << actual->persona->getCedula() << std::endl;
+			std::cout << "Nombre: " << actual->persona->getNombres() << " "
+				<< actual->persona->getApellidos() << std::endl;
+			std::cout << "Correo: " << actual->persona->getCorreo() << std::endl;
+
+			// Mostrar todas las cuentas de esta persona
+			std::cout << "\n----- CUENTAS ASOCIADAS -----\n";
+
+			// Mostrar cuentas de ahorro
+			int contadorAhorros = 0;
+			while (cuentaAhorros) {
+				if (cuentaAhorros->getCuentaAhorros()) {
+					std::cout << "\nCUENTA DE AHORROS #" << ++contadorAhorros << std::endl;
+					// Pasar false para no limpiar pantalla entre cuentas
+					cuentaAhorros->getCuentaAhorros()->mostrarInformacion(cedulaBuscar, false);
 				}
+				cuentaAhorros = cuentaAhorros->getSiguiente();
+			}
 
-				if (contadorAhorros == 0 && contadorCorrientes == 0) {
-					std::cout << "Esta persona no tiene cuentas asociadas.\n";
-				}
-				else {
-					std::cout << "\nTotal de cuentas: " << (contadorAhorros + contadorCorrientes) << std::endl;
+			// Mostrar cuentas corrientes
+			int contadorCorrientes = 0;
+			while (cuentaCorriente) {
+				if (cuentaCorriente->getCuentaCorriente()) {
+					std::cout << "\nCUENTA CORRIENTE #" << ++contadorCorrientes << std::endl;
+					// Pasar false para no limpiar pantalla entre cuentas
+					cuentaCorriente->getCuentaCorriente()->mostrarInformacion(cedulaBuscar, false);
 				}
+				cuentaCorriente = cuentaCorriente->getSiguiente();
+			}
 
-				encontrado = true;
-				break;
+			if (contadorAhorros == 0 && contadorCorrientes == 0) {
+				std::cout << "Esta persona no tiene cuentas asociadas.\n";
 			}
-			actual = actual->siguiente;
+			else {
+				std::cout << "\nTotal de cuentas: " << (contadorAhorros + contadorCorrientes) << std::endl;
+			}
+
+			encontrado = true;
 		}
 
 		if (!encontrado) {
@@ -962,6 +938,7 @@ void Banco::buscarCuenta() {
 		return;
 	}
 }
+#endif
 
 /**
  * @brief Funcin auxiliar para buscar cuentas por fecha de forma recursiva
@@ -990,6 +967,7 @@ void Banco::buscarCuentasPorFecha(const std::string& fecha) const {
 	}
 }
 
+#ifdef _WIN32
 /**
  * @brief Busca cuentas segn criterios personalizados del usuario
  *
@@ -1012,23 +990,8 @@ void Banco::buscarCuentasPorCriterio() {
 	int seleccion = 0;
 
 	// Menu de seleccion con cursor
-	while (true) {
-		system("cls");
-		std::cout << "Seleccione el criterio de busqueda de cuentas:\n\n";
-		for (int i = 0; i < numCriterios; i++) {
-			if (i == seleccion)
-				std::cout << " > " << criterios[i] << std::endl;
-			else
-				std::cout << "   " << criterios[i] << std::endl;
-		}
-		int tecla = _getch();
-		if (tecla == 224) {
-			tecla = _getch();
-			if (tecla == 72) seleccion = (seleccion - 1 + numCriterios) % numCriterios;
-			else if (tecla == 80) seleccion = (seleccion + 1) % numCriterios;
-		}
-		else if (tecla == 13) break;
-	}
+	MenuConsola menuCriterios("Seleccione el criterio de busqueda de cuentas:\n\n", std::vector<std::string>(criterios, criterios + numCriterios));
+	seleccion = menuCriterios.seleccionar();
 	if (seleccion == numCriterios - 1) return; // Cancelar
 
 	std::string fechaIngresada;
@@ -1694,18 +1657,21 @@ void Banco::realizarTransferencia() {
 	}
 
 	// 6. Realizar la transferencia
-	if (esAhorrosOrigen) {
-		cuentaAhorrosOrigen->retirar(montoEnCentavos);
-	}
-	else {
-		cuentaCorrienteOrigen->retirar(montoEnCentavos);
-	}
+	{
+		MEDIR_OPERACION(Operacion::Transferir);
+		if (esAhorrosOrigen) {
+			cuentaAhorrosOrigen->retirar(montoEnCentavos);
+		}
+		else {
+			cuentaCorrienteOrigen->retirar(montoEnCentavos);
+		}
 
-	if (esAhorrosDestino) {
-		cuentaAhorrosDestino->depositar(montoEnCentavos);
-	}
-	else {
-		cuentaCorrienteDestino->depositar(montoEnCentavos);
+		if (esAhorrosDestino) {
+			cuentaAhorrosDestino->depositar(montoEnCentavos);
+		}
+		else {
+			cuentaCorrienteDestino->depositar(montoEnCentavos);
+		}
 	}
 
 	// 7. Mostrar confirmacion
@@ -1717,6 +1683,7 @@ void Banco::realizarTransferencia() {
 
 	system("pause");
 }
+#endif
 
 /**
  * @brief Formatea un valor monetario con separadores de miles
@@ -1740,6 +1707,7 @@ std::string Banco::formatearConComas(double valorEnCentavos) const {
  * @return Ruta completa de la carpeta de la aplicacin
  */
 std::string Banco::obtenerRutaEscritorio() const {
+#ifdef _WIN32
 	PWSTR path = NULL;
 	std::string rutaEscritorio = "";
 
@@ -1770,4 +1738,16 @@ std::string Banco::obtenerRutaEscritorio() const {
 	system(comando.c_str());
 
 	return rutaEscritorio;
+#else
+	// Fuera de Windows: $HOME/Desktop si existe, si no el directorio actual
+	std::string rutaEscritorio = ".";
+	const char* home = std::getenv("HOME");
+	struct stat info;
+	if (home && stat((std::string(home) + "/Desktop").c_str(), &info) == 0 && S_ISDIR(info.st_mode)) {
+		rutaEscritorio = std::string(home) + "/Desktop";
+	}
+	rutaEscritorio += "/BancoApp/";
+	mkdir(rutaEscritorio.c_str(), 0755); // Si ya existe no hace nada
+	return rutaEscritorio;
+#endif
 }
\ No newline at end of file
@@ -4,10 +4,12 @@
 
 #include "Persona.h"
 #include "NodoPersona.h"
+#ifdef _WIN32
 #include <Shlobj.h>  // Para SHGetKnownFolderPath
 #include <comdef.h>  // Para _bstr_t
 #include <KnownFolders.h> // Para FOLDERID_Desktop
 #pragma comment(lib, "shell32.lib")  // Enlazar con shell32.lib
+#endif
 
 /**
  * @class Banco
@@ -76,6 +78,24 @@ public:
      */
     void cargarCuentasDesdeArchivo(const std::string& nombreArchivo);
 
+    /**
+     * @brief Guarda las cuentas en una ruta completa, sin mensajes por consola
+     * @param rutaCompleta Ruta del archivo de respaldo
+     * @return Nmero de personas guardadas, o -1 si no se pudo escribir el archivo
+     */
+    int guardarCuentasEnRuta(const std::string& rutaCompleta) const;
+
+    /**
+     * @brief Reemplaza la lista de personas con un respaldo, sin mensajes por consola
+     *
+     * La lista actual solo se libera si el archivo tiene la cabecera de respaldo.
+     *
+     * @param rutaCompleta Ruta del archivo de respaldo
+     * @return Nmero de personas cargadas, -1 si no se pudo abrir el archivo
+     *         o -2 si no tiene el formato de respaldo
+     */
+    int cargarCuentasDesdeRuta(const std::string& rutaCompleta);
+
     /**
      * @brief Busca una cuenta en el sistema
      *
@@ -114,7 +134,8 @@ public:
      * @brief Obtiene la ruta del escritorio del usuario actual
      * @return String con la ruta completa al escritorio
      *
-     * Utiliza funciones del API de Windows para obtener la ruta
+     * Utiliza funciones del API de Windows para obtener la ruta; en los dems
+     * sistemas usa $HOME/Desktop o, si no existe, el directorio actual
      */
     std::string obtenerRutaEscritorio() const;
 };
@@ -0,0 +1,19 @@
+/**
+ * @file BancoComandos.cpp
+ * @brief Programa sin consola interactiva que ejecuta guiones de comandos contra el banco
+ *
+ * Se compila con CMakeLists.txt en Windows y en Linux; la aplicación de menús
+ * ofrece el mismo modo con la opción --comandos.
+ */
+#include "InterpreteComandos.h"
+
+/**
+ * @brief Ejecuta el guion indicado o la entrada estándar
+ *
+ * @param argc Número de argumentos
+ * @param argv Argumentos: [guion]
+ * @return int Código de salida de InterpreteComandos::principal
+ */
+int main(int argc, char* argv[]) {
+    return InterpreteComandos::principal(argc, argv);
+}
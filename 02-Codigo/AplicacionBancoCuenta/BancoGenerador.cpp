@@ -0,0 +1,54 @@
+/**
+ * @file BancoGenerador.cpp
+ * @brief Programa que genera bancos sintéticos para pruebas de carga
+ *
+ * Uso: BancoGenerador --clientes N --salida ruta [--formato respaldo|csv]
+ *                     [--semilla 12345] [--hilos 0]
+ *
+ * El respaldo se recupera con la opción "Recuperar Archivo" o con el comando
+ * load; el CSV, con la importación masiva. Ver GeneradorBanco.
+ */
+#include "GeneradorBanco.h"
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * @brief Genera el banco indicado en la línea de comandos
+ *
+ * @param argc Número de argumentos
+ * @param argv Opciones
+ * @return int 0 si terminó bien, 1 si la generación falló, 2 si las opciones no son válidas
+ */
+int main(int argc, char* argv[]) {
+    ConfiguracionGenerador configuracion;
+    std::string formato = "respaldo";
+    std::string salida;
+    bool opcionesValidas = true;
+    for (int i = 1; i + 1 < argc && opcionesValidas; i += 2) {
+        const std::string opcion = argv[i];
+        const char* valor = argv[i + 1];
+        if (opcion == "--clientes") configuracion.clientes = std::strtoull(valor, nullptr, 10);
+        else if (opcion == "--semilla") configuracion.semilla = std::strtoull(valor, nullptr, 10);
+        else if (opcion == "--hilos") configuracion.hilos = static_cast<unsigned int>(std::strtoul(valor, nullptr, 10));
+        else if (opcion == "--formato") formato = valor;
+        else if (opcion == "--salida") salida = valor;
+        else opcionesValidas = false;
+    }
+    if (!opcionesValidas || argc % 2 == 0 || salida.empty() || (formato != "respaldo" && formato != "csv")) {
+        std::cerr << "Uso: " << argv[0] << " --clientes N --salida ruta [--formato respaldo|csv] [--semilla 12345] [--hilos 0]\n";
+        return 2;
+    }
+
+    const ResumenGeneracion resumen = formato == "csv"
+        ? GeneradorBanco::escribirCSV(configuracion, salida)
+        : GeneradorBanco::escribirRespaldo(configuracion, salida);
+    if (!resumen.exito) {
+        std::cerr << "Error: " << resumen.error << "\n";
+        return 1;
+    }
+    std::cout << "Clientes: " << resumen.clientes << "\n"
+        << "Cuentas de ahorros: " << resumen.cuentasAhorros << "\n"
+        << "Cuentas corrientes: " << resumen.cuentasCorrientes << "\n"
+        << "Segundos: " << resumen.segundos << "\n";
+    return 0;
+}
@@ -0,0 +1,1319 @@
+/**
+ * @file BancoPruebas.cpp
+ * @brief Comprobaciones automáticas de los módulos del banco que no usan la consola
+ *
+ * Uso: BancoPruebas [grupo]
+ *
+ * Sin argumentos ejecuta todos los grupos; con uno, solo ese. Cada fallo se
+ * informa con su archivo y línea en std::cerr y el programa termina con 1 si
+ * hubo alguno, de modo que ctest lo detecta.
+ */
+#include "VigilanteArchivo.h"
+#include "Cifrado.h"
+#include "Hash.h"
+#include "CacheHash.h"
+#include "CodigoQR.h"
+#include "AnalizadorMarquesina.h"
+#include "ImportadorCSV.h"
+#include "InterpreteComandos.h"
+#include "GeneradorBanco.h"
+#include "Estadisticas.h"
+#include "Persona.h"
+#include "Validar.h"
+#include "Utilidades.h"
+#include "Fecha.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <regex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#ifdef _WIN32
+#include <direct.h>
+#include <sys/utime.h>
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+#endif
+
+namespace {
+
+    /** @brief Comprobaciones que fallaron en el grupo actual */
+    int fallos = 0;
+
+    /** @brief Registra un fallo si la condición es falsa */
+    void comprobar(bool condicion, const char* expresion, const char* archivo, int linea) {
+        if (!condicion) {
+            std::cerr << archivo << ":" << linea << ": fallo: " << expresion << "\n";
+            ++fallos;
+        }
+    }
+
+#define COMPROBAR(condicion) comprobar((condicion), #condicion, __FILE__, __LINE__)
+
+    /** @brief Escribe un archivo completo con el texto dado */
+    void escribirArchivo(const std::string& ruta, const std::string& texto) {
+        std::ofstream archivo(ruta, std::ios::binary | std::ios::trunc);
+        archivo << texto;
+    }
+
+    // ----- VigilanteArchivo -----
+
+    /**
+     * @brief Espera un cambio del vigilante mientras otro hilo ejecuta una acción
+     *
+     * La acción se ejecuta poco después de empezar a esperar. Si el vigilante no
+     * despierta en limiteMs se cancela la espera, así una prueba fallida no
+     * bloquea a ctest.
+     *
+     * @return Resultado de esperarCambio()
+     */
+    bool cambioTrasAccion(VigilanteArchivo& vigilante, const std::function<void()>& accion, int limiteMs) {
+        std::mutex mutex;
+        std::condition_variable condicion;
+        bool terminado = false;
+        std::thread hilo([&]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            accion();
+            std::unique_lock<std::mutex> bloqueo(mutex);
+            if (!condicion.wait_for(bloqueo, std::chrono::milliseconds(limiteMs), [&]() { return terminado; })) {
+                vigilante.cancelar();
+            }
+        });
+        const bool cambio = vigilante.esperarCambio();
+        {
+            std::lock_guard<std::mutex> bloqueo(mutex);
+            terminado = true;
+        }
+        condicion.notify_all();
+        hilo.join();
+        return cambio;
+    }
+
+    /** @brief Escritura, reemplazo por renombrado y cambios de otros archivos */
+    void probarVigilante() {
+        const std::string directorio = "pruebas_vigilante";
+#ifdef _WIN32
+        _mkdir(directorio.c_str());
+#else
+        mkdir(directorio.c_str(), 0755);
+#endif
+        const std::string ruta = directorio + "/vigilado.txt";
+        const std::string temporal = directorio + "/vigilado.tmp";
+        const std::string otro = directorio + "/otro.txt";
+        escribirArchivo(ruta, "inicial");
+
+        {
+            VigilanteArchivo vigilante(ruta, 50);
+#ifdef __linux__
+            COMPROBAR(vigilante.usaNotificaciones());
+#endif
+            COMPROBAR(cambioTrasAccion(vigilante, [&]() { escribirArchivo(ruta, "modificado"); }, 5000));
+        }
+        {
+            // Así guardan los editores: escriben aparte y reemplazan el archivo
+            VigilanteArchivo vigilante(ruta, 50);
+            COMPROBAR(cambioTrasAccion(vigilante, [&]() {
+                escribirArchivo(temporal, "reemplazado");
+                std::remove(ruta.c_str());
+                std::rename(temporal.c_str(), ruta.c_str());
+            }, 5000));
+        }
+        {
+            // Otro archivo del directorio despierta al hilo pero no cuenta como cambio
+            VigilanteArchivo vigilante(ruta, 50);
+            COMPROBAR(!cambioTrasAccion(vigilante, [&]() { escribirArchivo(otro, "ajeno"); }, 300));
+            if (vigilante.usaNotificaciones()) {
+                COMPROBAR(vigilante.getDespertares() >= 1);
+            }
+        }
+
+        for (const std::string& archivo : { ruta, temporal, otro }) {
+            std::remove(archivo.c_str());
+        }
+#ifdef _WIN32
+        _rmdir(directorio.c_str());
+#else
+        rmdir(directorio.c_str());
+#endif
+    }
+
+    // ----- Validaciones sin expresiones regulares -----
+
+    /**
+     * @brief Validaciones tal como estaban con std::regex, para comparar los analizadores
+     *
+     * Copiadas de Validar.cpp y Utilidades.cpp antes de reemplazar las expresiones
+     * regulares; solo cambia sscanf_s por sscanf.
+     */
+    namespace conRegex {
+        bool numeroConDosDecimales(const std::string& monto) {
+            static const std::regex regex("^[0-9]+(\\.[0-9]{1,2})?$");
+            return std::regex_match(monto, regex);
+        }
+
+        bool saldo(const std::string& saldoStr) {
+            if (!numeroConDosDecimales(saldoStr)) return false;
+            try {
+                return std::stod(saldoStr) >= 0;
+            }
+            catch (...) {
+                return false;
+            }
+        }
+
+        bool fecha(const std::string& fecha) {
+            static const std::regex regex("^([0]?[1-9]|[12][0-9]|3[01])/([0]?[1-9]|1[0-2])/([0-9]{4})$");
+            if (!std::regex_match(fecha, regex)) return false;
+            int dia, mes, anio;
+            if (std::sscanf(fecha.c_str(), "%d/%d/%d", &dia, &mes, &anio) != 3) return false;
+            if (anio < 1900) return false;
+            if (mes < 1 || mes > 12) return false;
+            int diasMes[] = { 31,28,31,30,31,30,31,31,30,31,30,31 };
+            if (mes == 2 && ((anio % 4 == 0 && anio % 100 != 0) || (anio % 400 == 0))) diasMes[1] = 29;
+            if (dia < 1 || dia > diasMes[mes - 1]) return false;
+            std::tm hoy = Fecha::horaLocal(std::time(nullptr));
+            if (anio > hoy.tm_year + 1900) return false;
+            if (anio == hoy.tm_year + 1900 && mes > hoy.tm_mon + 1) return false;
+            if (anio == hoy.tm_year + 1900 && mes == hoy.tm_mon + 1 && dia > hoy.tm_mday) return false;
+            return true;
+        }
+
+        bool nombrePersona(const std::string& nombre) {
+            static const std::regex regex("^[a-zA-Z ]+$");
+            return std::regex_match(nombre, regex);
+        }
+
+        bool estadoCuenta(const std::string& estado) {
+            static const std::regex regex("^(Activa|Inactiva)$");
+            return std::regex_match(estado, regex);
+        }
+
+        bool tipoCuenta(const std::string& tipo) {
+            static const std::regex regex("^(Ahorros|Corriente)$");
+            return std::regex_match(tipo, regex);
+        }
+
+        bool tipoTransaccion(const std::string& tipo) {
+            static const std::regex regex("^(Retiro|Deposito)$");
+            return std::regex_match(tipo, regex);
+        }
+
+        bool correo(const std::string& correo) {
+            static const std::regex regex("(\\w+)(\\.|_)?(\\w*)@(\\w+)(\\.(\\w+))+");
+            return std::regex_match(correo, regex);
+        }
+    }
+
+    /** @brief Todas las cadenas del alfabeto con longitud de 0 a longitudMaxima */
+    std::vector<std::string> todasLasCadenas(const std::string& alfabeto, size_t longitudMaxima) {
+        std::vector<std::string> cadenas{ "" };
+        for (size_t inicio = 0; inicio < cadenas.size(); ++inicio) {
+            if (cadenas[inicio].size() == longitudMaxima) continue;
+            for (char c : alfabeto) {
+                cadenas.push_back(cadenas[inicio] + c);
+            }
+        }
+        return cadenas;
+    }
+
+    /** @brief Cadenas formadas por 1 a maximoPiezas piezas elegidas al azar */
+    std::vector<std::string> unirPiezas(const std::vector<std::string>& piezas, size_t maximoPiezas,
+        size_t cantidad, std::mt19937& aleatorio) {
+        std::vector<std::string> cadenas;
+        for (size_t i = 0; i < cantidad; ++i) {
+            std::string cadena;
+            const size_t partes = 1 + aleatorio() % maximoPiezas;
+            for (size_t p = 0; p < partes; ++p) {
+                cadena += piezas[aleatorio() % piezas.size()];
+            }
+            cadenas.push_back(cadena);
+        }
+        return cadenas;
+    }
+
+    /** @brief Comprueba que dos validaciones coincidan en todos los casos y muestra los primeros distintos */
+    void compararValidacion(const char* nombre, bool (*anterior)(const std::string&),
+        bool (*actual)(const std::string&), const std::vector<std::string>& casos) {
+        size_t distintos = 0;
+        for (const std::string& caso : casos) {
+            if (anterior(caso) != actual(caso)) {
+                if (++distintos <= 5) {
+                    std::cerr << nombre << ": distinto para \"" << caso << "\"\n";
+                }
+            }
+        }
+        COMPROBAR(distintos == 0);
+    }
+
+    /** @brief Los analizadores aceptan exactamente lo mismo que las expresiones regulares */
+    void probarValidaciones() {
+        std::mt19937 aleatorio(12345);
+
+        std::vector<std::string> montos = todasLasCadenas("05.-e +", 6);
+        for (const std::string& m : unirPiezas({ "0", "12", "999", ".", ".5", ".05", ".123", "-", "e3", " " }, 5, 20000, aleatorio)) {
+            montos.push_back(m);
+        }
+        compararValidacion("ValidarNumeroConDosDecimales", conRegex::numeroConDosDecimales,
+            Validar::ValidarNumeroConDosDecimales, montos);
+        compararValidacion("ValidarSaldo", conRegex::saldo, Validar::ValidarSaldo, montos);
+
+        // Fechas armadas por partes, cerca de los límites de cada campo y de hoy
+        const std::tm hoy = Fecha::horaLocal(std::time(nullptr));
+        const std::vector<std::string> dias{ "", "0", "1", "9", "00", "01", "09", "10", "19", "28", "29", "30", "31", "32",
+            "39", "001", "1a", std::to_string(hoy.tm_mday), std::to_string(hoy.tm_mday + 1) };
+        const std::vector<std::string> meses{ "", "0", "1", "2", "9", "00", "01", "02", "09", "10", "12", "13", "20",
+            "001", std::to_string(hoy.tm_mon + 1), std::to_string(hoy.tm_mon + 2) };
+        const std::vector<std::string> anios{ "", "1", "999", "1899", "1900", "1904", "2000", "2023", "2024", "2100",
+            "0000", "12345", std::to_string(hoy.tm_year + 1900), std::to_string(hoy.tm_year + 1901) };
+        std::vector<std::string> fechas;
+        for (const std::string& d : dias) {
+            for (const std::string& m : meses) {
+                for (const std::string& a : anios) {
+                    fechas.push_back(d + "/" + m + "/" + a);
+                }
+            }
+        }
+        for (const std::string& f : unirPiezas({ "0", "1", "2", "3", "9", "12", "29", "/", "-", " ", "2000", "x" }, 8, 20000, aleatorio)) {
+            fechas.push_back(f);
+        }
+        compararValidacion("ValidarFecha", conRegex::fecha, Validar::ValidarFecha, fechas);
+
+        compararValidacion("ValidarNombrePersona", conRegex::nombrePersona, Validar::ValidarNombrePersona,
+            todasLasCadenas("aZ -1\xF1", 6));
+
+        const std::vector<std::string> palabras{ "", "Activa", "Inactiva", "activa", "Activa ", " Activa", "ActivaInactiva",
+            "Ahorros", "Corriente", "Ahorro", "Retiro", "Deposito", "Dep\xF3sito", "Retiros", "A" };
+        compararValidacion("ValidarEstadoCuenta", conRegex::estadoCuenta, Validar::ValidarEstadoCuenta, palabras);
+        compararValidacion("ValidarTipoCuenta", conRegex::tipoCuenta, Validar::ValidarTipoCuenta, palabras);
+        compararValidacion("ValidarTipoTransaccion", conRegex::tipoTransaccion, Validar::ValidarTipoTransaccion, palabras);
+
+        std::vector<std::string> correos = todasLasCadenas("aZ0_.@-", 7);
+        for (const std::string& c : unirPiezas({ "a", "ab", "Z9", "_", ".", "@", "x.y", "com", ".com", "-", "\xF1" }, 7, 50000, aleatorio)) {
+            correos.push_back(c);
+        }
+        compararValidacion("EsCorreoValido", conRegex::correo, Utilidades::EsCorreoValido, correos);
+    }
+
+    // ----- Validación por lotes -----
+
+    /**
+     * @brief Registro de prueba para las validaciones por lotes
+     *
+     * Mezcla cédulas y cuentas válidas con los casos que cada regla rechaza:
+     * verificador, provincia, tercer dígito, dígitos iguales, caracteres que no
+     * son dígitos (incluidos los vecinos de '0' y '9' y bytes altos) y, si se
+     * permite, longitudes distintas de 10.
+     */
+    std::string registroLote(std::mt19937& aleatorio, bool otrasLongitudes) {
+        std::string registro(10, '0');
+        for (char& c : registro) c = static_cast<char>('0' + aleatorio() % 10);
+        switch (aleatorio() % 8) {
+        case 0:
+        case 1: {
+            // Cédula válida: provincia 01-24, tercer dígito 0-5 y verificador correcto
+            const unsigned provincia = 1 + aleatorio() % 24;
+            registro[0] = static_cast<char>('0' + provincia / 10);
+            registro[1] = static_cast<char>('0' + provincia % 10);
+            registro[2] = static_cast<char>('0' + aleatorio() % 6);
+            int suma = 0;
+            for (int i = 0; i < 9; ++i) {
+                int valor = (registro[i] - '0') * (i % 2 == 0 ? 2 : 1);
+                suma += valor > 9 ? valor - 9 : valor;
+            }
+            registro[9] = static_cast<char>('0' + (10 - suma % 10) % 10);
+            break;
+        }
+        case 2: {
+            // Cuenta válida: el último dígito es la suma de los nueve primeros módulo 10
+            int suma = 0;
+            for (int i = 0; i < 9; ++i) suma += registro[i] - '0';
+            registro[9] = static_cast<char>('0' + suma % 10);
+            break;
+        }
+        case 3:
+            registro.assign(10, static_cast<char>('0' + aleatorio() % 10));
+            break;
+        case 4: {
+            const char ajenos[] = { '/', ':', 'a', ' ', '\0', '\x7F', '\x80', '\xFF' };
+            registro[aleatorio() % 10] = ajenos[aleatorio() % sizeof(ajenos)];
+            break;
+        }
+        case 5:
+            if (otrasLongitudes) registro.resize(aleatorio() % 13);
+            break;
+        default:
+            break;
+        }
+        return registro;
+    }
+
+    /**
+     * @brief Comprueba un mapa de lote contra la validación individual
+     *
+     * Además de cada bit, exige que los bits posteriores al último registro de
+     * la última palabra queden en 0 y que la cuenta de válidos coincida.
+     */
+    void compararMapa(const char* nombre, const std::vector<uint64_t>& mapa, size_t validos,
+        const std::vector<std::string>& registros, bool (*individual)(const std::string&)) {
+        bool correcto = mapa.size() == (registros.size() + 63) / 64;
+        size_t esperados = 0;
+        for (size_t i = 0; correcto && i < mapa.size() * 64; ++i) {
+            const bool bit = ((mapa[i / 64] >> (i % 64)) & 1) != 0;
+            const bool valido = i < registros.size() && individual(registros[i]);
+            esperados += valido ? 1 : 0;
+            correcto = bit == valido;
+        }
+        correcto = correcto && validos == esperados;
+        if (!correcto) {
+            std::cerr << nombre << ": mapa distinto con " << registros.size() << " registros\n";
+        }
+        COMPROBAR(correcto);
+    }
+
+    /** @brief Los mapas de bits por lotes coinciden con la validación de una en una */
+    void probarLotes() {
+        std::mt19937 aleatorio(12345);
+        std::vector<size_t> cantidades;
+        for (size_t n = 0; n <= 200; ++n) cantidades.push_back(n);
+        for (size_t n : { 1000, 4095, 4096, 4097, 65537 }) cantidades.push_back(n);
+
+        for (size_t cantidad : cantidades) {
+            std::vector<std::string> registros;
+            for (size_t i = 0; i < cantidad; ++i) {
+                registros.push_back(registroLote(aleatorio, true));
+            }
+            auto contar = [](const std::vector<uint64_t>& mapa) {
+                size_t bits = 0;
+                for (uint64_t palabra : mapa) {
+                    for (; palabra != 0; palabra &= palabra - 1) ++bits;
+                }
+                return bits;
+            };
+            std::vector<uint64_t> mapa = Validar::ValidarCedulasLote(registros);
+            compararMapa("ValidarCedulasLote(cadenas)", mapa, contar(mapa), registros, Validar::ValidarCedula);
+            mapa = Validar::ValidarNumerosCuentaLote(registros);
+            compararMapa("ValidarNumerosCuentaLote(cadenas)", mapa, contar(mapa), registros,
+                Validar::ValidarDigitoVerificadorCuenta);
+
+            // Ancho fijo: el búfer termina justo después del último registro y el
+            // mapa empieza lleno de unos para notar bits que no se escriban
+            for (size_t paso : { 10, 11, 16 }) {
+                for (std::string& registro : registros) {
+                    if (registro.size() != 10) registro = registroLote(aleatorio, false);
+                }
+                std::vector<char> datos(cantidad * paso, '#');
+                for (size_t i = 0; i < cantidad; ++i) {
+                    std::copy(registros[i].begin(), registros[i].end(), datos.begin() + i * paso);
+                }
+                const size_t palabras = (cantidad + 63) / 64;
+                mapa.assign(palabras, ~uint64_t(0));
+                size_t validos = Validar::ValidarCedulasLote(datos.data(), cantidad, paso, mapa.data());
+                compararMapa("ValidarCedulasLote(ancho fijo)", mapa, validos, registros, Validar::ValidarCedula);
+                mapa.assign(palabras, ~uint64_t(0));
+                validos = Validar::ValidarNumerosCuentaLote(datos.data(), cantidad, paso, mapa.data());
+                compararMapa("ValidarNumerosCuentaLote(ancho fijo)", mapa, validos, registros,
+                    Validar::ValidarDigitoVerificadorCuenta);
+            }
+        }
+    }
+
+    // ----- Cifrado v2 -----
+
+    /** @brief Lee un archivo completo; vacío si no existe */
+    std::string leerArchivo(const std::string& ruta) {
+        std::ifstream archivo(ruta, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(archivo), std::istreambuf_iterator<char>());
+    }
+
+    /** @brief Indica si DescifrarArchivoV2 lanza std::runtime_error */
+    bool descifradoFalla(const std::string& entrada, const std::string& salida, const std::string& clave) {
+        try {
+            Cifrado::DescifrarArchivoV2(entrada, salida, clave, 2);
+        }
+        catch (const std::runtime_error&) {
+            return true;
+        }
+        return false;
+    }
+
+    /** @brief Ida y vuelta, byte alterado, clave incorrecta y cabecera fuera de rango */
+    void probarCifrado() {
+        const std::string plano = "pruebas_cifrado.txt";
+        const std::string cifrado = "pruebas_cifrado.bin";
+        const std::string alterado = "pruebas_cifrado_alterado.bin";
+        const std::string salida = "pruebas_cifrado_salida.txt";
+
+        // Varios bloques de 1000 bytes y uno final incompleto
+        std::mt19937 aleatorio(2026);
+        std::string contenido(4321, '\0');
+        for (char& c : contenido) c = static_cast<char>(aleatorio());
+        escribirArchivo(plano, contenido);
+
+        Cifrado::CifrarArchivoV2(plano, cifrado, "frase correcta", 2, 1000);
+        COMPROBAR(Cifrado::EsArchivoV2(cifrado));
+        COMPROBAR(leerArchivo(cifrado + ".tmp").empty());
+        Cifrado::DescifrarArchivoV2(cifrado, salida, "frase correcta", 2);
+        COMPROBAR(leerArchivo(salida) == contenido);
+
+        // Con un error la salida anterior queda intacta y no se deja el temporal
+        escribirArchivo(salida, "anterior");
+        COMPROBAR(descifradoFalla(cifrado, salida, "frase incorrecta"));
+        COMPROBAR(leerArchivo(salida) == "anterior");
+
+        const std::string original = leerArchivo(cifrado);
+        std::string bytes = original;
+        bytes[64 + 2500] ^= 0x01; // Dentro del tercer bloque sellado
+        escribirArchivo(alterado, bytes);
+        COMPROBAR(descifradoFalla(alterado, salida, "frase correcta"));
+        COMPROBAR(leerArchivo(salida) == "anterior");
+        COMPROBAR(leerArchivo(salida + ".tmp").empty());
+
+        // Cabecera sin autenticar que pide 2^32 - 1 iteraciones: se rechaza sin derivar
+        bytes = original;
+        for (size_t i = 24; i < 28; ++i) bytes[i] = '\xff';
+        escribirArchivo(alterado, bytes);
+        const auto inicio = std::chrono::steady_clock::now();
+        COMPROBAR(descifradoFalla(alterado, salida, "frase correcta"));
+        COMPROBAR(std::chrono::steady_clock::now() - inicio < std::chrono::seconds(2));
+
+        // Cabecera con un bloque de 4 GiB - 1
+        bytes = original;
+        for (size_t i = 12; i < 16; ++i) bytes[i] = '\xff';
+        escribirArchivo(alterado, bytes);
+        COMPROBAR(descifradoFalla(alterado, salida, "frase correcta"));
+        COMPROBAR(leerArchivo(salida) == "anterior");
+
+        for (const std::string& archivo : { plano, cifrado, alterado, salida }) {
+            std::remove(archivo.c_str());
+        }
+    }
+
+    // ----- SHA-1 y SHA-256 -----
+
+    /** @brief Resumen en hexadecimal de un mensaje, agregado por trozos de tamaño irregular */
+    template <typename Contexto>
+    std::string resumirPorTrozos(const std::string& mensaje) {
+        Contexto contexto;
+        const uint8_t* datos = reinterpret_cast<const uint8_t*>(mensaje.data());
+        size_t hecho = 0;
+        for (size_t trozo = 1; hecho < mensaje.size(); trozo = trozo * 3 + 1) {
+            const size_t cantidad = std::min(trozo, mensaje.size() - hecho);
+            contexto.actualizar(datos + hecho, cantidad);
+            hecho += cantidad;
+        }
+        uint8_t resumen[Contexto::TAM_RESUMEN];
+        contexto.finalizar(resumen);
+        static const char DIGITOS[] = "0123456789abcdef";
+        std::string hex;
+        for (uint8_t byte : resumen) {
+            hex += DIGITOS[byte >> 4];
+            hex += DIGITOS[byte & 0x0f];
+        }
+        return hex;
+    }
+
+    /** @brief Vectores de FIPS 180-4 con la implementación portable y, si la hay, la de hardware */
+    void probarSha() {
+        struct Vector {
+            std::string mensaje;
+            const char* sha1;
+            const char* sha256;
+        };
+        const Vector VECTORES[] = {
+            { "",
+              "da39a3ee5e6b4b0d3255bfef95601890afd80709",
+              "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855" },
+            { "abc",
+              "a9993e364706816aba3e25717850c26c9cd0d89d",
+              "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad" },
+            { "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+              "84983e441c3bd26ebaae4aa1f95129e5e54670f1",
+              "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1" },
+            { std::string(1000000, 'a'),
+              "34aa973cd4c4daa4f61eeb2bdbad27316534016f",
+              "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0" },
+        };
+
+        const bool hayHardware = Hash::aceleracionHardware();
+        for (bool hardware : { false, true }) {
+            if (hardware && !hayHardware) continue;
+            COMPROBAR(Hash::usarAceleracionHardware(hardware));
+            for (const Vector& vector : VECTORES) {
+                const uint8_t* datos = reinterpret_cast<const uint8_t*>(vector.mensaje.data());
+                COMPROBAR(Hash::calcularBuffer(datos, vector.mensaje.size(), AlgoritmoHash::SHA1) == vector.sha1);
+                COMPROBAR(Hash::calcularBuffer(datos, vector.mensaje.size(), AlgoritmoHash::SHA256) == vector.sha256);
+                COMPROBAR(resumirPorTrozos<ContextoSHA1>(vector.mensaje) == vector.sha1);
+                COMPROBAR(resumirPorTrozos<ContextoSHA256>(vector.mensaje) == vector.sha256);
+            }
+        }
+        Hash::usarAceleracionHardware(hayHardware);
+    }
+
+    // ----- Hash por bloques (árbol de Merkle) -----
+
+    /** @brief Hojas, raíz, bloques alterados, actualización por rangos y lectura del .hash */
+    void probarMerkle() {
+        const std::string ruta = "pruebas_merkle.bak";
+        const std::string rutaHash = ruta + ".hash";
+
+        // Hojas SHA-256(0x00 || bloque); el tercer nodo sube sin pareja a la raíz
+        escribirArchivo(ruta, "abcdefghij");
+        HashMerkle hash;
+        COMPROBAR(Hash::calcularMerkle(ruta, AlgoritmoHash::SHA256, 4, hash, 2));
+        COMPROBAR(hash.tamanio == 10);
+        COMPROBAR(hash.bloques == std::vector<std::string>({
+            "b4768f09ca070169db2f5962745531650515dbd00ea5bf393cd88fec601d598a",
+            "3aac0bdbaff34540d716868ea9c743cd667dfbb1b46d30f9bbbec7ed16415e44",
+            "54e62ec3b5438e8e41c0ba6348b48f5e24bf8d6c19cd2c0e682011565d98b27d" }));
+        COMPROBAR(hash.raiz == "2a5b33d54d89d05737a7dd798d9862d55951564aafb5460691ad8a7a9ab6c678");
+        COMPROBAR(Hash::raizMerkle({}, AlgoritmoHash::SHA256) ==
+            "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+
+        // Diez bloques de 64 bytes; se altera un byte del séptimo
+        std::string contenido(640, '\0');
+        for (size_t i = 0; i < contenido.size(); ++i) contenido[i] = static_cast<char>(i * 7);
+        escribirArchivo(ruta, contenido);
+        COMPROBAR(Hash::calcularMerkle(ruta, AlgoritmoHash::SHA256, 64, hash, 2));
+        const HashMerkle original = hash;
+        std::string alterado = contenido;
+        alterado[6 * 64 + 10] ^= 0x20;
+        escribirArchivo(ruta, alterado);
+        std::vector<uint64_t> bloques;
+        COMPROBAR(Hash::compararMerkle(ruta, original, bloques, 2));
+        COMPROBAR(bloques == std::vector<uint64_t>({ 6 }));
+
+        // Actualización por rangos: solo se leen los bloques indicados
+        HashMerkle completo;
+        COMPROBAR(Hash::calcularMerkle(ruta, AlgoritmoHash::SHA256, 64, completo, 2));
+        hash = original;
+        COMPROBAR(Hash::actualizarMerkle(ruta, hash, { { 6 * 64 + 10, 6 * 64 + 11 } }, bloques, 2));
+        COMPROBAR(bloques == std::vector<uint64_t>({ 6 }));
+        COMPROBAR(hash.raiz == completo.raiz);
+        hash = original;
+        COMPROBAR(Hash::actualizarMerkle(ruta, hash, { { 0, 10 } }, bloques, 2));
+        COMPROBAR(bloques.empty());
+        COMPROBAR(hash.raiz == original.raiz);
+
+        // Datos agregados al final: se rehace el último bloque incompleto y los nuevos
+        escribirArchivo(ruta, contenido.substr(0, 600));
+        COMPROBAR(Hash::calcularMerkle(ruta, AlgoritmoHash::SHA256, 64, hash, 2));
+        escribirArchivo(ruta, contenido + "agregado");
+        COMPROBAR(Hash::actualizarMerkle(ruta, hash, {}, bloques, 2));
+        COMPROBAR(bloques == std::vector<uint64_t>({ 9, 10 }));
+        COMPROBAR(Hash::calcularMerkle(ruta, AlgoritmoHash::SHA256, 64, completo, 2));
+        COMPROBAR(hash.bloques == completo.bloques && hash.raiz == completo.raiz);
+
+        // Archivo acortado: sobran hojas y el nuevo último bloque queda incompleto
+        escribirArchivo(ruta, contenido.substr(0, 300));
+        COMPROBAR(Hash::actualizarMerkle(ruta, hash, {}, bloques, 2));
+        COMPROBAR(bloques == std::vector<uint64_t>({ 4, 5, 6, 7, 8, 9, 10 }));
+        COMPROBAR(Hash::calcularMerkle(ruta, AlgoritmoHash::SHA256, 64, completo, 2));
+        COMPROBAR(hash.bloques == completo.bloques && hash.raiz == completo.raiz);
+
+        // El .hash se rechaza con índices fuera de orden, bloques de menos o raíz ajena
+        Utilidades::guardarHashMerkle(ruta, completo);
+        HashMerkle leido;
+        COMPROBAR(Utilidades::leerHashMerkle(rutaHash, leido));
+        COMPROBAR(leido.bloques == completo.bloques && leido.raiz == completo.raiz);
+        auto sidecar = [&](const std::vector<std::string>& bloquesTexto, const std::string& raiz) {
+            std::string texto = "MERKLE-SHA256:" + raiz + "-300\nTAM_BLOQUE:64\n";
+            for (const std::string& linea : bloquesTexto) texto += linea + "\n";
+            escribirArchivo(rutaHash, texto);
+            return Utilidades::leerHashMerkle(rutaHash, leido);
+        };
+        std::vector<std::string> lineas;
+        for (size_t i = 0; i < completo.bloques.size(); ++i) {
+            lineas.push_back("BLOQUE:" + std::to_string(i) + ":" + completo.bloques[i]);
+        }
+        COMPROBAR(sidecar(lineas, completo.raiz));
+        COMPROBAR(!sidecar(lineas, original.raiz));
+        std::vector<std::string> desordenadas = lineas;
+        std::swap(desordenadas[1], desordenadas[2]);
+        COMPROBAR(!sidecar(desordenadas, completo.raiz));
+        std::vector<std::string> renumeradas = lineas;
+        renumeradas[3] = "BLOQUE:7:" + completo.bloques[3];
+        COMPROBAR(!sidecar(renumeradas, completo.raiz));
+        std::vector<std::string> incompletas(lineas.begin(), lineas.end() - 1);
+        COMPROBAR(!sidecar(incompletas, Hash::raizMerkle(
+            std::vector<std::string>(completo.bloques.begin(), completo.bloques.end() - 1), AlgoritmoHash::SHA256)));
+
+        std::remove(ruta.c_str());
+        std::remove(rutaHash.c_str());
+    }
+
+    // ----- Caché de hashes -----
+
+    /** @brief Fija la fecha de modificación de un archivo, en segundos desde 1970 */
+    void fijarModificacion(const std::string& ruta, time_t segundos) {
+#ifdef _WIN32
+        struct _utimbuf tiempos = { segundos, segundos };
+        _utime(ruta.c_str(), &tiempos);
+#else
+        struct utimbuf tiempos = { segundos, segundos };
+        utime(ruta.c_str(), &tiempos);
+#endif
+    }
+
+    /** @brief Aciertos con el archivo intacto e invalidación al cambiar fecha o tamaño */
+    void probarCacheHash() {
+        const std::string ruta = "pruebas_cache.bak";
+        const std::string rutaIndice = "pruebas_cache.idx";
+        const time_t base = 1700000000;
+        escribirArchivo(ruta, "contenido");
+        fijarModificacion(ruta, base);
+
+        int calculos = 0;
+        auto calcular = [&]() {
+            ++calculos;
+            return Utilidades::calcularHash(ruta, AlgoritmoHash::SHA256);
+        };
+        bool desdeCache = true;
+        CacheHash cache(rutaIndice);
+        const std::string hash = cache.obtener(ruta, "SHA256", calcular, &desdeCache);
+        COMPROBAR(!desdeCache && calculos == 1 && !hash.empty());
+        COMPROBAR(cache.obtener(ruta, "SHA256", calcular, &desdeCache) == hash);
+        COMPROBAR(desdeCache && calculos == 1);
+
+        // Otra etiqueta es otra entrada
+        cache.obtener(ruta, "SHA1", calcular, &desdeCache);
+        COMPROBAR(!desdeCache && calculos == 2);
+
+        // Mismo tamaño, otra fecha
+        escribirArchivo(ruta, "CONTENIDO");
+        fijarModificacion(ruta, base + 10);
+        const std::string conOtraFecha = cache.obtener(ruta, "SHA256", calcular, &desdeCache);
+        COMPROBAR(!desdeCache && calculos == 3 && conOtraFecha != hash);
+
+        // Misma fecha, otro tamaño
+        escribirArchivo(ruta, "contenido mas largo");
+        fijarModificacion(ruta, base + 10);
+        cache.obtener(ruta, "SHA256", calcular, &desdeCache);
+        COMPROBAR(!desdeCache && calculos == 4);
+        COMPROBAR(cache.getAciertos() == 1 && cache.getFallos() == 4);
+
+        // El índice guardado sirve a otra instancia hasta que se invalida
+        COMPROBAR(cache.guardar());
+        CacheHash recargada(rutaIndice);
+        COMPROBAR(recargada.cargar());
+        recargada.obtener(ruta, "SHA256", calcular, &desdeCache);
+        COMPROBAR(desdeCache && calculos == 4);
+        recargada.invalidar(ruta);
+        recargada.obtener(ruta, "SHA256", calcular, &desdeCache);
+        COMPROBAR(!desdeCache && calculos == 5);
+
+        // Un archivo que no existe no se calcula ni se guarda
+        std::remove(ruta.c_str());
+        COMPROBAR(recargada.obtener(ruta, "SHA256", calcular, &desdeCache).empty());
+        COMPROBAR(calculos == 5);
+        std::remove(rutaIndice.c_str());
+    }
+
+    // ----- Código QR -----
+
+    /** @brief Compara un código con una matriz esperada, fila por fila ('#' = módulo negro) */
+    bool matrizIgual(const CodigoQR::QrCode& qr, const std::vector<std::string>& filas) {
+        if (qr.getSize() != static_cast<int>(filas.size())) return false;
+        for (int y = 0; y < qr.getSize(); ++y) {
+            for (int x = 0; x < qr.getSize(); ++x) {
+                if (qr.getModule(x, y) != (filas[static_cast<size_t>(y)][static_cast<size_t>(x)] == '#')) return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Matrices conocidas con la elección de máscara en serie y en paralelo
+     *
+     * Las matrices son las que produce la implementación original, previa a la
+     * matriz empaquetada, a las plantillas y a la máscara en paralelo.
+     */
+    void probarQr() {
+        // Ejemplo clásico 1-Q: modo alfanumérico, máscara 0
+        const std::vector<std::string> MENSAJE_1Q = {
+            "#######.##....#######",
+            "#.....#.#..#..#.....#",
+            "#.###.#.#..##.#.###.#",
+            "#.###.#.#.....#.###.#",
+            "#.###.#.#.#...#.###.#",
+            "#.....#...#...#.....#",
+            "#######.#.#.#.#######",
+            "........#............",
+            ".##.#.##....#.#.#####",
+            ".#......####....#...#",
+            "..##.###.##...#.##...",
+            ".##.##.#..##.#.#.###.",
+            "#...#.#.#.###.###.#.#",
+            "........##.#..#...#.#",
+            "#######.#.#....#.##..",
+            "#.....#..#.##.##.#...",
+            "#.###.#.#.#...#######",
+            "#.###.#..#.#.#.#...#.",
+            "#.###.#.#..#.###.#..#",
+            "#.....#.#.####...#.##",
+            "#######....#.###....#",
+        };
+        // Modo byte, versión 2-M, máscara 6
+        const std::vector<std::string> CUENTA_2M = {
+            "#######...#.#.###.#######",
+            "#.....#.#####.....#.....#",
+            "#.###.#..#.##..##.#.###.#",
+            "#.###.#.##.....#..#.###.#",
+            "#.###.#.####..#...#.###.#",
+            "#.....#...###.....#.....#",
+            "#######.#.#.#.#.#.#######",
+            "........####.#.##........",
+            ".#.####.#....#.#.##.##.#.",
+            "#.##.....##..#.###..###..",
+            "..#.######.#.#.#.###....#",
+            "....#..####.##.#..##.##.#",
+            "##..#.######.#.#.##..#..#",
+            "#.#.##..#...#.##.#.#####.",
+            "##..####..##.###..#..#.##",
+            "#..##.....#.........####.",
+            "#.##.###.##...#######.###",
+            "........#..#.#.##...#####",
+            "#######..#..###.#.#.###.#",
+            "#.....#.###.....#...##.##",
+            "#.###.#.##.##..#######..#",
+            "#.###.#.##.#....#.##..###",
+            "#.###.#..#..#.#.....#..##",
+            "#.....#.#..##.##.##...###",
+            "#######...#.#..##..###..#",
+        };
+
+        const unsigned int hilosAnteriores = CodigoQR::QrCode::getMaskThreads();
+        for (unsigned int hilos : { 1u, 4u }) {
+            CodigoQR::QrCode::setMaskThreads(hilos);
+            CodigoQR::QrCode qr = CodigoQR::QrCode::encodeText("HELLO WORLD", CodigoQR::QrCode::Ecc::QUARTILE);
+            COMPROBAR(qr.getVersion() == 1 && qr.getMask() == 0);
+            COMPROBAR(matrizIgual(qr, MENSAJE_1Q));
+            COMPROBAR(matrizIgual(CodigoQR::QrCode::encodeTextOptimal("HELLO WORLD", CodigoQR::QrCode::Ecc::QUARTILE), MENSAJE_1Q));
+
+            qr = CodigoQR::QrCode::encodeText("Cuenta 1712345678", CodigoQR::QrCode::Ecc::MEDIUM);
+            COMPROBAR(qr.getVersion() == 2 && qr.getMask() == 6);
+            COMPROBAR(matrizIgual(qr, CUENTA_2M));
+        }
+        CodigoQR::QrCode::setMaskThreads(hilosAnteriores);
+    }
+
+    // ----- Marquesina -----
+
+    namespace conRegex {
+        /** @brief Código de color de consola de un nombre; -1 si no se reconoce */
+        int codigoColor(const std::string& nombre) {
+            static const char* const NOMBRES[] = { "black", "blue", "green", "cyan", "red", "magenta", "yellow", "white" };
+            for (int i = 0; i < 8; ++i) {
+                if (nombre == NOMBRES[i]) return i;
+            }
+            return -1;
+        }
+
+        /**
+         * @brief Marquesina::parsearHTML tal como estaba con std::regex
+         *
+         * Copiada de Marquesina.cpp antes del analizador de una pasada; las cadenas
+         * de if por color se reemplazan por codigoColor con el mismo resultado.
+         */
+        std::vector<ElementoMarquesina> parsearMarquesina(const std::string& contenido) {
+            std::vector<ElementoMarquesina> resultado;
+            static const std::regex marquesinaRegex("<marquesina>[\\s\\S]*?</marquesina>");
+            static const std::regex colorRegex("<color=([a-z]+)(?:\\s+bg=([a-z]+))?>(.*?)</color>");
+            static const std::regex boldRegex("<b>(.*?)</b>");
+
+            std::smatch matchMarquesina;
+            if (std::regex_search(contenido, matchMarquesina, marquesinaRegex)) {
+                std::string textoMarquesina = matchMarquesina.str();
+                textoMarquesina = std::regex_replace(textoMarquesina, std::regex("<marquesina>"), "");
+                textoMarquesina = std::regex_replace(textoMarquesina, std::regex("</marquesina>"), "");
+
+                std::string::const_iterator searchStart(textoMarquesina.cbegin());
+                std::string::const_iterator end(textoMarquesina.cend());
+                std::smatch match;
+                while (std::regex_search(searchStart, end, match, colorRegex)) {
+                    ElementoMarquesina elem;
+                    const int texto = codigoColor(match[1].str());
+                    elem.colorTexto = texto < 0 ? 7 : texto;
+                    const int fondo = match[2].matched ? codigoColor(match[2].str()) : 0;
+                    elem.colorFondo = fondo < 0 ? 0 : fondo;
+
+                    std::string contenidoColor = match[3].str();
+                    std::smatch boldMatch;
+                    if (std::regex_search(contenidoColor, boldMatch, boldRegex)) {
+                        elem.negrita = true;
+                        elem.texto = boldMatch[1].str();
+                    }
+                    else {
+                        elem.negrita = false;
+                        elem.texto = contenidoColor;
+                    }
+                    resultado.push_back(elem);
+                    searchStart = match.suffix().first;
+                }
+
+                if (resultado.empty()) {
+                    ElementoMarquesina elem;
+                    elem.colorTexto = 7;
+                    elem.colorFondo = 0;
+                    elem.negrita = false;
+                    elem.texto = textoMarquesina;
+                    resultado.push_back(elem);
+                }
+            }
+            return resultado;
+        }
+    }
+
+    /** @brief Compara el analizador actual con el de expresiones regulares para un texto */
+    void compararMarquesina(const std::string& contenido) {
+        const std::vector<ElementoMarquesina> esperado = conRegex::parsearMarquesina(contenido);
+        const std::vector<ElementoMarquesina> obtenido = AnalizadorMarquesina::parsearHTML(contenido);
+        bool iguales = esperado.size() == obtenido.size();
+        for (size_t i = 0; iguales && i < esperado.size(); ++i) {
+            iguales = esperado[i].texto == obtenido[i].texto && esperado[i].colorTexto == obtenido[i].colorTexto &&
+                esperado[i].colorFondo == obtenido[i].colorFondo && esperado[i].negrita == obtenido[i].negrita;
+        }
+        if (!iguales) {
+            std::cerr << "parsearHTML difiere de la version con regex para: " << contenido << "\n";
+        }
+        COMPROBAR(iguales);
+    }
+
+    /** @brief Marquesina incluida, la que mide BancoRendimiento, casos límite y combinaciones aleatorias */
+    void probarMarquesina() {
+        std::ifstream archivo(std::string(BANCO_DIRECTORIO_FUENTES) + "/marquesina.html", std::ios::binary);
+        const std::string incluida((std::istreambuf_iterator<char>(archivo)), std::istreambuf_iterator<char>());
+        COMPROBAR(incluida.find("<marquesina>") != std::string::npos);
+        compararMarquesina(incluida);
+        COMPROBAR(AnalizadorMarquesina::parsearHTML(incluida).size() == 2);
+
+        std::string medida = "<marquesina>\n";
+        for (size_t i = 0; i < 200; ++i) {
+            medida += i % 2 == 0 ? "  <color=white bg=blue>Bienvenido al Sistema Bancario</color> -\n"
+                : "    <color=yellow><b>Desarrolladores: Uriel Andrade, Kerly Chuqui, Abner Proano</b></color>\n";
+        }
+        medida += "</marquesina>";
+        compararMarquesina(medida);
+
+        const char* const CASOS[] = {
+            "",
+            "sin marquesina",
+            "<marquesina></marquesina>",
+            "<marquesina>solo texto</marquesina>",
+            "<marquesina>sin cierre",
+            "antes<marquesina><color=red>a</color></marquesina>despues<marquesina><color=blue>b</color></marquesina>",
+            "<marquesina><color=purple bg=orange>desconocidos</color></marquesina>",
+            "<marquesina><color=red bg=>fondo vacio</color></marquesina>",
+            "<marquesina><color=Red>mayusculas</color></marquesina>",
+            "<marquesina><color=green\tbg=cyan>tabulador</color></marquesina>",
+            "<marquesina><color=red>dos\nlineas</color><color=blue>una</color></marquesina>",
+            "<marquesina><color=red>x<b>uno</b>y<b>dos</b></color></marquesina>",
+            "<marquesina><color=red><b>sin cierre de negrita</color></marquesina>",
+            "<marquesina><color=red></color><color=white><b></b></color></marquesina>",
+            "<marquesina><color=red>a<color=blue>b</color>c</color></marquesina>",
+        };
+        for (const char* caso : CASOS) {
+            compararMarquesina(caso);
+        }
+
+        // Combinaciones aleatorias de fragmentos, sin abrir otra <marquesina> dentro del bloque
+        const char* const FRAGMENTOS[] = {
+            "<color=", "red", "blue", "white", "rojo", " bg=", "yellow", ">", "</color>",
+            "<b>", "</b>", "texto", " ", "\n", "-", "<", "=", "</marquesina>",
+        };
+        std::mt19937 aleatorio(40);
+        for (int caso = 0; caso < 2000; ++caso) {
+            std::string contenido = aleatorio() % 4 == 0 ? "x" : "";
+            contenido += "<marquesina>";
+            const size_t piezas = aleatorio() % 24;
+            for (size_t i = 0; i < piezas; ++i) {
+                contenido += FRAGMENTOS[aleatorio() % (sizeof(FRAGMENTOS) / sizeof(FRAGMENTOS[0]))];
+            }
+            if (aleatorio() % 8 != 0) contenido += "</marquesina>";
+            compararMarquesina(contenido);
+        }
+    }
+
+    // ----- Importación de CSV -----
+
+    /** @brief Motivo de interpretarLinea para una línea, liberando el cliente si se creó */
+    MotivoRechazo motivoDeLinea(const std::string& linea, std::string* direccion = nullptr) {
+        Persona* persona = nullptr;
+        Cuenta<double>* cuenta = nullptr;
+        int sucursal = -1;
+        const MotivoRechazo motivo = ImportadorCSV::interpretarLinea(linea, "19/10/2026", persona, cuenta, sucursal);
+        if (persona && direccion) *direccion = persona->getDireccion();
+        delete persona;
+        return motivo;
+    }
+
+    /** @brief Líneas cortas o largas, comillas, límites de saldo y cédulas repetidas o registradas */
+    void probarImportador() {
+        const std::string CLIENTE = "Ana Maria,Perez Lopez,15/03/1990,ana@correo.com,Av Amazonas 123,";
+        COMPROBAR(Validar::ValidarCedula("1712345675") && Validar::ValidarCedula("0923456784"));
+        COMPROBAR(motivoDeLinea("1712345675," + CLIENTE + "Ahorros,210,100.50") == MotivoRechazo::NINGUNO);
+
+        // Número de campos
+        COMPROBAR(motivoDeLinea("1712345675," + CLIENTE + "Ahorros,210") == MotivoRechazo::CAMPOS_INCORRECTOS);
+        COMPROBAR(motivoDeLinea("1712345675," + CLIENTE + "Ahorros,210,100,extra") == MotivoRechazo::CAMPOS_INCORRECTOS);
+        COMPROBAR(motivoDeLinea("") == MotivoRechazo::CAMPOS_INCORRECTOS);
+        COMPROBAR(motivoDeLinea("1712345675," + CLIENTE + "Ahorros,210,") == MotivoRechazo::SALDO_INVALIDO);
+
+        // Campos entre comillas
+        std::string direccion;
+        COMPROBAR(motivoDeLinea("\"1712345675\",Ana,Perez,15/03/1990,ana@correo.com,\"Av. Amazonas, N34-451\",Ahorros,210,10",
+            &direccion) == MotivoRechazo::NINGUNO);
+        COMPROBAR(direccion == "Av. Amazonas, N34-451");
+        COMPROBAR(motivoDeLinea("1712345675,Ana,Perez,15/03/1990,ana@correo.com,\"Casa \"\"azul\"\"\",Ahorros,210,10") ==
+            MotivoRechazo::DIRECCION_INVALIDA);
+        COMPROBAR(motivoDeLinea("1712345675,Ana,Perez,15/03/1990,ana@correo.com,\"sin cierre,Ahorros,210,10") ==
+            MotivoRechazo::CAMPOS_INCORRECTOS);
+        COMPROBAR(motivoDeLinea("1712345675,Ana,Perez,15/03/1990,ana@correo.com,\"Quito\"x,Ahorros,210,10") ==
+            MotivoRechazo::CAMPOS_INCORRECTOS);
+
+        // Saldo: ahorros de 0 a 15000.00, corriente de 250.00 a 15000.00, hasta dos decimales
+        struct CasoSaldo {
+            const char* tipo;
+            const char* saldo;
+            bool valido;
+        };
+        const CasoSaldo SALDOS[] = {
+            { "Ahorros", "0", true }, { "Ahorros", "15000.00", true }, { "Ahorros", "15000.01", false },
+            { "Corriente", "249.99", false }, { "Corriente", "250", true }, { "Corriente", "15000", true },
+            { "Corriente", "15001", false }, { "Ahorros", "1.234", false }, { "Ahorros", "-5", false },
+            { "Ahorros", "99999999999999999999", false }, { "Ahorros", "12,5", false },
+        };
+        for (const CasoSaldo& caso : SALDOS) {
+            const MotivoRechazo motivo = motivoDeLinea("1712345675," + CLIENTE + caso.tipo + ",210," + caso.saldo);
+            COMPROBAR(motivo == (caso.valido ? MotivoRechazo::NINGUNO
+                : caso.saldo == std::string("12,5") ? MotivoRechazo::CAMPOS_INCORRECTOS : MotivoRechazo::SALDO_INVALIDO));
+        }
+
+        // Importación completa: repetida dentro del archivo y ya registrada en el banco
+        const std::string rutaCSV = "pruebas_importar.csv";
+        const std::string rutaRechazos = "pruebas_importar_rechazos.csv";
+        escribirArchivo(rutaCSV,
+            "cedula,nombres,apellidos,fecha,correo,direccion,tipo,sucursal,saldo\n"
+            "1712345675," + CLIENTE + "Ahorros,210,100\n"
+            "0923456784," + CLIENTE + "Corriente,220,300\n"
+            "\n"
+            "\"1712345675\"," + CLIENTE + "Ahorros,480,5\n"
+            "1712345675," + CLIENTE + "Ahorros\n");
+        NodoPersona* lista = nullptr;
+        ResumenImportacion resumen = ImportadorCSV::importar(lista, rutaCSV, rutaRechazos, 2);
+        COMPROBAR(resumen.exito && resumen.lineas == 4 && resumen.importados == 2 && resumen.rechazados == 2);
+        COMPROBAR(leerArchivo(rutaRechazos) ==
+            "linea,motivo,registro\n"
+            "5,cedula duplicada en la linea 2,\"1712345675\"," + CLIENTE + "Ahorros,480,5\n"
+            "6,se esperaban 9 campos,1712345675," + CLIENTE + "Ahorros\n");
+        size_t enLista = 0;
+        for (NodoPersona* nodo = lista; nodo; nodo = nodo->siguiente) {
+            ++enLista;
+            if (nodo->persona->getCedula() == "1712345675") {
+                COMPROBAR(nodo->persona->getCabezaAhorros()->getNumeroCuenta() == ImportadorCSV::numeroCuenta(0, 1));
+            }
+        }
+        COMPROBAR(enLista == 2);
+
+        resumen = ImportadorCSV::importar(lista, rutaCSV, rutaRechazos, 2);
+        COMPROBAR(resumen.importados == 0 && resumen.rechazados == 4);
+        COMPROBAR(leerArchivo(rutaRechazos).find("2,cedula ya registrada en el banco,") != std::string::npos);
+
+        while (lista) {
+            NodoPersona* siguiente = lista->siguiente;
+            delete lista->persona;
+            delete lista;
+            lista = siguiente;
+        }
+        std::remove(rutaCSV.c_str());
+        std::remove(rutaRechazos.c_str());
+    }
+
+    // ----- Intérprete de comandos -----
+
+    /** @brief Quita el campo "us" de una línea JSON, que cambia en cada ejecución */
+    std::string sinDuracion(const std::string& linea) {
+        const size_t inicio = linea.find("\"us\":");
+        if (inicio == std::string::npos) return linea;
+        const size_t fin = linea.find(',', inicio);
+        return linea.substr(0, inicio) + (fin == std::string::npos ? "" : linea.substr(fin + 1));
+    }
+
+    /** @brief Guion corto sobre un banco vacío y sus líneas JSON esperadas */
+    void probarComandos() {
+        const std::string GUION =
+            "# guion de prueba\n"
+            "create 1712345675,Ana Maria,Perez,15/03/1990,ana@correo.com,Av Amazonas 123,Ahorros,210,100.50\n"
+            "create 0923456784,Luis,Mora,01/01/1985,luis@correo.com,Calle 10,Corriente,220,300\n"
+            "search 1712345675\n"
+            "deposit 2100000014 50\n"
+            "withdraw 2100000014 1000\n"
+            "transfer 2200000015 2100000014 25.25\n"
+            "search 2100000014\n"
+            "create 1712345675,Ana Maria,Perez,15/03/1990,ana@correo.com,Av Amazonas 123,Ahorros,210,1\n"
+            "foo\n"
+            "deposit 9999999999 1\n"
+            "withdraw 2100000014 1000\n"
+            "deposit 2100000014 abc\n"
+            "search 2200000015\n";
+        const std::vector<std::string> ESPERADO = {
+            "{\"linea\":2,\"comando\":\"create\",\"ok\":true,\"cedula\":\"1712345675\",\"cuenta\":\"2100000014\",\"tipo\":\"Ahorros\",\"saldo\":\"100.50\"}",
+            "{\"linea\":3,\"comando\":\"create\",\"ok\":true,\"cedula\":\"0923456784\",\"cuenta\":\"2200000015\",\"tipo\":\"Corriente\",\"saldo\":\"300.00\"}",
+            "{\"linea\":4,\"comando\":\"search\",\"ok\":true,\"por\":\"cedula\",\"cedula\":\"1712345675\",\"nombres\":\"Ana Maria\",\"apellidos\":\"Perez\",\"correo\":\"ana@correo.com\",\"cuentas\":[{\"numero\":\"2100000014\",\"tipo\":\"Ahorros\",\"saldo\":\"100.50\",\"estado\":\"ACTIVA\"}]}",
+            "{\"linea\":5,\"comando\":\"deposit\",\"ok\":true,\"cuenta\":\"2100000014\",\"saldo\":\"150.50\"}",
+            "{\"linea\":6,\"comando\":\"withdraw\",\"ok\":false,\"error\":\"fondos insuficientes\"}",
+            "{\"linea\":7,\"comando\":\"transfer\",\"ok\":true,\"saldo_origen\":\"274.75\",\"saldo_destino\":\"175.75\"}",
+            "{\"linea\":8,\"comando\":\"search\",\"ok\":true,\"por\":\"cuenta\",\"cedula\":\"1712345675\",\"nombres\":\"Ana Maria\",\"apellidos\":\"Perez\",\"correo\":\"ana@correo.com\",\"cuentas\":[{\"numero\":\"2100000014\",\"tipo\":\"Ahorros\",\"saldo\":\"175.75\",\"estado\":\"ACTIVA\"}]}",
+            "{\"linea\":9,\"comando\":\"create\",\"ok\":false,\"error\":\"cedula ya registrada en el banco\"}",
+            "{\"linea\":10,\"comando\":\"foo\",\"ok\":false,\"error\":\"comando desconocido\"}",
+            "{\"linea\":11,\"comando\":\"deposit\",\"ok\":false,\"error\":\"cuenta no encontrada\"}",
+            "{\"linea\":12,\"comando\":\"withdraw\",\"ok\":false,\"error\":\"fondos insuficientes\"}",
+            "{\"linea\":13,\"comando\":\"deposit\",\"ok\":false,\"error\":\"monto invalido\"}",
+            "{\"linea\":14,\"comando\":\"search\",\"ok\":true,\"por\":\"cuenta\",\"cedula\":\"0923456784\",\"nombres\":\"Luis\",\"apellidos\":\"Mora\",\"correo\":\"luis@correo.com\",\"cuentas\":[{\"numero\":\"2200000015\",\"tipo\":\"Corriente\",\"saldo\":\"274.75\",\"estado\":\"ACTIVA\"}]}",
+        };
+
+        Banco banco;
+        InterpreteComandos interprete(banco);
+        std::istringstream entrada(GUION);
+        std::ostringstream salida;
+        const ResumenComandos resumen = interprete.ejecutar(entrada, salida);
+        COMPROBAR(resumen.comandos == 13 && resumen.errores == 6);
+        COMPROBAR(resumen.porComando.at("deposit").veces == 3 && resumen.porComando.at("deposit").errores == 2);
+
+        std::istringstream lineas(salida.str());
+        std::string linea;
+        size_t i = 0;
+        for (; std::getline(lineas, linea) && i < ESPERADO.size(); ++i) {
+            if (sinDuracion(linea) != ESPERADO[i]) {
+                std::cerr << "esperado: " << ESPERADO[i] << "\nobtenido: " << linea << "\n";
+                COMPROBAR(sinDuracion(linea) == ESPERADO[i]);
+            }
+        }
+        COMPROBAR(i == ESPERADO.size());
+        const std::string RESUMEN = "{\"resumen\":{\"comandos\":13,\"errores\":6,";
+        COMPROBAR(linea.compare(0, RESUMEN.size(), RESUMEN) == 0);
+        COMPROBAR(!std::getline(lineas, linea));
+
+        for (NodoPersona* nodo = banco.getListaPersonas(); nodo; nodo = nodo->siguiente) {
+            delete nodo->persona;
+        }
+    }
+
+    // ----- Generador de bancos sintéticos -----
+
+    /** @brief Texto con los datos de cada cliente y sus cuentas, en orden de lista */
+    std::string describirLista(NodoPersona* lista) {
+        std::string texto;
+        for (NodoPersona* nodo = lista; nodo; nodo = nodo->siguiente) {
+            Persona* persona = nodo->persona;
+            texto += persona->getCedula() + "," + persona->getNombres() + "," + persona->getApellidos() + "," +
+                persona->getCorreo() + "," + persona->getDireccion() + "," + std::to_string(persona->getNumCuentas());
+            for (CuentaAhorros* c = persona->getCabezaAhorros(); c; c = c->getSiguiente()) {
+                texto += ",A" + c->getNumeroCuenta() + ":" + std::to_string(c->getSaldo()) + ":" + c->getFechaApertura();
+            }
+            for (CuentaCorriente* c = persona->getCabezaCorriente(); c; c = c->getSiguiente()) {
+                texto += ",C" + c->getNumeroCuenta() + ":" + std::to_string(c->getSaldo()) + ":" + c->getFechaApertura();
+            }
+            texto += '\n';
+        }
+        return texto;
+    }
+
+    /** @brief Libera los clientes de un banco; Banco solo libera los nodos */
+    void liberarClientes(Banco& banco) {
+        for (NodoPersona* nodo = banco.getListaPersonas(); nodo; nodo = nodo->siguiente) {
+            delete nodo->persona;
+        }
+    }
+
+    /** @brief Mismo resultado con uno o varios hilos, cédulas válidas y conteo de cuentas */
+    void probarGenerador() {
+        ConfiguracionGenerador configuracion;
+        configuracion.clientes = GeneradorBanco::CLIENTES_POR_BLOQUE * 2 + 100; // Tres bloques
+        configuracion.semilla = 49;
+
+        std::string descripciones[2];
+        std::string csv[2];
+        std::string respaldo[2];
+        const unsigned int HILOS[2] = { 1, 4 };
+        for (int i = 0; i < 2; ++i) {
+            configuracion.hilos = HILOS[i];
+            Banco banco;
+            const ResumenGeneracion resumen = GeneradorBanco::poblar(configuracion, banco);
+            COMPROBAR(resumen.exito && resumen.clientes == configuracion.clientes);
+            descripciones[i] = describirLista(banco.getListaPersonas());
+
+            if (i == 0) {
+                std::unordered_set<std::string> cedulas;
+                size_t ahorros = 0;
+                size_t corrientes = 0;
+                bool cedulasValidas = true;
+                bool conteosCorrectos = true;
+                for (NodoPersona* nodo = banco.getListaPersonas(); nodo; nodo = nodo->siguiente) {
+                    Persona* persona = nodo->persona;
+                    cedulasValidas = cedulasValidas && Validar::ValidarCedula(persona->getCedula());
+                    cedulas.insert(persona->getCedula());
+                    int cuentas = 0;
+                    for (CuentaAhorros* c = persona->getCabezaAhorros(); c; c = c->getSiguiente()) {
+                        ++cuentas;
+                        ++ahorros;
+                    }
+                    for (CuentaCorriente* c = persona->getCabezaCorriente(); c; c = c->getSiguiente()) {
+                        ++cuentas;
+                        ++corrientes;
+                    }
+                    conteosCorrectos = conteosCorrectos && cuentas >= 1 && cuentas <= 3 && persona->getNumCuentas() == cuentas;
+                }
+                COMPROBAR(cedulasValidas);
+                COMPROBAR(conteosCorrectos);
+                COMPROBAR(cedulas.size() == configuracion.clientes);
+                COMPROBAR(resumen.cuentasAhorros == ahorros && resumen.cuentasCorrientes == corrientes);
+            }
+            liberarClientes(banco);
+
+            const std::string rutaCSV = "pruebas_generador.csv";
+            const std::string rutaRespaldo = "pruebas_generador.bak";
+            COMPROBAR(GeneradorBanco::escribirCSV(configuracion, rutaCSV).exito);
+            COMPROBAR(GeneradorBanco::escribirRespaldo(configuracion, rutaRespaldo).exito);
+            csv[i] = leerArchivo(rutaCSV);
+            respaldo[i] = leerArchivo(rutaRespaldo);
+            std::remove(rutaCSV.c_str());
+            std::remove(rutaRespaldo.c_str());
+        }
+        COMPROBAR(!descripciones[0].empty() && descripciones[0] == descripciones[1]);
+        COMPROBAR(!csv[0].empty() && csv[0] == csv[1]);
+        COMPROBAR(!respaldo[0].empty() && respaldo[0] == respaldo[1]);
+
+        // Otra semilla da otras cédulas, también válidas
+        COMPROBAR(GeneradorBanco::cedula(50, 0) != GeneradorBanco::cedula(49, 0));
+        COMPROBAR(Validar::ValidarCedula(GeneradorBanco::cedula(50, GeneradorBanco::CLIENTES_MAXIMOS - 1)));
+    }
+
+    // ----- Estadísticas de latencia -----
+
+    /** @brief Resumen de una operación, o uno vacío si no se registró */
+    ResumenOperacion resumenDe(Operacion operacion) {
+        for (const ResumenOperacion& resumen : Estadisticas::resumen()) {
+            if (resumen.nombre == Estadisticas::nombre(operacion)) return resumen;
+        }
+        return ResumenOperacion();
+    }
+
+    /** @brief Límites de las cubetas, percentiles, saturación, varios hilos y reinicio */
+    void probarEstadisticas() {
+        // Cada cubeta empieza justo después de la anterior y su ancho es a lo sumo 1/SUBCUBETAS
+        bool contiguas = Estadisticas::cubeta(0) == 0 && Estadisticas::limiteSuperior(0) == 0;
+        bool precisas = true;
+        for (size_t i = 1; i < Estadisticas::CUBETAS; ++i) {
+            const uint64_t inferior = Estadisticas::limiteSuperior(i - 1) + 1;
+            const uint64_t superior = Estadisticas::limiteSuperior(i);
+            contiguas = contiguas && superior >= inferior &&
+                Estadisticas::cubeta(inferior) == i && Estadisticas::cubeta(superior) == i;
+            precisas = precisas && (superior - inferior) * Estadisticas::SUBCUBETAS <= inferior;
+        }
+        COMPROBAR(contiguas);
+        COMPROBAR(precisas);
+        const uint64_t maximo = Estadisticas::NS_MAXIMO;
+        COMPROBAR(Estadisticas::limiteSuperior(Estadisticas::CUBETAS - 1) == maximo);
+        COMPROBAR(Estadisticas::cubeta(maximo) == Estadisticas::CUBETAS - 1);
+
+        if (!Estadisticas::activas()) {
+            return;
+        }
+
+        // 1..1000 ns: los percentiles son el límite de la cubeta del valor exacto
+        Estadisticas::reiniciar();
+        for (uint64_t ns = 1000; ns >= 1; --ns) {
+            Estadisticas::registrar(Operacion::Depositar, ns);
+        }
+        ResumenOperacion resumen = resumenDe(Operacion::Depositar);
+        COMPROBAR(resumen.cantidad == 1000 && resumen.nsMaximo == 1000);
+        COMPROBAR(resumen.nsP50 == Estadisticas::limiteSuperior(Estadisticas::cubeta(500)));
+        COMPROBAR(resumen.nsP50 >= 500 && resumen.nsP50 * Estadisticas::SUBCUBETAS <= 500 * (Estadisticas::SUBCUBETAS + 1));
+        COMPROBAR(resumen.nsP99 == Estadisticas::limiteSuperior(Estadisticas::cubeta(990)));
+
+        // El percentil no pasa del máximo exacto, y lo que excede NS_MAXIMO se satura
+        Estadisticas::registrar(Operacion::Retirar, 100000);
+        resumen = resumenDe(Operacion::Retirar);
+        COMPROBAR(resumen.cantidad == 1 && resumen.nsP50 == 100000 && resumen.nsP99 == 100000);
+        Estadisticas::registrar(Operacion::Retirar, maximo + 12345);
+        COMPROBAR(resumenDe(Operacion::Retirar).nsMaximo == maximo);
+
+        // Cada hilo registra en sus propios histogramas y el resumen los suma
+        std::vector<std::thread> hilos;
+        for (int h = 0; h < 4; ++h) {
+            hilos.emplace_back([h]() {
+                for (int i = 0; i < 250; ++i) {
+                    Estadisticas::registrar(Operacion::Transferir, static_cast<uint64_t>(h * 250 + i + 1));
+                }
+            });
+        }
+        for (std::thread& hilo : hilos) hilo.join();
+        resumen = resumenDe(Operacion::Transferir);
+        COMPROBAR(resumen.cantidad == 1000 && resumen.nsMaximo == 1000);
+        COMPROBAR(resumen.nsP50 == Estadisticas::limiteSuperior(Estadisticas::cubeta(500)));
+
+        Estadisticas::reiniciar();
+        COMPROBAR(Estadisticas::resumen().empty());
+    }
+
+    /**
+     * @struct Grupo
+     * @brief Conjunto de comprobaciones que se puede ejecutar por nombre
+     */
+    struct Grupo {
+        const char* nombre;
+        void (*ejecutar)();
+    };
+
+    const Grupo GRUPOS[] = {
+        { "vigilante", probarVigilante },
+        { "validaciones", probarValidaciones },
+        { "lotes", probarLotes },
+        { "cifrado", probarCifrado },
+        { "sha", probarSha },
+        { "merkle", probarMerkle },
+        { "cache_hash", probarCacheHash },
+        { "qr", probarQr },
+        { "marquesina", probarMarquesina },
+        { "importador", probarImportador },
+        { "comandos", probarComandos },
+        { "generador", probarGenerador },
+        { "estadisticas", probarEstadisticas },
+    };
+}
+
+int main(int argc, char** argv) {
+    const std::string elegido = argc > 1 ? argv[1] : "";
+    bool encontrado = false;
+    int gruposFallidos = 0;
+    for (const Grupo& grupo : GRUPOS) {
+        if (!elegido.empty() && elegido != grupo.nombre) {
+            continue;
+        }
+        encontrado = true;
+        fallos = 0;
+        grupo.ejecutar();
+        std::cout << grupo.nombre << ": " << (fallos == 0 ? "ok" : "FALLO") << "\n";
+        if (fallos != 0) ++gruposFallidos;
+    }
+    if (!encontrado) {
+        std::cerr << "Grupo desconocido: " << elegido << "\n";
+        return 2;
+    }
+    return gruposFallidos == 0 ? 0 : 1;
+}
@@ -0,0 +1,613 @@
+/**
+ * @file BancoRendimiento.cpp
+ * @brief Mediciones de rendimiento de las operaciones principales del banco
+ *
+ * Uso: BancoRendimiento [--tamanos 1000,10000] [--calentamiento 3] [--repeticiones 20]
+ *                       [--filtro texto] [--max-orden 5000] [--directorio .]
+ *                       [--semilla 12345] [--megabytes 64] [--salida resultados.json]
+ *
+ * Para cada tamaño se crea un banco con ese número de clientes y se mide cada
+ * operación. El cifrado por hilos y el SHA-256 con y sin las instrucciones del
+ * procesador se miden aparte, sobre un respaldo de --megabytes MB (1024 para
+ * medir un respaldo de 1 GB). El resultado es un JSON (ver
+ * Rendimiento::escribirJSON) que se escribe en la salida estándar o en el
+ * archivo de --salida. El progreso va a std::cerr y lo que las clases del
+ * banco escriben en std::cout se descarta.
+ */
+#include "Rendimiento.h"
+#include "InterpreteComandos.h"
+#include "Persona.h"
+#include "Cifrado.h"
+#include "Utilidades.h"
+#include "CodigoQR.h"
+#include "AnalizadorMarquesina.h"
+#include "Paralelo.h"
+#include "Hash.h"
+#include "Pantalla.h"
+#include "Validar.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <vector>
+
+namespace {
+
+    /**
+     * @struct OpcionesRendimiento
+     * @brief Opciones de la línea de comandos
+     */
+    struct OpcionesRendimiento {
+        std::vector<size_t> tamanos{ 1000, 10000 };
+        ConfiguracionRendimiento configuracion;
+        std::string filtro;
+        size_t maxOrden = 5000;
+        std::string directorio = ".";
+        unsigned int semilla = 12345;
+        size_t megabytes = 64;
+        std::string salida;
+    };
+
+    /**
+     * @brief Interpreta la línea de comandos
+     * @return false si hay una opción desconocida o sin valor
+     */
+    bool leerOpciones(int argc, char* argv[], OpcionesRendimiento& opciones) {
+        for (int i = 1; i < argc; ++i) {
+            const std::string opcion = argv[i];
+            if (i + 1 >= argc) return false;
+            const std::string valor = argv[++i];
+            if (opcion == "--tamanos") {
+                opciones.tamanos.clear();
+                std::istringstream lista(valor);
+                std::string tamano;
+                while (std::getline(lista, tamano, ',')) {
+                    if (!tamano.empty()) opciones.tamanos.push_back(std::strtoul(tamano.c_str(), nullptr, 10));
+                }
+            }
+            else if (opcion == "--calentamiento") opciones.configuracion.calentamiento = std::strtoul(valor.c_str(), nullptr, 10);
+            else if (opcion == "--repeticiones") opciones.configuracion.repeticiones = std::strtoul(valor.c_str(), nullptr, 10);
+            else if (opcion == "--filtro") opciones.filtro = valor;
+            else if (opcion == "--max-orden") opciones.maxOrden = std::strtoul(valor.c_str(), nullptr, 10);
+            else if (opcion == "--directorio") opciones.directorio = valor;
+            else if (opcion == "--semilla") opciones.semilla = static_cast<unsigned int>(std::strtoul(valor.c_str(), nullptr, 10));
+            else if (opcion == "--megabytes") opciones.megabytes = std::strtoul(valor.c_str(), nullptr, 10);
+            else if (opcion == "--salida") opciones.salida = valor;
+            else return false;
+        }
+        return !opciones.tamanos.empty();
+    }
+
+    /** @brief Cédula válida a partir de un índice (provincia 01 a 24 y siete dígitos) */
+    std::string cedulaSintetica(size_t indice) {
+        char base[16];
+        std::snprintf(base, sizeof(base), "%02u%07u",
+            static_cast<unsigned>(indice / 1000000 % 24 + 1), static_cast<unsigned>(indice % 1000000));
+        int suma = 0;
+        for (int i = 0; i < 9; ++i) {
+            int valor = (base[i] - '0') * (i % 2 == 0 ? 2 : 1);
+            suma += valor > 9 ? valor - 9 : valor;
+        }
+        return std::string(base) + static_cast<char>('0' + (10 - suma % 10) % 10);
+    }
+
+    /**
+     * @brief Línea con el formato de ImportadorCSV para el cliente indicado
+     * @param saldoFijo Si es positivo, cuenta de ahorros con ese saldo
+     */
+    std::string registroSintetico(size_t indice, std::mt19937& aleatorio, double saldoFijo = 0) {
+        static const char* const NOMBRES[] = { "Ana", "Luis", "Maria", "Jose", "Carmen", "Pedro", "Lucia", "Jorge" };
+        static const char* const APELLIDOS[] = { "Perez", "Gomez", "Andrade", "Chuqui", "Proano", "Torres", "Vera", "Mora" };
+        static const char* const SUCURSALES[] = { "210", "220", "480", "560" };
+
+        const bool ahorros = saldoFijo > 0 || aleatorio() % 2 == 0;
+        double saldo = saldoFijo;
+        if (saldoFijo <= 0) {
+            const unsigned int centavos = aleatorio() % 1500001u;
+            saldo = (ahorros ? centavos : 25000u + centavos % 1475001u) / 100.0;
+        }
+        char registro[256];
+        std::snprintf(registro, sizeof(registro), "%s,%s %s,%s %s,%02u/%02u/%u,cliente%zu@correo.com,Calle %zu,%s,%s,%.2f",
+            cedulaSintetica(indice).c_str(),
+            NOMBRES[aleatorio() % 8], NOMBRES[aleatorio() % 8],
+            APELLIDOS[aleatorio() % 8], APELLIDOS[aleatorio() % 8],
+            static_cast<unsigned>(aleatorio() % 28 + 1), static_cast<unsigned>(aleatorio() % 12 + 1),
+            static_cast<unsigned>(1950 + aleatorio() % 56),
+            indice, indice, ahorros ? "Ahorros" : "Corriente", SUCURSALES[aleatorio() % 4], saldo);
+        return registro;
+    }
+
+    /** @brief Tamaño de un archivo en bytes, 0 si no existe */
+    size_t tamanoArchivo(const std::string& ruta) {
+        std::ifstream archivo(ruta, std::ios::binary | std::ios::ate);
+        return archivo ? static_cast<size_t>(archivo.tellg()) : 0;
+    }
+
+    /** @brief true si la medición no está excluida por --filtro */
+    bool pasaFiltro(const OpcionesRendimiento& opciones, const std::string& nombre) {
+        return opciones.filtro.empty() || nombre.find(opciones.filtro) != std::string::npos;
+    }
+
+    /** @brief Mide si el nombre pasa el filtro e informa el progreso */
+    void medirCaso(const OpcionesRendimiento& opciones, std::vector<ResultadoRendimiento>& resultados,
+        const std::string& nombre, size_t tamano, size_t operaciones,
+        const std::function<void()>& repeticion, const std::function<void()>& preparar = std::function<void()>()) {
+        if (!pasaFiltro(opciones, nombre)) {
+            return;
+        }
+        std::cerr << "  " << nombre << " (" << tamano << ")..." << std::flush;
+        resultados.push_back(Rendimiento::medir(nombre, tamano, operaciones, opciones.configuracion, repeticion, preparar));
+        std::cerr << " p50 " << resultados.back().nsP50 << " ns\n";
+    }
+
+    /**
+     * @class Mediciones
+     * @brief Mide las operaciones sobre un banco de un tamaño dado
+     */
+    class Mediciones {
+    public:
+        Mediciones(const OpcionesRendimiento& opciones, std::vector<ResultadoRendimiento>& resultados)
+            : opciones(opciones), resultados(resultados) {}
+
+        /** @brief Crea el banco con n clientes y ejecuta todas las mediciones */
+        void ejecutar(size_t n);
+
+    private:
+        const OpcionesRendimiento& opciones;
+        std::vector<ResultadoRendimiento>& resultados;
+
+        /** @brief Mide una operación del banco de este tamaño */
+        void medir(const std::string& nombre, size_t tamano, size_t operaciones,
+            const std::function<void()>& repeticion, const std::function<void()>& preparar = std::function<void()>()) {
+            medirCaso(opciones, resultados, nombre, tamano, operaciones, repeticion, preparar);
+        }
+    };
+
+    void Mediciones::ejecutar(size_t n) {
+        std::cerr << "Banco con " << n << " clientes\n";
+        std::mt19937 aleatorio(opciones.semilla);
+        Banco banco;
+        InterpreteComandos interprete(banco);
+        std::ostream descartar(nullptr);
+        ResumenComandos resumen;
+
+        // Clientes: se crean por el intérprete, como con el comando create
+        for (size_t i = 0; i < n; ++i) {
+            interprete.ejecutarLinea("create " + registroSintetico(i, aleatorio), i + 1, descartar, resumen);
+        }
+        // Dos cuentas de ahorros con saldo conocido para las transferencias
+        interprete.ejecutarLinea("create " + registroSintetico(n, aleatorio, 5000.0), n + 1, descartar, resumen);
+        interprete.ejecutarLinea("create " + registroSintetico(n + 1, aleatorio, 5000.0), n + 2, descartar, resumen);
+
+        std::vector<Persona*> personas;
+        for (NodoPersona* nodo = banco.getListaPersonas(); nodo; nodo = nodo->siguiente) {
+            personas.push_back(nodo->persona);
+        }
+        if (personas.size() != n + 2) {
+            std::cerr << "Solo se crearon " << personas.size() << " clientes\n";
+            std::abort();
+        }
+        const std::string origen = personas[0]->getCabezaAhorros()->getNumeroCuenta();
+        const std::string destino = personas[1]->getCabezaAhorros()->getNumeroCuenta();
+
+        // Claves a buscar, siempre las mismas para un tamaño y una semilla
+        const size_t BUSQUEDAS = 64;
+        std::vector<std::string> cedulas, cuentas;
+        for (size_t i = 0; i < BUSQUEDAS; ++i) {
+            const Persona* p = personas[aleatorio() % personas.size()];
+            cedulas.push_back(p->getCedula());
+            cuentas.push_back(p->getCabezaAhorros() ? p->getCabezaAhorros()->getNumeroCuenta()
+                : p->getCabezaCorriente()->getNumeroCuenta());
+        }
+
+        // Búsquedas como las de los menús: recorrido de la lista
+        medir("buscar_cedula_lista", n, BUSQUEDAS, [&]() {
+            for (const std::string& cedula : cedulas) {
+                NodoPersona* nodo = banco.getListaPersonas();
+                while (nodo && nodo->persona->getCedula() != cedula) nodo = nodo->siguiente;
+                if (!nodo) std::abort();
+            }
+        });
+        medir("buscar_cuenta_lista", n, BUSQUEDAS, [&]() {
+            for (const std::string& numero : cuentas) {
+                bool encontrada = false;
+                for (NodoPersona* nodo = banco.getListaPersonas(); nodo && !encontrada; nodo = nodo->siguiente) {
+                    for (CuentaAhorros* c = nodo->persona->getCabezaAhorros(); c && !encontrada; c = c->getSiguiente())
+                        encontrada = c->getNumeroCuenta() == numero;
+                    for (CuentaCorriente* c = nodo->persona->getCabezaCorriente(); c && !encontrada; c = c->getSiguiente())
+                        encontrada = c->getNumeroCuenta() == numero;
+                }
+                if (!encontrada) std::abort();
+            }
+        });
+        // Búsquedas del modo sin consola: índices hash y resultado JSON
+        medir("buscar_cedula_indice", n, BUSQUEDAS, [&]() {
+            for (const std::string& cedula : cedulas) interprete.ejecutarLinea("search " + cedula, 0, descartar, resumen);
+        });
+        medir("buscar_cuenta_indice", n, BUSQUEDAS, [&]() {
+            for (const std::string& numero : cuentas) interprete.ejecutarLinea("search " + numero, 0, descartar, resumen);
+        });
+        medir("buscar_criterio", n, 1, [&]() {
+            for (NodoPersona* nodo = banco.getListaPersonas(); nodo; nodo = nodo->siguiente) {
+                nodo->persona->buscarPersonaPorCriterio("Saldo mayor a", "", "", 1e12);
+            }
+        });
+
+        // Transferencias de ida y vuelta, para que los saldos no cambien
+        const std::string ida = "transfer " + origen + " " + destino + " 1.00";
+        const std::string vuelta = "transfer " + destino + " " + origen + " 1.00";
+        medir("transferir", n, 2 * BUSQUEDAS, [&]() {
+            for (size_t i = 0; i < BUSQUEDAS; ++i) {
+                interprete.ejecutarLinea(ida, 0, descartar, resumen);
+                interprete.ejecutarLinea(vuelta, 0, descartar, resumen);
+            }
+        });
+
+        // Ordenamiento por apellidos, como en el menú de ordenar (burbuja, cuadrático)
+        if (n <= opciones.maxOrden) {
+            std::vector<Persona*> ordenadas;
+            std::function<bool(const Persona*, const Persona*)> porApellidos =
+                [](const Persona* a, const Persona* b) { return a->getApellidos() <= b->getApellidos(); };
+            medir("ordenar_burbuja", n, 1,
+                [&]() { Utilidades::burbuja<Persona>(ordenadas, porApellidos); },
+                [&]() { ordenadas = personas; });
+        }
+
+        // Respaldo, cifrado y hash sobre el mismo archivo
+        const std::string base = opciones.directorio + "/rendimiento_" + std::to_string(n);
+        const std::string respaldo = base + ".bak";
+        // Se escribe aunque el filtro excluya respaldo_guardar: los demás casos lo leen
+        if (banco.guardarCuentasEnRuta(respaldo) < 0) std::abort();
+        medir("respaldo_guardar", n, 1, [&]() {
+            if (banco.guardarCuentasEnRuta(respaldo) < 0) std::abort();
+        });
+        Banco copia;
+        medir("respaldo_cargar", n, 1, [&]() {
+            if (copia.cargarCuentasDesdeRuta(respaldo) < 0) std::abort();
+        });
+
+        const size_t bytes = tamanoArchivo(respaldo);
+        const std::string cifradoV1 = base + ".v1";
+        const std::string cifradoV2 = base + ".bin";
+        const std::string descifrado = base + ".txt";
+        medir("cifrar_v1", bytes, 1, [&]() { Cifrado::CifrarArchivo(respaldo, cifradoV1, 'K'); });
+        medir("descifrar_v1", bytes, 1, [&]() { Cifrado::desifrarArchivo(cifradoV1, descifrado, 'K'); });
+        medir("cifrar_v2", bytes, 1, [&]() { Cifrado::CifrarArchivoV2(respaldo, cifradoV2, "clave de rendimiento"); });
+        medir("descifrar_v2", bytes, 1, [&]() { Cifrado::DescifrarArchivoV2(cifradoV2, descifrado, "clave de rendimiento"); });
+        medir("calcular_sha1", bytes, 1, [&]() {
+            if (Utilidades::calcularSHA1(respaldo) == "ERROR_ARCHIVO_NO_ENCONTRADO") std::abort();
+        });
+        for (const std::string& ruta : { respaldo, cifradoV1, cifradoV2, descifrado }) {
+            std::remove(ruta.c_str());
+        }
+
+        // Códigos QR de las cuentas, sin la caché
+        std::vector<std::string> textosQR;
+        for (size_t i = 0; i < BUSQUEDAS; ++i) {
+            const Persona* p = personas[i % personas.size()];
+            textosQR.push_back(CodigoQR::GeneradorQRTextoPlano::formatearDatos(
+                p->getNombres() + " " + p->getApellidos(), cuentas[i]));
+        }
+        medir("qr_codificar", n, BUSQUEDAS, [&]() {
+            for (const std::string& texto : textosQR) {
+                CodigoQR::QrCode qr = CodigoQR::QrCode::encodeText(texto.c_str(), CodigoQR::QrCode::Ecc::LOW);
+                if (qr.getSize() == 0) std::abort();
+            }
+        });
+        medir("qr_codificar_optimo", n, BUSQUEDAS, [&]() {
+            for (const std::string& texto : textosQR) {
+                CodigoQR::QrCode qr = CodigoQR::QrCode::encodeTextOptimal(texto.c_str(), CodigoQR::QrCode::Ecc::LOW);
+                if (qr.getSize() == 0) std::abort();
+            }
+        });
+    }
+
+    /** @brief Mide el análisis del HTML de la marquesina con n elementos de color */
+    void medirMarquesina(const OpcionesRendimiento& opciones, std::vector<ResultadoRendimiento>& resultados) {
+        for (size_t elementos : { size_t(2), size_t(200) }) {
+            std::string html = "<marquesina>\n";
+            for (size_t i = 0; i < elementos; ++i) {
+                html += i % 2 == 0 ? "  <color=white bg=blue>Bienvenido al Sistema Bancario</color> -\n"
+                    : "    <color=yellow><b>Desarrolladores: Uriel Andrade, Kerly Chuqui, Abner Proano</b></color>\n";
+            }
+            html += "</marquesina>";
+            medirCaso(opciones, resultados, "marquesina_parsear", elementos, 256, [&]() {
+                for (int i = 0; i < 256; ++i) {
+                    if (AnalizadorMarquesina::parsearHTML(html).size() != elementos) std::abort();
+                }
+            });
+        }
+    }
+
+    /**
+     * @brief Mide las validaciones de formato sobre 1024 entradas, tres de cada cuatro válidas
+     */
+    void medirValidaciones(const OpcionesRendimiento& opciones, std::vector<ResultadoRendimiento>& resultados) {
+        const size_t ENTRADAS = 1024;
+        std::mt19937 aleatorio(opciones.semilla);
+        std::vector<std::string> fechas, montos, correos;
+        for (size_t i = 0; i < ENTRADAS; ++i) {
+            const bool valida = i % 4 != 0;
+            fechas.push_back(std::to_string(1 + aleatorio() % 28) + "/" + std::to_string(1 + aleatorio() % 12) + "/"
+                + std::to_string(valida ? 1950 + aleatorio() % 70 : 1800 + aleatorio() % 99));
+            montos.push_back(std::to_string(aleatorio() % 100000) + (valida ? "." : ",") + std::to_string(10 + aleatorio() % 90));
+            correos.push_back("cliente" + std::to_string(i) + (valida ? "@banco.com.ec" : "@banco"));
+        }
+
+        auto medirValidacion = [&](const char* nombre, bool (*validar)(const std::string&),
+            const std::vector<std::string>& entradas) {
+            medirCaso(opciones, resultados, nombre, ENTRADAS, ENTRADAS, [&]() {
+                size_t validas = 0;
+                for (const std::string& entrada : entradas) {
+                    validas += validar(entrada) ? 1 : 0;
+                }
+                if (validas != ENTRADAS - ENTRADAS / 4) std::abort();
+            });
+        };
+        medirValidacion("validar_fecha", Validar::ValidarFecha, fechas);
+        medirValidacion("validar_monto", Validar::ValidarNumeroConDosDecimales, montos);
+        medirValidacion("validar_correo", Utilidades::EsCorreoValido, correos);
+    }
+
+    /**
+     * @brief Mide la validación de cédulas de una en una y por lotes
+     *
+     * Las cantidades no son múltiplos de 64, así que la última palabra del mapa
+     * queda incompleta. Una de cada cuatro cédulas tiene el verificador alterado.
+     * validar_cedulas_ancho_fijo usa registros de 16 bytes, como ImportadorCSV,
+     * sin la copia desde las cadenas.
+     */
+    void medirCedulasLote(const OpcionesRendimiento& opciones, std::vector<ResultadoRendimiento>& resultados) {
+        for (size_t cantidad : { size_t(63), size_t(1000), size_t(65537) }) {
+            std::vector<std::string> cedulas;
+            for (size_t i = 0; i < cantidad; ++i) {
+                std::string cedula = cedulaSintetica(i * 7919);
+                if (i % 4 == 0) cedula[9] = static_cast<char>('0' + (cedula[9] - '0' + 1) % 10);
+                cedulas.push_back(cedula);
+            }
+            const size_t validas = cantidad - (cantidad + 3) / 4;
+
+            medirCaso(opciones, resultados, "validar_cedula", cantidad, cantidad, [&]() {
+                size_t contadas = 0;
+                for (const std::string& cedula : cedulas) {
+                    contadas += Validar::ValidarCedula(cedula) ? 1 : 0;
+                }
+                if (contadas != validas) std::abort();
+            });
+            medirCaso(opciones, resultados, "validar_cedulas_lote", cantidad, cantidad, [&]() {
+                std::vector<uint64_t> mapa = Validar::ValidarCedulasLote(cedulas);
+                if (!Validar::esValidoEnLote(mapa, 1) || Validar::esValidoEnLote(mapa, cantidad - 1) != ((cantidad - 1) % 4 != 0)) {
+                    std::abort();
+                }
+            });
+
+            std::vector<char> registros(cantidad * 16, ' ');
+            for (size_t i = 0; i < cantidad; ++i) {
+                std::copy(cedulas[i].begin(), cedulas[i].end(), registros.begin() + i * 16);
+            }
+            std::vector<uint64_t> mapa((cantidad + 63) / 64);
+            medirCaso(opciones, resultados, "validar_cedulas_ancho_fijo", cantidad, cantidad, [&]() {
+                if (Validar::ValidarCedulasLote(registros.data(), cantidad, 16, mapa.data()) != validas) std::abort();
+            });
+        }
+    }
+
+    /**
+     * @brief Mide los menús de consola con 4, 13, 100 y 1000 opciones sobre una pantalla en memoria
+     *
+     * menu_mover baja la selección y presenta el fotograma, que solo redibuja
+     * dos filas; menu_dibujar redibuja el menú completo, como referencia.
+     */
+    void medirMenus(const OpcionesRendimiento& opciones, std::vector<ResultadoRendimiento>& resultados) {
+        const int MOVIMIENTOS = 256;
+        for (int cantidad : { 4, 13, 100, 1000 }) {
+            std::vector<std::string> textos;
+            for (int i = 0; i < cantidad; ++i) {
+                textos.push_back("Opcion " + std::to_string(i + 1));
+            }
+            MenuConsola menu("=== MENU ===\n\n", textos);
+            SalidaMemoria salida(80, menu.getFilaSiguiente() + 1);
+            CompositorPantalla pantalla(salida, 80, menu.getFilaSiguiente() + 1);
+            menu.dibujar(pantalla);
+            pantalla.presentar();
+
+            medirCaso(opciones, resultados, "menu_mover", static_cast<size_t>(cantidad), MOVIMIENTOS, [&]() {
+                for (int i = 0; i < MOVIMIENTOS; ++i) {
+                    menu.mover(pantalla, 1);
+                    pantalla.presentar();
+                }
+            });
+            medirCaso(opciones, resultados, "menu_dibujar", static_cast<size_t>(cantidad), 1, [&]() {
+                pantalla.limpiar();
+                menu.dibujar(pantalla);
+                pantalla.presentar();
+            });
+        }
+    }
+
+    /**
+     * @brief Mide la codificación QR con la versión fija, de 1 a 40
+     *
+     * El tamaño de cada medición es la versión. El texto cabe en la versión 1,
+     * así que solo cambia el tamaño de la matriz: plantilla, relleno de datos,
+     * corrección de errores y elección de máscara.
+     */
+    void medirVersionesQR(const OpcionesRendimiento& opciones, std::vector<ResultadoRendimiento>& resultados) {
+        const std::vector<CodigoQR::QrSegment> segmentos = CodigoQR::QrSegment::makeSegments("0102030405");
+        for (int version = CodigoQR::QrCode::MIN_VERSION; version <= CodigoQR::QrCode::MAX_VERSION; ++version) {
+            medirCaso(opciones, resultados, "qr_codificar_version", static_cast<size_t>(version), 16, [&]() {
+                for (int i = 0; i < 16; ++i) {
+                    CodigoQR::QrCode qr = CodigoQR::QrCode::encodeSegments(segmentos,
+                        CodigoQR::QrCode::Ecc::LOW, version, version, -1, false);
+                    if (qr.getVersion() != version) std::abort();
+                }
+            });
+        }
+    }
+
+    /**
+     * @brief Mide la codificación QR en las versiones 5, 20 y 40 con cada nivel de
+     * corrección y con la máscara fija o elegida entre las ocho
+     *
+     * El tamaño de cada medición es la versión. qr_mascara_auto_hilos_<n> evalúa
+     * las máscaras con n hilos; el valor de setMaskThreads se restaura al final.
+     */
+    void medirOpcionesQR(const OpcionesRendimiento& opciones, std::vector<ResultadoRendimiento>& resultados) {
+        typedef CodigoQR::QrCode::Ecc Ecc;
+        const std::vector<CodigoQR::QrSegment> segmentos = CodigoQR::QrSegment::makeSegments("0102030405");
+        const std::pair<Ecc, const char*> niveles[] = { { Ecc::LOW, "qr_ecc_low" }, { Ecc::MEDIUM, "qr_ecc_medium" },
+            { Ecc::QUARTILE, "qr_ecc_quartile" }, { Ecc::HIGH, "qr_ecc_high" } };
+        std::vector<unsigned int> hilos{ 1 };
+        if (Paralelo::resolverHilos(0) > 1) hilos.push_back(Paralelo::resolverHilos(0));
+        const unsigned int hilosMascara = CodigoQR::QrCode::getMaskThreads();
+
+        auto codificar = [&](int version, Ecc nivel, int mascara) {
+            CodigoQR::QrCode qr = CodigoQR::QrCode::encodeSegments(segmentos, nivel, version, version, mascara, false);
+            if (qr.getVersion() != version) std::abort();
+        };
+        for (int version : { 5, 20, 40 }) {
+            const size_t tamano = static_cast<size_t>(version);
+            for (const auto& nivel : niveles) {
+                medirCaso(opciones, resultados, nivel.second, tamano, 16, [&]() {
+                    for (int i = 0; i < 16; ++i) codificar(version, nivel.first, -1);
+                });
+            }
+            medirCaso(opciones, resultados, "qr_mascara_fija", tamano, 16, [&]() {
+                for (int i = 0; i < 16; ++i) codificar(version, Ecc::LOW, 0);
+            });
+            for (unsigned int h : hilos) {
+                CodigoQR::QrCode::setMaskThreads(h);
+                medirCaso(opciones, resultados, "qr_mascara_auto_hilos_" + std::to_string(h), tamano, 16, [&]() {
+                    for (int i = 0; i < 16; ++i) codificar(version, Ecc::LOW, -1);
+                });
+            }
+        }
+        CodigoQR::QrCode::setMaskThreads(hilosMascara);
+    }
+
+    /**
+     * @brief Escribe un respaldo de unos megabytes repitiendo un tramo de clientes sintéticos
+     * @return Bytes escritos, 0 si no se pudo escribir
+     */
+    size_t escribirArchivoGrande(const std::string& ruta, size_t megabytes, unsigned int semilla) {
+        std::mt19937 aleatorio(semilla);
+        std::string tramo;
+        for (size_t i = 0; tramo.size() < (1u << 20); ++i) {
+            tramo += "===PERSONA_INICIO===\n" + registroSintetico(i, aleatorio) + "\n===PERSONA_FIN===\n\n";
+        }
+        std::ofstream archivo(ruta, std::ios::binary | std::ios::trunc);
+        archivo << "BANCO_BACKUP_V1.0\n";
+        for (size_t escritos = 0; escritos < megabytes; ++escritos) {
+            archivo.write(tramo.data(), static_cast<std::streamsize>(tramo.size()));
+        }
+        archivo.close();
+        return archivo ? tamanoArchivo(ruta) : 0;
+    }
+
+    /**
+     * @brief Mide sobre un respaldo grande el cifrado .bin v2, con un hilo y con
+     * todos los núcleos, y el SHA-256 con y sin las instrucciones del procesador
+     *
+     * Cada cifrado incluye la derivación de clave (PBKDF2, unos cientos de
+     * milisegundos), que no depende del tamaño del archivo.
+     */
+    void medirArchivoGrande(const OpcionesRendimiento& opciones, std::vector<ResultadoRendimiento>& resultados) {
+        std::vector<unsigned int> hilos{ 1 };
+        if (Paralelo::resolverHilos(0) > 1) hilos.push_back(Paralelo::resolverHilos(0));
+        std::vector<bool> implementaciones{ false };
+        if (Hash::aceleracionHardware()) implementaciones.push_back(true);
+        auto nombreSHA256 = [](bool hardware) {
+            return std::string(hardware ? "calcular_sha256_hardware" : "calcular_sha256_portable");
+        };
+
+        bool alguno = false;
+        for (unsigned int h : hilos) {
+            alguno = alguno || pasaFiltro(opciones, "cifrar_v2_hilos_" + std::to_string(h))
+                || pasaFiltro(opciones, "descifrar_v2_hilos_" + std::to_string(h));
+        }
+        for (bool hardware : implementaciones) {
+            alguno = alguno || pasaFiltro(opciones, nombreSHA256(hardware));
+        }
+        if (!alguno || opciones.megabytes == 0) {
+            return;
+        }
+
+        const std::string base = opciones.directorio + "/rendimiento_grande";
+        const std::string respaldo = base + ".bak";
+        const std::string cifrado = base + ".bin";
+        const std::string descifrado = base + ".txt";
+        std::cerr << "Respaldo de " << opciones.megabytes << " MB\n";
+        const size_t bytes = escribirArchivoGrande(respaldo, opciones.megabytes, opciones.semilla);
+        if (bytes == 0) {
+            std::cerr << "No se pudo escribir " << respaldo << "\n";
+            std::abort();
+        }
+
+        for (unsigned int h : hilos) {
+            medirCaso(opciones, resultados, "cifrar_v2_hilos_" + std::to_string(h), bytes, 1,
+                [&]() { Cifrado::CifrarArchivoV2(respaldo, cifrado, "clave de rendimiento", h); });
+            medirCaso(opciones, resultados, "descifrar_v2_hilos_" + std::to_string(h), bytes, 1,
+                [&]() { Cifrado::DescifrarArchivoV2(cifrado, descifrado, "clave de rendimiento", h); });
+        }
+        for (bool hardware : implementaciones) {
+            Hash::usarAceleracionHardware(hardware);
+            medirCaso(opciones, resultados, nombreSHA256(hardware), bytes, 1, [&]() {
+                std::string hexadecimal;
+                uint64_t tamanio = 0;
+                if (!Hash::calcularArchivo(respaldo, AlgoritmoHash::SHA256, hexadecimal, tamanio)) std::abort();
+            });
+        }
+        // Se deja la elección automática
+        Hash::usarAceleracionHardware(implementaciones.back());
+        for (const std::string& ruta : { respaldo, cifrado, descifrado }) {
+            std::remove(ruta.c_str());
+        }
+    }
+}
+
+/**
+ * @brief Ejecuta las mediciones y escribe el JSON
+ *
+ * @param argc Número de argumentos
+ * @param argv Opciones (ver el encabezado del archivo)
+ * @return int 0 si terminó bien, 2 si las opciones no son válidas o no se pudo escribir la salida
+ */
+int main(int argc, char* argv[]) {
+    OpcionesRendimiento opciones;
+    if (!leerOpciones(argc, argv, opciones)) {
+        std::cerr << "Uso: " << argv[0] << " [--tamanos 1000,10000] [--calentamiento 3] [--repeticiones 20]"
+            " [--filtro texto] [--max-orden 5000] [--directorio .] [--semilla 12345] [--megabytes 64]"
+            " [--salida archivo.json]\n";
+        return 2;
+    }
+
+    std::streambuf* consola = std::cout.rdbuf(nullptr);
+    std::vector<ResultadoRendimiento> resultados;
+    Mediciones mediciones(opciones, resultados);
+    for (size_t n : opciones.tamanos) {
+        mediciones.ejecutar(n);
+    }
+    medirArchivoGrande(opciones, resultados);
+    medirVersionesQR(opciones, resultados);
+    medirOpcionesQR(opciones, resultados);
+    medirMenus(opciones, resultados);
+    medirValidaciones(opciones, resultados);
+    medirCedulasLote(opciones, resultados);
+    medirMarquesina(opciones, resultados);
+    std::cout.rdbuf(consola);
+
+    if (opciones.salida.empty()) {
+        Rendimiento::escribirJSON(std::cout, resultados, opciones.configuracion);
+        return 0;
+    }
+    std::ofstream archivo(opciones.salida);
+    Rendimiento::escribirJSON(archivo, resultados, opciones.configuracion);
+    if (!archivo) {
+        std::cerr << "No se pudo escribir " << opciones.salida << "\n";
+        return 2;
+    }
+    std::cerr << "Resultados en " << opciones.salida << "\n";
+    return 0;
+}
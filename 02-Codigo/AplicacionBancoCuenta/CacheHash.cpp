@@ -0,0 +1,296 @@
+/**
+ * @file CacheHash.cpp
+ * @brief Implementación de la caché persistente de hashes de archivos
+ */
+#include "CacheHash.h"
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/stat.h>
+#include <dirent.h>
+#include <climits>
+#include <cstdlib>
+#endif
+
+namespace {
+    /** @brief Primera línea de todo archivo índice de la caché */
+    const char* const FIRMA_INDICE = "# BANCO_HASH_CACHE_V1";
+
+    std::string clave(const std::string& etiqueta, const std::string& rutaCanonica) {
+        return etiqueta + "|" + rutaCanonica;
+    }
+}
+
+/**
+ * @brief Crea una caché asociada a un archivo índice
+ *
+ * @param rutaIndice Ruta del archivo índice
+ */
+CacheHash::CacheHash(const std::string& rutaIndice)
+    : rutaIndice(rutaIndice), aciertos(0), fallos(0) {
+}
+
+/**
+ * @brief Carga las entradas desde el archivo índice
+ *
+ * Formato: una línea de firma y luego una entrada por línea con los campos
+ * etiqueta, tamaño, fecha, hash y ruta separados por tabuladores.
+ *
+ * @return true si el índice se leyó correctamente
+ */
+bool CacheHash::cargar() {
+    std::ifstream archivo(rutaIndice);
+    if (!archivo) {
+        return false;
+    }
+
+    std::string linea;
+    if (!std::getline(archivo, linea) || linea != FIRMA_INDICE) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mtx);
+    entradas.clear();
+    while (std::getline(archivo, linea)) {
+        std::istringstream campos(linea);
+        std::string etiqueta, tamanio, modificacion, hash, ruta;
+        if (!std::getline(campos, etiqueta, '\t') || !std::getline(campos, tamanio, '\t') ||
+            !std::getline(campos, modificacion, '\t') || !std::getline(campos, hash, '\t') ||
+            !std::getline(campos, ruta)) {
+            continue; // Linea danada: se ignora y se recalculara cuando haga falta
+        }
+        try {
+            Entrada entrada;
+            entrada.tamanio = std::stoull(tamanio);
+            entrada.modificacion = std::stoll(modificacion);
+            entrada.hash = hash;
+            entradas[clave(etiqueta, ruta)] = entrada;
+        }
+        catch (...) {
+            continue;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Escribe las entradas en el archivo índice
+ *
+ * @return true si se guardó correctamente
+ */
+bool CacheHash::guardar() const {
+    std::string rutaTemporal = rutaIndice + ".tmp";
+    {
+        std::ofstream archivo(rutaTemporal, std::ios::trunc);
+        if (!archivo) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(mtx);
+        archivo << FIRMA_INDICE << "\n";
+        for (const auto& par : entradas) {
+            size_t separador = par.first.find('|');
+            archivo << par.first.substr(0, separador) << '\t'
+                << par.second.tamanio << '\t'
+                << par.second.modificacion << '\t'
+                << par.second.hash << '\t'
+                << par.first.substr(separador + 1) << "\n";
+        }
+        if (!archivo) {
+            return false;
+        }
+    }
+
+#ifdef _WIN32
+    return MoveFileExA(rutaTemporal.c_str(), rutaIndice.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    return std::rename(rutaTemporal.c_str(), rutaIndice.c_str()) == 0;
+#endif
+}
+
+/**
+ * @brief Devuelve el hash de un archivo, calculándolo solo si cambió
+ *
+ * La consulta cuesta una lectura de metadatos y una búsqueda en tabla hash; el
+ * archivo solo se lee si la ruta, el tamaño o la fecha no coinciden con la entrada.
+ *
+ * @param rutaArchivo Ruta del archivo
+ * @param etiqueta Tipo de hash
+ * @param calcular Función que calcula el hash si hace falta
+ * @param desdeCache Salida opcional: true si se usó la caché
+ * @return Hash del archivo, o cadena vacía si el archivo no existe
+ */
+std::string CacheHash::obtener(const std::string& rutaArchivo, const std::string& etiqueta,
+    const std::function<std::string()>& calcular, bool* desdeCache) {
+    if (desdeCache) *desdeCache = false;
+
+    std::string rutaCanonica;
+    uint64_t tamanio = 0;
+    int64_t modificacion = 0;
+    if (!obtenerMetadatos(rutaArchivo, rutaCanonica, tamanio, modificacion)) {
+        return "";
+    }
+
+    std::string llave = clave(etiqueta, rutaCanonica);
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto it = entradas.find(llave);
+        if (it != entradas.end()) {
+            if (it->second.tamanio == tamanio && it->second.modificacion == modificacion) {
+                ++aciertos;
+                if (desdeCache) *desdeCache = true;
+                return it->second.hash;
+            }
+            entradas.erase(it); // Algun campo cambio: la entrada ya no es valida
+        }
+        ++fallos;
+    }
+
+    std::string hash = calcular();
+    if (hash.empty()) {
+        return hash;
+    }
+
+    // Si el archivo cambio mientras se calculaba, no se guarda el resultado
+    std::string rutaDespues;
+    uint64_t tamanioDespues = 0;
+    int64_t modificacionDespues = 0;
+    if (obtenerMetadatos(rutaArchivo, rutaDespues, tamanioDespues, modificacionDespues) &&
+        tamanioDespues == tamanio && modificacionDespues == modificacion) {
+        std::lock_guard<std::mutex> lock(mtx);
+        Entrada entrada;
+        entrada.tamanio = tamanio;
+        entrada.modificacion = modificacion;
+        entrada.hash = hash;
+        entradas[llave] = entrada;
+    }
+    return hash;
+}
+
+/**
+ * @brief Elimina de la caché todas las entradas de un archivo
+ *
+ * @param rutaArchivo Ruta del archivo
+ */
+void CacheHash::invalidar(const std::string& rutaArchivo) {
+    std::string rutaCanonica;
+    uint64_t tamanio = 0;
+    int64_t modificacion = 0;
+    if (!obtenerMetadatos(rutaArchivo, rutaCanonica, tamanio, modificacion)) {
+        return;
+    }
+
+    std::string sufijo = "|" + rutaCanonica;
+    std::lock_guard<std::mutex> lock(mtx);
+    for (auto it = entradas.begin(); it != entradas.end();) {
+        const std::string& llave = it->first;
+        if (llave.size() >= sufijo.size() &&
+            llave.compare(llave.size() - sufijo.size(), sufijo.size(), sufijo) == 0) {
+            it = entradas.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+/**
+ * @brief Obtiene la ruta canónica, el tamaño y la fecha de modificación de un archivo
+ *
+ * En Windows la ruta se normaliza a minúsculas con barras invertidas, ya que el
+ * sistema de archivos no distingue mayúsculas.
+ *
+ * @param rutaArchivo Ruta del archivo
+ * @param rutaCanonica Salida: ruta absoluta normalizada
+ * @param tamanio Salida: tamaño en bytes
+ * @param modificacion Salida: fecha de modificación
+ * @return true si el archivo existe
+ */
+bool CacheHash::obtenerMetadatos(const std::string& rutaArchivo, std::string& rutaCanonica,
+    uint64_t& tamanio, int64_t& modificacion) {
+#ifdef _WIN32
+    WIN32_FILE_ATTRIBUTE_DATA datos;
+    if (!GetFileAttributesExA(rutaArchivo.c_str(), GetFileExInfoStandard, &datos) ||
+        (datos.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) {
+        return false;
+    }
+    tamanio = (static_cast<uint64_t>(datos.nFileSizeHigh) << 32) | datos.nFileSizeLow;
+    modificacion = static_cast<int64_t>((static_cast<uint64_t>(datos.ftLastWriteTime.dwHighDateTime) << 32) |
+        datos.ftLastWriteTime.dwLowDateTime);
+
+    char ruta[MAX_PATH];
+    DWORD longitud = GetFullPathNameA(rutaArchivo.c_str(), MAX_PATH, ruta, nullptr);
+    rutaCanonica = (longitud > 0 && longitud < MAX_PATH) ? std::string(ruta, longitud) : rutaArchivo;
+    std::replace(rutaCanonica.begin(), rutaCanonica.end(), '/', '\\');
+    std::transform(rutaCanonica.begin(), rutaCanonica.end(), rutaCanonica.begin(),
+        [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return true;
+#else
+    struct stat info;
+    if (stat(rutaArchivo.c_str(), &info) != 0 || !S_ISREG(info.st_mode)) {
+        return false;
+    }
+    tamanio = static_cast<uint64_t>(info.st_size);
+    modificacion = static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000LL + info.st_mtim.tv_nsec;
+
+    char ruta[PATH_MAX];
+    rutaCanonica = realpath(rutaArchivo.c_str(), ruta) ? std::string(ruta) : rutaArchivo;
+    return true;
+#endif
+}
+
+/**
+ * @brief Lista los archivos de un directorio que tienen un archivo .hash asociado
+ *
+ * @param directorio Ruta del directorio
+ * @return Rutas completas de los archivos verificables, en orden alfabético
+ */
+std::vector<std::string> CacheHash::listarArchivosConHash(const std::string& directorio) {
+    std::vector<std::string> archivos;
+    std::string base = directorio;
+    if (!base.empty() && base.back() != '\\' && base.back() != '/') {
+#ifdef _WIN32
+        base += '\\';
+#else
+        base += '/';
+#endif
+    }
+
+    const std::string extension = ".hash";
+    auto agregar = [&](const std::string& nombre) {
+        if (nombre.size() > extension.size() &&
+            nombre.compare(nombre.size() - extension.size(), extension.size(), extension) == 0) {
+            archivos.push_back(base + nombre.substr(0, nombre.size() - extension.size()));
+        }
+    };
+
+#ifdef _WIN32
+    WIN32_FIND_DATAA datos;
+    HANDLE busqueda = FindFirstFileA((base + "*.hash").c_str(), &datos);
+    if (busqueda != INVALID_HANDLE_VALUE) {
+        do {
+            if (!(datos.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) {
+                agregar(datos.cFileName);
+            }
+        } while (FindNextFileA(busqueda, &datos));
+        FindClose(busqueda);
+    }
+#else
+    DIR* dir = opendir(base.c_str());
+    if (dir) {
+        while (struct dirent* entrada = readdir(dir)) {
+            agregar(entrada->d_name);
+        }
+        closedir(dir);
+    }
+#endif
+
+    std::sort(archivos.begin(), archivos.end());
+    return archivos;
+}
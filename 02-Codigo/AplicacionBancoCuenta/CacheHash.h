@@ -0,0 +1,113 @@
+#pragma once
+#ifndef CACHEHASH_H
+#define CACHEHASH_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <cstdint>
+#include <mutex>
+
+/**
+ * @class CacheHash
+ * @brief Caché persistente de hashes de archivos indexada por ruta, tamaño y fecha de modificación
+ *
+ * Guarda en un archivo índice el último hash calculado para cada archivo junto con
+ * su ruta canónica, su tamaño y su fecha de modificación. Si ninguno de esos datos
+ * cambió, el hash se devuelve sin volver a leer el archivo; si cualquiera difiere,
+ * la entrada se descarta y el hash se recalcula.
+ *
+ * @note La caché confía en los metadatos del sistema de archivos: una modificación
+ * que conserve tamaño y fecha no se detecta. Para una comprobación completa se debe
+ * verificar sin caché.
+ */
+class CacheHash {
+public:
+    /**
+     * @brief Crea una caché asociada a un archivo índice
+     * @param rutaIndice Ruta del archivo donde se persiste la caché
+     */
+    explicit CacheHash(const std::string& rutaIndice);
+
+    /**
+     * @brief Carga las entradas desde el archivo índice
+     * @return true si el índice se leyó; false si no existe o tiene otro formato
+     */
+    bool cargar();
+
+    /**
+     * @brief Escribe las entradas en el archivo índice
+     * @return true si se guardó correctamente
+     *
+     * Se escribe primero en un archivo temporal que luego reemplaza al índice,
+     * para no dejar un índice a medio escribir.
+     */
+    bool guardar() const;
+
+    /**
+     * @brief Devuelve el hash de un archivo, calculándolo solo si cambió
+     * @param rutaArchivo Ruta del archivo
+     * @param etiqueta Tipo de hash (por ejemplo "SHA256" o "MERKLE-SHA256/1048576")
+     * @param calcular Función que calcula el hash cuando no está en caché
+     * @param desdeCache Salida opcional: true si el resultado vino de la caché
+     * @return Hash del archivo, o cadena vacía si el archivo no existe
+     */
+    std::string obtener(const std::string& rutaArchivo, const std::string& etiqueta,
+        const std::function<std::string()>& calcular, bool* desdeCache = nullptr);
+
+    /**
+     * @brief Elimina de la caché todas las entradas de un archivo
+     * @param rutaArchivo Ruta del archivo
+     */
+    void invalidar(const std::string& rutaArchivo);
+
+    /** @brief Número de consultas resueltas desde la caché */
+    size_t getAciertos() const { return aciertos; }
+
+    /** @brief Número de consultas que obligaron a recalcular */
+    size_t getFallos() const { return fallos; }
+
+    /**
+     * @brief Obtiene la ruta canónica, el tamaño y la fecha de modificación de un archivo
+     * @param rutaArchivo Ruta del archivo
+     * @param rutaCanonica Salida: ruta absoluta normalizada
+     * @param tamanio Salida: tamaño en bytes
+     * @param modificacion Salida: fecha de modificación en la unidad nativa del sistema
+     * @return true si el archivo existe
+     */
+    static bool obtenerMetadatos(const std::string& rutaArchivo, std::string& rutaCanonica,
+        uint64_t& tamanio, int64_t& modificacion);
+
+    /**
+     * @brief Lista los archivos de un directorio que tienen un archivo .hash asociado
+     * @param directorio Ruta del directorio
+     * @return Rutas completas de los archivos (sin la extensión .hash)
+     */
+    static std::vector<std::string> listarArchivosConHash(const std::string& directorio);
+
+private:
+    /**
+     * @struct Entrada
+     * @brief Hash guardado junto con los metadatos del archivo al calcularlo
+     */
+    struct Entrada {
+        uint64_t tamanio;
+        int64_t modificacion;
+        std::string hash;
+    };
+
+    /** @brief Ruta del archivo índice */
+    std::string rutaIndice;
+
+    /** @brief Entradas indexadas por "etiqueta|ruta canónica" */
+    std::unordered_map<std::string, Entrada> entradas;
+
+    /** @brief Protege las entradas si se consulta desde varios hilos */
+    mutable std::mutex mtx;
+
+    size_t aciertos;
+    size_t fallos;
+};
+
+#endif // CACHEHASH_H
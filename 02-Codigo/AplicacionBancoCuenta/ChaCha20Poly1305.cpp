@@ -0,0 +1,335 @@
+/**
+ * @file ChaCha20Poly1305.cpp
+ * @brief Implementación de ChaCha20, Poly1305 y la construcción AEAD de RFC 8439
+ */
+#include "ChaCha20Poly1305.h"
+#include <cstring>
+
+namespace {
+
+    /**
+     * @brief Lee un entero de 32 bits little-endian
+     */
+    inline uint32_t leer32(const uint8_t* p) {
+        return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+            (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+    }
+
+    /**
+     * @brief Escribe un entero de 32 bits little-endian
+     */
+    inline void escribir32(uint8_t* p, uint32_t v) {
+        p[0] = static_cast<uint8_t>(v);
+        p[1] = static_cast<uint8_t>(v >> 8);
+        p[2] = static_cast<uint8_t>(v >> 16);
+        p[3] = static_cast<uint8_t>(v >> 24);
+    }
+
+    inline uint32_t rotar(uint32_t v, int n) {
+        return (v << n) | (v >> (32 - n));
+    }
+
+    inline void cuartoDeRonda(uint32_t& a, uint32_t& b, uint32_t& c, uint32_t& d) {
+        a += b; d ^= a; d = rotar(d, 16);
+        c += d; b ^= c; b = rotar(b, 12);
+        a += b; d ^= a; d = rotar(d, 8);
+        c += d; b ^= c; b = rotar(b, 7);
+    }
+
+    /**
+     * @brief Estado incremental de Poly1305 en limbs de 26 bits
+     *
+     * Se usan limbs de 26 bits para que los productos quepan en 64 bits sin
+     * depender de enteros de 128 bits, que MSVC no ofrece.
+     */
+    struct EstadoPoly1305 {
+        uint32_t r[5];
+        uint32_t h[5];
+        uint32_t s[4];
+        uint8_t pendiente[16];
+        size_t usados;
+
+        explicit EstadoPoly1305(const uint8_t clave[32]) : usados(0) {
+            // r se recorta segun la especificacion
+            r[0] = (leer32(clave + 0)) & 0x3ffffff;
+            r[1] = (leer32(clave + 3) >> 2) & 0x3ffff03;
+            r[2] = (leer32(clave + 6) >> 4) & 0x3ffc0ff;
+            r[3] = (leer32(clave + 9) >> 6) & 0x3f03fff;
+            r[4] = (leer32(clave + 12) >> 8) & 0x00fffff;
+            for (int i = 0; i < 5; ++i) h[i] = 0;
+            for (int i = 0; i < 4; ++i) s[i] = leer32(clave + 16 + 4 * i);
+        }
+
+        void bloques(const uint8_t* m, size_t longitud, uint32_t bitAlto) {
+            const uint32_t s1 = r[1] * 5, s2 = r[2] * 5, s3 = r[3] * 5, s4 = r[4] * 5;
+            uint32_t h0 = h[0], h1 = h[1], h2 = h[2], h3 = h[3], h4 = h[4];
+
+            while (longitud >= 16) {
+                h0 += (leer32(m + 0)) & 0x3ffffff;
+                h1 += (leer32(m + 3) >> 2) & 0x3ffffff;
+                h2 += (leer32(m + 6) >> 4) & 0x3ffffff;
+                h3 += (leer32(m + 9) >> 6) & 0x3ffffff;
+                h4 += (leer32(m + 12) >> 8) | bitAlto;
+
+                uint64_t d0 = (uint64_t)h0 * r[0] + (uint64_t)h1 * s4 + (uint64_t)h2 * s3 + (uint64_t)h3 * s2 + (uint64_t)h4 * s1;
+                uint64_t d1 = (uint64_t)h0 * r[1] + (uint64_t)h1 * r[0] + (uint64_t)h2 * s4 + (uint64_t)h3 * s3 + (uint64_t)h4 * s2;
+                uint64_t d2 = (uint64_t)h0 * r[2] + (uint64_t)h1 * r[1] + (uint64_t)h2 * r[0] + (uint64_t)h3 * s4 + (uint64_t)h4 * s3;
+                uint64_t d3 = (uint64_t)h0 * r[3] + (uint64_t)h1 * r[2] + (uint64_t)h2 * r[1] + (uint64_t)h3 * r[0] + (uint64_t)h4 * s4;
+                uint64_t d4 = (uint64_t)h0 * r[4] + (uint64_t)h1 * r[3] + (uint64_t)h2 * r[2] + (uint64_t)h3 * r[1] + (uint64_t)h4 * r[0];
+
+                uint32_t c;
+                c = (uint32_t)(d0 >> 26); h0 = (uint32_t)d0 & 0x3ffffff;
+                d1 += c; c = (uint32_t)(d1 >> 26); h1 = (uint32_t)d1 & 0x3ffffff;
+                d2 += c; c = (uint32_t)(d2 >> 26); h2 = (uint32_t)d2 & 0x3ffffff;
+                d3 += c; c = (uint32_t)(d3 >> 26); h3 = (uint32_t)d3 & 0x3ffffff;
+                d4 += c; c = (uint32_t)(d4 >> 26); h4 = (uint32_t)d4 & 0x3ffffff;
+                h0 += c * 5; c = h0 >> 26; h0 &= 0x3ffffff;
+                h1 += c;
+
+                m += 16;
+                longitud -= 16;
+            }
+
+            h[0] = h0; h[1] = h1; h[2] = h2; h[3] = h3; h[4] = h4;
+        }
+
+        void actualizar(const uint8_t* m, size_t longitud) {
+            if (usados > 0) {
+                size_t faltan = 16 - usados;
+                if (faltan > longitud) faltan = longitud;
+                std::memcpy(pendiente + usados, m, faltan);
+                usados += faltan;
+                m += faltan;
+                longitud -= faltan;
+                if (usados < 16) return;
+                bloques(pendiente, 16, 1u << 24);
+                usados = 0;
+            }
+            size_t completos = longitud & ~static_cast<size_t>(15);
+            if (completos > 0) {
+                bloques(m, completos, 1u << 24);
+                m += completos;
+                longitud -= completos;
+            }
+            if (longitud > 0) {
+                std::memcpy(pendiente, m, longitud);
+                usados = longitud;
+            }
+        }
+
+        /**
+         * @brief Completa con ceros hasta el siguiente múltiplo de 16 (relleno AEAD)
+         */
+        void rellenar() {
+            if (usados > 0) {
+                std::memset(pendiente + usados, 0, 16 - usados);
+                bloques(pendiente, 16, 1u << 24);
+                usados = 0;
+            }
+        }
+
+        void finalizar(uint8_t etiqueta[16]) {
+            if (usados > 0) {
+                // Bloque final parcial: se agrega el 1 explicito y sin bit alto
+                pendiente[usados] = 1;
+                std::memset(pendiente + usados + 1, 0, 16 - usados - 1);
+                bloques(pendiente, 16, 0);
+                usados = 0;
+            }
+
+            uint32_t h0 = h[0], h1 = h[1], h2 = h[2], h3 = h[3], h4 = h[4];
+            uint32_t c;
+            c = h1 >> 26; h1 &= 0x3ffffff;
+            h2 += c; c = h2 >> 26; h2 &= 0x3ffffff;
+            h3 += c; c = h3 >> 26; h3 &= 0x3ffffff;
+            h4 += c; c = h4 >> 26; h4 &= 0x3ffffff;
+            h0 += c * 5; c = h0 >> 26; h0 &= 0x3ffffff;
+            h1 += c;
+
+            // g = h + 5 - 2^130; se elige h o g sin ramas
+            uint32_t g0 = h0 + 5; c = g0 >> 26; g0 &= 0x3ffffff;
+            uint32_t g1 = h1 + c; c = g1 >> 26; g1 &= 0x3ffffff;
+            uint32_t g2 = h2 + c; c = g2 >> 26; g2 &= 0x3ffffff;
+            uint32_t g3 = h3 + c; c = g3 >> 26; g3 &= 0x3ffffff;
+            uint32_t g4 = h4 + c - (1u << 26);
+
+            uint32_t mascara = (g4 >> 31) - 1;
+            g0 &= mascara; g1 &= mascara; g2 &= mascara; g3 &= mascara; g4 &= mascara;
+            mascara = ~mascara;
+            h0 = (h0 & mascara) | g0;
+            h1 = (h1 & mascara) | g1;
+            h2 = (h2 & mascara) | g2;
+            h3 = (h3 & mascara) | g3;
+            h4 = (h4 & mascara) | g4;
+
+            h0 = (h0) | (h1 << 26);
+            h1 = (h1 >> 6) | (h2 << 20);
+            h2 = (h2 >> 12) | (h3 << 14);
+            h3 = (h3 >> 18) | (h4 << 8);
+
+            uint64_t f;
+            f = (uint64_t)h0 + s[0]; h0 = (uint32_t)f;
+            f = (uint64_t)h1 + s[1] + (f >> 32); h1 = (uint32_t)f;
+            f = (uint64_t)h2 + s[2] + (f >> 32); h2 = (uint32_t)f;
+            f = (uint64_t)h3 + s[3] + (f >> 32); h3 = (uint32_t)f;
+
+            escribir32(etiqueta + 0, h0);
+            escribir32(etiqueta + 4, h1);
+            escribir32(etiqueta + 8, h2);
+            escribir32(etiqueta + 12, h3);
+        }
+    };
+}
+
+/**
+ * @brief Calcula un bloque de 64 bytes del flujo ChaCha20
+ *
+ * @param clave Clave de 32 bytes
+ * @param contador Contador de bloque
+ * @param nonce Nonce de 12 bytes
+ * @param salida Búfer de 64 bytes donde se escribe el bloque
+ */
+void ChaCha20Poly1305::bloque(const uint8_t clave[32], uint32_t contador, const uint8_t nonce[12], uint8_t salida[64]) {
+    uint32_t estado[16] = {
+        0x61707865, 0x3320646e, 0x79622d32, 0x6b206574,
+        leer32(clave + 0), leer32(clave + 4), leer32(clave + 8), leer32(clave + 12),
+        leer32(clave + 16), leer32(clave + 20), leer32(clave + 24), leer32(clave + 28),
+        contador, leer32(nonce + 0), leer32(nonce + 4), leer32(nonce + 8)
+    };
+    uint32_t x[16];
+    std::memcpy(x, estado, sizeof(x));
+
+    for (int i = 0; i < 10; ++i) {
+        // Rondas de columna
+        cuartoDeRonda(x[0], x[4], x[8], x[12]);
+        cuartoDeRonda(x[1], x[5], x[9], x[13]);
+        cuartoDeRonda(x[2], x[6], x[10], x[14]);
+        cuartoDeRonda(x[3], x[7], x[11], x[15]);
+        // Rondas diagonales
+        cuartoDeRonda(x[0], x[5], x[10], x[15]);
+        cuartoDeRonda(x[1], x[6], x[11], x[12]);
+        cuartoDeRonda(x[2], x[7], x[8], x[13]);
+        cuartoDeRonda(x[3], x[4], x[9], x[14]);
+    }
+
+    for (int i = 0; i < 16; ++i) {
+        escribir32(salida + 4 * i, x[i] + estado[i]);
+    }
+}
+
+/**
+ * @brief Aplica el flujo ChaCha20 (XOR) sobre un búfer
+ *
+ * @param clave Clave de 32 bytes
+ * @param contador Contador inicial de bloque
+ * @param nonce Nonce de 12 bytes
+ * @param entrada Datos de entrada
+ * @param salida Datos de salida
+ * @param longitud Número de bytes a procesar
+ */
+void ChaCha20Poly1305::cifrar(const uint8_t clave[32], uint32_t contador, const uint8_t nonce[12],
+    const uint8_t* entrada, uint8_t* salida, size_t longitud) {
+    uint8_t flujo[64];
+    while (longitud > 0) {
+        bloque(clave, contador++, nonce, flujo);
+        size_t n = longitud < 64 ? longitud : 64;
+        for (size_t i = 0; i < n; ++i) {
+            salida[i] = entrada[i] ^ flujo[i];
+        }
+        entrada += n;
+        salida += n;
+        longitud -= n;
+    }
+}
+
+/**
+ * @brief Calcula la etiqueta Poly1305 de un mensaje
+ *
+ * @param claveUnica Clave de un solo uso de 32 bytes
+ * @param mensaje Datos a autenticar
+ * @param longitud Número de bytes del mensaje
+ * @param etiqueta Búfer de 16 bytes donde se escribe la etiqueta
+ */
+void ChaCha20Poly1305::poly1305(const uint8_t claveUnica[32], const uint8_t* mensaje, size_t longitud, uint8_t etiqueta[16]) {
+    EstadoPoly1305 estado(claveUnica);
+    estado.actualizar(mensaje, longitud);
+    estado.finalizar(etiqueta);
+}
+
+/**
+ * @brief Calcula la etiqueta AEAD: Poly1305 sobre aad, texto cifrado y longitudes
+ */
+void ChaCha20Poly1305::etiquetaAead(const uint8_t clave[32], const uint8_t nonce[12],
+    const uint8_t* aad, size_t longitudAad,
+    const uint8_t* cifrado, size_t longitud, uint8_t etiqueta[16]) {
+    // La clave de Poly1305 es el primer bloque del flujo con contador 0
+    uint8_t bloqueCero[64];
+    bloque(clave, 0, nonce, bloqueCero);
+
+    EstadoPoly1305 estado(bloqueCero);
+    estado.actualizar(aad, longitudAad);
+    estado.rellenar();
+    estado.actualizar(cifrado, longitud);
+    estado.rellenar();
+
+    uint8_t longitudes[16];
+    uint64_t la = longitudAad, lc = longitud;
+    for (int i = 0; i < 8; ++i) {
+        longitudes[i] = static_cast<uint8_t>(la >> (8 * i));
+        longitudes[8 + i] = static_cast<uint8_t>(lc >> (8 * i));
+    }
+    estado.actualizar(longitudes, 16);
+    estado.finalizar(etiqueta);
+}
+
+/**
+ * @brief Cifra y autentica un búfer (AEAD)
+ *
+ * @param clave Clave de 32 bytes
+ * @param nonce Nonce de 12 bytes
+ * @param aad Datos adicionales autenticados
+ * @param longitudAad Número de bytes de aad
+ * @param entrada Texto plano
+ * @param salida Texto cifrado
+ * @param longitud Número de bytes a cifrar
+ * @param etiqueta Búfer de 16 bytes donde se escribe la etiqueta
+ */
+void ChaCha20Poly1305::sellar(const uint8_t clave[32], const uint8_t nonce[12],
+    const uint8_t* aad, size_t longitudAad,
+    const uint8_t* entrada, uint8_t* salida, size_t longitud, uint8_t etiqueta[16]) {
+    cifrar(clave, 1, nonce, entrada, salida, longitud);
+    etiquetaAead(clave, nonce, aad, longitudAad, salida, longitud, etiqueta);
+}
+
+/**
+ * @brief Verifica la etiqueta y descifra un búfer (AEAD)
+ *
+ * La comparación de etiquetas se hace en tiempo constante.
+ *
+ * @param clave Clave de 32 bytes
+ * @param nonce Nonce de 12 bytes
+ * @param aad Datos adicionales autenticados
+ * @param longitudAad Número de bytes de aad
+ * @param entrada Texto cifrado
+ * @param salida Texto plano
+ * @param longitud Número de bytes a descifrar
+ * @param etiqueta Etiqueta esperada
+ * @return true si la etiqueta es válida, false en caso contrario
+ */
+bool ChaCha20Poly1305::abrir(const uint8_t clave[32], const uint8_t nonce[12],
+    const uint8_t* aad, size_t longitudAad,
+    const uint8_t* entrada, uint8_t* salida, size_t longitud, const uint8_t etiqueta[16]) {
+    uint8_t calculada[16];
+    etiquetaAead(clave, nonce, aad, longitudAad, entrada, longitud, calculada);
+
+    uint8_t diferencia = 0;
+    for (int i = 0; i < 16; ++i) {
+        diferencia |= static_cast<uint8_t>(calculada[i] ^ etiqueta[i]);
+    }
+    if (diferencia != 0) {
+        return false;
+    }
+
+    cifrar(clave, 1, nonce, entrada, salida, longitud);
+    return true;
+}
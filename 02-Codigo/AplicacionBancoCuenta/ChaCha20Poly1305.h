@@ -0,0 +1,99 @@
+#pragma once
+#ifndef CHACHA20POLY1305_H
+#define CHACHA20POLY1305_H
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @class ChaCha20Poly1305
+ * @brief Implementación del cifrado autenticado ChaCha20-Poly1305 (RFC 8439)
+ *
+ * Clase estática sin dependencias externas que ofrece el cifrado de flujo
+ * ChaCha20, el autenticador Poly1305 y la construcción AEAD que los combina.
+ * Es usada por Cifrado para el formato de archivos .bin versión 2.
+ */
+class ChaCha20Poly1305 {
+public:
+    /** @brief Tamaño de la clave en bytes */
+    static const size_t TAM_CLAVE = 32;
+
+    /** @brief Tamaño del nonce en bytes */
+    static const size_t TAM_NONCE = 12;
+
+    /** @brief Tamaño de la etiqueta de autenticación en bytes */
+    static const size_t TAM_ETIQUETA = 16;
+
+    /**
+     * @brief Calcula un bloque de 64 bytes del flujo ChaCha20
+     * @param clave Clave de 32 bytes
+     * @param contador Contador de bloque
+     * @param nonce Nonce de 12 bytes
+     * @param salida Búfer de 64 bytes donde se escribe el bloque
+     */
+    static void bloque(const uint8_t clave[32], uint32_t contador, const uint8_t nonce[12], uint8_t salida[64]);
+
+    /**
+     * @brief Aplica el flujo ChaCha20 (XOR) sobre un búfer
+     * @param clave Clave de 32 bytes
+     * @param contador Contador inicial de bloque
+     * @param nonce Nonce de 12 bytes
+     * @param entrada Datos de entrada
+     * @param salida Datos de salida (puede coincidir con la entrada)
+     * @param longitud Número de bytes a procesar
+     */
+    static void cifrar(const uint8_t clave[32], uint32_t contador, const uint8_t nonce[12],
+        const uint8_t* entrada, uint8_t* salida, size_t longitud);
+
+    /**
+     * @brief Calcula la etiqueta Poly1305 de un mensaje
+     * @param claveUnica Clave de un solo uso de 32 bytes
+     * @param mensaje Datos a autenticar
+     * @param longitud Número de bytes del mensaje
+     * @param etiqueta Búfer de 16 bytes donde se escribe la etiqueta
+     */
+    static void poly1305(const uint8_t claveUnica[32], const uint8_t* mensaje, size_t longitud, uint8_t etiqueta[16]);
+
+    /**
+     * @brief Cifra y autentica un búfer (AEAD)
+     * @param clave Clave de 32 bytes
+     * @param nonce Nonce de 12 bytes, nunca repetido para la misma clave
+     * @param aad Datos adicionales autenticados pero no cifrados
+     * @param longitudAad Número de bytes de aad
+     * @param entrada Texto plano
+     * @param salida Texto cifrado (puede coincidir con la entrada)
+     * @param longitud Número de bytes a cifrar
+     * @param etiqueta Búfer de 16 bytes donde se escribe la etiqueta
+     */
+    static void sellar(const uint8_t clave[32], const uint8_t nonce[12],
+        const uint8_t* aad, size_t longitudAad,
+        const uint8_t* entrada, uint8_t* salida, size_t longitud, uint8_t etiqueta[16]);
+
+    /**
+     * @brief Verifica la etiqueta y descifra un búfer (AEAD)
+     * @param clave Clave de 32 bytes
+     * @param nonce Nonce de 12 bytes usado al sellar
+     * @param aad Datos adicionales autenticados
+     * @param longitudAad Número de bytes de aad
+     * @param entrada Texto cifrado
+     * @param salida Texto plano (puede coincidir con la entrada)
+     * @param longitud Número de bytes a descifrar
+     * @param etiqueta Etiqueta de 16 bytes esperada
+     * @return true si la etiqueta es válida; false si los datos fueron alterados
+     *
+     * Si la verificación falla no se escribe nada en la salida.
+     */
+    static bool abrir(const uint8_t clave[32], const uint8_t nonce[12],
+        const uint8_t* aad, size_t longitudAad,
+        const uint8_t* entrada, uint8_t* salida, size_t longitud, const uint8_t etiqueta[16]);
+
+private:
+    /**
+     * @brief Calcula la etiqueta AEAD sobre aad y texto cifrado
+     */
+    static void etiquetaAead(const uint8_t clave[32], const uint8_t nonce[12],
+        const uint8_t* aad, size_t longitudAad,
+        const uint8_t* cifrado, size_t longitud, uint8_t etiqueta[16]);
+};
+
+#endif // CHACHA20POLY1305_H
@@ -5,8 +5,216 @@
 #include <iostream>
 #include <fstream>
 #include <stdexcept>
+#include <vector>
+#include <random>
+#include <cstring>
+#include <cstdio>
+#include <algorithm>
 #include "Cifrado.h"
 #include "Banco.h"
+#include "ChaCha20Poly1305.h"
+#include "Hash.h"
+#include "Paralelo.h"
+#include "Estadisticas.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+namespace {
+
+    /** @brief Firma al inicio de todo archivo .bin versin 2 */
+    const char FIRMA_V2[8] = { 'B', 'A', 'N', 'C', 'O', 'B', 'I', 'N' };
+
+    /** @brief Tamao fijo de la cabecera v2 en bytes */
+    const size_t TAM_CABECERA_V2 = 64;
+
+    /** @brief Identificador de la derivacin de clave PBKDF2-HMAC-SHA256 */
+    const uint8_t KDF_PBKDF2_SHA256 = 2;
+
+    /** @brief Iteraciones de PBKDF2 con que se cifra (las de cada archivo van en su cabecera) */
+    const uint32_t ITERACIONES_KDF = 600000;
+
+    /**
+     * @brief Mximo de iteraciones que se aceptan de una cabecera
+     *
+     * La cabecera no est autenticada hasta derivar la clave, as que sin este
+     * lmite un archivo manipulado podra pedir 2^32 iteraciones.
+     */
+    const uint32_t ITERACIONES_KDF_MAXIMO = 10000000;
+
+    /** @brief Bloques por hilo en cada lote; acota la memoria usada a la vez */
+    const size_t BLOQUES_POR_HILO = 4;
+
+    /**
+     * @class SalidaTemporal
+     * @brief Archivo de salida que se escribe aparte y reemplaza al destino al confirmarlo
+     *
+     * Si se destruye sin confirmar, por un error o una excepcin, el temporal se
+     * borra y el destino queda como estaba.
+     */
+    class SalidaTemporal {
+    public:
+        explicit SalidaTemporal(const std::string& destino)
+            : destino(destino), temporal(destino + ".tmp"), confirmada(false) {}
+
+        ~SalidaTemporal() {
+            if (!confirmada) std::remove(temporal.c_str());
+        }
+
+        SalidaTemporal(const SalidaTemporal&) = delete;
+        SalidaTemporal& operator=(const SalidaTemporal&) = delete;
+
+        /** @brief Ruta donde se debe escribir */
+        const std::string& ruta() const { return temporal; }
+
+        /**
+         * @brief Reemplaza el destino por el temporal; el flujo ya debe estar cerrado
+         * @throws std::runtime_error Si no se pudo reemplazar el destino
+         */
+        void confirmar() {
+#ifdef _WIN32
+            bool movido = MoveFileExA(temporal.c_str(), destino.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+            bool movido = std::rename(temporal.c_str(), destino.c_str()) == 0;
+#endif
+            if (!movido) {
+                throw std::runtime_error("Error al escribir el archivo de salida.");
+            }
+            confirmada = true;
+        }
+
+    private:
+        std::string destino;
+        std::string temporal;
+        bool confirmada;
+    };
+
+    /**
+     * @brief Cabecera del formato .bin versin 2
+     *
+     * Distribucin en disco (little-endian, 64 bytes):
+     * firma[8] version[1] kdf[1] reservado[2] tamBloque[4] tamTotal[8]
+     * iteraciones[4] prefijoNonce[4] sal[16] verificador[16]
+     */
+    struct CabeceraV2 {
+        uint8_t version = 2;
+        uint8_t kdf = KDF_PBKDF2_SHA256;
+        uint32_t tamBloque = 0;
+        uint64_t tamTotal = 0;
+        uint32_t iteraciones = ITERACIONES_KDF;
+        uint8_t prefijoNonce[4] = {};
+        uint8_t sal[16] = {};
+        uint8_t verificador[16] = {};
+
+        /**
+         * @brief Serializa la cabecera; los primeros 48 bytes son los autenticados
+         */
+        void serializar(uint8_t salida[TAM_CABECERA_V2]) const {
+            std::memset(salida, 0, TAM_CABECERA_V2);
+            std::memcpy(salida, FIRMA_V2, 8);
+            salida[8] = version;
+            salida[9] = kdf;
+            for (int i = 0; i < 4; ++i) salida[12 + i] = static_cast<uint8_t>(tamBloque >> (8 * i));
+            for (int i = 0; i < 8; ++i) salida[16 + i] = static_cast<uint8_t>(tamTotal >> (8 * i));
+            for (int i = 0; i < 4; ++i) salida[24 + i] = static_cast<uint8_t>(iteraciones >> (8 * i));
+            std::memcpy(salida + 28, prefijoNonce, 4);
+            std::memcpy(salida + 32, sal, 16);
+            std::memcpy(salida + 48, verificador, 16);
+        }
+
+        bool deserializar(const uint8_t entrada[TAM_CABECERA_V2]) {
+            if (std::memcmp(entrada, FIRMA_V2, 8) != 0) return false;
+            version = entrada[8];
+            kdf = entrada[9];
+            tamBloque = 0;
+            for (int i = 0; i < 4; ++i) tamBloque |= static_cast<uint32_t>(entrada[12 + i]) << (8 * i);
+            tamTotal = 0;
+            for (int i = 0; i < 8; ++i) tamTotal |= static_cast<uint64_t>(entrada[16 + i]) << (8 * i);
+            iteraciones = 0;
+            for (int i = 0; i < 4; ++i) iteraciones |= static_cast<uint32_t>(entrada[24 + i]) << (8 * i);
+            std::memcpy(prefijoNonce, entrada + 28, 4);
+            std::memcpy(sal, entrada + 32, 16);
+            std::memcpy(verificador, entrada + 48, 16);
+            return true;
+        }
+    };
+
+    /**
+     * @brief Deriva una clave de 256 bits con PBKDF2-HMAC-SHA256 (RFC 8018)
+     *
+     * La clave derivada mide lo mismo que el resumen, as que basta el primer
+     * bloque de PBKDF2. Los estados de HMAC tras las claves interna y externa se
+     * calculan una sola vez y se copian en cada iteracin.
+     */
+    void derivarClave(const std::string& frase, const uint8_t sal[16], uint32_t iteraciones, uint8_t clave[32]) {
+        uint8_t claveHMAC[64] = {};
+        if (frase.size() > sizeof(claveHMAC)) {
+            ContextoSHA256 resumen;
+            resumen.actualizar(reinterpret_cast<const uint8_t*>(frase.data()), frase.size());
+            resumen.finalizar(claveHMAC);
+        }
+        else {
+            std::memcpy(claveHMAC, frase.data(), frase.size());
+        }
+
+        ContextoSHA256 interno, externo;
+        uint8_t relleno[64];
+        for (int i = 0; i < 64; ++i) relleno[i] = static_cast<uint8_t>(claveHMAC[i] ^ 0x36);
+        interno.actualizar(relleno, sizeof(relleno));
+        for (int i = 0; i < 64; ++i) relleno[i] = static_cast<uint8_t>(claveHMAC[i] ^ 0x5c);
+        externo.actualizar(relleno, sizeof(relleno));
+
+        auto hmac = [&](const uint8_t* datos, size_t longitud, uint8_t salida[32]) {
+            uint8_t intermedio[32];
+            ContextoSHA256 contexto = interno;
+            contexto.actualizar(datos, longitud);
+            contexto.finalizar(intermedio);
+            contexto = externo;
+            contexto.actualizar(intermedio, sizeof(intermedio));
+            contexto.finalizar(salida);
+        };
+
+        // U1 = HMAC(frase, sal || 1); Ui = HMAC(frase, Ui-1); clave = U1 ^ ... ^ Un
+        uint8_t primero[20];
+        std::memcpy(primero, sal, 16);
+        primero[16] = 0;
+        primero[17] = 0;
+        primero[18] = 0;
+        primero[19] = 1;
+        uint8_t u[32];
+        hmac(primero, sizeof(primero), u);
+        std::memcpy(clave, u, 32);
+        for (uint32_t i = 1; i < iteraciones; ++i) {
+            hmac(u, sizeof(u), u);
+            for (int j = 0; j < 32; ++j) clave[j] ^= u[j];
+        }
+    }
+
+    /**
+     * @brief Construye el nonce de un bloque: prefijo aleatorio + ndice de bloque
+     */
+    void nonceDeBloque(const uint8_t prefijo[4], uint64_t indice, uint8_t nonce[12]) {
+        std::memcpy(nonce, prefijo, 4);
+        for (int i = 0; i < 8; ++i) nonce[4 + i] = static_cast<uint8_t>(indice >> (8 * i));
+    }
+
+    /**
+     * @brief Calcula el verificador de clave: etiqueta AEAD vaca sobre la cabecera
+     *
+     * Usa el ndice reservado 2^64-1, que nunca corresponde a un bloque de datos.
+     */
+    void calcularVerificador(const uint8_t clave[32], const CabeceraV2& cabecera, uint8_t verificador[16]) {
+        uint8_t bytes[TAM_CABECERA_V2];
+        cabecera.serializar(bytes);
+        uint8_t nonce[12];
+        nonceDeBloque(cabecera.prefijoNonce, ~static_cast<uint64_t>(0), nonce);
+        ChaCha20Poly1305::sellar(clave, nonce, bytes, 48, nullptr, nullptr, 0, verificador);
+    }
+}
 
  /**
   * @brief Cifra un archivo usando el algoritmo Csar
@@ -17,6 +225,7 @@
   * @throws std::runtime_error Si hay problemas al abrir los archivos
   */
 void Cifrado::CifrarArchivo(const std::string& rutaEntrada, const std::string& rutaSalida, char clave) {
+    MEDIR_OPERACION(Operacion::CifrarArchivo);
     std::ifstream archivoEntrada(rutaEntrada, std::ios::binary);
     if (!archivoEntrada) {
         throw std::runtime_error("Error al abrir el archivo de entrada.");
@@ -51,6 +260,7 @@ void Cifrado::CifrarArchivo(const std::string& rutaEntrada, const std::string& r
  * @throws std::runtime_error Si hay problemas al abrir los archivos
  */
 void Cifrado::desifrarArchivo(const std::string& rutaEntrada, const std::string& rutaSalida, char clave) {
+    MEDIR_OPERACION(Operacion::DescifrarArchivo);
     std::ifstream archivoEntrada(rutaEntrada, std::ios::binary);
     if (!archivoEntrada) {
         throw std::runtime_error("Error al abrir el archivo de entrada.");
@@ -76,6 +286,245 @@ void Cifrado::desifrarArchivo(const std::string& rutaEntrada, const std::string&
     archivoSalida.close();
 }
 
+/**
+ * @brief Cifra un archivo con el formato .bin versin 2
+ *
+ * Escribe la cabecera y luego el archivo en bloques de tamao fijo, cada uno
+ * seguido de su etiqueta Poly1305. Los bloques se leen por lotes y se sellan
+ * en paralelo, por lo que la memoria usada no depende del tamao del archivo.
+ *
+ * @param rutaEntrada Ruta del archivo original a cifrar
+ * @param rutaSalida Ruta donde se guardar el archivo cifrado
+ * @param clave Frase clave de cifrado
+ * @param hilos Nmero de hilos (0 = todos los ncleos)
+ * @param tamBloque Tamao de cada bloque de texto plano
+ * @throws std::runtime_error Si hay problemas con los archivos o la clave est vaca
+ */
+void Cifrado::CifrarArchivoV2(const std::string& rutaEntrada, const std::string& rutaSalida,
+    const std::string& clave, unsigned int hilos, uint32_t tamBloque) {
+    MEDIR_OPERACION(Operacion::CifrarArchivo);
+    if (clave.empty()) {
+        throw std::runtime_error("La clave de cifrado no puede estar vacia.");
+    }
+    if (tamBloque == 0 || tamBloque > TAM_BLOQUE_MAXIMO_V2) {
+        throw std::runtime_error("Tamano de bloque invalido.");
+    }
+
+    std::ifstream archivoEntrada(rutaEntrada, std::ios::binary | std::ios::ate);
+    if (!archivoEntrada) {
+        throw std::runtime_error("Error al abrir el archivo de entrada.");
+    }
+    uint64_t tamTotal = static_cast<uint64_t>(archivoEntrada.tellg());
+    archivoEntrada.seekg(0);
+
+    SalidaTemporal salidaTemporal(rutaSalida);
+    std::ofstream archivoSalida(salidaTemporal.ruta(), std::ios::binary);
+    if (!archivoSalida) {
+        throw std::runtime_error("Error al abrir el archivo de salida.");
+    }
+
+    CabeceraV2 cabecera;
+    cabecera.tamBloque = tamBloque;
+    cabecera.tamTotal = tamTotal;
+    std::random_device aleatorio;
+    for (int i = 0; i < 4; ++i) cabecera.prefijoNonce[i] = static_cast<uint8_t>(aleatorio());
+    for (int i = 0; i < 16; ++i) cabecera.sal[i] = static_cast<uint8_t>(aleatorio());
+
+    uint8_t claveDerivada[32];
+    derivarClave(clave, cabecera.sal, cabecera.iteraciones, claveDerivada);
+    calcularVerificador(claveDerivada, cabecera, cabecera.verificador);
+
+    uint8_t bytesCabecera[TAM_CABECERA_V2];
+    cabecera.serializar(bytesCabecera);
+    archivoSalida.write(reinterpret_cast<const char*>(bytesCabecera), TAM_CABECERA_V2);
+
+    hilos = Paralelo::resolverHilos(hilos);
+    const size_t bloquesPorLote = hilos * BLOQUES_POR_HILO;
+    const size_t tamSellado = static_cast<size_t>(tamBloque) + ChaCha20Poly1305::TAM_ETIQUETA;
+    std::vector<uint8_t> entrada(bloquesPorLote * tamBloque);
+    std::vector<uint8_t> salida(bloquesPorLote * tamSellado);
+
+    uint64_t totalBloques = (tamTotal + tamBloque - 1) / tamBloque;
+    uint64_t bloqueBase = 0;
+    while (bloqueBase < totalBloques) {
+        uint64_t restantes = totalBloques - bloqueBase;
+        size_t enLote = static_cast<size_t>(restantes < bloquesPorLote ? restantes : bloquesPorLote);
+        uint64_t inicioLote = bloqueBase * tamBloque;
+        size_t bytesLote = static_cast<size_t>(std::min<uint64_t>(static_cast<uint64_t>(enLote) * tamBloque, tamTotal - inicioLote));
+
+        if (!archivoEntrada.read(reinterpret_cast<char*>(entrada.data()), bytesLote)) {
+            throw std::runtime_error("Error al leer el archivo de entrada.");
+        }
+
+        Paralelo::ejecutar(enLote, hilos, [&](size_t i) {
+            size_t desplazamiento = i * tamBloque;
+            size_t longitud = std::min<size_t>(tamBloque, bytesLote - desplazamiento);
+            uint8_t nonce[12];
+            nonceDeBloque(cabecera.prefijoNonce, bloqueBase + i, nonce);
+            uint8_t* destino = salida.data() + i * tamSellado;
+            ChaCha20Poly1305::sellar(claveDerivada, nonce, bytesCabecera, 48,
+                entrada.data() + desplazamiento, destino, longitud, destino + longitud);
+            return true;
+        });
+
+        // Solo el ultimo bloque puede ser corto, asi que el lote sellado es contiguo
+        size_t bytesSalida = bytesLote + enLote * ChaCha20Poly1305::TAM_ETIQUETA;
+        archivoSalida.write(reinterpret_cast<const char*>(salida.data()), bytesSalida);
+        if (!archivoSalida) {
+            throw std::runtime_error("Error al escribir el archivo de salida.");
+        }
+        bloqueBase += enLote;
+    }
+
+    archivoEntrada.close();
+    archivoSalida.close();
+    if (!archivoSalida) {
+        throw std::runtime_error("Error al escribir el archivo de salida.");
+    }
+    salidaTemporal.confirmar();
+}
+
+/**
+ * @brief Descifra un archivo .bin versin 2
+ *
+ * Antes de derivar la clave o reservar memoria comprueba que el tamao de bloque
+ * y las iteraciones de la cabecera estn en rango, porque la cabecera todava no
+ * est autenticada. Luego verifica la clave con el verificador de la cabecera y
+ * abre los bloques por lotes en paralelo. Ante el primer bloque alterado se
+ * detiene, descarta la salida parcial e informa el rango de bytes afectado.
+ *
+ * @param rutaEntrada Ruta del archivo cifrado
+ * @param rutaSalida Ruta donde se guardar el archivo descifrado
+ * @param clave Frase clave usada al cifrar
+ * @param hilos Nmero de hilos (0 = todos los ncleos)
+ * @throws std::runtime_error Si la clave es incorrecta o el archivo fue alterado
+ */
+void Cifrado::DescifrarArchivoV2(const std::string& rutaEntrada, const std::string& rutaSalida,
+    const std::string& clave, unsigned int hilos) {
+    MEDIR_OPERACION(Operacion::DescifrarArchivo);
+    std::ifstream archivoEntrada(rutaEntrada, std::ios::binary | std::ios::ate);
+    if (!archivoEntrada) {
+        throw std::runtime_error("Error al abrir el archivo de entrada.");
+    }
+    uint64_t tamArchivo = static_cast<uint64_t>(archivoEntrada.tellg());
+    archivoEntrada.seekg(0);
+
+    uint8_t bytesCabecera[TAM_CABECERA_V2];
+    CabeceraV2 cabecera;
+    if (tamArchivo < TAM_CABECERA_V2 ||
+        !archivoEntrada.read(reinterpret_cast<char*>(bytesCabecera), TAM_CABECERA_V2) ||
+        !cabecera.deserializar(bytesCabecera)) {
+        throw std::runtime_error("El archivo no tiene formato .bin version 2.");
+    }
+    if (cabecera.version != 2 || cabecera.kdf != KDF_PBKDF2_SHA256) {
+        throw std::runtime_error("Version de archivo cifrado no soportada.");
+    }
+    if (cabecera.iteraciones < ITERACIONES_KDF || cabecera.iteraciones > ITERACIONES_KDF_MAXIMO ||
+        cabecera.tamBloque == 0 || cabecera.tamBloque > TAM_BLOQUE_MAXIMO_V2) {
+        throw std::runtime_error("Cabecera de archivo cifrado fuera de rango.");
+    }
+
+    const size_t tamSellado = static_cast<size_t>(cabecera.tamBloque) + ChaCha20Poly1305::TAM_ETIQUETA;
+    uint64_t totalBloques = (cabecera.tamTotal + cabecera.tamBloque - 1) / cabecera.tamBloque;
+    if (tamArchivo != TAM_CABECERA_V2 + cabecera.tamTotal + totalBloques * ChaCha20Poly1305::TAM_ETIQUETA) {
+        throw std::runtime_error("El archivo cifrado esta truncado o tiene datos de mas.");
+    }
+
+    uint8_t claveDerivada[32];
+    derivarClave(clave, cabecera.sal, cabecera.iteraciones, claveDerivada);
+    uint8_t verificador[16];
+    calcularVerificador(claveDerivada, cabecera, verificador);
+    uint8_t diferencia = 0;
+    for (int i = 0; i < 16; ++i) diferencia |= static_cast<uint8_t>(verificador[i] ^ cabecera.verificador[i]);
+    if (diferencia != 0) {
+        throw std::runtime_error("Clave incorrecta o cabecera alterada.");
+    }
+
+    SalidaTemporal salidaTemporal(rutaSalida);
+    std::ofstream archivoSalida(salidaTemporal.ruta(), std::ios::binary);
+    if (!archivoSalida) {
+        throw std::runtime_error("Error al abrir el archivo de salida.");
+    }
+
+    hilos = Paralelo::resolverHilos(hilos);
+    const size_t bloquesPorLote = hilos * BLOQUES_POR_HILO;
+    std::vector<uint8_t> entrada(bloquesPorLote * tamSellado);
+    std::vector<uint8_t> salida(bloquesPorLote * static_cast<size_t>(cabecera.tamBloque));
+
+    uint64_t bloqueBase = 0;
+    while (bloqueBase < totalBloques) {
+        uint64_t restantes = totalBloques - bloqueBase;
+        size_t enLote = static_cast<size_t>(restantes < bloquesPorLote ? restantes : bloquesPorLote);
+        uint64_t inicioLote = bloqueBase * cabecera.tamBloque;
+        size_t planoLote = static_cast<size_t>(std::min<uint64_t>(static_cast<uint64_t>(enLote) * cabecera.tamBloque, cabecera.tamTotal - inicioLote));
+        size_t bytesLote = planoLote + enLote * ChaCha20Poly1305::TAM_ETIQUETA;
+
+        if (!archivoEntrada.read(reinterpret_cast<char*>(entrada.data()), bytesLote)) {
+            throw std::runtime_error("Error al leer el archivo cifrado.");
+        }
+
+        size_t fallido = Paralelo::ejecutar(enLote, hilos, [&](size_t i) {
+            size_t longitud = std::min<size_t>(cabecera.tamBloque, planoLote - i * cabecera.tamBloque);
+            uint8_t nonce[12];
+            nonceDeBloque(cabecera.prefijoNonce, bloqueBase + i, nonce);
+            const uint8_t* origen = entrada.data() + i * tamSellado;
+            return ChaCha20Poly1305::abrir(claveDerivada, nonce, bytesCabecera, 48,
+                origen, salida.data() + i * cabecera.tamBloque, longitud, origen + longitud);
+        });
+
+        if (fallido < enLote) {
+            uint64_t inicio = (bloqueBase + fallido) * cabecera.tamBloque;
+            uint64_t fin = std::min<uint64_t>(inicio + cabecera.tamBloque, cabecera.tamTotal);
+            throw std::runtime_error("Archivo alterado: el bloque " + std::to_string(bloqueBase + fallido) +
+                " (bytes " + std::to_string(inicio) + "-" + std::to_string(fin) + ") no supero la verificacion.");
+        }
+
+        archivoSalida.write(reinterpret_cast<const char*>(salida.data()), planoLote);
+        if (!archivoSalida) {
+            throw std::runtime_error("Error al escribir el archivo de salida.");
+        }
+        bloqueBase += enLote;
+    }
+
+    archivoEntrada.close();
+    archivoSalida.close();
+    if (!archivoSalida) {
+        throw std::runtime_error("Error al escribir el archivo de salida.");
+    }
+    salidaTemporal.confirmar();
+}
+
+/**
+ * @brief Indica si un archivo comienza con la cabecera del formato .bin versin 2
+ *
+ * @param ruta Ruta del archivo a inspeccionar
+ * @return true si tiene la firma v2, false en caso contrario
+ */
+bool Cifrado::EsArchivoV2(const std::string& ruta) {
+    std::ifstream archivo(ruta, std::ios::binary);
+    char firma[8];
+    if (!archivo.read(firma, 8)) {
+        return false;
+    }
+    return std::memcmp(firma, FIRMA_V2, 8) == 0;
+}
+
+/**
+ * @brief Descifra un archivo .bin eligiendo el algoritmo segn su cabecera
+ *
+ * @param rutaEntrada Ruta del archivo cifrado
+ * @param rutaSalida Ruta del archivo descifrado
+ * @param clave Frase clave; los archivos antiguos solo usan su primer carcter
+ */
+void Cifrado::descifrarSegunFormato(const std::string& rutaEntrada, const std::string& rutaSalida, const std::string& clave) {
+    if (EsArchivoV2(rutaEntrada)) {
+        DescifrarArchivoV2(rutaEntrada, rutaSalida, clave);
+    }
+    else {
+        desifrarArchivo(rutaEntrada, rutaSalida, clave.empty() ? '\0' : clave[0]);
+    }
+}
+
 /**
  * @brief Guarda y cifra los datos del banco en un archivo
  *
@@ -86,7 +535,7 @@ void Cifrado::desifrarArchivo(const std::string& rutaEntrada, const std::string&
  * @param nombreArchivo Nombre del archivo de salida (sin extensin)
  * @param claveCifrado Clave de cifrado a utilizar
  */
-void Cifrado::cifrarYGuardarDatos(const Banco& banco, const std::string& nombreArchivo, char claveCifrado) {
+void Cifrado::cifrarYGuardarDatos(const Banco& banco, const std::string& nombreArchivo, const std::string& claveCifrado) {
     // Obtener la ruta del escritorio usando el metodo de Banco
     std::string rutaEscritorio = banco.obtenerRutaEscritorio();
 
@@ -100,7 +549,7 @@ void Cifrado::cifrarYGuardarDatos(const Banco& banco, const std::string& nombreA
 
     try {
         // Cifrar el archivo temporal y guardarlo en el archivo final
-        CifrarArchivo(rutaArchivoTemp, rutaDestino, claveCifrado);
+        CifrarArchivoV2(rutaArchivoTemp, rutaDestino, claveCifrado);
         std::cout << "Datos cifrados y guardados correctamente en " << rutaDestino << "\n";
 
         // Eliminar el archivo temporal despues de cifrar
@@ -121,7 +570,7 @@ void Cifrado::cifrarYGuardarDatos(const Banco& banco, const std::string& nombreA
  * @param claveCifrado Clave utilizada para el cifrado original
  * @return true si el proceso se complet exitosamente, false en caso contrario
  */
-bool Cifrado::descifrarYCargarDatos(Banco& banco, const std::string& nombreArchivo, char claveCifrado) {
+bool Cifrado::descifrarYCargarDatos(Banco& banco, const std::string& nombreArchivo, const std::string& claveCifrado) {
     // Obtener la ruta del escritorio usando el metodo de Banco
     std::string rutaEscritorio = banco.obtenerRutaEscritorio();
 
@@ -132,7 +581,7 @@ bool Cifrado::descifrarYCargarDatos(Banco& banco, const std::string& nombreArchi
 
     try {
         // Descifrar el archivo cifrado en un archivo temporal
-        desifrarArchivo(rutaOrigen, rutaArchivoTemp, claveCifrado);
+        descifrarSegunFormato(rutaOrigen, rutaArchivoTemp, claveCifrado);
 
         // Verificar que el archivo se descifro correctamente
         std::ifstream archivo(rutaArchivoTemp);
@@ -172,7 +621,7 @@ bool Cifrado::descifrarYCargarDatos(Banco& banco, const std::string& nombreArchi
  * @param opcion Formato de salida: 0 para .bak, 1 para .txt
  * @return true si el proceso se complet exitosamente, false en caso contrario
  */
-bool Cifrado::descifrarSinCargarDatos(const Banco& banco, const std::string& nombreArchivo, char claveCifrado, int opcion) {
+bool Cifrado::descifrarSinCargarDatos(const Banco& banco, const std::string& nombreArchivo, const std::string& claveCifrado, int opcion) {
     // Obtener la ruta del escritorio usando el metodo de Banco
     std::string rutaEscritorio = banco.obtenerRutaEscritorio();
     std::string rutaOrigen = rutaEscritorio + nombreArchivo + ".bin";
@@ -198,7 +647,7 @@ bool Cifrado::descifrarSinCargarDatos(const Banco& banco, const std::string& nom
 
     try {
         // Descifrar el archivo cifrado en un archivo temporal
-        desifrarArchivo(rutaOrigen, rutaArchivoTemp, claveCifrado);
+        descifrarSegunFormato(rutaOrigen, rutaArchivoTemp, claveCifrado);
 
         // Verificar que el archivo se descifro correctamente
         std::ifstream archivo(rutaArchivoTemp);
@@ -6,68 +6,118 @@
 #include <fstream>
 #include <iostream>
 #include <stdexcept>
+#include <cstdint>
 
 /**
  * @class Cifrado
  * @brief Clase que implementa funcionalidades de cifrado y descifrado de archivos
  *
  * Esta clase esttica proporciona mtodos para cifrar y descifrar archivos utilizando
- * el algoritmo XOR. Tambin contiene funcionalidades especficas para el manejo
- * de datos del banco, permitiendo cifrar, guardar, y recuperar informacin bancaria
- * de manera segura.
+ * un desplazamiento Csar (.bin versin 1). Tambin contiene funcionalidades
+ * especficas para el manejo de datos del banco, permitiendo cifrar, guardar, y
+ * recuperar informacin bancaria de manera segura.
+ *
+ * Los archivos .bin versin 2 usan ChaCha20-Poly1305, con la clave derivada de la
+ * frase por PBKDF2-HMAC-SHA256, sobre bloques de tamao fijo sellados de forma
+ * independiente, lo que permite cifrar y descifrar en paralelo y detectar
+ * cualquier alteracin. Los archivos .bin antiguos (Csar) se siguen leyendo.
  */
 class Cifrado {
 public:
+    /** @brief Tamao por defecto de cada bloque de texto plano en el formato v2 */
+    static const uint32_t TAM_BLOQUE_V2 = 1u << 20;
+
+    /** @brief Mayor tamao de bloque que se acepta al cifrar o al leer una cabecera v2 */
+    static const uint32_t TAM_BLOQUE_MAXIMO_V2 = 16u << 20;
+
     /**
-     * @brief Cifra un archivo usando el algoritmo XOR
+     * @brief Cifra un archivo usando el algoritmo Csar
      * @param rutaEntrada Ruta completa del archivo origen a cifrar
      * @param rutaSalida Ruta completa donde se guardar el archivo cifrado
-     * @param clave Carcter usado como clave de cifrado para el algoritmo XOR
+     * @param clave Carcter que determina el desplazamiento de cada byte
      *
-     * Este mtodo lee un archivo byte por byte, aplica una operacin XOR con la clave
-     * especificada, y guarda el resultado en un nuevo archivo.
+     * Este mtodo lee un archivo byte por byte, le suma el valor de la clave
+     * y guarda el resultado en un nuevo archivo.
      */
     static void CifrarArchivo(const std::string& rutaEntrada, const std::string& rutaSalida, char clave);
 
     /**
-     * @brief Descifra un archivo previamente cifrado con el algoritmo XOR
+     * @brief Descifra un archivo previamente cifrado con el algoritmo Csar
      * @param rutaEntrada Ruta completa del archivo cifrado
      * @param rutaSalida Ruta completa donde se guardar el archivo descifrado
      * @param valor Carcter usado como clave de descifrado (debe ser el mismo usado para cifrar)
      *
-     * Este mtodo invierte el proceso de cifrado, aplicando XOR con la misma clave
-     * para recuperar el contenido original.
+     * Este mtodo invierte el proceso de cifrado, restando a cada byte la misma
+     * clave para recuperar el contenido original.
      */
     static void desifrarArchivo(const std::string& rutaEntrada, const std::string& rutaSalida, char valor);
 
+    /**
+     * @brief Cifra un archivo con el formato .bin versin 2 (ChaCha20-Poly1305 por bloques)
+     * @param rutaEntrada Ruta completa del archivo origen a cifrar
+     * @param rutaSalida Ruta completa donde se guardar el archivo cifrado
+     * @param clave Frase clave de la que se deriva la clave de 256 bits
+     * @param hilos Nmero de hilos a usar (0 = todos los ncleos disponibles)
+     * @param tamBloque Tamao de cada bloque de texto plano en bytes (1 a TAM_BLOQUE_MAXIMO_V2)
+     * @throws std::runtime_error Si hay problemas al abrir, leer o escribir los archivos
+     *
+     * El archivo se divide en bloques de tamao fijo que se sellan de forma independiente,
+     * cada uno con su propio nonce y etiqueta de autenticacin, y se procesan en lotes
+     * repartidos entre los hilos para acotar el uso de memoria. Se escribe en
+     * rutaSalida + ".tmp", que reemplaza a rutaSalida solo si todo termina bien.
+     */
+    static void CifrarArchivoV2(const std::string& rutaEntrada, const std::string& rutaSalida,
+        const std::string& clave, unsigned int hilos = 0, uint32_t tamBloque = TAM_BLOQUE_V2);
+
+    /**
+     * @brief Descifra un archivo .bin versin 2 verificando la integridad de cada bloque
+     * @param rutaEntrada Ruta completa del archivo cifrado
+     * @param rutaSalida Ruta completa donde se guardar el archivo descifrado
+     * @param clave Frase clave usada al cifrar
+     * @param hilos Nmero de hilos a usar (0 = todos los ncleos disponibles)
+     * @throws std::runtime_error Si la clave es incorrecta, la cabecera pide un bloque o
+     *         un nmero de iteraciones fuera de rango, el archivo est truncado o algn
+     *         bloque fue alterado; en ese caso rutaSalida queda como estaba
+     */
+    static void DescifrarArchivoV2(const std::string& rutaEntrada, const std::string& rutaSalida,
+        const std::string& clave, unsigned int hilos = 0);
+
+    /**
+     * @brief Indica si un archivo tiene la cabecera del formato .bin versin 2
+     * @param ruta Ruta completa del archivo
+     * @return true si el archivo comienza con la cabecera v2, false en caso contrario
+     */
+    static bool EsArchivoV2(const std::string& ruta);
+
     /**
      * @brief Cifra y guarda los datos del banco en un archivo binario
      * @param banco Referencia al objeto Banco cuyos datos sern cifrados
      * @param nombreArchivo Nombre base del archivo (sin extensin) donde guardar los datos
-     * @param claveCifrado Carcter usado como clave de cifrado
+     * @param claveCifrado Frase clave de cifrado
      *
      * Este mtodo serializa los datos del banco a un archivo temporal, luego
-     * cifra este archivo y guarda el resultado como un archivo binario (.bin).
+     * cifra este archivo y guarda el resultado como un archivo binario (.bin) versin 2.
      */
-    static void cifrarYGuardarDatos(const class Banco& banco, const std::string& nombreArchivo, char claveCifrado);
+    static void cifrarYGuardarDatos(const class Banco& banco, const std::string& nombreArchivo, const std::string& claveCifrado);
 
     /**
      * @brief Descifra y carga datos desde un archivo binario al objeto Banco
      * @param banco Referencia al objeto Banco donde se cargarn los datos descifrados
      * @param nombreArchivo Nombre base del archivo cifrado (sin extensin) a cargar
-     * @param claveCifrado Carcter usado como clave de descifrado
+     * @param claveCifrado Frase clave de descifrado
      * @return true si el proceso fue exitoso, false en caso contrario
      *
      * Este mtodo descifra el archivo binario especificado y carga los datos
-     * recuperados en el objeto Banco proporcionado.
+     * recuperados en el objeto Banco proporcionado. Acepta tanto el formato v2
+     * como el formato antiguo, en cuyo caso se usa el primer carcter de la clave.
      */
-    static bool descifrarYCargarDatos(class Banco& banco, const std::string& nombreArchivo, char claveCifrado);
+    static bool descifrarYCargarDatos(class Banco& banco, const std::string& nombreArchivo, const std::string& claveCifrado);
 
     /**
      * @brief Descifra un archivo sin cargar los datos al banco
      * @param banco Referencia al objeto Banco (usado para obtener rutas)
      * @param nombreArchivo Nombre base del archivo cifrado (sin extensin) a descifrar
-     * @param claveCifrado Carcter usado como clave de descifrado
+     * @param claveCifrado Frase clave de descifrado
      * @param opcion Tipo de archivo de salida: 0 para .bak, 1 para .txt
      * @return true si el proceso fue exitoso, false en caso contrario
      *
@@ -75,7 +125,16 @@ public:
      * en un nuevo archivo, sin modificar el estado del objeto Banco.
      * La opcin determina si se genera un archivo de backup (.bak) o texto (.txt).
      */
-    static bool descifrarSinCargarDatos(const Banco& banco, const std::string& nombreArchivo, char claveCifrado, int opcion);
+    static bool descifrarSinCargarDatos(const Banco& banco, const std::string& nombreArchivo, const std::string& claveCifrado, int opcion);
+
+private:
+    /**
+     * @brief Descifra un archivo .bin detectando si es versin 2 o formato antiguo
+     * @param rutaEntrada Ruta completa del archivo cifrado
+     * @param rutaSalida Ruta completa del archivo descifrado
+     * @param clave Frase clave (en formato antiguo solo se usa su primer carcter)
+     */
+    static void descifrarSegunFormato(const std::string& rutaEntrada, const std::string& rutaSalida, const std::string& clave);
 };
 
 #endif // CIFRADO_H
\ No newline at end of file
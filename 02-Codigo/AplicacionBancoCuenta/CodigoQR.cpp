@@ -12,11 +12,28 @@
 #include <cstddef>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
+#include <mutex>
 #include <sstream>
 #include <utility>
 #include "CodigoQR.h"
+#include "Paralelo.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
 
 using std::int8_t;
+using std::uint32_t;
 using std::uint8_t;
 using std::size_t;
 using std::vector;
@@ -182,6 +199,101 @@ namespace CodigoQR {
 		return result;
 	}
 
+	/**
+	 * @brief Divide un texto en segmentos con la menor longitud total en bits
+	 *
+	 * Programación dinámica sobre los caracteres: para cada posición se guarda el
+	 * coste mínimo de terminar en cada modo (bytes, alfanumérico, numérico), en
+	 * sextos de bit para que 5,5 bits por carácter alfanumérico y 10/3 por dígito
+	 * sean enteros. Cambiar de modo redondea el segmento anterior a bits enteros
+	 * y suma la cabecera del nuevo. Después se recorre hacia atrás para recuperar
+	 * el modo de cada carácter y se agrupan los caracteres contiguos del mismo modo.
+	 *
+	 * @param text Cadena de caracteres a codificar
+	 * @param version Versión del código QR (fija el ancho de los contadores)
+	 * @return Vector de segmentos QR de longitud mínima
+	 * @throws std::invalid_argument Si la versión está fuera de rango
+	 */
+	vector<QrSegment> QrSegment::makeSegmentsOptimally(const char* text, int version) {
+		if (version < QrCode::MIN_VERSION || version > QrCode::MAX_VERSION)
+			throw std::invalid_argument("Invalid value");
+		vector<QrSegment> result;
+		size_t length = std::strlen(text);
+		if (length == 0)
+			return result;
+
+		const int NUM_MODES = 3;
+		const Mode* const modes[NUM_MODES] = { &Mode::BYTE, &Mode::ALPHANUMERIC, &Mode::NUMERIC };
+		int headCosts[NUM_MODES];
+		for (int j = 0; j < NUM_MODES; j++)
+			headCosts[j] = (4 + modes[j]->numCharCountBits(version)) * 6;
+
+		// fromMode[i * NUM_MODES + j]: modo del carácter i si tras él se está en el modo j (-1 = imposible)
+		vector<int8_t> fromMode(length * NUM_MODES, -1);
+		int prevCosts[NUM_MODES] = { headCosts[0], headCosts[1], headCosts[2] };
+		for (size_t i = 0; i < length; i++) {
+			char c = text[i];
+			int8_t* charModes = &fromMode[i * NUM_MODES];
+			int curCosts[NUM_MODES] = { 0, 0, 0 };
+
+			// Extender el segmento actual si el carácter se puede codificar en su modo
+			curCosts[0] = prevCosts[0] + 8 * 6;
+			charModes[0] = 0;
+			if (std::strchr(ALPHANUMERIC_CHARSET, c) != nullptr) {
+				curCosts[1] = prevCosts[1] + 33;
+				charModes[1] = 1;
+			}
+			if (c >= '0' && c <= '9') {
+				curCosts[2] = prevCosts[2] + 20;
+				charModes[2] = 2;
+			}
+
+			// Empezar un segmento nuevo tras este carácter para cambiar de modo
+			int extendedCosts[NUM_MODES] = { curCosts[0], curCosts[1], curCosts[2] };
+			int8_t extendedModes[NUM_MODES] = { charModes[0], charModes[1], charModes[2] };
+			for (int j = 0; j < NUM_MODES; j++) {  // Modo de destino
+				for (int k = 0; k < NUM_MODES; k++) {  // Modo de origen
+					if (extendedModes[k] == -1)
+						continue;
+					int newCost = (extendedCosts[k] + 5) / 6 * 6 + headCosts[j];
+					if (charModes[j] == -1 || newCost < curCosts[j]) {
+						curCosts[j] = newCost;
+						charModes[j] = extendedModes[k];
+					}
+				}
+			}
+			std::copy(curCosts, curCosts + NUM_MODES, prevCosts);
+		}
+
+		// Modo final más barato y recorrido hacia atrás
+		int curMode = 0;
+		for (int j = 1; j < NUM_MODES; j++) {
+			if (prevCosts[j] < prevCosts[curMode])
+				curMode = j;
+		}
+		vector<int8_t> charModes(length);
+		for (size_t i = length; i-- > 0;) {
+			curMode = fromMode[i * NUM_MODES + curMode];
+			charModes[i] = static_cast<int8_t>(curMode);
+		}
+
+		// Agrupar los caracteres contiguos del mismo modo
+		for (size_t inicio = 0; inicio < length;) {
+			size_t fin = inicio + 1;
+			while (fin < length && charModes[fin] == charModes[inicio])
+				fin++;
+			std::string parte(text + inicio, fin - inicio);
+			if (charModes[inicio] == 2)
+				result.push_back(makeNumeric(parte.c_str()));
+			else if (charModes[inicio] == 1)
+				result.push_back(makeAlphanumeric(parte.c_str()));
+			else
+				result.push_back(makeBytes(vector<uint8_t>(parte.begin(), parte.end())));
+			inicio = fin;
+		}
+		return result;
+	}
+
 	/**
 	 * @brief Crea un segmento ECI con el valor de asignación especificado
 	 *
@@ -209,14 +321,14 @@ namespace CodigoQR {
 	}
 
 	/**
-	 * @brief Constructor de QrSegment con vector de bool
+	 * @brief Constructor de QrSegment con un buffer de bits
 	 *
 	 * @param md Modo de codificación del segmento
 	 * @param numCh Número de caracteres representados
-	 * @param dt Vector de bits que contiene los datos codificados
+	 * @param dt Buffer de bits que contiene los datos codificados
 	 * @throws std::domain_error Si el número de caracteres es negativo
 	 */
-	QrSegment::QrSegment(const Mode& md, int numCh, const std::vector<bool>& dt) :
+	QrSegment::QrSegment(const Mode& md, int numCh, const BitBuffer& dt) :
 		mode(&md),
 		numChars(numCh),
 		data(dt) {
@@ -229,10 +341,10 @@ namespace CodigoQR {
 	 *
 	 * @param md Modo de codificación del segmento
 	 * @param numCh Número de caracteres representados
-	 * @param dt Vector de bits que contiene los datos codificados (movido)
+	 * @param dt Buffer de bits que contiene los datos codificados (movido)
 	 * @throws std::domain_error Si el número de caracteres es negativo
 	 */
-	QrSegment::QrSegment(const Mode& md, int numCh, std::vector<bool>&& dt) :
+	QrSegment::QrSegment(const Mode& md, int numCh, BitBuffer&& dt) :
 		mode(&md),
 		numChars(numCh),
 		data(std::move(dt)) {
@@ -313,9 +425,9 @@ namespace CodigoQR {
 	/**
 	 * @brief Obtiene los datos binarios del segmento
 	 *
-	 * @return Referencia al vector de bits
+	 * @return Referencia al buffer de bits
 	 */
-	const std::vector<bool>& QrSegment::getData() const {
+	const BitBuffer& QrSegment::getData() const {
 		return data;
 	}
 
@@ -326,6 +438,274 @@ namespace CodigoQR {
 
 
 
+	/*---- Class BitMatrix ----*/
+
+	namespace {
+
+		/**
+		 * @brief Cuenta los bits en 1 de una palabra
+		 *
+		 * @param v Palabra de 64 bits
+		 * @return Número de bits activos
+		 */
+		inline int popcount64(std::uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+			return __builtin_popcountll(v);
+#else
+			v = v - ((v >> 1) & 0x5555555555555555ULL);
+			v = (v & 0x3333333333333333ULL) + ((v >> 2) & 0x3333333333333333ULL);
+			v = (v + (v >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+			return static_cast<int>((v * 0x0101010101010101ULL) >> 56);
+#endif
+		}
+
+		/**
+		 * @brief Posición del bit en 1 menos significativo
+		 *
+		 * @param v Palabra de 64 bits distinta de 0
+		 * @return Número de ceros a la derecha del primer bit activo
+		 */
+		inline int trailingZeros64(std::uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+			return __builtin_ctzll(v);
+#elif defined(_MSC_VER) && defined(_M_X64)
+			unsigned long index;
+			_BitScanForward64(&index, v);
+			return static_cast<int>(index);
+#else
+			return popcount64((v & (0 - v)) - 1);
+#endif
+		}
+
+		/**
+		 * @brief Traspone en el lugar un bloque de 64x64 bits
+		 *
+		 * El bit j de block[i] pasa a ser el bit i de block[j]. Se intercambian
+		 * submatrices de 32, 16, ..., 1 bits en seis pasadas.
+		 *
+		 * @param block Las 64 filas del bloque
+		 */
+		void transpose64(std::uint64_t block[64]) {
+			std::uint64_t m = 0x00000000FFFFFFFFULL;
+			for (int j = 32; j != 0; j >>= 1, m ^= (m << j)) {
+				for (int k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+					std::uint64_t t = ((block[k] >> j) ^ block[k | j]) & m;
+					block[k] ^= t << j;
+					block[k | j] ^= t;
+				}
+			}
+		}
+
+	}
+
+	/**
+	 * @brief Constructor de una matriz vacía
+	 */
+	BitMatrix::BitMatrix() :
+		size(0),
+		wordsPerRow(0) {}
+
+	/**
+	 * @brief Constructor de una matriz cuadrada con todos los bits en 0
+	 *
+	 * @param sz Ancho y alto en bits
+	 */
+	BitMatrix::BitMatrix(int sz) :
+		size(sz),
+		wordsPerRow((sz + 63) / 64),
+		words(static_cast<size_t>(wordsPerRow) * static_cast<size_t>(sz)) {}
+
+	/**
+	 * @brief Cuenta los bits en 1 de la matriz, una palabra a la vez
+	 *
+	 * @return Número de bits activos
+	 */
+	long BitMatrix::countOnes() const {
+		long total = 0;
+		for (std::uint64_t word : words)
+			total += popcount64(word);
+		return total;
+	}
+
+	/**
+	 * @brief Calcula la matriz traspuesta
+	 *
+	 * Se recorre la matriz en bloques de 64x64 bits; cada bloque se traspone
+	 * con operaciones por palabra y se escribe en la posición simétrica.
+	 *
+	 * @return Matriz traspuesta
+	 */
+	BitMatrix BitMatrix::transpose() const {
+		BitMatrix result(size);
+		std::uint64_t block[64];
+		for (int bi = 0; bi < wordsPerRow; bi++) {  // Block row
+			for (int bj = 0; bj < wordsPerRow; bj++) {  // Block column
+				for (int r = 0; r < 64; r++) {
+					int y = bi * 64 + r;
+					block[r] = y < size ? words[static_cast<size_t>(y * wordsPerRow + bj)] : 0;
+				}
+				transpose64(block);
+				for (int r = 0; r < 64; r++) {
+					int y = bj * 64 + r;
+					if (y < size)
+						result.words[static_cast<size_t>(y * wordsPerRow + bi)] = block[r];
+				}
+			}
+		}
+		return result;
+	}
+
+	/**
+	 * @brief Libera la memoria de la matriz
+	 */
+	void BitMatrix::clear() {
+		size = 0;
+		wordsPerRow = 0;
+		std::vector<std::uint64_t>().swap(words);
+	}
+
+	namespace {
+
+		/**
+		 * @brief Obtiene el plano de un patrón de máscara para una versión
+		 *
+		 * El plano tiene en 1 los módulos que la máscara invierte. Se calcula una
+		 * sola vez por versión (de forma segura entre hilos) y luego se aplica con
+		 * un XOR por palabra.
+		 *
+		 * @param version Versión del código QR (1-40)
+		 * @param msk Patrón de máscara (0-7)
+		 * @return Plano de la máscara
+		 */
+		const BitMatrix& maskPlane(int version, int msk) {
+			static std::once_flag initialized[QrCode::MAX_VERSION + 1];
+			static BitMatrix planes[QrCode::MAX_VERSION + 1][8];
+			std::call_once(initialized[version], [version]() {
+				int sz = version * 4 + 17;
+				for (int m = 0; m < 8; m++) {
+					BitMatrix plane(sz);
+					for (size_t y = 0; y < static_cast<size_t>(sz); y++) {
+						for (size_t x = 0; x < static_cast<size_t>(sz); x++) {
+							bool invert;
+							switch (m) {
+							case 0:  invert = (x + y) % 2 == 0;                    break;
+							case 1:  invert = y % 2 == 0;                          break;
+							case 2:  invert = x % 3 == 0;                          break;
+							case 3:  invert = (x + y) % 3 == 0;                    break;
+							case 4:  invert = (x / 3 + y / 2) % 2 == 0;            break;
+							case 5:  invert = x * y % 2 + x * y % 3 == 0;          break;
+							case 6:  invert = (x * y % 2 + x * y % 3) % 2 == 0;    break;
+							case 7:  invert = ((x + y) % 2 + x * y % 3) % 2 == 0;  break;
+							default:  throw std::logic_error("Unreachable");
+							}
+							plane.set(static_cast<int>(x), static_cast<int>(y), invert);
+						}
+					}
+					planes[version][m] = std::move(plane);
+				}
+			});
+			return planes[version][msk];
+		}
+
+		/** @brief Hilos para evaluar las máscaras (0 = todos los núcleos disponibles) */
+		std::atomic<unsigned int> maskThreads(0);
+
+		/**
+		 * @struct GaloisTables
+		 * @brief Tablas de exponentes y logaritmos de GF(2^8/0x11D) con generador 0x02
+		 *
+		 * exp tiene 1024 entradas: las primeras 510 repiten el ciclo de 255 potencias
+		 * para no reducir módulo 255, y el resto vale 0. Como log[0] = 512, el producto
+		 * exp[log[x] + log[y]] da 0 sin ramas cuando x o y es 0.
+		 */
+		struct GaloisTables {
+			std::uint8_t exp[1024];
+			std::uint16_t log[256];
+		};
+
+		/**
+		 * @brief Construye las tablas de GF(256) en tiempo de compilación
+		 *
+		 * @return Tablas de exponentes y logaritmos
+		 */
+		constexpr GaloisTables buildGaloisTables() {
+			GaloisTables tables{};
+			int x = 1;
+			for (int i = 0; i < 255; i++) {
+				tables.exp[i] = static_cast<std::uint8_t>(x);
+				tables.exp[i + 255] = static_cast<std::uint8_t>(x);
+				tables.log[x] = static_cast<std::uint16_t>(i);
+				x <<= 1;
+				if (x & 0x100)
+					x ^= 0x11D;
+			}
+			tables.log[0] = 512;
+			return tables;
+		}
+
+		constexpr GaloisTables GALOIS = buildGaloisTables();
+
+		/**
+		 * @brief Multiplica dos elementos de GF(256) con las tablas de logaritmos
+		 */
+		inline std::uint8_t gfMultiply(std::uint8_t x, std::uint8_t y) {
+			return GALOIS.exp[GALOIS.log[x] + GALOIS.log[y]];
+		}
+
+		/**
+		 * @struct ReedSolomonGenerator
+		 * @brief Polinomio generador de un grado y sus productos precalculados
+		 *
+		 * products[f * grado + i] = divisor[i] * f, de modo que cada paso de la
+		 * división polinómica es un XOR de una fila de la tabla.
+		 */
+		struct ReedSolomonGenerator {
+			std::vector<std::uint8_t> divisor;
+			std::vector<std::uint8_t> products;
+		};
+
+		/**
+		 * @brief Obtiene el generador de un grado, calculándolo una sola vez
+		 *
+		 * @param degree Grado del polinomio (1-255)
+		 * @return Generador con sus productos precalculados
+		 */
+		const ReedSolomonGenerator& reedSolomonGenerator(int degree) {
+			static std::once_flag initialized[256];
+			static ReedSolomonGenerator generators[256];
+			std::call_once(initialized[degree], [degree]() {
+				ReedSolomonGenerator& generator = generators[degree];
+				size_t deg = static_cast<size_t>(degree);
+				// Polynomial coefficients are stored from highest to lowest power, excluding the leading term which is always 1.
+				// For example the polynomial x^3 + 255x^2 + 8x + 93 is stored as the uint8 array {255, 8, 93}.
+				generator.divisor.assign(deg, 0);
+				generator.divisor[deg - 1] = 1;  // Start off with the monomial x^0
+
+				// Compute the product polynomial (x - r^0) * (x - r^1) * (x - r^2) * ... * (x - r^{degree-1}),
+				// and drop the highest monomial term which is always 1x^degree.
+				// Note that r = 0x02, which is a generator element of this field GF(2^8/0x11D).
+				for (int i = 0; i < degree; i++) {
+					std::uint8_t root = GALOIS.exp[i];
+					for (size_t j = 0; j < deg; j++) {
+						generator.divisor[j] = gfMultiply(generator.divisor[j], root);
+						if (j + 1 < deg)
+							generator.divisor[j] ^= generator.divisor[j + 1];
+					}
+				}
+
+				generator.products.resize(256 * deg);
+				for (size_t factor = 0; factor < 256; factor++) {
+					for (size_t j = 0; j < deg; j++)
+						generator.products[factor * deg + j] = gfMultiply(generator.divisor[j], static_cast<std::uint8_t>(factor));
+				}
+			});
+			return generators[degree];
+		}
+
+	}
+
+
+
 	/*---- Class QrCode ----*/
 
 	/**
@@ -357,6 +737,29 @@ namespace CodigoQR {
 		return encodeSegments(segs, ecl);
 	}
 
+	/**
+	 * @brief Codifica texto en un código QR con segmentación óptima
+	 *
+	 * El ancho de los contadores de caracteres solo cambia en las versiones 10 y
+	 * 27, así que basta con calcular la segmentación tres veces como máximo.
+	 *
+	 * @param text Texto a codificar
+	 * @param ecl Nivel de corrección de errores
+	 * @return Objeto QrCode con la menor versión en la que cabe el texto
+	 * @throws data_too_long Si el texto no cabe en la versión 40
+	 */
+	QrCode QrCode::encodeTextOptimal(const char* text, Ecc ecl) {
+		vector<QrSegment> segs;
+		for (int version = MIN_VERSION; version <= MAX_VERSION; version++) {
+			if (version == MIN_VERSION || version == 10 || version == 27)
+				segs = QrSegment::makeSegmentsOptimally(text, version);
+			int dataUsedBits = QrSegment::getTotalBits(segs, version);
+			if (dataUsedBits != -1 && dataUsedBits <= getNumDataCodewords(version, ecl) * 8)
+				return encodeSegments(segs, ecl, version, version);
+		}
+		return encodeSegments(segs, ecl);  // Lanza data_too_long con el detalle
+	}
+
 	/**
 	 * @brief Codifica datos binarios en un código QR
 	 *
@@ -418,7 +821,7 @@ namespace CodigoQR {
 		for (const QrSegment& seg : segs) {
 			bb.appendBits(static_cast<uint32_t>(seg.getMode().getModeBits()), 4);
 			bb.appendBits(static_cast<uint32_t>(seg.getNumChars()), seg.getMode().numCharCountBits(version));
-			bb.insert(bb.end(), seg.getData().begin(), seg.getData().end());
+			bb.appendData(seg.getData());
 		}
 		assert(bb.size() == static_cast<unsigned int>(dataUsedBits));
 
@@ -433,10 +836,8 @@ namespace CodigoQR {
 		for (uint8_t padByte = 0xEC; bb.size() < dataCapacityBits; padByte ^= 0xEC ^ 0x11)
 			bb.appendBits(padByte, 8);
 
-		// Pack bits into bytes in big endian
-		vector<uint8_t> dataCodewords(bb.size() / 8);
-		for (size_t i = 0; i < bb.size(); i++)
-			dataCodewords.at(i >> 3) |= (bb.at(i) ? 1 : 0) << (7 - (i & 7));
+		// The buffer already stores bits in big endian order
+		vector<uint8_t> dataCodewords = bb.getBytes();
 
 		// Create the QR Code object
 		return QrCode(version, ecl, dataCodewords, mask);
@@ -460,36 +861,117 @@ namespace CodigoQR {
 		if (msk < -1 || msk > 7)
 			throw std::domain_error("Mask value out of range");
 		size = ver * 4 + 17;
-		size_t sz = static_cast<size_t>(size);
-		modules = vector<vector<bool> >(sz, vector<bool>(sz));  // Initially all light
-		isFunction = vector<vector<bool> >(sz, vector<bool>(sz));
+
+		// Start from the version template: function patterns drawn, data area light
+		const FunctionTemplate& functionTemplate = getFunctionTemplate(ver);
+		modules = functionTemplate.modules;
+		isFunction = functionTemplate.isFunction;
 
 		// Compute ECC, draw modules
-		drawFunctionPatterns();
 		const vector<uint8_t> allCodewords = addEccAndInterleave(dataCodewords);
-		drawCodewords(allCodewords);
+		drawCodewords(allCodewords, functionTemplate.dataPositions);
 
 		// Do masking
-		if (msk == -1) {  // Automatically choose best mask
-			long minPenalty = LONG_MAX;
-			for (int i = 0; i < 8; i++) {
-				applyMask(i);
-				drawFormatBits(i);
-				long penalty = getPenaltyScore();
-				if (penalty < minPenalty) {
-					msk = i;
-					minPenalty = penalty;
-				}
-				applyMask(i);  // Undoes the mask due to XOR
-			}
-		}
+		if (msk == -1)  // Automatically choose best mask
+			msk = chooseBestMask();
 		assert(0 <= msk && msk <= 7);
 		mask = msk;
-		applyMask(msk);  // Apply the final choice of mask
+		applyMask(msk, modules);  // Apply the final choice of mask
 		drawFormatBits(msk);  // Overwrite old format bits
 
 		isFunction.clear();
-		isFunction.shrink_to_fit();
+	}
+
+	/**
+	 * @brief Crea un código sin datos con solo los patrones de función dibujados
+	 *
+	 * Los bits de formato quedan con un valor provisional (nivel L, máscara 0); todo
+	 * código construido a partir de la plantilla los sobrescribe.
+	 *
+	 * @param ver Versión del código QR (1-40)
+	 */
+	QrCode::QrCode(int ver) :
+		version(ver),
+		size(ver * 4 + 17),
+		errorCorrectionLevel(Ecc::LOW),
+		mask(-1),
+		modules(ver * 4 + 17),
+		isFunction(ver * 4 + 17) {
+		drawFunctionPatterns();
+	}
+
+	/**
+	 * @brief Obtiene la plantilla de una versión
+	 *
+	 * Las 40 plantillas se calculan bajo demanda, una sola vez cada una, dibujando
+	 * los patrones de función (búsqueda, temporización, alineación, formato y
+	 * versión) y recorriendo el zigzag de colocación de datos.
+	 *
+	 * @param ver Versión del código QR (1-40)
+	 * @return Plantilla de la versión
+	 */
+	const QrCode::FunctionTemplate& QrCode::getFunctionTemplate(int ver) {
+		static std::once_flag initialized[MAX_VERSION + 1];
+		static FunctionTemplate templates[MAX_VERSION + 1];
+		std::call_once(initialized[ver], [ver]() {
+			QrCode blank(ver);
+			FunctionTemplate& functionTemplate = templates[ver];
+			functionTemplate.dataPositions = blank.computeDataPositions();
+			functionTemplate.modules = std::move(blank.modules);
+			functionTemplate.isFunction = std::move(blank.isFunction);
+		});
+		return templates[ver];
+	}
+
+	/**
+	 * @brief Elige el patrón de máscara con menor penalización
+	 *
+	 * Cada candidato se evalúa sobre su propia copia de la matriz (máscara, bits de
+	 * formato y penalización), por lo que los ocho pueden evaluarse en paralelo sin
+	 * deshacer cambios sobre una matriz compartida. Ante un empate gana la máscara
+	 * de menor índice, igual que en la evaluación en serie.
+	 *
+	 * @return Patrón de máscara elegido (0-7)
+	 */
+	int QrCode::chooseBestMask() const {
+		std::array<long, 8> penalties;
+		unsigned int threads = 1;
+		if (version >= MIN_PARALLEL_MASK_VERSION)  // Smaller codes finish before a thread starts
+			threads = std::min(8u, Paralelo::resolverHilos(maskThreads.load()));
+
+		Paralelo::ejecutar(penalties.size(), threads, [&](size_t i) {
+			int candidateMask = static_cast<int>(i);
+			BitMatrix candidate = modules;
+			applyMask(candidateMask, candidate);
+			placeFormatBits(computeFormatBits(candidateMask), candidate);
+			penalties[i] = getPenaltyScore(candidate);
+			return true;
+		});
+
+		int best = 0;
+		for (int i = 1; i < 8; i++) {
+			if (penalties[i] < penalties[best])
+				best = i;
+		}
+		return best;
+	}
+
+	/**
+	 * @brief Establece cuántos hilos se usan para evaluar las máscaras
+	 *
+	 * @param threads Número de hilos (0 = todos los núcleos disponibles, 1 = en serie)
+	 */
+	void QrCode::setMaskThreads(unsigned int threads) {
+		maskThreads = threads;
+	}
+
+	/**
+	 * @brief Obtiene cuántos hilos se usan para evaluar las máscaras
+	 *
+	 * @return Número de hilos configurado (0 = todos los núcleos disponibles)
+	 */
+	unsigned int QrCode::getMaskThreads() {
+		return maskThreads.load();
 	}
 
 	/**
@@ -539,6 +1021,18 @@ namespace CodigoQR {
 		return 0 <= x && x < size && 0 <= y && y < size && module(x, y);
 	}
 
+	/**
+	 * @brief Obtiene la matriz empaquetada de módulos
+	 *
+	 * Permite recorrer el código por palabras de 64 bits en lugar de
+	 * llamar a getModule módulo por módulo.
+	 *
+	 * @return Matriz de bits con los módulos (1=oscuro)
+	 */
+	const BitMatrix& QrCode::getModules() const {
+		return modules;
+	}
+
 	/**
 	 * @brief Dibuja los patrones de función fijos del código QR
 	 */
@@ -575,11 +1069,22 @@ namespace CodigoQR {
 	 *
 	 * Los bits de formato contienen información sobre el nivel de corrección de errores
 	 * y el patrón de máscara utilizado. Esta función dibuja estos bits en las posiciones
-	 * específicas requeridas por el estándar QR.
+	 * específicas requeridas por el estándar QR y las marca como módulos de función.
 	 *
 	 * @param msk Patrón de máscara a utilizar (0-7)
 	 */
 	void QrCode::drawFormatBits(int msk) {
+		placeFormatBits(computeFormatBits(msk), modules);
+		placeFormatBits(0x7FFF, isFunction);  // Every format position is a function module
+	}
+
+	/**
+	 * @brief Calcula los 15 bits de formato (nivel de corrección, máscara y BCH)
+	 *
+	 * @param msk Patrón de máscara (0-7)
+	 * @return Bits de formato ya enmascarados con 0x5412
+	 */
+	int QrCode::computeFormatBits(int msk) const {
 		// Calculate error correction code and pack bits
 		int data = getFormatBits(errorCorrectionLevel) << 3 | msk;  // errCorrLvl is uint2, msk is uint3
 		int rem = data;
@@ -587,22 +1092,31 @@ namespace CodigoQR {
 			rem = (rem << 1) ^ ((rem >> 9) * 0x537);
 		int bits = (data << 10 | rem) ^ 0x5412;  // uint15
 		assert(bits >> 15 == 0);
+		return bits;
+	}
 
+	/**
+	 * @brief Escribe las dos copias de los bits de formato en una matriz
+	 *
+	 * @param bits Bits de formato (15 bits)
+	 * @param target Matriz donde se escriben
+	 */
+	void QrCode::placeFormatBits(int bits, BitMatrix& target) const {
 		// Draw first copy
 		for (int i = 0; i <= 5; i++)
-			setFunctionModule(8, i, getBit(bits, i));
-		setFunctionModule(8, 7, getBit(bits, 6));
-		setFunctionModule(8, 8, getBit(bits, 7));
-		setFunctionModule(7, 8, getBit(bits, 8));
+			target.set(8, i, getBit(bits, i));
+		target.set(8, 7, getBit(bits, 6));
+		target.set(8, 8, getBit(bits, 7));
+		target.set(7, 8, getBit(bits, 8));
 		for (int i = 9; i < 15; i++)
-			setFunctionModule(14 - i, 8, getBit(bits, i));
+			target.set(14 - i, 8, getBit(bits, i));
 
 		// Draw second copy
 		for (int i = 0; i < 8; i++)
-			setFunctionModule(size - 1 - i, 8, getBit(bits, i));
+			target.set(size - 1 - i, 8, getBit(bits, i));
 		for (int i = 8; i < 15; i++)
-			setFunctionModule(8, size - 15 + i, getBit(bits, i));
-		setFunctionModule(8, size - 8, true);  // Always dark
+			target.set(8, size - 15 + i, getBit(bits, i));
+		target.set(8, size - 8, true);  // Always dark
 	}
 
 	/**
@@ -679,10 +1193,8 @@ namespace CodigoQR {
 	 * @param isDark True para un módulo oscuro, false para un módulo claro
 	 */
 	void QrCode::setFunctionModule(int x, int y, bool isDark) {
-		size_t ux = static_cast<size_t>(x);
-		size_t uy = static_cast<size_t>(y);
-		modules.at(uy).at(ux) = isDark;
-		isFunction.at(uy).at(ux) = true;
+		modules.set(x, y, isDark);
+		isFunction.set(x, y, true);
 	}
 
 	/**
@@ -693,7 +1205,7 @@ namespace CodigoQR {
 	 * @return true si el módulo es oscuro, false si es claro
 	 */
 	bool QrCode::module(int x, int y) const {
-		return modules.at(static_cast<size_t>(y)).at(static_cast<size_t>(x));
+		return modules.get(x, y);
 	}
 
 	/**
@@ -701,6 +1213,7 @@ namespace CodigoQR {
 	 *
 	 * Esta función implementa el algoritmo Reed-Solomon para generar códigos
 	 * de corrección de errores y luego entrelaza los bloques según el estándar QR.
+	 * Cada byte se escribe directamente en su posición final, sin copias por bloque.
 	 *
 	 * @param data Vector de bytes con los datos originales
 	 * @return Vector de bytes con datos y códigos de corrección entrelazados
@@ -716,98 +1229,106 @@ namespace CodigoQR {
 		int rawCodewords = getNumRawDataModules(version) / 8;
 		int numShortBlocks = numBlocks - rawCodewords % numBlocks;
 		int shortBlockLen = rawCodewords / numBlocks;
-
-		// Split data into blocks and append ECC to each block
-		vector<vector<uint8_t> > blocks;
-		const vector<uint8_t> rsDiv = reedSolomonComputeDivisor(blockEccLen);
-		for (int i = 0, k = 0; i < numBlocks; i++) {
-			vector<uint8_t> dat(data.cbegin() + k, data.cbegin() + (k + shortBlockLen - blockEccLen + (i < numShortBlocks ? 0 : 1)));
-			k += static_cast<int>(dat.size());
-			const vector<uint8_t> ecc = reedSolomonComputeRemainder(dat, rsDiv);
-			if (i < numShortBlocks)
-				dat.push_back(0);
-			dat.insert(dat.end(), ecc.cbegin(), ecc.cend());
-			blocks.push_back(std::move(dat));
+		int shortDataLen = shortBlockLen - blockEccLen;
+		size_t numDataCodewords = data.size();
+
+		// Split data into blocks, compute each block's ECC and write every byte straight to
+		// its interleaved position: byte k of block j goes to k * numBlocks + j, except the
+		// extra data byte of long blocks, which follows the data bytes common to all blocks
+		vector<uint8_t> result(static_cast<size_t>(rawCodewords));
+		uint8_t ecc[255];
+		for (int j = 0, k = 0; j < numBlocks; j++) {
+			int datLen = shortDataLen + (j < numShortBlocks ? 0 : 1);
+			reedSolomonComputeRemainder(&data[static_cast<size_t>(k)], static_cast<size_t>(datLen), blockEccLen, ecc);
+			for (int i = 0; i < shortDataLen; i++)
+				result[static_cast<size_t>(i * numBlocks + j)] = data[static_cast<size_t>(k + i)];
+			if (j >= numShortBlocks)
+				result[static_cast<size_t>(shortDataLen * numBlocks + j - numShortBlocks)] = data[static_cast<size_t>(k + shortDataLen)];
+			for (int i = 0; i < blockEccLen; i++)
+				result[numDataCodewords + static_cast<size_t>(i * numBlocks + j)] = ecc[i];
+			k += datLen;
 		}
-
-		// Interleave (not concatenate) the bytes from every block into a single sequence
-		vector<uint8_t> result;
-		for (size_t i = 0; i < blocks.at(0).size(); i++) {
-			for (size_t j = 0; j < blocks.size(); j++) {
-				// Skip the padding byte in short blocks
-				if (i != static_cast<unsigned int>(shortBlockLen - blockEccLen) || j >= static_cast<unsigned int>(numShortBlocks))
-					result.push_back(blocks.at(j).at(i));
-			}
-		}
-		assert(result.size() == static_cast<unsigned int>(rawCodewords));
 		return result;
 	}
 
 	/**
-	 * @brief Dibuja los codewords (bytes de datos y corrección) en el código QR
+	 * @brief Calcula el orden de colocación de los bits de datos
 	 *
-	 * Coloca los datos en el código QR siguiendo el patrón de zigzag
-	 * definido por el estándar.
+	 * Sigue el recorrido en zigzag definido por el estándar, saltando los módulos
+	 * de función. Los módulos sobrantes (0 a 7 bits de relleno) no se incluyen y
+	 * quedan en blanco.
 	 *
-	 * @param data Vector de bytes con datos y códigos de corrección entrelazados
-	 * @throws std::invalid_argument Si la cantidad de datos no coincide con la capacidad
+	 * @return Posición de cada bit (y * palabrasPorFila * 64 + x), en orden
 	 */
-	void QrCode::drawCodewords(const vector<uint8_t>& data) {
-		if (data.size() != static_cast<unsigned int>(getNumRawDataModules(version) / 8))
-			throw std::invalid_argument("Invalid argument");
-
-		size_t i = 0;  // Bit index into the data
+	vector<uint32_t> QrCode::computeDataPositions() const {
+		size_t numBits = static_cast<size_t>(getNumRawDataModules(version) / 8) * 8;
+		uint32_t bitsPerRow = static_cast<uint32_t>(isFunction.getWordsPerRow()) * 64;
+		vector<uint32_t> positions;
+		positions.reserve(numBits);
 		// Do the funny zigzag scan
 		for (int right = size - 1; right >= 1; right -= 2) {  // Index of right column in each column pair
 			if (right == 6)
 				right = 5;
 			for (int vert = 0; vert < size; vert++) {  // Vertical counter
 				for (int j = 0; j < 2; j++) {
-					size_t x = static_cast<size_t>(right - j);  // Actual x coordinate
+					int x = right - j;  // Actual x coordinate
 					bool upward = ((right + 1) & 2) == 0;
-					size_t y = static_cast<size_t>(upward ? size - 1 - vert : vert);  // Actual y coordinate
-					if (!isFunction.at(y).at(x) && i < data.size() * 8) {
-						modules.at(y).at(x) = getBit(data.at(i >> 3), 7 - static_cast<int>(i & 7));
-						i++;
-					}
-					// If this QR Code has any remainder bits (0 to 7), they were assigned as
-					// 0/false/light by the constructor and are left unchanged by this method
+					int y = upward ? size - 1 - vert : vert;  // Actual y coordinate
+					if (!isFunction.get(x, y) && positions.size() < numBits)
+						positions.push_back(static_cast<uint32_t>(y) * bitsPerRow + static_cast<uint32_t>(x));
 				}
 			}
 		}
-		assert(i == data.size() * 8);
+		assert(positions.size() == numBits);
+		return positions;
+	}
+
+	/**
+	 * @brief Dibuja los codewords (bytes de datos y corrección) en el código QR
+	 *
+	 * Reparte los bits en las posiciones precalculadas de la plantilla; como el
+	 * área de datos de la plantilla está en blanco, solo se escriben los bits en 1.
+	 *
+	 * @param data Vector de bytes con datos y códigos de corrección entrelazados
+	 * @param positions Posiciones de los bits de datos, en orden de colocación
+	 * @throws std::invalid_argument Si la cantidad de datos no coincide con la capacidad
+	 */
+	void QrCode::drawCodewords(const vector<uint8_t>& data, const vector<uint32_t>& positions) {
+		if (data.size() != static_cast<unsigned int>(getNumRawDataModules(version) / 8) ||
+			positions.size() != data.size() * 8)
+			throw std::invalid_argument("Invalid argument");
+
+		std::uint64_t* words = modules.data();
+		const uint32_t* position = positions.data();
+		for (uint8_t byte : data) {
+			for (int bit = 7; bit >= 0; bit--, position++) {
+				if ((byte >> bit) & 1)
+					words[*position >> 6] |= std::uint64_t(1) << (*position & 63);
+			}
+		}
 	}
 
 	/**
 	 * @brief Aplica un patrón de máscara al código QR
 	 *
 	 * La máscara ayuda a evitar patrones que podrían confundir a los escáneres
-	 * alternando los bits según reglas específicas.
+	 * alternando los bits según reglas específicas. Los planos de cada máscara
+	 * se calculan una vez por versión y se aplican con XOR por palabra.
 	 *
 	 * @param msk Patrón de máscara a aplicar (0-7)
+	 * @param target Matriz de módulos sobre la que se aplica
 	 * @throws std::domain_error Si el patrón de máscara está fuera del rango válido
 	 */
-	void QrCode::applyMask(int msk) {
+	void QrCode::applyMask(int msk, BitMatrix& target) const {
 		if (msk < 0 || msk > 7)
 			throw std::domain_error("Mask value out of range");
-		size_t sz = static_cast<size_t>(size);
-		for (size_t y = 0; y < sz; y++) {
-			for (size_t x = 0; x < sz; x++) {
-				bool invert;
-				switch (msk) {
-				case 0:  invert = (x + y) % 2 == 0;                    break;
-				case 1:  invert = y % 2 == 0;                          break;
-				case 2:  invert = x % 3 == 0;                          break;
-				case 3:  invert = (x + y) % 3 == 0;                    break;
-				case 4:  invert = (x / 3 + y / 2) % 2 == 0;            break;
-				case 5:  invert = x * y % 2 + x * y % 3 == 0;          break;
-				case 6:  invert = (x * y % 2 + x * y % 3) % 2 == 0;    break;
-				case 7:  invert = ((x + y) % 2 + x * y % 3) % 2 == 0;  break;
-				default:  throw std::logic_error("Unreachable");
-				}
-				modules.at(y).at(x) = modules.at(y).at(x) ^ (invert & !isFunction.at(y).at(x));
-			}
-		}
+		// Invert the data modules selected by the mask plane, one word at a time
+		const std::uint64_t* plane = maskPlane(version, msk).data();
+		const std::uint64_t* function = isFunction.data();
+		std::uint64_t* words = target.data();
+		size_t count = target.getWordCount();
+		for (size_t i = 0; i < count; i++)
+			words[i] ^= plane[i] & ~function[i];
 	}
 
 	/**
@@ -816,77 +1337,36 @@ namespace CodigoQR {
 	 * Las penalizaciones se basan en características como patrones repetidos,
 	 * bloques del mismo color, o desequilibrio entre módulos claros y oscuros.
 	 *
+	 * @param matrix Módulos a evaluar (con máscara y bits de formato ya aplicados)
 	 * @return Puntuación de penalización (valores más bajos son mejores)
 	 */
-	long QrCode::getPenaltyScore() const {
+	long QrCode::getPenaltyScore(const BitMatrix& matrix) const {
 		long result = 0;
 
-		// Adjacent modules in row having same color, and finder-like patterns
-		for (int y = 0; y < size; y++) {
-			bool runColor = false;
-			int runX = 0;
-			std::array<int, 7> runHistory = {};
-			for (int x = 0; x < size; x++) {
-				if (module(x, y) == runColor) {
-					runX++;
-					if (runX == 5)
-						result += PENALTY_N1;
-					else if (runX > 5)
-						result++;
-				}
-				else {
-					finderPenaltyAddHistory(runX, runHistory);
-					if (!runColor)
-						result += finderPenaltyCountPatterns(runHistory) * PENALTY_N3;
-					runColor = module(x, y);
-					runX = 1;
-				}
-			}
-			result += finderPenaltyTerminateAndCount(runColor, runX, runHistory) * PENALTY_N3;
-		}
-		// Adjacent modules in column having same color, and finder-like patterns
-		for (int x = 0; x < size; x++) {
-			bool runColor = false;
-			int runY = 0;
-			std::array<int, 7> runHistory = {};
-			for (int y = 0; y < size; y++) {
-				if (module(x, y) == runColor) {
-					runY++;
-					if (runY == 5)
-						result += PENALTY_N1;
-					else if (runY > 5)
-						result++;
-				}
-				else {
-					finderPenaltyAddHistory(runY, runHistory);
-					if (!runColor)
-						result += finderPenaltyCountPatterns(runHistory) * PENALTY_N3;
-					runColor = module(x, y);
-					runY = 1;
-				}
-			}
-			result += finderPenaltyTerminateAndCount(runColor, runY, runHistory) * PENALTY_N3;
-		}
+		// Adjacent modules in row/column having same color, and finder-like patterns.
+		// Columns are scanned as the rows of the transposed matrix.
+		result += getRunPenalty(matrix);
+		result += getRunPenalty(matrix.transpose());
 
-		// 2*2 blocks of modules having same color
+		// 2*2 blocks of modules having same color: bit x of 'same' is set when
+		// modules (x, y), (x+1, y), (x, y+1) and (x+1, y+1) are equal
+		int wordsPerRow = matrix.getWordsPerRow();
 		for (int y = 0; y < size - 1; y++) {
-			for (int x = 0; x < size - 1; x++) {
-				bool  color = module(x, y);
-				if (color == module(x + 1, y) &&
-					color == module(x, y + 1) &&
-					color == module(x + 1, y + 1))
-					result += PENALTY_N2;
+			const std::uint64_t* top = matrix.row(y);
+			const std::uint64_t* bottom = matrix.row(y + 1);
+			for (int w = 0; w < wordsPerRow; w++) {
+				std::uint64_t topNext = (top[w] >> 1) | (w + 1 < wordsPerRow ? top[w + 1] << 63 : 0);
+				std::uint64_t bottomNext = (bottom[w] >> 1) | (w + 1 < wordsPerRow ? bottom[w + 1] << 63 : 0);
+				std::uint64_t same = ~(top[w] ^ bottom[w]) & ~(top[w] ^ topNext) & ~(bottom[w] ^ bottomNext);
+				int starts = size - 1 - w * 64;  // Valid block origins x < size - 1 in this word
+				if (starts < 64)
+					same &= (std::uint64_t(1) << starts) - 1;
+				result += popcount64(same) * PENALTY_N2;
 			}
 		}
 
 		// Balance of dark and light modules
-		int dark = 0;
-		for (const vector<bool>& row : modules) {
-			for (bool color : row) {
-				if (color)
-					dark++;
-			}
-		}
+		long dark = matrix.countOnes();
 		int total = size * size;  // Note that size is odd, so dark/total != 1/2
 		// Compute the smallest integer k >= 0 such that (45-5k)% <= dark/total <= (55+5k)%
 		int k = static_cast<int>((std::abs(dark * 20L - total * 10L) + total - 1) / total) - 1;
@@ -896,6 +1376,55 @@ namespace CodigoQR {
 		return result;
 	}
 
+	/**
+	 * @brief Calcula las penalizaciones por rachas y patrones tipo buscador de cada fila
+	 *
+	 * Recorre las rachas completas de cada fila en lugar de módulo por módulo: la
+	 * longitud de cada racha se obtiene buscando el primer bit distinto dentro de
+	 * la palabra de 64 bits. El resultado es idéntico al recorrido módulo a módulo.
+	 *
+	 * @param matrix Matriz de módulos o su traspuesta
+	 * @return Penalizaciones N1 y N3 acumuladas
+	 */
+	long QrCode::getRunPenalty(const BitMatrix& matrix) const {
+		long result = 0;
+		for (int y = 0; y < size; y++) {
+			const std::uint64_t* row = matrix.row(y);
+			bool runColor = false;
+			int runLength = 0;
+			std::array<int, 7> runHistory = {};
+			int x = 0;
+			while (x < size) {
+				bool color = ((row[x >> 6] >> (x & 63)) & 1) != 0;
+				// Find the end of the run: the first bit that differs from 'color'
+				int end = x;
+				while (end < size) {
+					std::uint64_t differ = (color ? ~row[end >> 6] : row[end >> 6]) >> (end & 63);
+					if (differ != 0) {
+						end += trailingZeros64(differ);
+						break;
+					}
+					end += 64 - (end & 63);
+				}
+				end = std::min(end, size);
+
+				if (color != runColor) {
+					finderPenaltyAddHistory(runLength, runHistory);
+					if (!runColor)
+						result += finderPenaltyCountPatterns(runHistory) * PENALTY_N3;
+					runColor = color;
+					runLength = 0;
+				}
+				runLength += end - x;
+				if (runLength >= 5)
+					result += PENALTY_N1 + (runLength - 5);
+				x = end;
+			}
+			result += finderPenaltyTerminateAndCount(runColor, runLength, runHistory) * PENALTY_N3;
+		}
+		return result;
+	}
+
 	/**
 	 * @brief Obtiene las posiciones de los patrones de alineación para la versión actual
 	 *
@@ -950,56 +1479,46 @@ namespace CodigoQR {
 	}
 
 	/**
-	 * @brief Calcula el polinomio divisor para la codificación Reed-Solomon
+	 * @brief Obtiene el polinomio divisor para la codificación Reed-Solomon
+	 *
+	 * El polinomio de cada grado se calcula una sola vez y queda en caché.
 	 *
 	 * @param degree Grado del polinomio (igual al número de codewords ECC)
 	 * @return Vector de coeficientes del polinomio divisor
 	 * @throws std::domain_error Si el grado está fuera del rango válido
 	 */
-	vector<uint8_t> QrCode::reedSolomonComputeDivisor(int degree) {
+	const vector<uint8_t>& QrCode::reedSolomonComputeDivisor(int degree) {
 		if (degree < 1 || degree > 255)
 			throw std::domain_error("Degree out of range");
-		// Polynomial coefficients are stored from highest to lowest power, excluding the leading term which is always 1.
-		// For example the polynomial x^3 + 255x^2 + 8x + 93 is stored as the uint8 array {255, 8, 93}.
-		vector<uint8_t> result(static_cast<size_t>(degree));
-		result.at(result.size() - 1) = 1;  // Start off with the monomial x^0
-
-		// Compute the product polynomial (x - r^0) * (x - r^1) * (x - r^2) * ... * (x - r^{degree-1}),
-		// and drop the highest monomial term which is always 1x^degree.
-		// Note that r = 0x02, which is a generator element of this field GF(2^8/0x11D).
-		uint8_t root = 1;
-		for (int i = 0; i < degree; i++) {
-			// Multiply the current product by (x - r^i)
-			for (size_t j = 0; j < result.size(); j++) {
-				result.at(j) = reedSolomonMultiply(result.at(j), root);
-				if (j + 1 < result.size())
-					result.at(j) ^= result.at(j + 1);
-			}
-			root = reedSolomonMultiply(root, 0x02);
-		}
-		return result;
+		return reedSolomonGenerator(degree).divisor;
 	}
 
 	/**
 	 * @brief Calcula el resto de la división polinómica para la corrección Reed-Solomon
 	 *
 	 * Esta función implementa la división polinómica en el campo de Galois GF(2^8)
-	 * para calcular los bytes de corrección de errores.
-	 *
-	 * @param data Vector de bytes con los datos originales (dividendo)
-	 * @param divisor Vector de bytes representando el polinomio divisor
-	 * @return Vector de bytes con el resto de la división (bytes ECC)
-	 */
-	vector<uint8_t> QrCode::reedSolomonComputeRemainder(const vector<uint8_t>& data, const vector<uint8_t>& divisor) {
-		vector<uint8_t> result(divisor.size());
-		for (uint8_t b : data) {  // Polynomial division
-			uint8_t factor = b ^ result.at(0);
-			result.erase(result.begin());
-			result.push_back(0);
-			for (size_t i = 0; i < result.size(); i++)
-				result.at(i) ^= reedSolomonMultiply(divisor.at(i), factor);
+	 * para calcular los bytes de corrección de errores. Los productos del divisor
+	 * por cada posible factor están precalculados, así que cada byte de datos
+	 * cuesta un desplazamiento del resto y un XOR con una fila de la tabla.
+	 *
+	 * @param data Bytes de datos (dividendo)
+	 * @param length Número de bytes de datos
+	 * @param degree Grado del divisor (número de bytes ECC)
+	 * @param result Salida: resto de la división (degree bytes)
+	 * @throws std::domain_error Si el grado está fuera del rango válido
+	 */
+	void QrCode::reedSolomonComputeRemainder(const uint8_t* data, size_t length, int degree, uint8_t* result) {
+		if (degree < 1 || degree > 255)
+			throw std::domain_error("Degree out of range");
+		const uint8_t* products = reedSolomonGenerator(degree).products.data();
+		size_t deg = static_cast<size_t>(degree);
+		std::memset(result, 0, deg);
+		for (size_t n = 0; n < length; n++) {  // Polynomial division
+			const uint8_t* row = products + static_cast<size_t>(data[n] ^ result[0]) * deg;
+			for (size_t i = 0; i + 1 < deg; i++)
+				result[i] = result[i + 1] ^ row[i];
+			result[deg - 1] = row[deg - 1];
 		}
-		return result;
 	}
 
 
@@ -1007,21 +1526,14 @@ namespace CodigoQR {
 	 * @brief Realiza la multiplicación en el campo finito GF(2^8)
 	 *
 	 * Implementa la multiplicación de dos bytes en el campo de Galois GF(2^8)
-	 * usado en la codificación Reed-Solomon.
+	 * usado en la codificación Reed-Solomon, mediante tablas de logaritmos.
 	 *
 	 * @param x Primer operando (byte)
 	 * @param y Segundo operando (byte)
 	 * @return Resultado de la multiplicación en GF(2^8)
 	 */
 	uint8_t QrCode::reedSolomonMultiply(uint8_t x, uint8_t y) {
-		// Russian peasant multiplication
-		int z = 0;
-		for (int i = 7; i >= 0; i--) {
-			z = (z << 1) ^ ((z >> 7) * 0x11D);
-			z ^= ((y >> i) & 1) * x;
-		}
-		assert(z >> 8 == 0);
-		return static_cast<uint8_t>(z);
+		return gfMultiply(x, y);
 	}
 
 
@@ -1108,6 +1620,11 @@ namespace CodigoQR {
 	 */
 	const int QrCode::PENALTY_N4 = 10;
 
+	/**
+	 * @brief Versión mínima a partir de la cual las máscaras se evalúan en paralelo
+	 */
+	const int QrCode::MIN_PARALLEL_MASK_VERSION = 10;
+
 	
 	const int8_t QrCode::ECC_CODEWORDS_PER_BLOCK[4][41] = {
 		// Version: (note that index 0 is for padding, and is set to an illegal value)
@@ -1142,7 +1659,7 @@ namespace CodigoQR {
 	 * Crea un buffer de bits vacío
 	 */
 	BitBuffer::BitBuffer()
-		: std::vector<bool>() {}
+		: words(), bitLength(0) {}
 
 	/**
 	 * @brief Añade bits al buffer a partir de un valor entero
@@ -1154,8 +1671,364 @@ namespace CodigoQR {
 	void BitBuffer::appendBits(std::uint32_t val, int len) {
 		if (len < 0 || len > 31 || val >> len != 0)
 			throw std::domain_error("Value out of range");
-		for (int i = len - 1; i >= 0; i--)  // Append bit by bit
-			this->push_back(((val >> i) & 1) != 0);
+		appendWord(val, len);
+	}
+
+	/**
+	 * @brief Añade al final todos los bits de otro buffer
+	 *
+	 * Se copian palabras completas de 64 bits; solo la última se recorta.
+	 *
+	 * @param other Buffer a concatenar
+	 */
+	void BitBuffer::appendData(const BitBuffer& other) {
+		if (&other == this) {
+			BitBuffer copy(other);
+			appendData(copy);
+			return;
+		}
+		size_t fullWords = other.bitLength >> 6;
+		words.reserve((bitLength + other.bitLength + 63) >> 6);
+		for (size_t i = 0; i < fullWords; i++)
+			appendWord(other.words[i], 64);
+		int remaining = static_cast<int>(other.bitLength & 63);
+		if (remaining > 0)
+			appendWord(other.words[fullWords] >> (64 - remaining), remaining);
+	}
+
+	/**
+	 * @brief Convierte el buffer en bytes
+	 *
+	 * @return Bytes del buffer, el primer bit en el MSB del primer byte
+	 */
+	vector<uint8_t> BitBuffer::getBytes() const {
+		vector<uint8_t> result((bitLength + 7) >> 3);
+		for (size_t i = 0; i < result.size(); i++)
+			result[i] = static_cast<uint8_t>(words[i >> 3] >> (56 - ((i & 7) << 3)));
+		return result;
+	}
+
+	/**
+	 * @brief Añade hasta 64 bits sin comprobar el rango
+	 *
+	 * Los bits se colocan a continuación del último bit válido; si no caben en la
+	 * palabra actual, el resto pasa a una palabra nueva.
+	 *
+	 * @param val Valor en los bits bajos (los bits por encima de len deben ser 0)
+	 * @param len Número de bits (0-64)
+	 */
+	void BitBuffer::appendWord(std::uint64_t val, int len) {
+		if (len == 0)
+			return;
+		int used = static_cast<int>(bitLength & 63);
+		if (used == 0)
+			words.push_back(0);
+		int available = 64 - used;
+		if (len <= available)
+			words.back() |= val << (available - len);
+		else {
+			words.back() |= val >> (len - available);
+			words.push_back(val << (64 - (len - available)));
+		}
+		bitLength += static_cast<size_t>(len);
+	}
+
+	/*---- Class CacheCodigosQR ----*/
+
+	/**
+	 * @brief Crea una caché vacía
+	 *
+	 * @param presupuestoBytes Memoria máxima estimada para las entradas
+	 */
+	CacheCodigosQR::CacheCodigosQR(size_t presupuestoBytes) :
+		presupuesto(presupuestoBytes),
+		bytesUsados(0),
+		aciertos(0),
+		fallos(0) {}
+
+	/**
+	 * @brief Devuelve el código QR de un texto, generándolo solo si no está en caché
+	 *
+	 * El código se genera fuera del mutex para que varios hilos puedan codificar a
+	 * la vez; si dos piden el mismo texto al mismo tiempo, ambos lo generan y se
+	 * guarda uno de los dos resultados, que son idénticos.
+	 *
+	 * @param datos Texto a codificar
+	 * @param ecl Nivel de corrección de errores
+	 * @return Código QR compartido
+	 */
+	std::shared_ptr<const QrCode> CacheCodigosQR::obtener(const std::string& datos, QrCode::Ecc ecl) {
+		std::string clave;
+		clave.reserve(datos.size() + 2);
+		clave += static_cast<char>('0' + static_cast<int>(ecl));
+		clave += '|';
+		clave += datos;
+		{
+			std::lock_guard<std::mutex> lock(mtx);
+			auto it = indice.find(clave);
+			if (it != indice.end()) {
+				entradas.splice(entradas.begin(), entradas, it->second);  // Pasa a ser la más reciente
+				++aciertos;
+				return it->second->codigo;
+			}
+			++fallos;
+		}
+
+		auto codigo = std::make_shared<const QrCode>(QrCode::encodeTextOptimal(datos.c_str(), ecl));
+		size_t bytes = estimarBytes(clave, *codigo);
+
+		std::lock_guard<std::mutex> lock(mtx);
+		if (bytes > presupuesto || indice.find(clave) != indice.end())
+			return codigo;  // No cabe nunca, o otro hilo ya lo guardó
+		entradas.push_front(Entrada{ clave, codigo, bytes });
+		indice.emplace(std::move(clave), entradas.begin());
+		bytesUsados += bytes;
+		recortar();
+		return codigo;
+	}
+
+	/**
+	 * @brief Cambia el presupuesto de memoria
+	 *
+	 * @param presupuestoBytes Nueva memoria máxima estimada
+	 */
+	void CacheCodigosQR::setPresupuesto(size_t presupuestoBytes) {
+		std::lock_guard<std::mutex> lock(mtx);
+		presupuesto = presupuestoBytes;
+		recortar();
+	}
+
+	/**
+	 * @brief Obtiene el presupuesto de memoria
+	 *
+	 * @return Presupuesto en bytes
+	 */
+	size_t CacheCodigosQR::getPresupuesto() const {
+		std::lock_guard<std::mutex> lock(mtx);
+		return presupuesto;
+	}
+
+	/**
+	 * @brief Obtiene la memoria estimada ocupada por las entradas
+	 *
+	 * @return Bytes usados
+	 */
+	size_t CacheCodigosQR::getBytesUsados() const {
+		std::lock_guard<std::mutex> lock(mtx);
+		return bytesUsados;
+	}
+
+	/**
+	 * @brief Obtiene el número de códigos guardados
+	 *
+	 * @return Número de entradas
+	 */
+	size_t CacheCodigosQR::getEntradas() const {
+		std::lock_guard<std::mutex> lock(mtx);
+		return entradas.size();
+	}
+
+	/**
+	 * @brief Obtiene el número de consultas resueltas desde la caché
+	 *
+	 * @return Aciertos desde la creación o el último vaciado
+	 */
+	size_t CacheCodigosQR::getAciertos() const {
+		std::lock_guard<std::mutex> lock(mtx);
+		return aciertos;
+	}
+
+	/**
+	 * @brief Obtiene el número de consultas que obligaron a generar el código
+	 *
+	 * @return Fallos desde la creación o el último vaciado
+	 */
+	size_t CacheCodigosQR::getFallos() const {
+		std::lock_guard<std::mutex> lock(mtx);
+		return fallos;
+	}
+
+	/**
+	 * @brief Elimina todas las entradas y reinicia los contadores
+	 */
+	void CacheCodigosQR::vaciar() {
+		std::lock_guard<std::mutex> lock(mtx);
+		indice.clear();
+		entradas.clear();
+		bytesUsados = 0;
+		aciertos = 0;
+		fallos = 0;
+	}
+
+	/**
+	 * @brief Caché compartida por el menú interactivo y la exportación masiva
+	 *
+	 * @return Instancia única
+	 */
+	CacheCodigosQR& CacheCodigosQR::compartida() {
+		static CacheCodigosQR instancia;
+		return instancia;
+	}
+
+	/**
+	 * @brief Descarta las entradas menos usadas hasta respetar el presupuesto
+	 */
+	void CacheCodigosQR::recortar() {
+		while (bytesUsados > presupuesto && !entradas.empty()) {
+			const Entrada& antigua = entradas.back();
+			bytesUsados -= antigua.bytes;
+			indice.erase(antigua.clave);
+			entradas.pop_back();
+		}
+	}
+
+	/**
+	 * @brief Estima la memoria que ocupa una entrada
+	 *
+	 * @param clave Clave de la entrada
+	 * @param qr Código guardado
+	 * @return Bytes aproximados
+	 */
+	size_t CacheCodigosQR::estimarBytes(const std::string& clave, const QrCode& qr) {
+		// La clave se guarda dos veces (lista e índice); se suma un margen por nodo
+		const size_t SOBRECARGA_NODOS = 96;
+		return sizeof(Entrada) + sizeof(QrCode) + clave.size() * 2 + SOBRECARGA_NODOS +
+			qr.getModules().getWordCount() * sizeof(std::uint64_t);
+	}
+
+	/*---- Class RenderizadorTextoQR ----*/
+
+	namespace {
+		/** @brief Medios bloques en UTF-8, indexados por (arriba oscuro) * 2 + (abajo oscuro) */
+		const char* const GLIFOS_MEDIOS_BLOQUES[4] = {
+			" ",
+			"\xE2\x96\x84",  // U+2584 medio bloque inferior
+			"\xE2\x96\x80",  // U+2580 medio bloque superior
+			"\xE2\x96\x88"   // U+2588 bloque completo
+		};
+		const size_t LONGITUD_GLIFOS[4] = { 1, 3, 3, 3 };
+
+		/** @brief Texto negro sobre fondo blanco brillante, y restablecimiento */
+		const char COLOR_ANSI[] = "\x1b[30;107m";
+		const char FIN_ANSI[] = "\x1b[0m";
+	}
+
+	/**
+	 * @brief Compone el código QR como texto
+	 *
+	 * Los módulos oscuros se dibujan con glifos y los claros con espacios. En los
+	 * modos de medios bloques cada carácter combina un módulo de la fila par (mitad
+	 * superior) con el de la fila siguiente (mitad inferior).
+	 *
+	 * @param qr Código QR
+	 * @param modo Forma de dibujarlo
+	 * @param zonaSilencio Módulos claros alrededor del código
+	 * @return Texto del código, terminado en salto de línea
+	 * @throws std::invalid_argument Si la zona de silencio es negativa
+	 */
+	std::string RenderizadorTextoQR::renderizar(const QrCode& qr, ModoTextoQR modo, int zonaSilencio) {
+		if (zonaSilencio < 0)
+			throw std::invalid_argument("Invalid value");
+		const BitMatrix& modulos = qr.getModules();
+		int size = qr.getSize();
+		int total = size + zonaSilencio * 2;
+		auto oscuro = [&](int x, int y) {
+			x -= zonaSilencio;
+			y -= zonaSilencio;
+			return x >= 0 && y >= 0 && x < size && y < size && modulos.get(x, y);
+		};
+
+		std::string salida;
+		if (modo == ModoTextoQR::ASCII) {
+			salida.reserve(static_cast<size_t>(total) * (total * 2 + 1));
+			for (int y = 0; y < total; y++) {
+				for (int x = 0; x < total; x++)
+					salida.append(oscuro(x, y) ? "##" : "  ", 2);
+				salida += '\n';
+			}
+			return salida;
+		}
+
+		bool ansi = modo == ModoTextoQR::ANSI;
+		size_t lineas = static_cast<size_t>((total + 1) / 2);
+		size_t porLinea = static_cast<size_t>(total) * 3 + 1 + (ansi ? sizeof(COLOR_ANSI) + sizeof(FIN_ANSI) - 2 : 0);
+		salida.reserve(lineas * porLinea);
+		for (int y = 0; y < total; y += 2) {
+			if (ansi)
+				salida.append(COLOR_ANSI, sizeof(COLOR_ANSI) - 1);
+			for (int x = 0; x < total; x++) {
+				int indice = (oscuro(x, y) ? 2 : 0) | (y + 1 < total && oscuro(x, y + 1) ? 1 : 0);
+				salida.append(GLIFOS_MEDIOS_BLOQUES[indice], LONGITUD_GLIFOS[indice]);
+			}
+			if (ansi)
+				salida.append(FIN_ANSI, sizeof(FIN_ANSI) - 1);
+			salida += '\n';
+		}
+		return salida;
+	}
+
+	/**
+	 * @brief Compone el código QR y lo escribe con una sola operación
+	 *
+	 * @param qr Código QR
+	 * @param modo Forma de dibujarlo
+	 * @param salida Flujo de destino
+	 * @return Número de bytes escritos
+	 */
+	size_t RenderizadorTextoQR::imprimir(const QrCode& qr, ModoTextoQR modo, std::ostream& salida) {
+		std::string texto = renderizar(qr, modo);
+		salida.write(texto.data(), static_cast<std::streamsize>(texto.size()));
+		salida.flush();
+		return texto.size();
+	}
+
+	/**
+	 * @brief Guarda el código QR como archivo de texto UTF-8
+	 *
+	 * @param qr Código QR
+	 * @param ruta Ruta del archivo
+	 * @param modo Forma de dibujarlo
+	 * @return true si se escribió correctamente
+	 */
+	bool RenderizadorTextoQR::guardar(const QrCode& qr, const std::string& ruta, ModoTextoQR modo) {
+		std::ofstream archivo(ruta, std::ios::binary | std::ios::trunc);
+		if (!archivo)
+			return false;
+		std::string texto = renderizar(qr, modo);
+		archivo.write(texto.data(), static_cast<std::streamsize>(texto.size()));
+		return static_cast<bool>(archivo);
+	}
+
+	/**
+	 * @brief Elige el modo más adecuado para la consola actual
+	 *
+	 * @return Modo de dibujo recomendado
+	 */
+	ModoTextoQR RenderizadorTextoQR::detectarModo() {
+#ifdef _WIN32
+		HANDLE consola = GetStdHandle(STD_OUTPUT_HANDLE);
+		DWORD modoConsola = 0;
+		if (consola != INVALID_HANDLE_VALUE && GetConsoleMode(consola, &modoConsola)) {
+			if ((modoConsola & ENABLE_VIRTUAL_TERMINAL_PROCESSING) ||
+				SetConsoleMode(consola, modoConsola | ENABLE_VIRTUAL_TERMINAL_PROCESSING))
+				return ModoTextoQR::ANSI;
+		}
+		return ModoTextoQR::MEDIOS_BLOQUES;  // La aplicación ya pone la consola en UTF-8
+#else
+		const char* terminal = std::getenv("TERM");
+		if (isatty(STDOUT_FILENO) && terminal != nullptr && *terminal != '\0' && std::strcmp(terminal, "dumb") != 0)
+			return ModoTextoQR::ANSI;
+		for (const char* variable : { "LC_ALL", "LC_CTYPE", "LANG" }) {
+			const char* valor = std::getenv(variable);
+			if (valor == nullptr || *valor == '\0')
+				continue;
+			std::string locale(valor);
+			bool utf8 = locale.find("UTF-8") != std::string::npos || locale.find("utf8") != std::string::npos ||
+				locale.find("utf-8") != std::string::npos || locale.find("UTF8") != std::string::npos;
+			return utf8 ? ModoTextoQR::MEDIOS_BLOQUES : ModoTextoQR::ASCII;
+		}
+		return ModoTextoQR::ASCII;
+#endif
 	}
 
 }
\ No newline at end of file
@@ -11,6 +11,11 @@
 #include <fstream>
 #include <iomanip>
 #include <sstream>
+#include <chrono>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 /**
  * @namespace CodigoQR
@@ -21,6 +26,60 @@
  */
 namespace CodigoQR {
 
+    /**
+     * @class BitBuffer
+     * @brief Buffer de bits para construir datos QR
+     *
+     * Los bits se empaquetan en palabras de 64 bits, el primero en el bit ms
+     * significativo, de modo que aadir un valor de varios bits o concatenar otro
+     * buffer cuesta unas pocas operaciones por palabra y no una por bit.
+     */
+    class BitBuffer final {
+        /**
+         * @brief Constructor por defecto
+         */
+    public: BitBuffer();
+          /**
+           * @brief Aade bits al buffer
+           * @param val Valor a codificar
+           * @param len Nmero de bits a usar (desde el LSB)
+           */
+    public: void appendBits(std::uint32_t val, int len);
+          /**
+           * @brief Aade al final todos los bits de otro buffer
+           * @param other Buffer a concatenar
+           */
+    public: void appendData(const BitBuffer& other);
+          /**
+           * @brief Obtiene el nmero de bits del buffer
+           * @return Longitud en bits
+           */
+    public: std::size_t size() const { return bitLength; }
+          /**
+           * @brief Obtiene un bit del buffer
+           * @param index Posicin del bit (0 = primero)
+           * @return Valor del bit
+           */
+    public: bool getBit(std::size_t index) const {
+        return ((words[index >> 6] >> (63 - (index & 63))) & 1) != 0;
+    }
+          /**
+           * @brief Convierte el buffer en bytes, el primer bit en el MSB del primer byte
+           * @return Bytes del buffer; el ltimo se completa con ceros
+           */
+    public: std::vector<std::uint8_t> getBytes() const;
+          /**
+           * @brief Aade hasta 64 bits sin comprobar el rango
+           * @param val Valor en los bits bajos
+           * @param len Nmero de bits (0-64)
+           */
+    private: void appendWord(std::uint64_t val, int len);
+           /** @brief Palabras con los bits, el primero en el MSB */
+    private: std::vector<std::uint64_t> words;
+           /** @brief Nmero de bits vlidos */
+    private: std::size_t bitLength;
+    };
+
     /**
      * @class QrSegment
      * @brief Representa un segmento de datos en un cdigo QR
@@ -99,6 +158,17 @@ namespace CodigoQR {
            * @return Vector de segmentos QR optimizados para el texto
            */
     public: static std::vector<QrSegment> makeSegments(const char* text);
+          /**
+           * @brief Divide un texto en segmentos numricos, alfanumricos y de bytes
+           *        con la menor longitud total en bits
+           * @param text Texto a codificar
+           * @param version Versin del cdigo QR, que fija el ancho de los contadores
+           * @return Segmentos cuya codificacin ocupa el mnimo de bits posible
+           *
+           * Cambiar de modo cuesta una cabecera (modo y contador), as que solo se
+           * parte el texto cuando el ahorro de los caracteres compensa ese coste.
+           */
+    public: static std::vector<QrSegment> makeSegmentsOptimally(const char* text, int version);
           /**
            * @brief Crea un segmento ECI con el valor asignado
            * @param assignVal Valor ECI a codificar
@@ -122,21 +192,21 @@ namespace CodigoQR {
            /** @brief Nmero de caracteres en este segmento */
     private: int numChars;
            /** @brief Datos del segmento como bits */
-    private: std::vector<bool> data;
+    private: BitBuffer data;
            /**
             * @brief Constructor para crear un segmento
             * @param md Modo de codificacin
             * @param numCh Nmero de caracteres
             * @param dt Vector de bits con los datos
             */
-    public: QrSegment(const Mode& md, int numCh, const std::vector<bool>& dt);
+    public: QrSegment(const Mode& md, int numCh, const BitBuffer& dt);
           /**
            * @brief Constructor con movimiento para datos
            * @param md Modo de codificacin
            * @param numCh Nmero de caracteres
            * @param dt Vector de bits con los datos (movido)
            */
-    public: QrSegment(const Mode& md, int numCh, std::vector<bool>&& dt);
+    public: QrSegment(const Mode& md, int numCh, BitBuffer&& dt);
           /**
            * @brief Obtiene el modo de este segmento
            * @return Referencia al modo de codificacin
@@ -149,9 +219,9 @@ namespace CodigoQR {
     public: int getNumChars() const;
           /**
            * @brief Obtiene los datos codificados como bits
-           * @return Vector de bits con los datos
+           * @return Buffer de bits con los datos
            */
-    public: const std::vector<bool>& getData() const;
+    public: const BitBuffer& getData() const;
           /**
            * @brief Calcula el nmero total de bits necesarios para los segmentos
            * @param segs Vector de segmentos
@@ -164,6 +234,124 @@ namespace CodigoQR {
 
     };
 
+    /**
+     * @class BitMatrix
+     * @brief Matriz cuadrada de bits empaquetada en palabras de 64 bits
+     *
+     * Las filas se guardan una tras otra; el mdulo (x, y) es el bit x % 64 de la
+     * palabra x / 64 de la fila y. Los bits sobrantes al final de cada fila valen
+     * siempre 0, de modo que las operaciones por palabra (XOR, AND, popcount) no
+     * necesitan tratar el borde por separado.
+     */
+    class BitMatrix final {
+        /**
+         * @brief Crea una matriz vaca de tamao 0
+         */
+    public: BitMatrix();
+          /**
+           * @brief Crea una matriz de size x size bits, todos en 0
+           * @param size Ancho y alto en bits
+           */
+    public: explicit BitMatrix(int size);
+          /**
+           * @brief Obtiene el ancho (y alto) de la matriz
+           * @return Tamao en bits
+           */
+    public: int getSize() const { return size; }
+          /**
+           * @brief Obtiene el nmero de palabras de 64 bits por fila
+           * @return Palabras por fila
+           */
+    public: int getWordsPerRow() const { return wordsPerRow; }
+          /**
+           * @brief Lee un bit sin comprobar lmites
+           * @param x Columna (0 a size-1)
+           * @param y Fila (0 a size-1)
+           * @return Valor del bit
+           */
+    public: bool get(int x, int y) const {
+        return ((words[static_cast<std::size_t>(y * wordsPerRow + (x >> 6))] >> (x & 63)) & 1) != 0;
+    }
+          /**
+           * @brief Escribe un bit sin comprobar lmites
+           * @param x Columna (0 a size-1)
+           * @param y Fila (0 a size-1)
+           * @param value Valor a escribir
+           */
+    public: void set(int x, int y, bool value) {
+        std::uint64_t& word = words[static_cast<std::size_t>(y * wordsPerRow + (x >> 6))];
+        std::uint64_t bit = std::uint64_t(1) << (x & 63);
+        word = value ? (word | bit) : (word & ~bit);
+    }
+          /**
+           * @brief Obtiene las palabras de una fila
+           * @param y Fila (0 a size-1)
+           * @return Puntero a la primera palabra de la fila
+           */
+    public: const std::uint64_t* row(int y) const { return words.data() + static_cast<std::size_t>(y * wordsPerRow); }
+          /**
+           * @brief Obtiene todas las palabras de la matriz
+           * @return Puntero a la primera palabra
+           */
+    public: std::uint64_t* data() { return words.data(); }
+          /** @copydoc data() */
+    public: const std::uint64_t* data() const { return words.data(); }
+          /**
+           * @brief Obtiene el nmero total de palabras de la matriz
+           * @return Palabras de 64 bits
+           */
+    public: std::size_t getWordCount() const { return words.size(); }
+          /**
+           * @brief Cuenta los bits en 1 de toda la matriz
+           * @return Nmero de bits activos
+           */
+    public: long countOnes() const;
+          /**
+           * @brief Calcula la matriz traspuesta por bloques de 64x64 bits
+           * @return Matriz en la que el bit (x, y) es el bit (y, x) de esta
+           */
+    public: BitMatrix transpose() const;
+          /**
+           * @brief Recorre los tramos horizontales de bits en 1, fila por fila
+           * @param callback Funcin llamada como callback(y, xInicio, longitud)
+           *
+           * Las palabras vacas se saltan enteras, as que el coste depende del
+           * nmero de tramos y no del de bits. Lo usan los escritores vectoriales
+           * para dibujar un rectngulo por tramo en lugar de uno por mdulo.
+           */
+    public: template<typename Funcion>
+    void forEachRowRun(Funcion callback) const {
+        for (int y = 0; y < size; y++) {
+            const std::uint64_t* fila = row(y);
+            int x = 0;
+            while (x < size) {
+                if ((x & 63) == 0 && fila[x >> 6] == 0) {
+                    x += 64;
+                    continue;
+                }
+                if (!((fila[x >> 6] >> (x & 63)) & 1)) {
+                    x++;
+                    continue;
+                }
+                int inicio = x;
+                while (x < size && ((fila[x >> 6] >> (x & 63)) & 1))
+                    x++;
+                callback(y, inicio, x - inicio);
+            }
+        }
+    }
+          /**
+           * @brief Libera la memoria de la matriz y la deja con tamao 0
+           */
+    public: void clear();
+          /** @brief Ancho y alto en bits */
+    private: int size;
+           /** @brief Palabras de 64 bits por fila */
+    private: int wordsPerRow;
+           /** @brief Palabras de la matriz, fila por fila */
+    private: std::vector<std::uint64_t> words;
+    };
+
     /**
      * @class QrCode
      * @brief Representa un cdigo QR completo con todos sus elementos
@@ -195,6 +383,16 @@ namespace CodigoQR {
             * @return Objeto QrCode con el cdigo generado
             */
     public: static QrCode encodeText(const char* text, Ecc ecl);
+          /**
+           * @brief Codifica texto en un cdigo QR con segmentacin ptima
+           * @param text Texto a codificar
+           * @param ecl Nivel de correccin de errores
+           * @return Objeto QrCode con la menor versin posible para el texto
+           *
+           * Mezcla modos numrico, alfanumrico y de bytes dentro del mismo texto;
+           * un lector QR obtiene exactamente el mismo texto que con encodeText.
+           */
+    public: static QrCode encodeTextOptimal(const char* text, Ecc ecl);
           /**
            * @brief Codifica datos binarios en un cdigo QR
            * @param data Datos binarios a codificar
@@ -222,10 +420,10 @@ namespace CodigoQR {
     private: Ecc errorCorrectionLevel;
            /** @brief Patrn de mscara utilizado */
     private: int mask;
-           /** @brief Matriz de mdulos (true=negro, false=blanco) */
-    private: std::vector<std::vector<bool> > modules;
-           /** @brief Matriz de funciones (patrones fijos) */
-    private: std::vector<std::vector<bool> > isFunction;
+           /** @brief Matriz de mdulos (1=negro, 0=blanco) */
+    private: BitMatrix modules;
+           /** @brief Matriz de funciones (patrones fijos); se libera al terminar el constructor */
+    private: BitMatrix isFunction;
            /**
             * @brief Constructor para crear un cdigo QR
             * @param ver Versin (1-40)
@@ -234,6 +432,35 @@ namespace CodigoQR {
             * @param msk Patrn de mscara
             */
     public: QrCode(int ver, Ecc ecl, const std::vector<std::uint8_t>& dataCodewords, int msk);
+          /**
+           * @struct FunctionTemplate
+           * @brief Plantilla precalculada de una versin
+           *
+           * Guarda los patrones de funcin ya dibujados y la posicin de cada bit de
+           * datos en el recorrido en zigzag, de modo que construir un cdigo es copiar
+           * la plantilla y repartir los bits, sin volver a dibujar patrones.
+           */
+    private: struct FunctionTemplate {
+        /** @brief Mdulos con los patrones de funcin dibujados y el rea de datos en blanco */
+        BitMatrix modules;
+        /** @brief Mdulos que pertenecen a patrones de funcin */
+        BitMatrix isFunction;
+        /** @brief Posicin (y * palabrasPorFila * 64 + x) de cada bit de datos, en orden */
+        std::vector<std::uint32_t> dataPositions;
+    };
+           /**
+            * @brief Obtiene la plantilla de una versin, calculndola en el primer uso
+            * @param ver Versin (1-40)
+            * @return Plantilla compartida (se calcula una vez, de forma segura entre hilos)
+            */
+    private: static const FunctionTemplate& getFunctionTemplate(int ver);
+           /**
+            * @brief Crea un cdigo sin datos con solo los patrones de funcin dibujados
+            * @param ver Versin (1-40)
+            *
+            * Solo se usa para construir las plantillas.
+            */
+    private: explicit QrCode(int ver);
           /**
            * @brief Obtiene la versin del cdigo QR
            * @return Versin (1-40)
@@ -261,6 +488,23 @@ namespace CodigoQR {
            * @return true si el mdulo est activo, false si es blanco
            */
     public: bool getModule(int x, int y) const;
+          /**
+           * @brief Obtiene la matriz empaquetada de mdulos
+           * @return Matriz de bits (1=negro) de getSize() x getSize()
+           */
+    public: const BitMatrix& getModules() const;
+          /**
+           * @brief Establece cuntos hilos se usan para elegir la mscara automticamente
+           * @param threads Nmero de hilos (0 = todos los ncleos, 1 = en serie)
+           *
+           * Los procesos por lotes que ya reparten cdigos entre hilos deben usar 1.
+           */
+    public: static void setMaskThreads(unsigned int threads);
+          /**
+           * @brief Obtiene cuntos hilos se usan para elegir la mscara automticamente
+           * @return Valor del ltimo setMaskThreads (0 = todos los ncleos)
+           */
+    public: static unsigned int getMaskThreads();
           /**
            * @brief Dibuja los patrones de funcin (fijos) en el cdigo QR
            */
@@ -270,6 +514,23 @@ namespace CodigoQR {
             * @param msk ndice del patrn de mscara
             */
     private: void drawFormatBits(int msk);
+           /**
+            * @brief Calcula los 15 bits de formato para un patrn de mscara
+            * @param msk ndice del patrn de mscara
+            * @return Bits de formato
+            */
+    private: int computeFormatBits(int msk) const;
+           /**
+            * @brief Escribe los bits de formato en una matriz
+            * @param bits Bits de formato
+            * @param target Matriz de destino
+            */
+    private: void placeFormatBits(int bits, BitMatrix& target) const;
+           /**
+            * @brief Evala las 8 mscaras y devuelve la de menor penalizacin
+            * @return ndice del patrn de mscara (0-7)
+            */
+    private: int chooseBestMask() const;
            /**
             * @brief Dibuja la informacin de versin (solo para versiones 7+)
             */
@@ -306,21 +567,35 @@ namespace CodigoQR {
             * @return Vector con datos y correccin de errores entrelazados
             */
     private: std::vector<std::uint8_t> addEccAndInterleave(const std::vector<std::uint8_t>& data) const;
+           /**
+            * @brief Calcula la posicin de cada bit de datos segn el recorrido en zigzag
+            * @return Posiciones de los mdulos de datos, en orden de colocacin
+            */
+    private: std::vector<std::uint32_t> computeDataPositions() const;
            /**
             * @brief Dibuja los datos codificados en el cdigo QR
             * @param data Datos codificados con correccin de errores
+            * @param positions Posiciones de los bits de datos de la plantilla de la versin
             */
-    private: void drawCodewords(const std::vector<std::uint8_t>& data);
+    private: void drawCodewords(const std::vector<std::uint8_t>& data, const std::vector<std::uint32_t>& positions);
            /**
             * @brief Aplica un patrn de mscara a los datos
             * @param msk ndice del patrn de mscara (0-7)
+            * @param target Matriz de mdulos sobre la que se aplica
             */
-    private: void applyMask(int msk);
+    private: void applyMask(int msk, BitMatrix& target) const;
            /**
             * @brief Calcula la puntuacin de penalizacin segn las reglas del estndar
+            * @param matrix Mdulos a evaluar
             * @return Puntuacin de penalizacin
             */
-    private: long getPenaltyScore() const;
+    private: long getPenaltyScore(const BitMatrix& matrix) const;
+           /**
+            * @brief Suma las penalizaciones N1 y N3 de todas las filas de una matriz
+            * @param matrix Mdulos (o su traspuesta, para evaluar las columnas)
+            * @return Penalizacin por rachas y patrones tipo buscador
+            */
+    private: long getRunPenalty(const BitMatrix& matrix) const;
            /**
             * @brief Obtiene las posiciones de los patrones de alineacin
             * @return Vector con posiciones de patrones de alineacin
@@ -340,18 +615,19 @@ namespace CodigoQR {
             */
     private: static int getNumDataCodewords(int ver, Ecc ecl);
            /**
-            * @brief Calcula el divisor Reed-Solomon para correccin de errores
+            * @brief Obtiene el divisor Reed-Solomon para correccin de errores
             * @param degree Grado del polinomio
-            * @return Vector con coeficientes del divisor
+            * @return Vector con coeficientes del divisor (calculado una vez por grado)
             */
-    private: static std::vector<std::uint8_t> reedSolomonComputeDivisor(int degree);
+    private: static const std::vector<std::uint8_t>& reedSolomonComputeDivisor(int degree);
            /**
             * @brief Calcula el resto Reed-Solomon para correccin de errores
             * @param data Datos originales
-            * @param divisor Divisor Reed-Solomon
-            * @return Vector con el resto de la divisin
+            * @param length Nmero de bytes de datos
+            * @param degree Grado del divisor (bytes de correccin)
+            * @param result Salida: degree bytes con el resto de la divisin
             */
-    private: static std::vector<std::uint8_t> reedSolomonComputeRemainder(const std::vector<std::uint8_t>& data, const std::vector<std::uint8_t>& divisor);
+    private: static void reedSolomonComputeRemainder(const std::uint8_t* data, std::size_t length, int degree, std::uint8_t* result);
            /**
             * @brief Multiplica dos valores en el campo finito GF(256)
             * @param x Primer valor
@@ -398,6 +674,8 @@ namespace CodigoQR {
     private: static const int PENALTY_N3;
            /** @brief Constante de penalizacin N4 */
     private: static const int PENALTY_N4;
+           /** @brief Versin mnima para evaluar las mscaras en paralelo */
+    private: static const int MIN_PARALLEL_MASK_VERSION;
            /** @brief Tabla de palabras cdigo de correccin de errores por bloque */
     private: static const std::int8_t ECC_CODEWORDS_PER_BLOCK[4][41];
            /** @brief Tabla de nmero de bloques de correccin de errores */
@@ -420,22 +698,150 @@ namespace CodigoQR {
     };
 
     /**
-     * @class BitBuffer
-     * @brief Buffer de bits para construir datos QR
+     * @class CacheCodigosQR
+     * @brief Cach LRU en memoria de cdigos QR ya generados
      *
-     * Extiende std::vector<bool> con mtodos para aadir bits de manera eficiente
+     * Las entradas se indexan por el texto codificado y el nivel de correccin
+     * pedido. Cada cdigo guarda su matriz de mdulos empaquetada, as que volver
+     * a pedir el QR de una cuenta cuesta una bsqueda en tabla hash en lugar de
+     * repetir segmentacin, Reed-Solomon y eleccin de mscara.
+     *
+     * El tamao est limitado por un presupuesto de memoria: al superarlo se
+     * descartan los cdigos usados hace ms tiempo. Se puede consultar desde
+     * varios hilos a la vez.
      */
-    class BitBuffer final : public std::vector<bool> {
+    class CacheCodigosQR final {
+        /** @brief Presupuesto de memoria por defecto (4 MB) */
+    public: static const std::size_t PRESUPUESTO_PREDETERMINADO = 4 * 1024 * 1024;
+          /**
+           * @brief Crea una cach vaca
+           * @param presupuestoBytes Memoria mxima estimada para las entradas
+           */
+    public: explicit CacheCodigosQR(std::size_t presupuestoBytes = PRESUPUESTO_PREDETERMINADO);
+          /**
+           * @brief Devuelve el cdigo QR de un texto, generndolo solo si no est en cach
+           * @param datos Texto a codificar
+           * @param ecl Nivel de correccin de errores
+           * @return Cdigo QR compartido (se genera con QrCode::encodeTextOptimal)
+           */
+    public: std::shared_ptr<const QrCode> obtener(const std::string& datos, QrCode::Ecc ecl);
+          /**
+           * @brief Cambia el presupuesto de memoria, descartando entradas si hace falta
+           * @param presupuestoBytes Nueva memoria mxima estimada
+           */
+    public: void setPresupuesto(std::size_t presupuestoBytes);
+          /** @brief Presupuesto de memoria en bytes */
+    public: std::size_t getPresupuesto() const;
+          /** @brief Memoria estimada ocupada por las entradas */
+    public: std::size_t getBytesUsados() const;
+          /** @brief Nmero de cdigos guardados */
+    public: std::size_t getEntradas() const;
+          /** @brief Nmero de consultas resueltas desde la cach */
+    public: std::size_t getAciertos() const;
+          /** @brief Nmero de consultas que obligaron a generar el cdigo */
+    public: std::size_t getFallos() const;
+          /**
+           * @brief Elimina todas las entradas y reinicia los contadores
+           */
+    public: void vaciar();
+          /**
+           * @brief Cach compartida por el men interactivo y la exportacin masiva
+           * @return Instancia nica, creada en el primer uso
+           */
+    public: static CacheCodigosQR& compartida();
+
+          /**
+           * @struct Entrada
+           * @brief Cdigo guardado junto con su clave y su tamao estimado
+           */
+    private: struct Entrada {
+        std::string clave;
+        std::shared_ptr<const QrCode> codigo;
+        std::size_t bytes;
+    };
+           /**
+            * @brief Descarta las entradas menos usadas hasta respetar el presupuesto
+            *
+            * Se llama con el mutex tomado.
+            */
+    private: void recortar();
+           /**
+            * @brief Estima la memoria que ocupa una entrada
+            * @param clave Clave de la entrada
+            * @param qr Cdigo guardado
+            * @return Bytes aproximados (matriz, clave y estructuras de la cach)
+            */
+    private: static std::size_t estimarBytes(const std::string& clave, const QrCode& qr);
+
+           /** @brief Entradas de la ms reciente (principio) a la ms antigua (final) */
+    private: std::list<Entrada> entradas;
+           /** @brief Posicin de cada clave en la lista */
+    private: std::unordered_map<std::string, std::list<Entrada>::iterator> indice;
+           /** @brief Protege la lista, el ndice y los contadores */
+    private: mutable std::mutex mtx;
+    private: std::size_t presupuesto;
+    private: std::size_t bytesUsados;
+    private: std::size_t aciertos;
+    private: std::size_t fallos;
+    };
+
+    /**
+     * @enum ModoTextoQR
+     * @brief Formas de dibujar un cdigo QR como texto
+     */
+    enum class ModoTextoQR {
+        MEDIOS_BLOQUES, ///< Medios bloques Unicode (U+2580, U+2584, U+2588): dos filas de mdulos por lnea
+        ANSI,           ///< Medios bloques con colores ANSI fijos (negro sobre blanco), legible con cualquier tema
+        ASCII           ///< Solo ASCII ("##" por mdulo oscuro), una fila de mdulos por lnea
+    };
+
+    /**
+     * @class RenderizadorTextoQR
+     * @brief Dibuja un cdigo QR como texto en un nico buffer
+     *
+     * Todo el cdigo se compone en memoria y se escribe con una sola operacin,
+     * en lugar de enviar cada mdulo a la consola por separado. En los modos de
+     * medios bloques cada lnea de texto representa dos filas de mdulos, con lo
+     * que el cdigo ocupa la mitad de alto y queda aproximadamente cuadrado.
+     *
+     * Los glifos se escriben como bytes UTF-8 explcitos, as que el resultado no
+     * depende de la pgina de cdigos con la que se compile el programa; la consola
+     * debe estar en UTF-8 (SetConsoleOutputCP(CP_UTF8)) para mostrarlos.
+     */
+    class RenderizadorTextoQR final {
         /**
-         * @brief Constructor por defecto
+         * @brief Compone el cdigo QR como texto
+         * @param qr Cdigo QR
+         * @param modo Forma de dibujarlo
+         * @param zonaSilencio Mdulos claros alrededor del cdigo
+         * @return Texto con una lnea por cada fila (o par de filas) de mdulos
          */
-    public: BitBuffer();
+    public: static std::string renderizar(const QrCode& qr, ModoTextoQR modo, int zonaSilencio = 2);
           /**
-           * @brief Aade bits al buffer
-           * @param val Valor a codificar
-           * @param len Nmero de bits a usar (desde el LSB)
+           * @brief Compone el cdigo QR y lo escribe de una sola vez
+           * @param qr Cdigo QR
+           * @param modo Forma de dibujarlo
+           * @param salida Flujo de destino
+           * @return Nmero de bytes escritos
            */
-    public: void appendBits(std::uint32_t val, int len);
+    public: static std::size_t imprimir(const QrCode& qr, ModoTextoQR modo, std::ostream& salida);
+          /**
+           * @brief Guarda el cdigo QR como archivo de texto UTF-8
+           * @param qr Cdigo QR
+           * @param ruta Ruta del archivo
+           * @param modo Forma de dibujarlo (ANSI solo tiene sentido si se mostrar en una terminal)
+           * @return true si se escribi correctamente
+           */
+    public: static bool guardar(const QrCode& qr, const std::string& ruta, ModoTextoQR modo);
+          /**
+           * @brief Elige el modo ms adecuado para la consola actual
+           * @return ANSI si la terminal interpreta secuencias de escape; si no,
+           *         medios bloques (Windows o locale UTF-8) o ASCII
+           *
+           * En Windows intenta activar el procesamiento de secuencias virtuales de
+           * la consola.
+           */
+    public: static ModoTextoQR detectarModo();
     };
 
     /**
@@ -458,8 +864,21 @@ namespace CodigoQR {
             * @return Texto formateado con nombre y nmero de cuenta
             */
     private: std::string generarCadenaTextoPlano() const {
-        std::string resultado = "NOMBRE: " + nombreCompleto + "\n";
-        resultado += "CUENTA: " + numeroCuenta;
+        return formatearDatos(nombreCompleto, numeroCuenta);
+    }
+
+           /**
+            * @brief Da formato de texto plano a los datos de una cuenta
+            * @param nombre Nombre completo del titular
+            * @param cuenta Nmero de cuenta bancaria
+            * @return Texto "NOMBRE: ...\nCUENTA: ..." que se codifica en el QR
+            *
+            * Es el mismo formato que usa generarQR, para que los procesos por lotes
+            * produzcan exactamente los mismos cdigos.
+            */
+    public: static std::string formatearDatos(const std::string& nombre, const std::string& cuenta) {
+        std::string resultado = "NOMBRE: " + nombre + "\n";
+        resultado += "CUENTA: " + cuenta;
         return resultado;
     }
 
@@ -486,17 +905,36 @@ namespace CodigoQR {
 
         std::cout << "Generando cdigo QR..." << std::endl;
 
-        // Generamos el cdigo QR con la biblioteca (nivel de correccin LOW = L)
-        qr = CodigoQR::QrCode::encodeText(datosTexto.c_str(), CodigoQR::QrCode::Ecc::LOW);
+        // Generamos el cdigo QR con la biblioteca (nivel de correccin LOW = L);
+        // si ya se gener para esta cuenta, se reutiliza desde la cach
+        qr = *CacheCodigosQR::compartida().obtener(datosTexto, CodigoQR::QrCode::Ecc::LOW);
 
         std::cout << "Cdigo QR generado correctamente." << std::endl;
     }
 
+          /**
+           * @brief Describe un nivel de correccin de errores
+           * @param ecl Nivel de correccin
+           * @return Letra del nivel y porcentaje de errores que tolera
+           *
+           * La segmentacin ptima puede dejar espacio libre y el codificador sube
+           * entonces el nivel de correccin, as que no siempre es L.
+           */
+    private: static const char* describirNivelCorreccion(CodigoQR::QrCode::Ecc ecl) {
+        switch (ecl) {
+        case CodigoQR::QrCode::Ecc::MEDIUM: return "M (permite hasta 15% de errores)";
+        case CodigoQR::QrCode::Ecc::QUARTILE: return "Q (permite hasta 25% de errores)";
+        case CodigoQR::QrCode::Ecc::HIGH: return "H (permite hasta 30% de errores)";
+        default: return "L (permite hasta 7% de errores)";
+        }
+    }
+
           /**
            * @brief Imprime el cdigo QR en la consola
            *
-           * Muestra una representacin visual del cdigo QR utilizando caracteres ASCII,
-           * junto con informacin tcnica sobre el cdigo.
+           * Muestra el cdigo QR con medios bloques (o ASCII si la terminal no admite
+           * UTF-8) mediante RenderizadorTextoQR, junto con informacin tcnica sobre
+           * el cdigo.
            */
     public: void imprimirEnConsola() const {
         if (qr.getSize() == 0) {
@@ -509,49 +947,62 @@ namespace CodigoQR {
         std::cout << "- Nmero de cuenta: " << numeroCuenta << std::endl;
         std::cout << "\nCdigo QR:\n" << std::endl;
 
-        const int quietZone = 4;
-        const int size = qr.getSize() + quietZone * 2;
-
-        // Borde superior
-        for (int i = 0; i < size; i++) {
-            std::cout << "??";
-        }
-        std::cout << std::endl;
-
-        // Imprimir QR con bordes
-        for (int y = -quietZone; y < qr.getSize() + quietZone; y++) {
-            std::cout << "????"; // Borde izquierdo extra
-            for (int x = -quietZone; x < qr.getSize() + quietZone; x++) {
-                bool module = (x >= 0 && y >= 0 && x < qr.getSize() && y < qr.getSize()) && qr.getModule(x, y);
-                std::cout << (module ? "??" : "  ");
-            }
-            std::cout << "????" << std::endl; // Borde derecho extra
-        }
-
-        // Borde inferior
-        for (int i = 0; i < size; i++) {
-            std::cout << "??";
-        }
-        std::cout << std::endl;
+        // Se compone todo el cdigo en un buffer y se escribe de una vez
+        auto inicio = std::chrono::steady_clock::now();
+        std::size_t bytes = RenderizadorTextoQR::imprimir(qr, RenderizadorTextoQR::detectarModo(), std::cout);
+        double microsegundos = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - inicio).count();
 
         // Informacin tcnica
         std::cout << "\nInformacin tcnica:" << std::endl;
         std::cout << "- Versin: " << qr.getVersion() << std::endl;
         std::cout << "- Tamao: " << qr.getSize() << "x" << qr.getSize() << " mdulos" << std::endl;
-        std::cout << "- Nivel de correccin: L (permite hasta 7% de errores)" << std::endl;
+        std::cout << "- Nivel de correccin: " << describirNivelCorreccion(qr.getErrorCorrectionLevel()) << std::endl;
         std::cout << "- Mscara aplicada: " << qr.getMask() << std::endl;
+        std::cout << "- Salida en consola: " << bytes << " bytes en " << std::fixed << std::setprecision(0)
+            << microsegundos << " us" << std::defaultfloat << std::endl;
+        const CacheCodigosQR& cache = CacheCodigosQR::compartida();
+        std::cout << "- Cach de cdigos: " << cache.getAciertos() << " aciertos, " << cache.getFallos()
+            << " fallos, " << cache.getEntradas() << " cdigos (" << cache.getBytesUsados() / 1024 << " KB)" << std::endl;
         std::cout << "- Formato: Texto plano (NOMBRE: " << nombreCompleto << ", CUENTA: " << numeroCuenta << ")" << std::endl;
         std::cout << "\nEste QR puede ser escaneado por cualquier lector QR estndar." << std::endl;
         std::cout << "Al escanearlo, el mvil mostrar los datos personales en formato texto." << std::endl;
     }
 
+          /** @brief Bytes de contenido que se acumulan antes de escribirlos en el PDF */
+    private: static const std::size_t TAMANIO_BLOQUE_PDF = 4096;
+
+           /**
+            * @brief Aade un nmero no negativo con tres decimales (como std::fixed con precisin 3)
+            * @param destino Cadena a la que se aade
+            * @param valor Nmero a escribir
+            *
+            * Evita el formateo de flujos, que domina el tiempo de escritura del PDF.
+            */
+    private: static void agregarDecimal(std::string& destino, double valor) {
+        unsigned long long milesimas = static_cast<unsigned long long>(valor * 1000.0 + 0.5);
+        char texto[32];
+        int posicion = sizeof(texto);
+        for (int i = 0; i < 3; i++) {
+            texto[--posicion] = static_cast<char>('0' + milesimas % 10);
+            milesimas /= 10;
+        }
+        texto[--posicion] = '.';
+        do {
+            texto[--posicion] = static_cast<char>('0' + milesimas % 10);
+            milesimas /= 10;
+        } while (milesimas != 0);
+        destino.append(texto + posicion, sizeof(texto) - posicion);
+    }
+
           /**
            * @brief Genera un archivo PDF con el cdigo QR
            * @param qr Objeto QR a convertir en PDF
            * @param nombreArchivo Ruta completa del archivo PDF a generar
            *
            * Crea un archivo PDF que contiene el cdigo QR con un tamao adecuado
-           * para ser escaneado fcilmente por dispositivos mviles.
+           * para ser escaneado fcilmente por dispositivos mviles. Cada tramo
+           * horizontal de mdulos oscuros es un solo rectngulo y el contenido se
+           * escribe directamente en el archivo, sin construirlo antes en memoria.
            */
     public: void generarPDFQR(const CodigoQR::QrCode& qr, const std::string& nombreArchivo) {
         if (qr.getSize() == 0) {
@@ -601,46 +1052,53 @@ namespace CodigoQR {
             << "/MediaBox [0 0 " << PAGE_WIDTH << " " << PAGE_HEIGHT << "] "
             << "/Contents 4 0 R>>\nendobj\n";
 
-        // Contenido (objeto 4) - Aqu va el QR
-        std::stringstream contenido;
-        contenido << "q\n"; // Guardar estado grfico
+        // Contenido (objeto 4) - Aqu va el QR. Se escribe directamente en el archivo;
+        // su longitud se guarda en el objeto 5, que se escribe al cerrar el flujo
+        objetos.push_back(pdf.tellp());
+        pdf << "4 0 obj\n<</Length 5 0 R>>\nstream\n";
+        std::streamoff inicioFlujo = pdf.tellp();
+        pdf << "q\n"; // Guardar estado grfico
 
         // Establecer color blanco y dibujar fondo
-        contenido << "1 1 1 rg\n"; // RGB blanco
-        contenido << "0 0 " << PAGE_WIDTH << " " << PAGE_HEIGHT << " re f\n";
+        pdf << "1 1 1 rg\n"; // RGB blanco
+        pdf << "0 0 " << PAGE_WIDTH << " " << PAGE_HEIGHT << " re f\n";
 
         // Establecer color negro slido para el QR
-        contenido << "0 0 0 rg\n"; // RGB negro
+        pdf << "0 0 0 rg\n"; // RGB negro
 
         // Definir rea de recorte y dibujo con margen extra para mejor contraste
-        contenido << MARGEN_EXTRA << " " << MARGEN_EXTRA << " "
+        pdf << MARGEN_EXTRA << " " << MARGEN_EXTRA << " "
             << (PAGE_WIDTH - 2 * MARGEN_EXTRA) << " "
             << (PAGE_HEIGHT - 2 * MARGEN_EXTRA) << " re W n\n";
 
-        // Dibujar mdulos del QR con mayor precisin
-        for (int y = 0; y < qr.getSize(); y++) {
-            for (int x = 0; x < qr.getSize(); x++) {
-                if (qr.getModule(x, y)) {
-                    // Calcular posicin con ms precisin
-                    double posX = MARGEN + x * MODULO_SIZE;
-                    double posY = MARGEN + (qr.getSize() - 1 - y) * MODULO_SIZE;
-                    // Usar un path ms eficiente para cada mdulo con tamao exacto
-                    contenido << std::fixed << std::setprecision(3)
-                        << posX << " " << posY << " "
-                        << MODULO_SIZE << " " << MODULO_SIZE << " re\n";
-                }
+        // Un rectngulo por cada tramo horizontal de mdulos oscuros. Las lneas se
+        // acumulan en un bloque pequeo que se vuelca al archivo cada pocos KB
+        std::string bloque;
+        bloque.reserve(TAMANIO_BLOQUE_PDF + 64);
+        qr.getModules().forEachRowRun([&](int y, int x, int longitud) {
+            agregarDecimal(bloque, MARGEN + x * MODULO_SIZE);
+            bloque += ' ';
+            agregarDecimal(bloque, MARGEN + (qr.getSize() - 1 - y) * MODULO_SIZE);
+            bloque += ' ';
+            agregarDecimal(bloque, longitud * MODULO_SIZE);
+            bloque += ' ';
+            agregarDecimal(bloque, MODULO_SIZE);
+            bloque += " re\n";
+            if (bloque.size() >= TAMANIO_BLOQUE_PDF) {
+                pdf.write(bloque.data(), static_cast<std::streamsize>(bloque.size()));
+                bloque.clear();
             }
-        }
-        // Rellenar todos los mdulos de una vez con mxima densidad
-        contenido << "f\n";
-        contenido << "Q\n"; // Restaurar estado grfico
+        });
+        pdf.write(bloque.data(), static_cast<std::streamsize>(bloque.size()));
+        // Rellenar todos los tramos de una vez
+        pdf << "f\n";
+        pdf << "Q\n"; // Restaurar estado grfico
+        std::streamoff longitudFlujo = pdf.tellp() - inicioFlujo;
+        pdf << "endstream\nendobj\n";
 
-        std::string contenidoStr = contenido.str();
+        // Longitud del contenido (objeto 5)
         objetos.push_back(pdf.tellp());
-        pdf << "4 0 obj\n"
-            << "<</Length " << contenidoStr.length() << ">>\nstream\n"
-            << contenidoStr
-            << "endstream\nendobj\n";
+        pdf << "5 0 obj\n" << longitudFlujo << "\nendobj\n";
 
         // xref
         size_t xrefPos = pdf.tellp();
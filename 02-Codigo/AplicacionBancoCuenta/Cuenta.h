@@ -5,7 +5,6 @@
 #include <iostream>
 #include <string>
 #include <fstream>
-#include <regex> // Incluye la libreria regex para validacion de fecha
 #include "Validar.h" // Incluye la clase de validacion
 #include "Fecha.h" // Incluye la clase Fecha para manejar fechas
 
@@ -5,13 +5,17 @@
 #include <fstream>
 #include <sstream>
 #include <iomanip>
+#include <stdexcept>
+#ifdef _WIN32
 #include <conio.h>
+#endif
 #include <limits>
 #include "Cuenta.h"
 #include "Validar.h"
 #include "Cifrado.h"
 #include "Fecha.h"
 #include "CuentaAhorros.h" 
+#include "Estadisticas.h"
 
 using namespace std;
 
@@ -25,6 +29,7 @@ using namespace std;
  * @param cantidad Monto a depositar en la cuenta
  */
 void CuentaAhorros::depositar(double cantidad) {
+	MEDIR_OPERACION(Operacion::Depositar);
 
 	if (cantidad <= 0) {
 		std::cout << "El monto debe ser mayor a cero.\n";
@@ -53,6 +58,7 @@ void CuentaAhorros::depositar(double cantidad) {
  * @param cantidad Monto a retirar de la cuenta
  */
 void CuentaAhorros::retirar(double cantidad) {
+	MEDIR_OPERACION(Operacion::Retirar);
 	if (cantidad <= this->saldo) {
 		this->saldo -= cantidad;
 	}
@@ -98,7 +104,17 @@ std::string CuentaAhorros::formatearConComas(double saldo) const {
 	// Convertir de centavos a valor decimal
 	double valorReal = saldo;
 	std::ostringstream oss;
-	oss.imbue(std::locale("en_US.UTF-8")); // Usar formato americano: 1,234.56
+	// Formato americano (1,234.56), resuelto una sola vez; sin esa localizacion
+	// instalada se usa la clasica, sin separador de miles
+	static const std::locale americano = []() {
+		try {
+			return std::locale("en_US.UTF-8");
+		}
+		catch (const std::runtime_error&) {
+			return std::locale::classic();
+		}
+	}();
+	oss.imbue(americano);
 	oss << std::fixed << std::setprecision(2) << valorReal;
 	return oss.str();
 }
@@ -148,8 +164,12 @@ void CuentaAhorros::mostrarInformacion(const std::string& cedula = "", bool limp
 	// Pie de pagina
 	std::cout << "\n" << std::string(50, '-') << std::endl;
 	std::cout << "Presione cualquier tecla para continuar..." << std::endl;
+#ifdef _WIN32
 	int tecla = _getch();
 	(void)tecla;
+#else
+	std::cin.get();
+#endif
 }
 
 /**
@@ -4,12 +4,16 @@
 #include <fstream>
 #include <sstream>
 #include <iomanip>
+#include <stdexcept>
+#ifdef _WIN32
 #include <conio.h>
+#endif
 #include "Cuenta.h"
 #include "Validar.h"
 #include "Cifrado.h"
 #include "Fecha.h"
 #include "CuentaCorriente.h"
+#include "Estadisticas.h"
 
 using namespace std;
 
@@ -22,6 +26,7 @@ using namespace std;
  * @param cantidad Monto a depositar en la cuenta
  */
 void CuentaCorriente::depositar(double cantidad) {
+	MEDIR_OPERACION(Operacion::Depositar);
 	if (cantidad > 0) {
 		this->saldo += cantidad;
 	}
@@ -38,6 +43,7 @@ void CuentaCorriente::depositar(double cantidad) {
  * @param cantidad Monto a retirar de la cuenta
  */
 void CuentaCorriente::retirar(double cantidad) {
+	MEDIR_OPERACION(Operacion::Retirar);
 	if (cantidad <= this->saldo) {
 		this->saldo -= cantidad;
 	}
@@ -83,7 +89,17 @@ std::string CuentaCorriente::formatearConComas(double saldo) const {
 	// Convertir de centavos a valor decimal
 	double valorReal = saldo / 100.0;
 	std::ostringstream oss;
-	oss.imbue(std::locale("en_US.UTF-8")); // Usar formato americano: 1,234.56
+	// Formato americano (1,234.56), resuelto una sola vez; sin esa localizacion
+	// instalada se usa la clasica, sin separador de miles
+	static const std::locale americano = []() {
+		try {
+			return std::locale("en_US.UTF-8");
+		}
+		catch (const std::runtime_error&) {
+			return std::locale::classic();
+		}
+	}();
+	oss.imbue(americano);
 	oss << std::fixed << std::setprecision(2) << valorReal;
 	return oss.str();
 }
@@ -136,8 +152,12 @@ void CuentaCorriente::mostrarInformacion(const std::string& cedula = "", bool li
 	// Pie de pagina
 	std::cout << "\n" << std::string(50, '-') << std::endl;
 	std::cout << "Presione cualquier tecla para continuar..." << std::endl;
+#ifdef _WIN32
 	int tecla = _getch();
 	(void)tecla;
+#else
+	std::cin.get();
+#endif
 	// Limpieza de pantalla
 	std::system("cls");
 }
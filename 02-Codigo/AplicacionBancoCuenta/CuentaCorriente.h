@@ -85,14 +85,14 @@ public:
      * @param cuentaSiguiente Puntero a la siguiente cuenta
      * @return Puntero a esta cuenta
      */
-    CuentaCorriente* setSiguiente(CuentaCorriente* cuentaSiguiente) { this->siguiente = siguiente; return this; }
+    CuentaCorriente* setSiguiente(CuentaCorriente* cuentaSiguiente) { this->siguiente = cuentaSiguiente; return this; }
 
     /**
      * @brief Establece la cuenta anterior en la lista enlazada
      * @param cuentaAnterior Puntero a la cuenta anterior
      * @return Puntero a esta cuenta
      */
-    CuentaCorriente* setAnterior(CuentaCorriente* cuentaAnterior) { this->anterior = anterior; return this; }
+    CuentaCorriente* setAnterior(CuentaCorriente* cuentaAnterior) { this->anterior = cuentaAnterior; return this; }
 
     /**
      * @brief Obtiene el monto mnimo de la cuenta
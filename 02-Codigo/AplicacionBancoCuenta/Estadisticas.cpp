@@ -0,0 +1,283 @@
+/**
+ * @file Estadisticas.cpp
+ * @brief Histogramas de latencia por operación, uno por hilo y sin bloqueos al registrar
+ */
+#include "Estadisticas.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace {
+
+    const size_t NUM_OPERACIONES = static_cast<size_t>(Operacion::Total);
+
+    /**
+     * @struct HistogramasHilo
+     * @brief Histogramas de un hilo; solo ese hilo los escribe
+     *
+     * Los contadores son atómicos para que el resumen los lea mientras el hilo
+     * registra; como hay un solo escritor, cada registro es una lectura y una
+     * escritura simples, sin fetch_add ni compare_exchange.
+     */
+    struct HistogramasHilo {
+        std::atomic<uint64_t> cubetas[NUM_OPERACIONES][Estadisticas::CUBETAS];
+        std::atomic<uint64_t> maximo[NUM_OPERACIONES];
+
+        HistogramasHilo() { poner0(); }
+
+        void poner0() {
+            for (size_t o = 0; o < NUM_OPERACIONES; ++o) {
+                for (size_t c = 0; c < Estadisticas::CUBETAS; ++c) {
+                    cubetas[o][c].store(0, std::memory_order_relaxed);
+                }
+                maximo[o].store(0, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    /**
+     * @struct Registro
+     * @brief Histogramas de todos los hilos que han registrado algo
+     *
+     * Los de un hilo que termina se conservan hasta el final del programa.
+     */
+    struct Registro {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<HistogramasHilo>> hilos;
+    };
+
+    Registro& registro() {
+        static Registro instancia;
+        return instancia;
+    }
+
+    thread_local HistogramasHilo* histogramasHilo = nullptr;
+
+    /** @brief Reserva los histogramas del hilo que llama y los agrega al registro */
+    HistogramasHilo* crearHistogramasHilo() {
+        std::unique_ptr<HistogramasHilo> nuevos(new HistogramasHilo());
+        HistogramasHilo* propios = nuevos.get();
+        Registro& r = registro();
+        std::lock_guard<std::mutex> bloqueo(r.mutex);
+        r.hilos.push_back(std::move(nuevos));
+        return propios;
+    }
+
+    /**
+     * @brief Posición del bit en 1 más significativo
+     *
+     * @param v Palabra de 64 bits distinta de 0
+     * @return Índice del bit, de 0 a 63
+     */
+    inline int bitMasAlto(uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63 - __builtin_clzll(v);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        unsigned long indice;
+        _BitScanReverse64(&indice, v);
+        return static_cast<int>(indice);
+#else
+        int indice = 0;
+        while (v >>= 1) ++indice;
+        return indice;
+#endif
+    }
+
+    /**
+     * @brief Percentil por rango más cercano de un histograma
+     *
+     * @param cubetas Cuentas por cubeta
+     * @param cantidad Suma de las cuentas, mayor que 0
+     * @param percentil Percentil de 0 a 100
+     * @return Límite superior de la cubeta del percentil
+     */
+    uint64_t percentil(const std::vector<uint64_t>& cubetas, uint64_t cantidad, double percentil) {
+        uint64_t rango = static_cast<uint64_t>(std::ceil(percentil / 100.0 * static_cast<double>(cantidad)));
+        if (rango < 1) rango = 1;
+        uint64_t acumulado = 0;
+        for (size_t c = 0; c < cubetas.size(); ++c) {
+            acumulado += cubetas[c];
+            if (acumulado >= rango) return Estadisticas::limiteSuperior(c);
+        }
+        return Estadisticas::NS_MAXIMO;
+    }
+}
+
+/**
+ * @brief Registra una duración en el histograma del hilo que llama
+ *
+ * @param operacion Operación medida
+ * @param nanosegundos Duración
+ */
+void Estadisticas::registrar(Operacion operacion, uint64_t nanosegundos) {
+    HistogramasHilo* propios = histogramasHilo;
+    if (propios == nullptr) {
+        propios = histogramasHilo = crearHistogramasHilo();
+    }
+    if (nanosegundos > NS_MAXIMO) nanosegundos = NS_MAXIMO;
+    const size_t o = static_cast<size_t>(operacion);
+
+    std::atomic<uint64_t>& contador = propios->cubetas[o][cubeta(nanosegundos)];
+    contador.store(contador.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    if (nanosegundos > propios->maximo[o].load(std::memory_order_relaxed)) {
+        propios->maximo[o].store(nanosegundos, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Cubeta de una duración
+ *
+ * Por debajo de 2 * SUBCUBETAS la cubeta es el valor; por encima, los
+ * BITS_SUBCUBETA + 1 bits más altos del valor y su posición.
+ *
+ * @param nanosegundos Duración, a lo sumo NS_MAXIMO
+ * @return size_t Índice de la cubeta
+ */
+size_t Estadisticas::cubeta(uint64_t nanosegundos) {
+    if (nanosegundos < SUBCUBETAS) return static_cast<size_t>(nanosegundos);
+    const int desplazamiento = bitMasAlto(nanosegundos) - BITS_SUBCUBETA;
+    return static_cast<size_t>(desplazamiento) * SUBCUBETAS + static_cast<size_t>(nanosegundos >> desplazamiento);
+}
+
+/**
+ * @brief Mayor duración que cae en una cubeta
+ *
+ * @param indice Índice de la cubeta
+ * @return uint64_t Nanosegundos
+ */
+uint64_t Estadisticas::limiteSuperior(size_t indice) {
+    if (indice < 2 * SUBCUBETAS) return indice;
+    const int desplazamiento = static_cast<int>(indice / SUBCUBETAS) - 1;
+    const uint64_t mantisa = (indice % SUBCUBETAS) + SUBCUBETAS;
+    return ((mantisa + 1) << desplazamiento) - 1;
+}
+
+/**
+ * @brief Suma los histogramas de todos los hilos
+ *
+ * @return std::vector<ResumenOperacion> Operaciones con al menos un registro
+ */
+std::vector<ResumenOperacion> Estadisticas::resumen() {
+    std::vector<std::vector<uint64_t>> cubetas(NUM_OPERACIONES, std::vector<uint64_t>(CUBETAS, 0));
+    std::vector<uint64_t> maximos(NUM_OPERACIONES, 0);
+    {
+        Registro& r = registro();
+        std::lock_guard<std::mutex> bloqueo(r.mutex);
+        for (const std::unique_ptr<HistogramasHilo>& hilo : r.hilos) {
+            for (size_t o = 0; o < NUM_OPERACIONES; ++o) {
+                for (size_t c = 0; c < CUBETAS; ++c) {
+                    cubetas[o][c] += hilo->cubetas[o][c].load(std::memory_order_relaxed);
+                }
+                const uint64_t maximo = hilo->maximo[o].load(std::memory_order_relaxed);
+                if (maximo > maximos[o]) maximos[o] = maximo;
+            }
+        }
+    }
+
+    std::vector<ResumenOperacion> operaciones;
+    for (size_t o = 0; o < NUM_OPERACIONES; ++o) {
+        uint64_t cantidad = 0;
+        for (uint64_t n : cubetas[o]) cantidad += n;
+        if (cantidad == 0) continue;
+
+        ResumenOperacion resultado;
+        resultado.nombre = nombre(static_cast<Operacion>(o));
+        resultado.cantidad = cantidad;
+        resultado.nsMaximo = maximos[o];
+        // El límite de la cubeta puede pasar del máximo observado
+        resultado.nsP50 = std::min(percentil(cubetas[o], cantidad, 50.0), maximos[o]);
+        resultado.nsP99 = std::min(percentil(cubetas[o], cantidad, 99.0), maximos[o]);
+        operaciones.push_back(resultado);
+    }
+    return operaciones;
+}
+
+/**
+ * @brief Escribe un resumen como tabla de texto, con los tiempos en la unidad más legible
+ *
+ * @param salida Destino
+ * @param operaciones Resumen de cada operación
+ */
+void Estadisticas::escribirTabla(std::ostream& salida, const std::vector<ResumenOperacion>& operaciones) {
+    auto tiempo = [](uint64_t ns) {
+        char texto[32];
+        if (ns < 10000) std::snprintf(texto, sizeof(texto), "%llu ns", static_cast<unsigned long long>(ns));
+        else if (ns < 10000000) std::snprintf(texto, sizeof(texto), "%.1f us", ns / 1e3);
+        else if (ns < 10000000000ULL) std::snprintf(texto, sizeof(texto), "%.1f ms", ns / 1e6);
+        else std::snprintf(texto, sizeof(texto), "%.1f s", ns / 1e9);
+        return std::string(texto);
+    };
+
+    char linea[128];
+    std::snprintf(linea, sizeof(linea), "%-24s %12s %12s %12s %12s\n", "Operacion", "Cantidad", "p50", "p99", "Maximo");
+    salida << linea;
+    for (const ResumenOperacion& o : operaciones) {
+        std::snprintf(linea, sizeof(linea), "%-24s %12llu %12s %12s %12s\n", o.nombre.c_str(),
+            static_cast<unsigned long long>(o.cantidad), tiempo(o.nsP50).c_str(), tiempo(o.nsP99).c_str(),
+            tiempo(o.nsMaximo).c_str());
+        salida << linea;
+    }
+}
+
+/**
+ * @brief Escribe el resumen actual en un CSV
+ *
+ * @param ruta Ruta del archivo
+ * @return int Operaciones escritas, o -1 si no se pudo escribir
+ */
+int Estadisticas::guardarEnRuta(const std::string& ruta) {
+    const std::vector<ResumenOperacion> operaciones = resumen();
+    std::ofstream archivo(ruta);
+    if (!archivo) return -1;
+    archivo << "operacion,cantidad,ns_p50,ns_p99,ns_max\n";
+    for (const ResumenOperacion& o : operaciones) {
+        archivo << o.nombre << ',' << o.cantidad << ',' << o.nsP50 << ',' << o.nsP99 << ',' << o.nsMaximo << '\n';
+    }
+    archivo.close();
+    return archivo ? static_cast<int>(operaciones.size()) : -1;
+}
+
+/**
+ * @brief Pone en cero los histogramas de todos los hilos
+ */
+void Estadisticas::reiniciar() {
+    Registro& r = registro();
+    std::lock_guard<std::mutex> bloqueo(r.mutex);
+    for (const std::unique_ptr<HistogramasHilo>& hilo : r.hilos) {
+        hilo->poner0();
+    }
+}
+
+/**
+ * @brief Nombre de una operación
+ *
+ * @param operacion Operación
+ * @return const char* Nombre corto
+ */
+const char* Estadisticas::nombre(Operacion operacion) {
+    switch (operacion) {
+    case Operacion::Depositar: return "depositar";
+    case Operacion::Retirar: return "retirar";
+    case Operacion::Transferir: return "transferir";
+    case Operacion::BuscarCedula: return "buscar_cedula";
+    case Operacion::BuscarCuenta: return "buscar_cuenta";
+    case Operacion::GuardarRespaldo: return "guardar_respaldo";
+    case Operacion::CargarRespaldo: return "cargar_respaldo";
+    case Operacion::GuardarCuentasPersona: return "guardar_cuentas_persona";
+    case Operacion::CrearNumeroCuenta: return "crear_numero_cuenta";
+    case Operacion::CifrarArchivo: return "cifrar_archivo";
+    case Operacion::DescifrarArchivo: return "descifrar_archivo";
+    case Operacion::CalcularHash: return "calcular_hash";
+    case Operacion::VerificarDirectorio: return "verificar_directorio";
+    case Operacion::FormatearMonto: return "formatear_monto";
+    default: return "desconocida";
+    }
+}
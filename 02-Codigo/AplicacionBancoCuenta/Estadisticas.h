@@ -0,0 +1,182 @@
+#pragma once
+#ifndef ESTADISTICAS_H
+#define ESTADISTICAS_H
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include <ostream>
+#include <vector>
+
+/**
+ * @def BANCO_ESTADISTICAS
+ * @brief 1 para medir las operaciones, 0 para compilar sin las mediciones
+ *
+ * Con 0, MEDIR_OPERACION no genera código y las estadísticas quedan vacías.
+ */
+#ifndef BANCO_ESTADISTICAS
+#define BANCO_ESTADISTICAS 1
+#endif
+
+/**
+ * @enum Operacion
+ * @brief Operaciones cuya duración se registra
+ */
+enum class Operacion {
+    Depositar,
+    Retirar,
+    Transferir,
+    BuscarCedula,
+    BuscarCuenta,
+    GuardarRespaldo,
+    CargarRespaldo,
+    GuardarCuentasPersona,
+    CrearNumeroCuenta,
+    CifrarArchivo,
+    DescifrarArchivo,
+    CalcularHash,
+    VerificarDirectorio,
+    FormatearMonto,
+    /** @brief Número de operaciones; no es una operación */
+    Total
+};
+
+/**
+ * @struct ResumenOperacion
+ * @brief Duraciones registradas de una operación, en nanosegundos
+ */
+struct ResumenOperacion {
+    /** @brief Nombre de la operación */
+    std::string nombre;
+    /** @brief Veces que se registró */
+    uint64_t cantidad = 0;
+    uint64_t nsP50 = 0;
+    uint64_t nsP99 = 0;
+    uint64_t nsMaximo = 0;
+};
+
+/**
+ * @class Estadisticas
+ * @brief Clase estática con histogramas de latencia por operación
+ *
+ * Cada hilo registra en sus propios histogramas, sin bloqueos: el primer
+ * registro de un hilo reserva sus histogramas y los agrega a una lista común;
+ * después solo escribe contadores atómicos que nadie más escribe. El resumen
+ * suma los histogramas de todos los hilos.
+ *
+ * Los histogramas son logarítmicos con SUBCUBETAS divisiones por potencia de
+ * dos, como los HDR: hasta 63 ns cada cubeta es un nanosegundo y desde ahí el
+ * error de un percentil es menor que 1/SUBCUBETAS (3 %). El máximo es exacto.
+ */
+class Estadisticas {
+public:
+    /**
+     * @brief Registra una duración en el histograma del hilo que llama
+     * @param operacion Operación medida
+     * @param nanosegundos Duración; las mayores que NS_MAXIMO se registran como NS_MAXIMO
+     */
+    static void registrar(Operacion operacion, uint64_t nanosegundos);
+
+    /**
+     * @brief Suma los histogramas de todos los hilos
+     * @return Operaciones registradas al menos una vez, en el orden de Operacion
+     */
+    static std::vector<ResumenOperacion> resumen();
+
+    /**
+     * @brief Escribe un resumen como tabla de texto
+     * @param salida Destino
+     * @param operaciones Resultado de resumen()
+     */
+    static void escribirTabla(std::ostream& salida, const std::vector<ResumenOperacion>& operaciones);
+
+    /**
+     * @brief Escribe el resumen actual en un CSV
+     *
+     * Columnas: operacion,cantidad,ns_p50,ns_p99,ns_max
+     *
+     * @param ruta Ruta del archivo
+     * @return Operaciones escritas, o -1 si no se pudo escribir el archivo
+     */
+    static int guardarEnRuta(const std::string& ruta);
+
+    /**
+     * @brief Pone en cero los histogramas de todos los hilos
+     *
+     * Un registro que ocurra al mismo tiempo puede perderse.
+     */
+    static void reiniciar();
+
+    /**
+     * @brief Nombre de una operación
+     * @param operacion Operación
+     * @return Nombre corto, sin espacios ni comas
+     */
+    static const char* nombre(Operacion operacion);
+
+    /** @brief false si se compiló con BANCO_ESTADISTICAS en 0 */
+    static bool activas() { return BANCO_ESTADISTICAS != 0; }
+
+    /**
+     * @brief Cubeta de una duración
+     * @param nanosegundos Duración, a lo sumo NS_MAXIMO
+     * @return Índice menor que CUBETAS
+     */
+    static size_t cubeta(uint64_t nanosegundos);
+
+    /**
+     * @brief Mayor duración que cae en una cubeta
+     * @param indice Índice menor que CUBETAS
+     * @return Nanosegundos
+     */
+    static uint64_t limiteSuperior(size_t indice);
+
+    /** @brief Bits de la subdivisión de cada potencia de dos */
+    static const int BITS_SUBCUBETA = 5;
+    /** @brief Divisiones de cada potencia de dos */
+    static const size_t SUBCUBETAS = size_t(1) << BITS_SUBCUBETA;
+    /** @brief Bits de la mayor duración registrable */
+    static const int BITS_MAXIMO = 40;
+    /** @brief Mayor duración registrable: unos 18 minutos */
+    static const uint64_t NS_MAXIMO = (uint64_t(1) << BITS_MAXIMO) - 1;
+    /** @brief Cubetas de cada histograma */
+    static const size_t CUBETAS = (BITS_MAXIMO - BITS_SUBCUBETA + 1) * SUBCUBETAS;
+};
+
+/**
+ * @class MedicionOperacion
+ * @brief Mide el tiempo entre su construcción y su destrucción y lo registra
+ *
+ * Se usa mediante MEDIR_OPERACION, que desaparece si BANCO_ESTADISTICAS es 0.
+ */
+class MedicionOperacion {
+public:
+    explicit MedicionOperacion(Operacion operacion)
+        : operacion(operacion), inicio(std::chrono::steady_clock::now()) {}
+
+    ~MedicionOperacion() {
+        const auto duracion = std::chrono::steady_clock::now() - inicio;
+        Estadisticas::registrar(operacion, static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(duracion).count()));
+    }
+
+    MedicionOperacion(const MedicionOperacion&) = delete;
+    MedicionOperacion& operator=(const MedicionOperacion&) = delete;
+
+private:
+    Operacion operacion;
+    std::chrono::steady_clock::time_point inicio;
+};
+
+/**
+ * @def MEDIR_OPERACION
+ * @brief Registra la duración del resto del bloque como la operación indicada
+ */
+#if BANCO_ESTADISTICAS
+#define MEDIR_OPERACION(operacion) MedicionOperacion medicionOperacion_(operacion)
+#else
+#define MEDIR_OPERACION(operacion) ((void)0)
+#endif
+
+#endif // ESTADISTICAS_H
@@ -0,0 +1,304 @@
+/**
+ * @file ExportadorQR.cpp
+ * @brief Exportación masiva de los códigos QR de todas las cuentas en paralelo
+ */
+#include "ExportadorQR.h"
+#include "Persona.h"
+#include "Hash.h"
+#include "Paralelo.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/stat.h>
+#endif
+
+namespace {
+    /** @brief Prefijo del comentario que guarda la huella en cada archivo */
+    const char* const ETIQUETA_HUELLA = "huella-sha256: ";
+
+    /** @brief Bytes que se acumulan antes de escribirlos en el archivo */
+    const size_t TAMANIO_BLOQUE = 4096;
+
+    /**
+     * @brief Añade un entero no negativo en decimal sin pasar por un flujo
+     */
+    void agregarEntero(std::string& destino, int valor) {
+        char texto[12];
+        int posicion = sizeof(texto);
+        do {
+            texto[--posicion] = static_cast<char>('0' + valor % 10);
+            valor /= 10;
+        } while (valor != 0);
+        destino.append(texto + posicion, sizeof(texto) - posicion);
+    }
+
+    /**
+     * @brief Crea un directorio si no existe
+     */
+    void crearDirectorio(const std::string& directorio) {
+#ifdef _WIN32
+        CreateDirectoryA(directorio.c_str(), nullptr);
+#else
+        mkdir(directorio.c_str(), 0755);
+#endif
+    }
+
+    /**
+     * @brief Reemplaza un archivo por otro ya escrito, de una sola vez
+     */
+    bool reemplazarArchivo(const std::string& origen, const std::string& destino) {
+#ifdef _WIN32
+        return MoveFileExA(origen.c_str(), destino.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+        return std::rename(origen.c_str(), destino.c_str()) == 0;
+#endif
+    }
+}
+
+/**
+ * @brief Recorre la lista de personas y reúne todas sus cuentas
+ *
+ * @param lista Primer nodo de la lista de personas
+ * @return Cuentas de ahorro y corrientes, en el orden de la lista
+ */
+std::vector<CuentaQR> ExportadorQR::recolectarCuentas(const NodoPersona* lista) {
+    std::vector<CuentaQR> cuentas;
+    for (const NodoPersona* nodo = lista; nodo; nodo = nodo->siguiente) {
+        const Persona* persona = nodo->persona;
+        if (!persona || !persona->isValidInstance()) {
+            continue;
+        }
+
+        std::string titular = persona->getNombres() + " " + persona->getApellidos();
+        for (CuentaAhorros* cuenta = persona->getCabezaAhorros(); cuenta; cuenta = cuenta->getSiguiente()) {
+            cuentas.push_back({ titular, cuenta->getNumeroCuenta() });
+        }
+        for (CuentaCorriente* cuenta = persona->getCabezaCorriente(); cuenta; cuenta = cuenta->getSiguiente()) {
+            cuentas.push_back({ titular, cuenta->getNumeroCuenta() });
+        }
+    }
+    return cuentas;
+}
+
+/**
+ * @brief Genera y escribe los códigos QR de un conjunto de cuentas
+ *
+ * Cada hilo toma la siguiente cuenta libre, comprueba si su archivo ya está al
+ * día, genera el código y lo escribe antes de pasar a la siguiente. Cada código
+ * se escribe en un temporal que reemplaza al archivo solo si se escribió
+ * completo, así que un error nunca deja un archivo a medias. La elección de
+ * máscara de cada código se hace en serie para no crear hilos dentro de hilos.
+ *
+ * @param cuentas Cuentas a exportar
+ * @param directorio Directorio de destino
+ * @param formato Formato de los archivos
+ * @param hilos Número de hilos (0 = todos los núcleos disponibles)
+ * @return Resumen de la exportación
+ */
+ResumenExportacionQR ExportadorQR::exportarTodas(const std::vector<CuentaQR>& cuentas,
+    const std::string& directorio, FormatoQR formato, unsigned int hilos) {
+    auto inicio = std::chrono::steady_clock::now();
+
+    std::string base = directorio;
+    crearDirectorio(base);
+    if (!base.empty() && base.back() != '\\' && base.back() != '/') {
+#ifdef _WIN32
+        base += '\\';
+#else
+        base += '/';
+#endif
+    }
+
+    std::atomic<size_t> generados(0);
+    std::atomic<size_t> omitidos(0);
+    std::atomic<size_t> errores(0);
+
+    const unsigned int hilosMascara = CodigoQR::QrCode::getMaskThreads();
+    CodigoQR::QrCode::setMaskThreads(1);
+    Paralelo::ejecutar(cuentas.size(), hilos, [&](size_t i) {
+        std::string temporal;
+        try {
+            const CuentaQR& cuenta = cuentas[i];
+            std::string datos = CodigoQR::GeneradorQRTextoPlano::formatearDatos(cuenta.titular, cuenta.numeroCuenta);
+            std::string huella = calcularHuella(datos, formato);
+            std::string ruta = base + nombreArchivo(cuenta.numeroCuenta, formato);
+            if (archivoVigente(ruta, huella)) {
+                ++omitidos;
+                return true;
+            }
+
+            // Mismo nivel de corrección que el QR interactivo, y la misma caché
+            std::shared_ptr<const CodigoQR::QrCode> codigo =
+                CodigoQR::CacheCodigosQR::compartida().obtener(datos, CodigoQR::QrCode::Ecc::LOW);
+            const CodigoQR::QrCode& qr = *codigo;
+            temporal = ruta + ".tmp";
+            std::ofstream archivo(temporal, std::ios::binary | std::ios::trunc);
+            if (formato == FormatoQR::SVG) {
+                escribirSVG(qr, huella, archivo);
+            }
+            else {
+                escribirPBM(qr, huella, archivo);
+            }
+            archivo.close();
+            if (archivo && reemplazarArchivo(temporal, ruta)) {
+                ++generados;
+            }
+            else {
+                std::remove(temporal.c_str());
+                ++errores;
+            }
+        }
+        catch (const std::exception&) {
+            if (!temporal.empty()) std::remove(temporal.c_str());
+            ++errores;
+        }
+        return true; // Un error en una cuenta no detiene el resto
+    });
+    CodigoQR::QrCode::setMaskThreads(hilosMascara);
+
+    ResumenExportacionQR resumen;
+    resumen.generados = generados;
+    resumen.omitidos = omitidos;
+    resumen.errores = errores;
+    resumen.segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    return resumen;
+}
+
+/**
+ * @brief Construye el nombre de archivo de una cuenta
+ *
+ * Los caracteres que no son letras, dígitos, '-' o '_' se reemplazan por '_'.
+ *
+ * @param numeroCuenta Número de cuenta
+ * @param formato Formato del archivo
+ * @return Nombre de archivo
+ */
+std::string ExportadorQR::nombreArchivo(const std::string& numeroCuenta, FormatoQR formato) {
+    std::string nombre = "QR_";
+    for (char c : numeroCuenta) {
+        bool valido = (c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c == '-' || c == '_';
+        nombre += valido ? c : '_';
+    }
+    return nombre + (formato == FormatoQR::SVG ? ".svg" : ".pbm");
+}
+
+/**
+ * @brief Escribe un código QR como SVG
+ *
+ * Cada tramo horizontal de módulos oscuros es un subtrazado "M x,y h n v1 h -n z"
+ * dentro de un único path, en unidades de módulo y con la zona de silencio incluida
+ * en el viewBox. Se escribe fila a fila directamente en el flujo.
+ *
+ * @param qr Código QR
+ * @param huella Huella del contenido
+ * @param salida Flujo de destino
+ */
+void ExportadorQR::escribirSVG(const CodigoQR::QrCode& qr, const std::string& huella, std::ostream& salida) {
+    int tamanio = qr.getSize() + ZONA_SILENCIO * 2;
+    salida << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+    salida << "<!-- " << ETIQUETA_HUELLA << huella << " -->\n";
+    salida << "<svg xmlns=\"http://www.w3.org/2000/svg\" version=\"1.1\" viewBox=\"0 0 "
+        << tamanio << " " << tamanio << "\" stroke=\"none\" shape-rendering=\"crispEdges\">\n";
+    salida << "<rect width=\"100%\" height=\"100%\" fill=\"#FFFFFF\"/>\n";
+    salida << "<path d=\"";
+
+    // Los subtrazados se acumulan en un bloque pequeño que se vuelca cada pocos KB
+    std::string bloque;
+    bloque.reserve(TAMANIO_BLOQUE + 64);
+    int filaAnterior = -1;
+    qr.getModules().forEachRowRun([&](int y, int x, int longitud) {
+        if (filaAnterior != -1) {
+            bloque += (y != filaAnterior ? '\n' : ' ');
+        }
+        filaAnterior = y;
+        bloque += 'M';
+        agregarEntero(bloque, x + ZONA_SILENCIO);
+        bloque += ',';
+        agregarEntero(bloque, y + ZONA_SILENCIO);
+        bloque += 'h';
+        agregarEntero(bloque, longitud);
+        bloque += "v1h-";
+        agregarEntero(bloque, longitud);
+        bloque += 'z';
+        if (bloque.size() >= TAMANIO_BLOQUE) {
+            salida.write(bloque.data(), static_cast<std::streamsize>(bloque.size()));
+            bloque.clear();
+        }
+    });
+    salida.write(bloque.data(), static_cast<std::streamsize>(bloque.size()));
+    salida << "\" fill=\"#000000\"/>\n";
+    salida << "</svg>\n";
+}
+
+/**
+ * @brief Escribe un código QR como PBM binario (P4)
+ *
+ * Cada fila de píxeles se empaqueta en bytes, el bit más significativo primero,
+ * con 1 para los módulos oscuros. Se escribe una fila cada vez.
+ *
+ * @param qr Código QR
+ * @param huella Huella del contenido
+ * @param salida Flujo de destino
+ */
+void ExportadorQR::escribirPBM(const CodigoQR::QrCode& qr, const std::string& huella, std::ostream& salida) {
+    int tamanio = qr.getSize() + ZONA_SILENCIO * 2;
+    size_t bytesPorFila = static_cast<size_t>((tamanio + 7) / 8);
+    salida << "P4\n# " << ETIQUETA_HUELLA << huella << "\n" << tamanio << " " << tamanio << "\n";
+
+    std::vector<char> fila(bytesPorFila);
+    for (int y = -ZONA_SILENCIO; y < qr.getSize() + ZONA_SILENCIO; y++) {
+        std::fill(fila.begin(), fila.end(), '\0');
+        if (y >= 0 && y < qr.getSize()) {
+            for (int x = 0; x < qr.getSize(); x++) {
+                if (qr.getModule(x, y)) {
+                    int px = x + ZONA_SILENCIO;
+                    fila[px >> 3] = static_cast<char>(fila[px >> 3] | (0x80 >> (px & 7)));
+                }
+            }
+        }
+        salida.write(fila.data(), static_cast<std::streamsize>(bytesPorFila));
+    }
+}
+
+/**
+ * @brief Calcula la huella del texto codificado y el formato de salida
+ *
+ * @param datos Texto codificado en el QR
+ * @param formato Formato del archivo
+ * @return Huella SHA-256 en hexadecimal
+ */
+std::string ExportadorQR::calcularHuella(const std::string& datos, FormatoQR formato) {
+    // El formato, el nivel de corrección y la segmentación forman parte de la huella: si cambian, se regenera
+    std::string entrada = std::string(formato == FormatoQR::SVG ? "SVG" : "PBM") + "|L|OPT|" + datos;
+    return Hash::calcularBuffer(reinterpret_cast<const uint8_t*>(entrada.data()), entrada.size(), AlgoritmoHash::SHA256);
+}
+
+/**
+ * @brief Comprueba si un archivo existente ya contiene la huella indicada
+ *
+ * Solo se leen los primeros bytes del archivo, donde está la cabecera.
+ *
+ * @param ruta Ruta del archivo
+ * @param huella Huella esperada
+ * @return true si el archivo está al día
+ */
+bool ExportadorQR::archivoVigente(const std::string& ruta, const std::string& huella) {
+    std::ifstream archivo(ruta, std::ios::binary);
+    if (!archivo) {
+        return false;
+    }
+    char cabecera[256];
+    archivo.read(cabecera, sizeof(cabecera));
+    std::string inicio(cabecera, static_cast<size_t>(archivo.gcount()));
+    return inicio.find(std::string(ETIQUETA_HUELLA) + huella) != std::string::npos;
+}
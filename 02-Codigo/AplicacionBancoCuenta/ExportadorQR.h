@@ -0,0 +1,130 @@
+#pragma once
+#ifndef EXPORTADORQR_H
+#define EXPORTADORQR_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <ostream>
+#include "CodigoQR.h"
+#include "NodoPersona.h"
+
+/**
+ * @enum FormatoQR
+ * @brief Formatos de archivo de la exportación masiva de códigos QR
+ */
+enum class FormatoQR {
+    SVG,  ///< Imagen vectorial escalable
+    PBM   ///< Mapa de bits binario (Netpbm P4), un píxel por módulo
+};
+
+/**
+ * @struct CuentaQR
+ * @brief Datos de una cuenta que se codifican en su código QR
+ */
+struct CuentaQR {
+    /** @brief Nombres y apellidos del titular */
+    std::string titular;
+    /** @brief Número de cuenta */
+    std::string numeroCuenta;
+};
+
+/**
+ * @struct ResumenExportacionQR
+ * @brief Resultado de una exportación masiva de códigos QR
+ */
+struct ResumenExportacionQR {
+    /** @brief Códigos generados y escritos */
+    size_t generados = 0;
+    /** @brief Cuentas cuyo archivo ya existía con el mismo contenido */
+    size_t omitidos = 0;
+    /** @brief Cuentas que no pudieron exportarse */
+    size_t errores = 0;
+    /** @brief Duración total en segundos */
+    double segundos = 0.0;
+};
+
+/**
+ * @class ExportadorQR
+ * @brief Clase estática para generar los códigos QR de todas las cuentas del banco
+ *
+ * Cada cuenta se codifica con el mismo texto que GeneradorQRTextoPlano y se
+ * escribe en su propio archivo. Los códigos se reparten entre varios hilos y cada
+ * uno se escribe en cuanto se genera, de modo que la memoria usada depende del
+ * número de hilos y no del número de cuentas.
+ *
+ * Cada archivo lleva en su cabecera una huella del contenido codificado; si el
+ * archivo ya existe con la misma huella, la cuenta se omite sin volver a generarla.
+ */
+class ExportadorQR {
+public:
+    /**
+     * @brief Recorre la lista de personas y reúne todas sus cuentas
+     * @param lista Primer nodo de la lista de personas del banco
+     * @return Cuentas de ahorro y corrientes de todas las personas válidas
+     *
+     * Se llama desde el hilo principal: los datos se copian para que los hilos de
+     * exportación no accedan a los objetos del banco.
+     */
+    static std::vector<CuentaQR> recolectarCuentas(const NodoPersona* lista);
+
+    /**
+     * @brief Genera y escribe los códigos QR de un conjunto de cuentas
+     * @param cuentas Cuentas a exportar
+     * @param directorio Directorio de destino (se crea si no existe)
+     * @param formato Formato de los archivos
+     * @param hilos Número de hilos (0 = todos los núcleos disponibles)
+     * @return Resumen con los códigos generados, omitidos y con error
+     */
+    static ResumenExportacionQR exportarTodas(const std::vector<CuentaQR>& cuentas,
+        const std::string& directorio, FormatoQR formato, unsigned int hilos = 0);
+
+    /**
+     * @brief Construye el nombre de archivo de una cuenta
+     * @param numeroCuenta Número de cuenta
+     * @param formato Formato del archivo
+     * @return Nombre "QR_<cuenta>.svg" o "QR_<cuenta>.pbm"
+     */
+    static std::string nombreArchivo(const std::string& numeroCuenta, FormatoQR formato);
+
+    /**
+     * @brief Escribe un código QR como SVG
+     * @param qr Código QR
+     * @param huella Huella del contenido, guardada en un comentario
+     * @param salida Flujo de destino
+     *
+     * Los módulos oscuros se agrupan en tramos horizontales dentro de un único
+     * trazado, que se escribe directamente en el flujo.
+     */
+    static void escribirSVG(const CodigoQR::QrCode& qr, const std::string& huella, std::ostream& salida);
+
+    /**
+     * @brief Escribe un código QR como PBM binario (P4) con zona de silencio
+     * @param qr Código QR
+     * @param huella Huella del contenido, guardada en un comentario
+     * @param salida Flujo de destino
+     */
+    static void escribirPBM(const CodigoQR::QrCode& qr, const std::string& huella, std::ostream& salida);
+
+private:
+    /** @brief Módulos de zona de silencio alrededor del código */
+    static const int ZONA_SILENCIO = 4;
+
+    /**
+     * @brief Calcula la huella SHA-256 del texto codificado y el formato de salida
+     * @param datos Texto codificado en el QR
+     * @param formato Formato del archivo
+     * @return Huella en hexadecimal
+     */
+    static std::string calcularHuella(const std::string& datos, FormatoQR formato);
+
+    /**
+     * @brief Comprueba si un archivo existente ya contiene la huella indicada
+     * @param ruta Ruta del archivo
+     * @param huella Huella esperada
+     * @return true si el archivo existe y su cabecera tiene la misma huella
+     */
+    static bool archivoVigente(const std::string& ruta, const std::string& huella);
+};
+
+#endif // EXPORTADORQR_H
@@ -18,8 +18,7 @@
   */
 Fecha::Fecha() {
     time_t t = time(0);
-    tm now = {};
-    localtime_s(&now, &t);
+    tm now = horaLocal(t);
     dia = now.tm_mday;
     mes = now.tm_mon + 1;
     anio = now.tm_year + 1900;
@@ -155,8 +154,7 @@ std::string Fecha::obtenerFechaFormateada() const {
  */
 bool Fecha::esFechaSistemaManipulada() const {
     time_t t = time(0); // Obtiene la fecha actual del sistema
-    tm now = {}; // Estructura para almacenar la fecha actual
-    localtime_s(&now, &t); // Convierte el tiempo a la estructura tm
+    tm now = horaLocal(t); // Convierte el tiempo a la hora local
     // Comparamos la fecha almacenada con la del sistema
     return (dia != now.tm_mday || mes != (now.tm_mon + 1) || anio != (now.tm_year + 1900)); // Verifica si hay discrepancias
 }
@@ -194,8 +192,7 @@ bool Fecha::getEsFechaSistemaManipulada() const {
  */
 std::string Fecha::obtenerFechaActual() const {
     time_t t = time(0);
-    tm now = {};
-    localtime_s(&now, &t);
+    tm now = horaLocal(t);
     std::ostringstream oss;
     oss << "Fecha del sistema: "
         << (now.tm_mday < 10 ? "0" : "") << now.tm_mday << '/'
@@ -218,4 +215,20 @@ std::string Fecha::obtenerFechaActual() const {
 std::string Fecha::toString() const
 {
     return obtenerFechaFormateada();
+}
+
+/**
+ * @brief Convierte un instante a la hora local
+ *
+ * @param t Instante a convertir
+ * @return std::tm Hora local
+ */
+std::tm Fecha::horaLocal(std::time_t t) {
+    std::tm local = {};
+#ifdef _WIN32
+    localtime_s(&local, &t);
+#else
+    localtime_r(&t, &local);
+#endif
+    return local;
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #ifndef FECHA_H
 #define FECHA_H
 
+#include <ctime>
 #include <string>
 #include <vector>
 
@@ -173,5 +174,15 @@ public:
      * @return Cadena que representa la fecha en formato DD/MM/AAAA
      */
     std::string toString() const;
+
+    /**
+     * @brief Convierte un instante a la hora local
+     *
+     * Usa localtime_s en Windows y localtime_r en los dems sistemas.
+     *
+     * @param t Instante a convertir
+     * @return Estructura tm con la hora local
+     */
+    static std::tm horaLocal(std::time_t t);
 };
 #endif // FECHA_H
\ No newline at end of file
@@ -0,0 +1,534 @@
+/**
+ * @file GeneradorBanco.cpp
+ * @brief Generación determinista de clientes y cuentas sintéticos
+ */
+#include "GeneradorBanco.h"
+#include "Persona.h"
+#include "Fecha.h"
+#include "Paralelo.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <vector>
+
+namespace {
+
+    /** @brief Mezcla de splitmix64: a entradas consecutivas les corresponden salidas independientes */
+    uint64_t mezclar(uint64_t x) {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    /**
+     * @class Aleatorio
+     * @brief Secuencia pseudoaleatoria de un cliente, igual en todas las plataformas
+     */
+    class Aleatorio {
+    public:
+        Aleatorio(uint64_t semilla, size_t indice) : estado(mezclar(semilla) ^ mezclar(indice)) {}
+
+        /** @brief Entero uniforme en [0, n) */
+        uint32_t menor(uint32_t n) {
+            estado += 0x9E3779B97F4A7C15ull;
+            return static_cast<uint32_t>(((mezclar(estado) >> 32) * n) >> 32);
+        }
+
+        /** @brief Entero uniforme en [desde, hasta] */
+        int entre(int desde, int hasta) {
+            return desde + static_cast<int>(menor(static_cast<uint32_t>(hasta - desde + 1)));
+        }
+
+    private:
+        uint64_t estado;
+    };
+
+    const char* const NOMBRES[] = {
+        "Jose", "Luis", "Carlos", "Juan", "Jorge", "Miguel", "Diego", "Andres", "Pablo", "Fernando",
+        "Santiago", "Mateo", "Daniel", "David", "Francisco", "Ricardo", "Marco", "Segundo", "Manuel", "Angel",
+        "Maria", "Ana", "Rosa", "Carmen", "Gabriela", "Daniela", "Andrea", "Veronica", "Paola", "Fernanda",
+        "Lucia", "Patricia", "Sofia", "Valentina", "Camila", "Monica", "Diana", "Elena", "Martha", "Jessica"
+    };
+    const char* const APELLIDOS[] = {
+        "Perez", "Gomez", "Andrade", "Chuqui", "Proano", "Torres", "Vera", "Mora", "Zambrano", "Sanchez",
+        "Rodriguez", "Garcia", "Lopez", "Martinez", "Castillo", "Vargas", "Cedeno", "Reyes", "Ramirez", "Moreira",
+        "Guaman", "Cevallos", "Suarez", "Jimenez", "Herrera", "Morales", "Ortiz", "Mendoza", "Vasquez", "Espinoza",
+        "Velez", "Castro", "Romero", "Ruiz", "Aguilar", "Salazar", "Paredes", "Benitez", "Villacis", "Toapanta"
+    };
+    const char* const CALLES[] = {
+        "Amazonas", "Seis de Diciembre", "Diez de Agosto", "Shyris", "Eloy Alfaro", "Naciones Unidas",
+        "Colon", "Patria", "Orellana", "America", "La Prensa", "Maldonado", "Mariscal Sucre",
+        "Simon Bolivar", "Nueve de Octubre", "Malecon"
+    };
+    const char* const CODIGOS_SUCURSAL[ImportadorCSV::NUM_SUCURSALES] = { "210", "220", "480", "560" };
+    /** @brief Porcentaje acumulado de clientes por sucursal (35, 25, 25 y 15) */
+    const uint32_t REPARTO_SUCURSAL[ImportadorCSV::NUM_SUCURSALES] = { 35, 60, 85, 100 };
+
+    template <typename T, size_t N>
+    const T& elegir(Aleatorio& aleatorio, const T(&opciones)[N]) {
+        return opciones[aleatorio.menor(static_cast<uint32_t>(N))];
+    }
+
+    /** @brief Días desde el 01/01/1970 de una fecha del calendario gregoriano */
+    int diasDesdeCivil(int anio, int mes, int dia) {
+        anio -= mes <= 2;
+        const int era = (anio >= 0 ? anio : anio - 399) / 400;
+        const int anioEra = anio - era * 400;
+        const int diaAnio = (153 * (mes + (mes > 2 ? -3 : 9)) + 2) / 5 + dia - 1;
+        const int diaEra = anioEra * 365 + anioEra / 4 - anioEra / 100 + diaAnio;
+        return era * 146097 + diaEra - 719468;
+    }
+
+    /** @brief Fecha del calendario de un número de días desde el 01/01/1970 */
+    void civilDesdeDias(int dias, int& anio, int& mes, int& dia) {
+        dias += 719468;
+        const int era = (dias >= 0 ? dias : dias - 146096) / 146097;
+        const int diaEra = dias - era * 146097;
+        const int anioEra = (diaEra - diaEra / 1460 + diaEra / 36524 - diaEra / 146096) / 365;
+        const int diaAnio = diaEra - (365 * anioEra + anioEra / 4 - anioEra / 100);
+        const int mesPrima = (5 * diaAnio + 2) / 153;
+        dia = diaAnio - (153 * mesPrima + 2) / 5 + 1;
+        mes = mesPrima < 10 ? mesPrima + 3 : mesPrima - 9;
+        anio = anioEra + era * 400 + (mes <= 2);
+    }
+
+    /** @brief DD/MM/AAAA de un número de días */
+    void fechaTexto(int dias, char texto[16]) {
+        int anio, mes, dia;
+        civilDesdeDias(dias, anio, mes, dia);
+        std::snprintf(texto, 16, "%02d/%02d/%04d", dia, mes, anio);
+    }
+
+    /** @brief Sábado, domingo o feriado de Fecha::esFeriado */
+    bool esNoLaborable(int dias) {
+        static const Fecha calendario(1, 1, 2000);
+        const int diaSemana = ((dias % 7) + 11) % 7; // 0 = domingo; el 01/01/1970 fue jueves
+        if (diaSemana == 0 || diaSemana == 6) {
+            return true;
+        }
+        int anio, mes, dia;
+        civilDesdeDias(dias, anio, mes, dia);
+        return calendario.esFeriado(dia, mes, anio);
+    }
+
+    /** @brief Días de una fecha que cumple años, con el 29/02 pasado al 28/02 */
+    int aniversario(int dias, int anios) {
+        int anio, mes, dia;
+        civilDesdeDias(dias, anio, mes, dia);
+        if (mes == 2 && dia == 29) dia = 28;
+        return diasDesdeCivil(anio + anios, mes, dia);
+    }
+
+    /**
+     * @brief Saldo en centavos: 20% hasta 100, 35% hasta 1000, 30% hasta 5000 y 15% hasta 15000
+     * @param minimo Saldo mínimo en centavos (250.00 para las corrientes)
+     */
+    long long saldoCentavos(Aleatorio& aleatorio, long long minimo) {
+        static const long long TRAMOS[] = { 0, 10000, 100000, 500000, 1500000 };
+        const uint32_t r = aleatorio.menor(100);
+        const int tramo = r < 20 ? 0 : r < 55 ? 1 : r < 85 ? 2 : 3;
+        const long long desde = std::max(TRAMOS[tramo], minimo);
+        const long long hasta = std::max(TRAMOS[tramo + 1], desde);
+        return desde + aleatorio.menor(static_cast<uint32_t>(hasta - desde + 1));
+    }
+
+    /** @brief Cuenta sintética; el número se asigna al escribirla */
+    struct CuentaSintetica {
+        bool ahorros;
+        long long centavos;
+        char apertura[16];
+    };
+
+    /** @brief Cliente sintético con sus cuentas */
+    struct ClienteSintetico {
+        std::string cedula;
+        std::string nombres;
+        std::string apellidos;
+        char nacimiento[16];
+        std::string correo;
+        std::string direccion;
+        int sucursal;
+        int numCuentas;
+        CuentaSintetica cuentas[3];
+    };
+
+    /**
+     * @brief Sucursal y número de cuentas de un cliente
+     *
+     * Son los dos primeros valores de su secuencia, para poder contarlos sin
+     * generar el resto: 72% una cuenta, 22% dos y 6% tres.
+     */
+    void perfil(Aleatorio& aleatorio, int& sucursal, int& numCuentas) {
+        const uint32_t r = aleatorio.menor(100);
+        sucursal = 0;
+        while (r >= REPARTO_SUCURSAL[sucursal]) ++sucursal;
+        const uint32_t c = aleatorio.menor(100);
+        numCuentas = c < 72 ? 1 : c < 94 ? 2 : 3;
+    }
+
+    /** @brief Genera el cliente de un índice */
+    void generarCliente(uint64_t semilla, size_t indice, int hoy, ClienteSintetico& cliente) {
+        Aleatorio aleatorio(semilla, indice);
+        perfil(aleatorio, cliente.sucursal, cliente.numCuentas);
+
+        cliente.cedula = GeneradorBanco::cedula(semilla, indice);
+        const char* nombre = elegir(aleatorio, NOMBRES);
+        const char* apellido = elegir(aleatorio, APELLIDOS);
+        cliente.nombres = std::string(nombre) + " " + elegir(aleatorio, NOMBRES);
+        cliente.apellidos = std::string(apellido) + " " + elegir(aleatorio, APELLIDOS);
+
+        // Entre 18 y 85 años
+        const int nacimiento = aniversario(hoy, -85) + static_cast<int>(aleatorio.menor(
+            static_cast<uint32_t>(aniversario(hoy, -18) - aniversario(hoy, -85))));
+        fechaTexto(nacimiento, cliente.nacimiento);
+
+        cliente.correo = std::string(nombre) + "." + apellido + std::to_string(indice) + "@correo.ec";
+        std::transform(cliente.correo.begin(), cliente.correo.end(), cliente.correo.begin(),
+            [](char c) { return static_cast<char>(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c); });
+        cliente.direccion = std::string("Av. ") + elegir(aleatorio, CALLES) + " N" + std::to_string(aleatorio.entre(1, 80)) +
+            "-" + std::to_string(aleatorio.entre(1, 300)) + " y " + elegir(aleatorio, CALLES);
+
+        // Apertura en un día laborable desde los 18 años (y desde el 2000) hasta hoy
+        const int primerDia = std::max(aniversario(nacimiento, 18), diasDesdeCivil(2000, 1, 3));
+        for (int i = 0; i < cliente.numCuentas; ++i) {
+            CuentaSintetica& cuenta = cliente.cuentas[i];
+            cuenta.ahorros = i == 0 ? aleatorio.menor(100) < 65 : aleatorio.menor(100) < 50;
+            cuenta.centavos = saldoCentavos(aleatorio, cuenta.ahorros ? 0 : 25000);
+            int apertura = primerDia + static_cast<int>(aleatorio.menor(static_cast<uint32_t>(hoy - primerDia + 1)));
+            while (apertura > primerDia && esNoLaborable(apertura)) --apertura;
+            while (apertura < hoy && esNoLaborable(apertura)) ++apertura;
+            fechaTexto(apertura, cuenta.apertura);
+        }
+    }
+
+    /** @brief Saldo en centavos como texto con dos decimales */
+    void agregarSaldo(std::string& texto, long long centavos) {
+        char saldo[32];
+        std::snprintf(saldo, sizeof(saldo), "%lld.%02lld", centavos / 100, centavos % 100);
+        texto += saldo;
+    }
+
+    /** @brief Cuentas de cada sucursal en un bloque de clientes */
+    typedef std::array<int, ImportadorCSV::NUM_SUCURSALES> ContadorSucursales;
+
+    /**
+     * @class Generacion
+     * @brief Estado compartido de una generación: bloques, secuenciales iniciales y totales
+     */
+    class Generacion {
+    public:
+        Generacion(const ConfiguracionGenerador& configuracion, bool numerarCuentas, ResumenGeneracion& resumen)
+            : configuracion(configuracion), resumen(resumen),
+            bloques((configuracion.clientes + GeneradorBanco::CLIENTES_POR_BLOQUE - 1) / GeneradorBanco::CLIENTES_POR_BLOQUE) {
+            std::tm ahora = Fecha::horaLocal(std::time(nullptr));
+            hoy = diasDesdeCivil(ahora.tm_year + 1900, ahora.tm_mon + 1, ahora.tm_mday);
+            if (configuracion.clientes > GeneradorBanco::CLIENTES_MAXIMOS) {
+                resumen.error = "demasiados clientes: el maximo es " + std::to_string(GeneradorBanco::CLIENTES_MAXIMOS);
+                return;
+            }
+            if (numerarCuentas && !calcularSecuenciales()) {
+                return;
+            }
+            valida = true;
+        }
+
+        /** @brief false si la configuración no se puede generar; el motivo queda en el resumen */
+        bool esValida() const { return valida; }
+
+        /**
+         * @brief Genera todos los bloques en lotes paralelos y los entrega en orden
+         * @param generar void(cliente, secuenciales por sucursal, salida del bloque, cuentas de ahorros y corrientes)
+         * @param consumir bool(salida del bloque); si devuelve false se detiene
+         */
+        template <typename Salida, typename Generar, typename Consumir>
+        bool recorrer(Generar generar, Consumir consumir) {
+            const unsigned int hilos = Paralelo::resolverHilos(configuracion.hilos);
+            const size_t porLote = static_cast<size_t>(hilos) * 4;
+            std::vector<Salida> salidas(porLote);
+            std::vector<std::array<size_t, 2>> cuentas(porLote);
+            for (size_t primero = 0; primero < bloques; primero += porLote) {
+                const size_t enLote = std::min(porLote, bloques - primero);
+                Paralelo::ejecutar(enLote, hilos, [&](size_t i) {
+                    const size_t bloque = primero + i;
+                    const size_t desde = bloque * GeneradorBanco::CLIENTES_POR_BLOQUE;
+                    const size_t hasta = std::min(desde + GeneradorBanco::CLIENTES_POR_BLOQUE, configuracion.clientes);
+                    ContadorSucursales secuencial = inicioBloque.empty() ? ContadorSucursales() : inicioBloque[bloque];
+                    ClienteSintetico cliente;
+                    cuentas[i] = { 0, 0 };
+                    for (size_t indice = desde; indice < hasta; ++indice) {
+                        generarCliente(configuracion.semilla, indice, hoy, cliente);
+                        generar(cliente, secuencial, salidas[i], cuentas[i]);
+                    }
+                    return true;
+                });
+                for (size_t i = 0; i < enLote; ++i) {
+                    resumen.cuentasAhorros += cuentas[i][0];
+                    resumen.cuentasCorrientes += cuentas[i][1];
+                    if (!consumir(salidas[i])) {
+                        return false;
+                    }
+                }
+            }
+            resumen.clientes = configuracion.clientes;
+            return true;
+        }
+
+    private:
+        const ConfiguracionGenerador& configuracion;
+        ResumenGeneracion& resumen;
+        size_t bloques;
+        int hoy = 0;
+        bool valida = false;
+        /** @brief Último secuencial usado de cada sucursal antes de cada bloque */
+        std::vector<ContadorSucursales> inicioBloque;
+
+        /** @brief Cuenta en paralelo las cuentas por sucursal de cada bloque y acumula */
+        bool calcularSecuenciales() {
+            std::vector<ContadorSucursales> porBloque(bloques);
+            Paralelo::ejecutar(bloques, configuracion.hilos, [&](size_t bloque) {
+                ContadorSucursales contador = ContadorSucursales();
+                const size_t desde = bloque * GeneradorBanco::CLIENTES_POR_BLOQUE;
+                const size_t hasta = std::min(desde + GeneradorBanco::CLIENTES_POR_BLOQUE, configuracion.clientes);
+                for (size_t indice = desde; indice < hasta; ++indice) {
+                    Aleatorio aleatorio(configuracion.semilla, indice);
+                    int sucursal, numCuentas;
+                    perfil(aleatorio, sucursal, numCuentas);
+                    contador[sucursal] += numCuentas;
+                }
+                porBloque[bloque] = contador;
+                return true;
+            });
+            inicioBloque.resize(bloques);
+            ContadorSucursales acumulado = ContadorSucursales();
+            for (size_t bloque = 0; bloque < bloques; ++bloque) {
+                inicioBloque[bloque] = acumulado;
+                for (int s = 0; s < ImportadorCSV::NUM_SUCURSALES; ++s) {
+                    acumulado[s] += porBloque[bloque][s];
+                    if (acumulado[s] > ImportadorCSV::SECUENCIAL_MAXIMO) {
+                        resumen.error = std::string("la sucursal ") + CODIGOS_SUCURSAL[s] + " supera sus " +
+                            std::to_string(ImportadorCSV::SECUENCIAL_MAXIMO) + " numeros de cuenta";
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+    };
+
+    double segundosDesde(std::chrono::steady_clock::time_point inicio) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    }
+}
+
+/**
+ * @brief Cédula del cliente de un índice
+ *
+ * Una permutación afín del índice (módulo 144 millones, desplazada por la semilla)
+ * elige la provincia, el tercer dígito (0 a 5) y los seis siguientes; el décimo es
+ * el verificador. La única combinación con todos los dígitos iguales se sustituye
+ * por la del índice que no se usa.
+ *
+ * @param semilla Semilla
+ * @param indice Índice del cliente
+ * @return std::string Cédula de 10 dígitos
+ */
+std::string GeneradorBanco::cedula(uint64_t semilla, size_t indice) {
+    const uint64_t TOTAL = CLIENTES_MAXIMOS + 1u;
+    const uint64_t PROHIBIDA = 21u * 6000000u + 2u * 1000000u + 222222u; // 222222222 -> 2222222222
+    const uint64_t desplazamiento = mezclar(semilla) % TOTAL;
+    uint64_t valor = (static_cast<uint64_t>(indice) * 2654435761u + desplazamiento) % TOTAL;
+    if (valor == PROHIBIDA) {
+        valor = (static_cast<uint64_t>(CLIENTES_MAXIMOS) * 2654435761u + desplazamiento) % TOTAL;
+    }
+
+    char digitos[11];
+    std::snprintf(digitos, sizeof(digitos), "%02u%u%06u", static_cast<unsigned>(valor / 6000000u + 1),
+        static_cast<unsigned>(valor / 1000000u % 6u), static_cast<unsigned>(valor % 1000000u));
+    int suma = 0;
+    for (int i = 0; i < 9; ++i) {
+        const int producto = (digitos[i] - '0') * (i % 2 == 0 ? 2 : 1);
+        suma += producto >= 10 ? producto - 9 : producto;
+    }
+    digitos[9] = static_cast<char>('0' + (10 - suma % 10) % 10);
+    return std::string(digitos, 10);
+}
+
+/**
+ * @brief Escribe un respaldo V1 con todos los clientes y sus cuentas
+ *
+ * @param configuracion Clientes, semilla e hilos
+ * @param ruta Ruta del archivo
+ * @return ResumenGeneracion Clientes y cuentas escritos
+ */
+ResumenGeneracion GeneradorBanco::escribirRespaldo(const ConfiguracionGenerador& configuracion, const std::string& ruta) {
+    ResumenGeneracion resumen;
+    const auto inicio = std::chrono::steady_clock::now();
+    Generacion generacion(configuracion, true, resumen);
+    if (!generacion.esValida()) {
+        return resumen;
+    }
+    std::ofstream archivo(ruta, std::ios::binary | std::ios::trunc);
+    if (!archivo.is_open()) {
+        resumen.error = "no se pudo crear " + ruta;
+        return resumen;
+    }
+    archivo << "BANCO_BACKUP_V1.0\n";
+
+    auto generar = [](const ClienteSintetico& cliente, ContadorSucursales& secuencial, std::string& texto,
+        std::array<size_t, 2>& cuentas) {
+        texto += "===PERSONA_INICIO===\nCEDULA:" + cliente.cedula + "\nNOMBRES:" + cliente.nombres +
+            "\nAPELLIDOS:" + cliente.apellidos + "\nFECHA_NACIMIENTO:" + cliente.nacimiento +
+            "\nCORREO:" + cliente.correo + "\nDIRECCION:" + cliente.direccion + "\n";
+        // Los números se reparten en orden de cuenta, aunque se escriban agrupadas por tipo
+        std::string numeros[3];
+        for (int i = 0; i < cliente.numCuentas; ++i) {
+            numeros[i] = ImportadorCSV::numeroCuenta(cliente.sucursal, ++secuencial[cliente.sucursal]);
+        }
+        for (int tipo = 0; tipo < 2; ++tipo) {
+            const bool ahorros = tipo == 0;
+            const char* marca = ahorros ? "AHORRO" : "CORRIENTE";
+            texto += ahorros ? "===CUENTAS_AHORRO_INICIO===\n" : "===CUENTAS_CORRIENTE_INICIO===\n";
+            int total = 0;
+            for (int i = 0; i < cliente.numCuentas; ++i) {
+                const CuentaSintetica& cuenta = cliente.cuentas[i];
+                if (cuenta.ahorros != ahorros) continue;
+                texto += std::string("CUENTA_") + marca + "_INICIO\nNUMERO_CUENTA:" + numeros[i] + "\nSALDO:";
+                agregarSaldo(texto, cuenta.centavos);
+                texto += std::string("\nFECHA_APERTURA:") + cuenta.apertura + "\nESTADO:ACTIVA\nCUENTA_" + marca + "_FIN\n";
+                ++total;
+            }
+            cuentas[tipo] += total;
+            texto += ahorros ? "TOTAL_CUENTAS_AHORRO:" : "TOTAL_CUENTAS_CORRIENTE:";
+            texto += std::to_string(total);
+            texto += ahorros ? "\n===CUENTAS_AHORRO_FIN===\n" : "\n===CUENTAS_CORRIENTE_FIN===\n";
+        }
+        texto += "===PERSONA_FIN===\n\n";
+    };
+    auto consumir = [&archivo](std::string& texto) {
+        archivo.write(texto.data(), static_cast<std::streamsize>(texto.size()));
+        texto.clear();
+        return static_cast<bool>(archivo);
+    };
+    if (!generacion.recorrer<std::string>(generar, consumir)) {
+        resumen.error = "no se pudo escribir " + ruta;
+        return resumen;
+    }
+
+    archivo << "TOTAL_PERSONAS:" << configuracion.clientes << "\nFIN_BACKUP\n";
+    archivo.close();
+    resumen.exito = static_cast<bool>(archivo);
+    if (!resumen.exito) resumen.error = "no se pudo escribir " + ruta;
+    resumen.segundos = segundosDesde(inicio);
+    return resumen;
+}
+
+/**
+ * @brief Escribe un CSV para ImportadorCSV con la primera cuenta de cada cliente
+ *
+ * @param configuracion Clientes, semilla e hilos
+ * @param ruta Ruta del archivo
+ * @return ResumenGeneracion Clientes y cuentas escritos
+ */
+ResumenGeneracion GeneradorBanco::escribirCSV(const ConfiguracionGenerador& configuracion, const std::string& ruta) {
+    ResumenGeneracion resumen;
+    const auto inicio = std::chrono::steady_clock::now();
+    Generacion generacion(configuracion, false, resumen);
+    if (!generacion.esValida()) {
+        return resumen;
+    }
+    std::ofstream archivo(ruta, std::ios::binary | std::ios::trunc);
+    if (!archivo.is_open()) {
+        resumen.error = "no se pudo crear " + ruta;
+        return resumen;
+    }
+    archivo << "cedula,nombres,apellidos,fecha_nacimiento,correo,direccion,tipo_cuenta,sucursal,saldo\n";
+
+    auto generar = [](const ClienteSintetico& cliente, ContadorSucursales&, std::string& texto,
+        std::array<size_t, 2>& cuentas) {
+        const CuentaSintetica& cuenta = cliente.cuentas[0];
+        texto += cliente.cedula + "," + cliente.nombres + "," + cliente.apellidos + "," + cliente.nacimiento + "," +
+            cliente.correo + "," + cliente.direccion + "," + (cuenta.ahorros ? "Ahorros," : "Corriente,") +
+            CODIGOS_SUCURSAL[cliente.sucursal] + ",";
+        agregarSaldo(texto, cuenta.centavos);
+        texto += '\n';
+        ++cuentas[cuenta.ahorros ? 0 : 1];
+    };
+    auto consumir = [&archivo](std::string& texto) {
+        archivo.write(texto.data(), static_cast<std::streamsize>(texto.size()));
+        texto.clear();
+        return static_cast<bool>(archivo);
+    };
+    if (!generacion.recorrer<std::string>(generar, consumir)) {
+        resumen.error = "no se pudo escribir " + ruta;
+        return resumen;
+    }
+    archivo.close();
+    resumen.exito = static_cast<bool>(archivo);
+    if (!resumen.exito) resumen.error = "no se pudo escribir " + ruta;
+    resumen.segundos = segundosDesde(inicio);
+    return resumen;
+}
+
+/**
+ * @brief Crea los clientes con sus cuentas y los enlaza a la lista del banco
+ *
+ * @param configuracion Clientes, semilla e hilos
+ * @param banco Banco sin clientes
+ * @return ResumenGeneracion Clientes y cuentas creados
+ */
+ResumenGeneracion GeneradorBanco::poblar(const ConfiguracionGenerador& configuracion, Banco& banco) {
+    ResumenGeneracion resumen;
+    const auto inicio = std::chrono::steady_clock::now();
+    if (banco.getListaPersonas() != nullptr) {
+        resumen.error = "el banco ya tiene clientes";
+        return resumen;
+    }
+    Generacion generacion(configuracion, true, resumen);
+    if (!generacion.esValida()) {
+        return resumen;
+    }
+
+    auto generar = [](const ClienteSintetico& cliente, ContadorSucursales& secuencial, std::vector<Persona*>& personas,
+        std::array<size_t, 2>& cuentas) {
+        Persona* persona = new Persona(cliente.cedula, cliente.nombres, cliente.apellidos, cliente.nacimiento,
+            cliente.correo, cliente.direccion);
+        int ahorros = 0;
+        int corrientes = 0;
+        for (int i = 0; i < cliente.numCuentas; ++i) {
+            const CuentaSintetica& cuenta = cliente.cuentas[i];
+            const std::string numero = ImportadorCSV::numeroCuenta(cliente.sucursal, ++secuencial[cliente.sucursal]);
+            if (cuenta.ahorros) {
+                persona->setCabezaAhorros(new CuentaAhorros(numero, cuenta.centavos / 100.0, cuenta.apertura, "ACTIVA", 5.0));
+                ++ahorros;
+            }
+            else {
+                persona->setCabezaCorriente(new CuentaCorriente(numero, cuenta.centavos / 100.0, cuenta.apertura, "ACTIVA", 0.0));
+                ++corrientes;
+            }
+        }
+        persona->setNumeCuentas(ahorros + corrientes); // Como Persona::crearAgregarCuenta*, cuenta ambos tipos
+        persona->setNumCorrientes(corrientes);
+        cuentas[0] += ahorros;
+        cuentas[1] += corrientes;
+        personas.push_back(persona);
+    };
+    NodoPersona* lista = nullptr;
+    auto consumir = [&lista](std::vector<Persona*>& personas) {
+        for (Persona* persona : personas) {
+            NodoPersona* nodo = new NodoPersona(persona);
+            nodo->siguiente = lista;
+            lista = nodo;
+        }
+        personas.clear();
+        return true;
+    };
+    generacion.recorrer<std::vector<Persona*>>(generar, consumir);
+    banco.setListaPersonas(lista);
+    resumen.exito = true;
+    resumen.segundos = segundosDesde(inicio);
+    return resumen;
+}
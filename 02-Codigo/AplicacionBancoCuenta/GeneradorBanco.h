@@ -0,0 +1,111 @@
+#pragma once
+#ifndef GENERADORBANCO_H
+#define GENERADORBANCO_H
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include "Banco.h"
+#include "ImportadorCSV.h"
+
+/**
+ * @struct ConfiguracionGenerador
+ * @brief Parámetros de un banco sintético
+ */
+struct ConfiguracionGenerador {
+    /** @brief Número de clientes */
+    size_t clientes = 1000;
+    /** @brief Semilla; la misma semilla produce los mismos datos */
+    uint64_t semilla = 12345;
+    /** @brief Número de hilos (0 = todos los núcleos disponibles) */
+    unsigned int hilos = 0;
+};
+
+/**
+ * @struct ResumenGeneracion
+ * @brief Resultado de generar un banco sintético
+ */
+struct ResumenGeneracion {
+    /** @brief Clientes generados */
+    size_t clientes = 0;
+    /** @brief Cuentas de ahorros generadas */
+    size_t cuentasAhorros = 0;
+    /** @brief Cuentas corrientes generadas */
+    size_t cuentasCorrientes = 0;
+    /** @brief Duración total en segundos */
+    double segundos = 0.0;
+    /** @brief false si la configuración no es válida o no se pudo escribir la salida */
+    bool exito = false;
+    /** @brief Motivo del fallo, vacío si terminó bien */
+    std::string error;
+};
+
+/**
+ * @class GeneradorBanco
+ * @brief Clase estática que genera clientes y cuentas sintéticos y deterministas
+ *
+ * Cada cliente se deriva solo de la semilla y de su índice, así que el resultado
+ * no depende del número de hilos. Los datos cumplen las reglas del ingreso por
+ * teclado y del importador:
+ * - cédulas distintas que pasan Validar::ValidarCedula;
+ * - nombres y apellidos dobles, correo único y dirección sin comas;
+ * - nacimiento entre 18 y 85 años atrás;
+ * - de una a tres cuentas, todas en la sucursal del cliente (210, 220, 480 o
+ *   560), numeradas como Persona::crearNumeroCuenta: sucursal, secuencial de la
+ *   sucursal en orden de cliente y dígito verificador;
+ * - apertura en un día laborable (ver Fecha::esFeriado) posterior a los 18 años
+ *   del cliente y no anterior al año 2000;
+ * - saldos de ahorros de 0 a 15000.00 y corrientes de 250.00 a 15000.00, con
+ *   más cuentas de saldo bajo que alto.
+ *
+ * Los clientes se generan por bloques en paralelo y se escriben en orden, en
+ * lotes, para acotar la memoria. Las cédulas alcanzan para CLIENTES_MAXIMOS
+ * clientes; los números de cuenta, para SECUENCIAL_MAXIMO cuentas por sucursal,
+ * así que el respaldo y poblar se limitan a unos cuatro millones de cuentas y el
+ * CSV (que no lleva números de cuenta) no.
+ */
+class GeneradorBanco {
+public:
+    /**
+     * @brief Escribe un respaldo con el formato de Banco::guardarCuentasEnRuta
+     * @param configuracion Clientes, semilla e hilos
+     * @param ruta Ruta del archivo .bak
+     * @return Resumen con los clientes y cuentas escritos
+     */
+    static ResumenGeneracion escribirRespaldo(const ConfiguracionGenerador& configuracion, const std::string& ruta);
+
+    /**
+     * @brief Escribe un CSV con el formato de ImportadorCSV, con la primera cuenta de cada cliente
+     * @param configuracion Clientes, semilla e hilos
+     * @param ruta Ruta del archivo .csv
+     * @return Resumen con los clientes y cuentas escritos
+     */
+    static ResumenGeneracion escribirCSV(const ConfiguracionGenerador& configuracion, const std::string& ruta);
+
+    /**
+     * @brief Agrega los clientes a un banco vacío
+     *
+     * Quedan en la lista como si se hubieran agregado uno a uno, en orden de índice.
+     *
+     * @param configuracion Clientes, semilla e hilos
+     * @param banco Banco sin clientes
+     * @return Resumen con los clientes y cuentas creados; falla si el banco ya tenía clientes
+     */
+    static ResumenGeneracion poblar(const ConfiguracionGenerador& configuracion, Banco& banco);
+
+    /**
+     * @brief Cédula del cliente de un índice
+     * @param semilla Semilla de la generación
+     * @param indice Índice del cliente, menor que CLIENTES_MAXIMOS
+     * @return Cédula válida; distinta para cada índice con la misma semilla
+     */
+    static std::string cedula(uint64_t semilla, size_t indice);
+
+    /** @brief Cédulas distintas disponibles: 24 provincias por 6 millones, menos 2222222222 */
+    static const size_t CLIENTES_MAXIMOS = 24u * 6000000u - 1u;
+
+    /** @brief Clientes que genera cada tarea de la fase paralela */
+    static const size_t CLIENTES_POR_BLOQUE = 8192;
+};
+
+#endif // GENERADORBANCO_H
@@ -0,0 +1,914 @@
+/**
+ * @file Hash.cpp
+ * @brief Implementación de SHA-1 y SHA-256 con aceleración SHA de x86 y lectura mapeada de archivos
+ */
+#include "Hash.h"
+#include "Paralelo.h"
+#include <cstring>
+#include <fstream>
+#include <vector>
+#include <cctype>
+#include <algorithm>
+#include <atomic>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+#define HASH_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define HASH_OBJETIVO_SHA
+#else
+#include <cpuid.h>
+#define HASH_OBJETIVO_SHA __attribute__((target("sha,sse4.1,ssse3")))
+#endif
+#endif
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+    const uint32_t K256[64] = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+    };
+
+    /** @brief Tamaño del búfer de lectura cuando el archivo no puede mapearse */
+    const size_t TAM_BUFFER_LECTURA = 1 << 20;
+
+    inline uint32_t rotarIzq(uint32_t v, int n) { return (v << n) | (v >> (32 - n)); }
+    inline uint32_t rotarDer(uint32_t v, int n) { return (v >> n) | (v << (32 - n)); }
+
+    inline uint32_t leerBE32(const uint8_t* p) {
+        return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+            (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+    }
+
+    inline void escribirBE32(uint8_t* p, uint32_t v) {
+        p[0] = static_cast<uint8_t>(v >> 24);
+        p[1] = static_cast<uint8_t>(v >> 16);
+        p[2] = static_cast<uint8_t>(v >> 8);
+        p[3] = static_cast<uint8_t>(v);
+    }
+
+    // ----- Implementaciones portables -----
+
+    void bloquesSHA1Portable(uint32_t estado[5], const uint8_t* datos, size_t bloques) {
+        uint32_t w[80];
+        while (bloques--) {
+            for (int i = 0; i < 16; ++i) w[i] = leerBE32(datos + 4 * i);
+            for (int i = 16; i < 80; ++i) w[i] = rotarIzq(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+
+            uint32_t a = estado[0], b = estado[1], c = estado[2], d = estado[3], e = estado[4];
+            for (int i = 0; i < 80; ++i) {
+                uint32_t f, k;
+                if (i < 20) { f = (b & c) | (~b & d); k = 0x5a827999; }
+                else if (i < 40) { f = b ^ c ^ d; k = 0x6ed9eba1; }
+                else if (i < 60) { f = (b & c) | (b & d) | (c & d); k = 0x8f1bbcdc; }
+                else { f = b ^ c ^ d; k = 0xca62c1d6; }
+                uint32_t t = rotarIzq(a, 5) + f + e + k + w[i];
+                e = d; d = c; c = rotarIzq(b, 30); b = a; a = t;
+            }
+            estado[0] += a; estado[1] += b; estado[2] += c; estado[3] += d; estado[4] += e;
+            datos += 64;
+        }
+    }
+
+    void bloquesSHA256Portable(uint32_t estado[8], const uint8_t* datos, size_t bloques) {
+        uint32_t w[64];
+        while (bloques--) {
+            for (int i = 0; i < 16; ++i) w[i] = leerBE32(datos + 4 * i);
+            for (int i = 16; i < 64; ++i) {
+                uint32_t s0 = rotarDer(w[i - 15], 7) ^ rotarDer(w[i - 15], 18) ^ (w[i - 15] >> 3);
+                uint32_t s1 = rotarDer(w[i - 2], 17) ^ rotarDer(w[i - 2], 19) ^ (w[i - 2] >> 10);
+                w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+            }
+
+            uint32_t a = estado[0], b = estado[1], c = estado[2], d = estado[3];
+            uint32_t e = estado[4], f = estado[5], g = estado[6], h = estado[7];
+            for (int i = 0; i < 64; ++i) {
+                uint32_t S1 = rotarDer(e, 6) ^ rotarDer(e, 11) ^ rotarDer(e, 25);
+                uint32_t ch = (e & f) ^ (~e & g);
+                uint32_t t1 = h + S1 + ch + K256[i] + w[i];
+                uint32_t S0 = rotarDer(a, 2) ^ rotarDer(a, 13) ^ rotarDer(a, 22);
+                uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+                uint32_t t2 = S0 + maj;
+                h = g; g = f; f = e; e = d + t1; d = c; c = b; b = a; a = t1 + t2;
+            }
+            estado[0] += a; estado[1] += b; estado[2] += c; estado[3] += d;
+            estado[4] += e; estado[5] += f; estado[6] += g; estado[7] += h;
+            datos += 64;
+        }
+    }
+
+#ifdef HASH_X86
+    // ----- Implementaciones con instrucciones SHA de x86 -----
+
+    /**
+     * @brief Detecta en tiempo de ejecución las extensiones SHA, SSSE3 y SSE4.1
+     */
+    bool detectarExtensionesSHA() {
+#ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) return false;
+        __cpuid(info, 1);
+        bool ssse3 = (info[2] & (1 << 9)) != 0;
+        bool sse41 = (info[2] & (1 << 19)) != 0;
+        __cpuidex(info, 7, 0);
+        bool sha = (info[1] & (1 << 29)) != 0;
+        return ssse3 && sse41 && sha;
+#else
+        unsigned int a = 0, b = 0, c = 0, d = 0;
+        if (__get_cpuid_max(0, nullptr) < 7) return false;
+        __get_cpuid(1, &a, &b, &c, &d);
+        bool ssse3 = (c & (1u << 9)) != 0;
+        bool sse41 = (c & (1u << 19)) != 0;
+        __cpuid_count(7, 0, a, b, c, d);
+        bool sha = (b & (1u << 29)) != 0;
+        return ssse3 && sse41 && sha;
+#endif
+    }
+
+    /**
+     * @brief Grupos consecutivos de cuatro rondas SHA-1 con la función lógica F
+     *
+     * Genera los mensajes expandidos a medida que avanza; F es parámetro de
+     * plantilla porque sha1rnds4 solo acepta un inmediato.
+     */
+    template <int F>
+    HASH_OBJETIVO_SHA inline void rondasSHA1(__m128i& abcd, __m128i& abcdPrevio, __m128i msg[4], int inicio, int fin) {
+        for (int g = inicio; g < fin; ++g) {
+            if (g >= 4) {
+                // W[g] = msg2(msg1(W[g-4], W[g-3]) ^ W[g-2], W[g-1])
+                __m128i t = _mm_sha1msg1_epu32(msg[g & 3], msg[(g + 1) & 3]);
+                t = _mm_xor_si128(t, msg[(g + 2) & 3]);
+                msg[g & 3] = _mm_sha1msg2_epu32(t, msg[(g + 3) & 3]);
+            }
+            __m128i e = _mm_sha1nexte_epu32(abcdPrevio, msg[g & 3]);
+            abcdPrevio = abcd;
+            abcd = _mm_sha1rnds4_epu32(abcd, e, F);
+        }
+    }
+
+    HASH_OBJETIVO_SHA void bloquesSHA1Hardware(uint32_t estado[5], const uint8_t* datos, size_t bloques) {
+        const __m128i mascara = _mm_set_epi64x(0x0001020304050607LL, 0x08090a0b0c0d0e0fLL);
+
+        __m128i abcd = _mm_loadu_si128(reinterpret_cast<const __m128i*>(estado));
+        abcd = _mm_shuffle_epi32(abcd, 0x1B);
+        __m128i e0 = _mm_set_epi32(static_cast<int>(estado[4]), 0, 0, 0);
+
+        while (bloques--) {
+            const __m128i abcdGuardado = abcd;
+            const __m128i e0Guardado = e0;
+
+            __m128i msg[4];
+            for (int i = 0; i < 4; ++i) {
+                msg[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(datos + 16 * i)), mascara);
+            }
+
+            // Rondas 0-3: E entra sumado directamente al primer mensaje
+            __m128i abcdPrevio = abcd;
+            abcd = _mm_sha1rnds4_epu32(abcd, _mm_add_epi32(e0, msg[0]), 0);
+
+            rondasSHA1<0>(abcd, abcdPrevio, msg, 1, 5);
+            rondasSHA1<1>(abcd, abcdPrevio, msg, 5, 10);
+            rondasSHA1<2>(abcd, abcdPrevio, msg, 10, 15);
+            rondasSHA1<3>(abcd, abcdPrevio, msg, 15, 20);
+
+            e0 = _mm_sha1nexte_epu32(abcdPrevio, e0Guardado);
+            abcd = _mm_add_epi32(abcd, abcdGuardado);
+            datos += 64;
+        }
+
+        abcd = _mm_shuffle_epi32(abcd, 0x1B);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(estado), abcd);
+        estado[4] = static_cast<uint32_t>(_mm_extract_epi32(e0, 3));
+    }
+
+    HASH_OBJETIVO_SHA void bloquesSHA256Hardware(uint32_t estado[8], const uint8_t* datos, size_t bloques) {
+        const __m128i mascara = _mm_set_epi64x(0x0c0d0e0f08090a0bLL, 0x0405060700010203LL);
+
+        __m128i tmp = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&estado[0]));
+        __m128i estado1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&estado[4]));
+        tmp = _mm_shuffle_epi32(tmp, 0xB1);                    // CDAB
+        estado1 = _mm_shuffle_epi32(estado1, 0x1B);            // EFGH
+        __m128i estado0 = _mm_alignr_epi8(tmp, estado1, 8);    // ABEF
+        estado1 = _mm_blend_epi16(estado1, tmp, 0xF0);         // CDGH
+
+        while (bloques--) {
+            const __m128i abefGuardado = estado0;
+            const __m128i cdghGuardado = estado1;
+
+            __m128i msg[4];
+            for (int g = 0; g < 16; ++g) {
+                if (g < 4) {
+                    msg[g] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(datos + 16 * g)), mascara);
+                }
+                else {
+                    // W[g] = msg2(msg1(W[g-4], W[g-3]) + alignr(W[g-1], W[g-2], 4), W[g-1])
+                    __m128i t = _mm_sha256msg1_epu32(msg[g & 3], msg[(g + 1) & 3]);
+                    t = _mm_add_epi32(t, _mm_alignr_epi8(msg[(g + 3) & 3], msg[(g + 2) & 3], 4));
+                    msg[g & 3] = _mm_sha256msg2_epu32(t, msg[(g + 3) & 3]);
+                }
+                __m128i m = _mm_add_epi32(msg[g & 3], _mm_loadu_si128(reinterpret_cast<const __m128i*>(&K256[4 * g])));
+                estado1 = _mm_sha256rnds2_epu32(estado1, estado0, m);
+                m = _mm_shuffle_epi32(m, 0x0E);
+                estado0 = _mm_sha256rnds2_epu32(estado0, estado1, m);
+            }
+
+            estado0 = _mm_add_epi32(estado0, abefGuardado);
+            estado1 = _mm_add_epi32(estado1, cdghGuardado);
+            datos += 64;
+        }
+
+        tmp = _mm_shuffle_epi32(estado0, 0x1B);                // FEBA
+        estado1 = _mm_shuffle_epi32(estado1, 0xB1);            // DCHG
+        estado0 = _mm_blend_epi16(tmp, estado1, 0xF0);         // DCBA
+        estado1 = _mm_alignr_epi8(estado1, tmp, 8);            // HGFE
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&estado[0]), estado0);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&estado[4]), estado1);
+    }
+
+    const bool HARDWARE_DISPONIBLE = detectarExtensionesSHA();
+#else
+    const bool HARDWARE_DISPONIBLE = false;
+#endif
+
+    /** @brief Implementación elegida; solo la cambia Hash::usarAceleracionHardware */
+    std::atomic<bool> usarHardware(HARDWARE_DISPONIBLE);
+
+    inline void bloquesSHA1(uint32_t estado[5], const uint8_t* datos, size_t bloques) {
+#ifdef HASH_X86
+        if (usarHardware.load(std::memory_order_relaxed)) {
+            bloquesSHA1Hardware(estado, datos, bloques);
+            return;
+        }
+#endif
+        bloquesSHA1Portable(estado, datos, bloques);
+    }
+
+    inline void bloquesSHA256(uint32_t estado[8], const uint8_t* datos, size_t bloques) {
+#ifdef HASH_X86
+        if (usarHardware.load(std::memory_order_relaxed)) {
+            bloquesSHA256Hardware(estado, datos, bloques);
+            return;
+        }
+#endif
+        bloquesSHA256Portable(estado, datos, bloques);
+    }
+
+    /**
+     * @brief Lógica común de acumulación por bloques de 64 bytes
+     */
+    template <typename FuncionBloques, typename Estado>
+    void acumular(Estado* estado, uint8_t pendiente[64], size_t& usados, uint64_t& totalBytes,
+        const uint8_t* datos, size_t longitud, FuncionBloques bloques) {
+        totalBytes += longitud;
+        if (usados > 0) {
+            size_t faltan = 64 - usados;
+            if (faltan > longitud) faltan = longitud;
+            std::memcpy(pendiente + usados, datos, faltan);
+            usados += faltan;
+            datos += faltan;
+            longitud -= faltan;
+            if (usados < 64) return;
+            bloques(estado, pendiente, 1);
+            usados = 0;
+        }
+        if (longitud >= 64) {
+            bloques(estado, datos, longitud / 64);
+            datos += longitud & ~static_cast<size_t>(63);
+            longitud &= 63;
+        }
+        if (longitud > 0) {
+            std::memcpy(pendiente, datos, longitud);
+            usados = longitud;
+        }
+    }
+
+    /**
+     * @brief Relleno de Merkle-Damgård común a SHA-1 y SHA-256
+     */
+    template <typename FuncionBloques, typename Estado>
+    void rellenar(Estado* estado, uint8_t pendiente[64], size_t usados, uint64_t totalBytes, FuncionBloques bloques) {
+        uint64_t bits = totalBytes * 8;
+        pendiente[usados++] = 0x80;
+        if (usados > 56) {
+            std::memset(pendiente + usados, 0, 64 - usados);
+            bloques(estado, pendiente, 1);
+            usados = 0;
+        }
+        std::memset(pendiente + usados, 0, 56 - usados);
+        for (int i = 0; i < 8; ++i) {
+            pendiente[56 + i] = static_cast<uint8_t>(bits >> (56 - 8 * i));
+        }
+        bloques(estado, pendiente, 1);
+    }
+
+    /**
+     * @brief Vista de solo lectura de un archivo mapeado en memoria
+     */
+    class ArchivoMapeado {
+    public:
+        explicit ArchivoMapeado(const std::string& ruta) : datos(nullptr), tamanio(0) {
+#ifdef _WIN32
+            archivo = CreateFileA(ruta.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            mapeo = nullptr;
+            if (archivo == INVALID_HANDLE_VALUE) return;
+            LARGE_INTEGER tam;
+            if (!GetFileSizeEx(archivo, &tam) || tam.QuadPart == 0 ||
+                static_cast<uint64_t>(tam.QuadPart) > static_cast<uint64_t>(SIZE_MAX)) return;
+            mapeo = CreateFileMappingA(archivo, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!mapeo) return;
+            datos = static_cast<const uint8_t*>(MapViewOfFile(mapeo, FILE_MAP_READ, 0, 0, 0));
+            if (datos) tamanio = static_cast<size_t>(tam.QuadPart);
+#else
+            descriptor = open(ruta.c_str(), O_RDONLY);
+            if (descriptor < 0) return;
+            struct stat info;
+            if (fstat(descriptor, &info) != 0 || info.st_size == 0 ||
+                static_cast<uint64_t>(info.st_size) > static_cast<uint64_t>(SIZE_MAX)) return;
+            void* p = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+            if (p == MAP_FAILED) return;
+            madvise(p, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+            datos = static_cast<const uint8_t*>(p);
+            tamanio = static_cast<size_t>(info.st_size);
+#endif
+        }
+
+        ~ArchivoMapeado() {
+#ifdef _WIN32
+            if (datos) UnmapViewOfFile(datos);
+            if (mapeo) CloseHandle(mapeo);
+            if (archivo != INVALID_HANDLE_VALUE) CloseHandle(archivo);
+#else
+            if (datos) munmap(const_cast<uint8_t*>(datos), tamanio);
+            if (descriptor >= 0) close(descriptor);
+#endif
+        }
+
+        ArchivoMapeado(const ArchivoMapeado&) = delete;
+        ArchivoMapeado& operator=(const ArchivoMapeado&) = delete;
+
+        const uint8_t* datos;
+        size_t tamanio;
+
+    private:
+#ifdef _WIN32
+        HANDLE archivo;
+        HANDLE mapeo;
+#else
+        int descriptor;
+#endif
+    };
+
+    /**
+     * @brief Recorre un archivo completo entregando sus bytes al consumidor
+     *
+     * Intenta primero el mapeo en memoria; si falla (archivo vacío, sin permisos
+     * de mapeo o proceso de 32 bits con archivo enorme) lee con un búfer grande.
+     */
+    template <typename Consumidor>
+    bool recorrerArchivo(const std::string& ruta, uint64_t& tamanio, Consumidor consumir) {
+        {
+            ArchivoMapeado mapeado(ruta);
+            if (mapeado.datos) {
+                consumir(mapeado.datos, mapeado.tamanio);
+                tamanio = mapeado.tamanio;
+                return true;
+            }
+        }
+
+        std::ifstream archivo(ruta, std::ios::binary);
+        if (!archivo) return false;
+        std::vector<uint8_t> buffer(TAM_BUFFER_LECTURA);
+        tamanio = 0;
+        while (archivo) {
+            archivo.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+            std::streamsize leidos = archivo.gcount();
+            if (leidos <= 0) break;
+            consumir(buffer.data(), static_cast<size_t>(leidos));
+            tamanio += static_cast<uint64_t>(leidos);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Resumen binario de (prefijo || a || b), usado por hojas y nodos del árbol
+     */
+    std::vector<uint8_t> resumirConPrefijo(AlgoritmoHash algoritmo, uint8_t prefijo,
+        const uint8_t* a, size_t longitudA, const uint8_t* b, size_t longitudB) {
+        if (algoritmo == AlgoritmoHash::SHA1) {
+            ContextoSHA1 contexto;
+            contexto.actualizar(&prefijo, 1);
+            contexto.actualizar(a, longitudA);
+            if (b) contexto.actualizar(b, longitudB);
+            std::vector<uint8_t> resumen(ContextoSHA1::TAM_RESUMEN);
+            contexto.finalizar(resumen.data());
+            return resumen;
+        }
+        ContextoSHA256 contexto;
+        contexto.actualizar(&prefijo, 1);
+        contexto.actualizar(a, longitudA);
+        if (b) contexto.actualizar(b, longitudB);
+        std::vector<uint8_t> resumen(ContextoSHA256::TAM_RESUMEN);
+        contexto.finalizar(resumen.data());
+        return resumen;
+    }
+
+    std::vector<uint8_t> deHexadecimal(const std::string& texto) {
+        std::vector<uint8_t> bytes(texto.size() / 2);
+        for (size_t i = 0; i < bytes.size(); ++i) {
+            auto valor = [](char c) -> uint8_t {
+                if (c >= '0' && c <= '9') return static_cast<uint8_t>(c - '0');
+                if (c >= 'a' && c <= 'f') return static_cast<uint8_t>(c - 'a' + 10);
+                if (c >= 'A' && c <= 'F') return static_cast<uint8_t>(c - 'A' + 10);
+                return 0;
+            };
+            bytes[i] = static_cast<uint8_t>((valor(texto[2 * i]) << 4) | valor(texto[2 * i + 1]));
+        }
+        return bytes;
+    }
+
+    /**
+     * @brief Calcula en paralelo las hojas de todos los bloques de un archivo
+     */
+    bool calcularHojas(const std::string& ruta, AlgoritmoHash algoritmo, uint32_t tamBloque,
+        std::vector<std::string>& hojas, uint64_t& tamanio, unsigned int hilos) {
+        auto hoja = [&](const uint8_t* datos, size_t longitud) {
+            std::vector<uint8_t> resumen = resumirConPrefijo(algoritmo, 0x00, datos, longitud, nullptr, 0);
+            return Hash::aHexadecimal(resumen.data(), resumen.size());
+        };
+
+        {
+            ArchivoMapeado mapeado(ruta);
+            if (mapeado.datos) {
+                tamanio = mapeado.tamanio;
+                uint64_t total = (tamanio + tamBloque - 1) / tamBloque;
+                hojas.assign(static_cast<size_t>(total), std::string());
+                Paralelo::ejecutar(static_cast<size_t>(total), hilos, [&](size_t i) {
+                    uint64_t inicio = static_cast<uint64_t>(i) * tamBloque;
+                    size_t longitud = static_cast<size_t>(std::min<uint64_t>(tamBloque, tamanio - inicio));
+                    hojas[i] = hoja(mapeado.datos + inicio, longitud);
+                    return true;
+                });
+                return true;
+            }
+        }
+
+        // Sin mapeo: se leen lotes de bloques y cada lote se resume en paralelo
+        std::ifstream archivo(ruta, std::ios::binary | std::ios::ate);
+        if (!archivo) return false;
+        tamanio = static_cast<uint64_t>(archivo.tellg());
+        uint64_t total = (tamanio + tamBloque - 1) / tamBloque;
+        hojas.assign(static_cast<size_t>(total), std::string());
+        archivo.seekg(0);
+
+        hilos = Paralelo::resolverHilos(hilos);
+        const size_t bloquesPorLote = static_cast<size_t>(hilos) * 4;
+        std::vector<uint8_t> buffer(bloquesPorLote * tamBloque);
+        for (uint64_t base = 0; base < total; base += bloquesPorLote) {
+            size_t enLote = static_cast<size_t>(std::min<uint64_t>(bloquesPorLote, total - base));
+            size_t bytesLote = static_cast<size_t>(std::min<uint64_t>(static_cast<uint64_t>(enLote) * tamBloque, tamanio - base * tamBloque));
+            if (!archivo.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(bytesLote))) return false;
+            Paralelo::ejecutar(enLote, hilos, [&](size_t i) {
+                size_t inicio = i * tamBloque;
+                size_t longitud = std::min<size_t>(tamBloque, bytesLote - inicio);
+                hojas[static_cast<size_t>(base + i)] = hoja(buffer.data() + inicio, longitud);
+                return true;
+            });
+        }
+        return true;
+    }
+
+    /**
+     * @brief Vuelve a calcular en paralelo las hojas de algunos bloques de un archivo
+     *
+     * Ajusta hojas al número de bloques del tamaño actual y sobrescribe las de
+     * los índices que devuelve elegir(tamanio), ordenados y sin repetir; el
+     * resto se conserva sin leer el archivo.
+     */
+    template <typename Elegir>
+    bool recalcularHojas(const std::string& ruta, AlgoritmoHash algoritmo, uint32_t tamBloque,
+        Elegir elegir, std::vector<std::string>& hojas, uint64_t& tamanio, unsigned int hilos) {
+        auto hoja = [&](const uint8_t* datos, size_t longitud) {
+            std::vector<uint8_t> resumen = resumirConPrefijo(algoritmo, 0x00, datos, longitud, nullptr, 0);
+            return Hash::aHexadecimal(resumen.data(), resumen.size());
+        };
+
+        {
+            ArchivoMapeado mapeado(ruta);
+            if (mapeado.datos) {
+                tamanio = mapeado.tamanio;
+                hojas.resize(static_cast<size_t>((tamanio + tamBloque - 1) / tamBloque));
+                const std::vector<uint64_t> elegidos = elegir(tamanio);
+                Paralelo::ejecutar(elegidos.size(), hilos, [&](size_t i) {
+                    uint64_t inicio = elegidos[i] * tamBloque;
+                    size_t longitud = static_cast<size_t>(std::min<uint64_t>(tamBloque, tamanio - inicio));
+                    hojas[static_cast<size_t>(elegidos[i])] = hoja(mapeado.datos + inicio, longitud);
+                    return true;
+                });
+                return true;
+            }
+        }
+
+        // Sin mapeo: se leen lotes de bloques elegidos y cada lote se resume en paralelo
+        std::ifstream archivo(ruta, std::ios::binary | std::ios::ate);
+        if (!archivo) return false;
+        tamanio = static_cast<uint64_t>(archivo.tellg());
+        hojas.resize(static_cast<size_t>((tamanio + tamBloque - 1) / tamBloque));
+        const std::vector<uint64_t> elegidos = elegir(tamanio);
+
+        hilos = Paralelo::resolverHilos(hilos);
+        const size_t bloquesPorLote = static_cast<size_t>(hilos) * 4;
+        std::vector<uint8_t> buffer(bloquesPorLote * tamBloque);
+        std::vector<size_t> longitudes(bloquesPorLote);
+        for (size_t base = 0; base < elegidos.size(); base += bloquesPorLote) {
+            size_t enLote = std::min(bloquesPorLote, elegidos.size() - base);
+            for (size_t i = 0; i < enLote; ++i) {
+                uint64_t inicio = elegidos[base + i] * tamBloque;
+                longitudes[i] = static_cast<size_t>(std::min<uint64_t>(tamBloque, tamanio - inicio));
+                archivo.seekg(static_cast<std::streamoff>(inicio));
+                if (!archivo.read(reinterpret_cast<char*>(buffer.data()) + i * tamBloque,
+                    static_cast<std::streamsize>(longitudes[i]))) return false;
+            }
+            Paralelo::ejecutar(enLote, hilos, [&](size_t i) {
+                hojas[static_cast<size_t>(elegidos[base + i])] = hoja(buffer.data() + i * tamBloque, longitudes[i]);
+                return true;
+            });
+        }
+        return true;
+    }
+
+    /** @brief Índices de las hojas distintas, faltantes o sobrantes entre dos listas */
+    void hojasDistintas(const std::vector<std::string>& hojas, const std::vector<std::string>& anteriores,
+        std::vector<uint64_t>& distintas) {
+        distintas.clear();
+        size_t total = std::max(hojas.size(), anteriores.size());
+        for (size_t i = 0; i < total; ++i) {
+            if (i >= hojas.size() || i >= anteriores.size() || hojas[i] != anteriores[i]) {
+                distintas.push_back(i);
+            }
+        }
+    }
+}
+
+// ----- ContextoSHA1 -----
+
+ContextoSHA1::ContextoSHA1() : totalBytes(0), usados(0) {
+    estado[0] = 0x67452301;
+    estado[1] = 0xefcdab89;
+    estado[2] = 0x98badcfe;
+    estado[3] = 0x10325476;
+    estado[4] = 0xc3d2e1f0;
+}
+
+void ContextoSHA1::actualizar(const uint8_t* datos, size_t longitud) {
+    acumular(estado, pendiente, usados, totalBytes, datos, longitud, bloquesSHA1);
+}
+
+void ContextoSHA1::finalizar(uint8_t resumen[TAM_RESUMEN]) {
+    rellenar(estado, pendiente, usados, totalBytes, bloquesSHA1);
+    for (int i = 0; i < 5; ++i) escribirBE32(resumen + 4 * i, estado[i]);
+}
+
+// ----- ContextoSHA256 -----
+
+ContextoSHA256::ContextoSHA256() : totalBytes(0), usados(0) {
+    estado[0] = 0x6a09e667;
+    estado[1] = 0xbb67ae85;
+    estado[2] = 0x3c6ef372;
+    estado[3] = 0xa54ff53a;
+    estado[4] = 0x510e527f;
+    estado[5] = 0x9b05688c;
+    estado[6] = 0x1f83d9ab;
+    estado[7] = 0x5be0cd19;
+}
+
+void ContextoSHA256::actualizar(const uint8_t* datos, size_t longitud) {
+    acumular(estado, pendiente, usados, totalBytes, datos, longitud, bloquesSHA256);
+}
+
+void ContextoSHA256::finalizar(uint8_t resumen[TAM_RESUMEN]) {
+    rellenar(estado, pendiente, usados, totalBytes, bloquesSHA256);
+    for (int i = 0; i < 8; ++i) escribirBE32(resumen + 4 * i, estado[i]);
+}
+
+// ----- Hash -----
+
+/**
+ * @brief Convierte bytes a hexadecimal en minúsculas
+ *
+ * @param datos Bytes a convertir
+ * @param longitud Número de bytes
+ * @return Cadena hexadecimal
+ */
+std::string Hash::aHexadecimal(const uint8_t* datos, size_t longitud) {
+    static const char digitos[] = "0123456789abcdef";
+    std::string resultado(longitud * 2, '0');
+    for (size_t i = 0; i < longitud; ++i) {
+        resultado[2 * i] = digitos[datos[i] >> 4];
+        resultado[2 * i + 1] = digitos[datos[i] & 0x0f];
+    }
+    return resultado;
+}
+
+/**
+ * @brief Calcula el resumen de un búfer en memoria
+ *
+ * @param datos Puntero a los datos
+ * @param longitud Número de bytes
+ * @param algoritmo Algoritmo a utilizar
+ * @return Resumen en hexadecimal
+ */
+std::string Hash::calcularBuffer(const uint8_t* datos, size_t longitud, AlgoritmoHash algoritmo) {
+    if (algoritmo == AlgoritmoHash::SHA1) {
+        ContextoSHA1 contexto;
+        contexto.actualizar(datos, longitud);
+        uint8_t resumen[ContextoSHA1::TAM_RESUMEN];
+        contexto.finalizar(resumen);
+        return aHexadecimal(resumen, sizeof(resumen));
+    }
+    ContextoSHA256 contexto;
+    contexto.actualizar(datos, longitud);
+    uint8_t resumen[ContextoSHA256::TAM_RESUMEN];
+    contexto.finalizar(resumen);
+    return aHexadecimal(resumen, sizeof(resumen));
+}
+
+/**
+ * @brief Calcula el resumen de un archivo completo
+ *
+ * @param rutaArchivo Ruta del archivo
+ * @param algoritmo Algoritmo a utilizar
+ * @param hexadecimal Salida: resumen en hexadecimal
+ * @param tamanio Salida: tamaño del archivo en bytes
+ * @return true si el archivo pudo leerse, false en caso contrario
+ */
+bool Hash::calcularArchivo(const std::string& rutaArchivo, AlgoritmoHash algoritmo,
+    std::string& hexadecimal, uint64_t& tamanio) {
+    if (algoritmo == AlgoritmoHash::SHA1) {
+        ContextoSHA1 contexto;
+        if (!recorrerArchivo(rutaArchivo, tamanio, [&](const uint8_t* d, size_t n) { contexto.actualizar(d, n); })) {
+            return false;
+        }
+        uint8_t resumen[ContextoSHA1::TAM_RESUMEN];
+        contexto.finalizar(resumen);
+        hexadecimal = aHexadecimal(resumen, sizeof(resumen));
+        return true;
+    }
+
+    ContextoSHA256 contexto;
+    if (!recorrerArchivo(rutaArchivo, tamanio, [&](const uint8_t* d, size_t n) { contexto.actualizar(d, n); })) {
+        return false;
+    }
+    uint8_t resumen[ContextoSHA256::TAM_RESUMEN];
+    contexto.finalizar(resumen);
+    hexadecimal = aHexadecimal(resumen, sizeof(resumen));
+    return true;
+}
+
+/**
+ * @brief Calcula el hash por bloques (árbol de Merkle) de un archivo
+ *
+ * Los bloques se resumen en paralelo directamente sobre el archivo mapeado.
+ *
+ * @param rutaArchivo Ruta del archivo
+ * @param algoritmo Algoritmo a utilizar
+ * @param tamBloque Tamaño de bloque en bytes
+ * @param resultado Salida: hojas y raíz
+ * @param hilos Número de hilos (0 = todos los núcleos)
+ * @return true si el archivo pudo leerse, false en caso contrario
+ */
+bool Hash::calcularMerkle(const std::string& rutaArchivo, AlgoritmoHash algoritmo, uint32_t tamBloque,
+    HashMerkle& resultado, unsigned int hilos) {
+    if (tamBloque == 0) return false;
+    HashMerkle nuevo;
+    nuevo.algoritmo = algoritmo;
+    nuevo.tamBloque = tamBloque;
+    if (!calcularHojas(rutaArchivo, algoritmo, tamBloque, nuevo.bloques, nuevo.tamanio, hilos)) {
+        return false;
+    }
+    nuevo.raiz = raizMerkle(nuevo.bloques, algoritmo);
+    resultado = std::move(nuevo);
+    return true;
+}
+
+/**
+ * @brief Actualiza un hash por bloques con el contenido actual del archivo
+ *
+ * Todos los bloques se vuelven a resumir en paralelo: un cambio puede estar en
+ * cualquier parte del archivo, no solo después del final anterior. Las hojas
+ * nuevas se comparan con las guardadas para informar qué bloques cambiaron.
+ *
+ * @param rutaArchivo Ruta del archivo
+ * @param hash Hash previo; se actualiza en el lugar
+ * @param bloquesCambiados Salida: índices de bloques distintos, nuevos o eliminados
+ * @param hilos Número de hilos (0 = todos los núcleos)
+ * @return true si el archivo pudo leerse, false en caso contrario
+ */
+bool Hash::actualizarMerkle(const std::string& rutaArchivo, HashMerkle& hash,
+    std::vector<uint64_t>& bloquesCambiados, unsigned int hilos) {
+    bloquesCambiados.clear();
+    if (hash.tamBloque == 0) return false;
+
+    std::vector<std::string> hojas;
+    uint64_t tamanio = 0;
+    if (!calcularHojas(rutaArchivo, hash.algoritmo, hash.tamBloque, hojas, tamanio, hilos)) {
+        return false;
+    }
+    hojasDistintas(hojas, hash.bloques, bloquesCambiados);
+    hash.bloques = std::move(hojas);
+    hash.tamanio = tamanio;
+    hash.raiz = raizMerkle(hash.bloques, hash.algoritmo);
+    return true;
+}
+
+/**
+ * @brief Actualiza un hash por bloques resumiendo solo los bloques que pudieron cambiar
+ *
+ * Solo se leen los bloques que tocan los rangos indicados y, si el tamaño
+ * cambió, los que van desde el que contenía el final anterior (que pudo estar
+ * incompleto) hasta el final actual. Las demás hojas se conservan. Si las hojas
+ * guardadas no cuadran con el tamaño guardado no se puede saber cuáles siguen
+ * valiendo y se resumen todas.
+ *
+ * @param rutaArchivo Ruta del archivo
+ * @param hash Hash previo; se actualiza en el lugar
+ * @param rangos Rangos de bytes que pudieron cambiar
+ * @param bloquesCambiados Salida: índices de bloques distintos, nuevos o eliminados
+ * @param hilos Número de hilos (0 = todos los núcleos)
+ * @return true si el archivo pudo leerse, false en caso contrario
+ */
+bool Hash::actualizarMerkle(const std::string& rutaArchivo, HashMerkle& hash,
+    const std::vector<RangoModificado>& rangos, std::vector<uint64_t>& bloquesCambiados, unsigned int hilos) {
+    bloquesCambiados.clear();
+    if (hash.tamBloque == 0) return false;
+    const uint64_t tamBloque = hash.tamBloque;
+    if (hash.bloques.size() != (hash.tamanio + tamBloque - 1) / tamBloque) {
+        return actualizarMerkle(rutaArchivo, hash, bloquesCambiados, hilos);
+    }
+
+    const uint64_t tamanioAnterior = hash.tamanio;
+    auto elegir = [&](uint64_t tamanio) {
+        const uint64_t total = (tamanio + tamBloque - 1) / tamBloque;
+        std::vector<uint64_t> indices;
+        for (const RangoModificado& rango : rangos) {
+            uint64_t hasta = std::min(total, rango.fin / tamBloque + (rango.fin % tamBloque != 0 ? 1 : 0));
+            for (uint64_t i = rango.inicio / tamBloque; i < hasta; ++i) {
+                indices.push_back(i);
+            }
+        }
+        if (tamanio != tamanioAnterior) {
+            for (uint64_t i = std::min(tamanio, tamanioAnterior) / tamBloque; i < total; ++i) {
+                indices.push_back(i);
+            }
+        }
+        std::sort(indices.begin(), indices.end());
+        indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+        return indices;
+    };
+
+    std::vector<std::string> hojas = hash.bloques;
+    uint64_t tamanio = 0;
+    if (!recalcularHojas(rutaArchivo, hash.algoritmo, hash.tamBloque, elegir, hojas, tamanio, hilos)) {
+        return false;
+    }
+    hojasDistintas(hojas, hash.bloques, bloquesCambiados);
+    hash.bloques = std::move(hojas);
+    hash.tamanio = tamanio;
+    hash.raiz = raizMerkle(hash.bloques, hash.algoritmo);
+    return true;
+}
+
+/**
+ * @brief Compara un archivo contra un hash por bloques guardado
+ *
+ * Se resumen todos los bloques en paralelo y se informan todos los que no
+ * coinciden, no solo el primero, para poder ubicar cada rango alterado.
+ *
+ * @param rutaArchivo Ruta del archivo
+ * @param esperado Hash de referencia
+ * @param bloquesAlterados Salida: índices de bloques distintos, faltantes o sobrantes
+ * @param hilos Número de hilos (0 = todos los núcleos)
+ * @return true si el archivo pudo leerse, false en caso contrario
+ */
+bool Hash::compararMerkle(const std::string& rutaArchivo, const HashMerkle& esperado,
+    std::vector<uint64_t>& bloquesAlterados, unsigned int hilos) {
+    bloquesAlterados.clear();
+    if (esperado.tamBloque == 0) return false;
+
+    std::vector<std::string> hojas;
+    uint64_t tamanio = 0;
+    if (!calcularHojas(rutaArchivo, esperado.algoritmo, esperado.tamBloque, hojas, tamanio, hilos)) {
+        return false;
+    }
+    hojasDistintas(hojas, esperado.bloques, bloquesAlterados);
+    return true;
+}
+
+/**
+ * @brief Calcula la raíz del árbol a partir de las hojas
+ *
+ * @param bloques Resúmenes hexadecimales de las hojas
+ * @param algoritmo Algoritmo de los nodos internos
+ * @return Resumen hexadecimal de la raíz
+ */
+std::string Hash::raizMerkle(const std::vector<std::string>& bloques, AlgoritmoHash algoritmo) {
+    if (bloques.empty()) {
+        return calcularBuffer(nullptr, 0, algoritmo);
+    }
+
+    std::vector<std::vector<uint8_t>> nivel;
+    nivel.reserve(bloques.size());
+    for (const auto& hoja : bloques) {
+        nivel.push_back(deHexadecimal(hoja));
+    }
+
+    while (nivel.size() > 1) {
+        std::vector<std::vector<uint8_t>> siguiente;
+        siguiente.reserve((nivel.size() + 1) / 2);
+        for (size_t i = 0; i + 1 < nivel.size(); i += 2) {
+            siguiente.push_back(resumirConPrefijo(algoritmo, 0x01,
+                nivel[i].data(), nivel[i].size(), nivel[i + 1].data(), nivel[i + 1].size()));
+        }
+        if (nivel.size() % 2 == 1) {
+            siguiente.push_back(std::move(nivel.back()));
+        }
+        nivel = std::move(siguiente);
+    }
+    return aHexadecimal(nivel[0].data(), nivel[0].size());
+}
+
+/**
+ * @brief Devuelve la etiqueta textual de un algoritmo
+ *
+ * @param algoritmo Algoritmo
+ * @return "SHA1" o "SHA256"
+ */
+const char* Hash::nombreAlgoritmo(AlgoritmoHash algoritmo) {
+    return algoritmo == AlgoritmoHash::SHA1 ? "SHA1" : "SHA256";
+}
+
+/**
+ * @brief Interpreta una etiqueta de algoritmo
+ *
+ * @param nombre Etiqueta a interpretar
+ * @param algoritmo Salida: algoritmo reconocido
+ * @return true si la etiqueta es válida
+ */
+bool Hash::algoritmoDesdeNombre(const std::string& nombre, AlgoritmoHash& algoritmo) {
+    std::string mayusculas;
+    for (char c : nombre) {
+        if (c != '-') mayusculas += static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+    if (mayusculas == "SHA1") {
+        algoritmo = AlgoritmoHash::SHA1;
+        return true;
+    }
+    if (mayusculas == "SHA256") {
+        algoritmo = AlgoritmoHash::SHA256;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Indica si se están usando las instrucciones SHA del procesador
+ *
+ * @return true si hay aceleración por hardware
+ */
+bool Hash::aceleracionHardware() {
+    return usarHardware.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Elige entre las instrucciones SHA del procesador y la implementación portable
+ *
+ * @param hardware true para las instrucciones SHA, false para la portable
+ * @return true si se aplicó; false si se pidió hardware y el procesador no lo tiene
+ */
+bool Hash::usarAceleracionHardware(bool hardware) {
+    if (hardware && !HARDWARE_DISPONIBLE) {
+        return false;
+    }
+    usarHardware.store(hardware, std::memory_order_relaxed);
+    return true;
+}
@@ -0,0 +1,264 @@
+#pragma once
+#ifndef HASH_H
+#define HASH_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @enum AlgoritmoHash
+ * @brief Algoritmos de resumen disponibles para la verificación de archivos
+ */
+enum class AlgoritmoHash {
+    SHA1,   ///< SHA-1 (FIPS 180-4), 160 bits
+    SHA256  ///< SHA-256 (FIPS 180-4), 256 bits
+};
+
+/**
+ * @class ContextoSHA1
+ * @brief Cálculo incremental de SHA-1
+ *
+ * Usa las instrucciones SHA de x86 cuando el procesador las tiene y una
+ * implementación portable en caso contrario.
+ */
+class ContextoSHA1 {
+public:
+    /** @brief Tamaño del resumen en bytes */
+    static const size_t TAM_RESUMEN = 20;
+
+    /**
+     * @brief Inicializa el contexto con los valores iniciales del estándar
+     */
+    ContextoSHA1();
+
+    /**
+     * @brief Agrega datos al resumen
+     * @param datos Puntero a los datos
+     * @param longitud Número de bytes
+     */
+    void actualizar(const uint8_t* datos, size_t longitud);
+
+    /**
+     * @brief Completa el relleno y obtiene el resumen
+     * @param resumen Búfer de 20 bytes donde se escribe el resultado
+     */
+    void finalizar(uint8_t resumen[TAM_RESUMEN]);
+
+private:
+    uint32_t estado[5];
+    uint64_t totalBytes;
+    uint8_t pendiente[64];
+    size_t usados;
+};
+
+/**
+ * @class ContextoSHA256
+ * @brief Cálculo incremental de SHA-256
+ *
+ * Usa las instrucciones SHA de x86 cuando el procesador las tiene y una
+ * implementación portable en caso contrario.
+ */
+class ContextoSHA256 {
+public:
+    /** @brief Tamaño del resumen en bytes */
+    static const size_t TAM_RESUMEN = 32;
+
+    /**
+     * @brief Inicializa el contexto con los valores iniciales del estándar
+     */
+    ContextoSHA256();
+
+    /**
+     * @brief Agrega datos al resumen
+     * @param datos Puntero a los datos
+     * @param longitud Número de bytes
+     */
+    void actualizar(const uint8_t* datos, size_t longitud);
+
+    /**
+     * @brief Completa el relleno y obtiene el resumen
+     * @param resumen Búfer de 32 bytes donde se escribe el resultado
+     */
+    void finalizar(uint8_t resumen[TAM_RESUMEN]);
+
+private:
+    uint32_t estado[8];
+    uint64_t totalBytes;
+    uint8_t pendiente[64];
+    size_t usados;
+};
+
+/**
+ * @struct HashMerkle
+ * @brief Hash por bloques de un archivo organizado como árbol de Merkle
+ *
+ * Cada hoja es el resumen de un bloque de tamaño fijo, H(0x00 || bloque), y cada
+ * nodo interno es H(0x01 || izquierdo || derecho); un nodo sin pareja sube sin
+ * cambios. Guardar la lista de hojas permite verificar en paralelo y señalar
+ * exactamente qué rangos de bytes cambiaron.
+ */
+struct HashMerkle {
+    /** @brief Algoritmo usado en hojas y nodos */
+    AlgoritmoHash algoritmo = AlgoritmoHash::SHA256;
+    /** @brief Tamaño de cada bloque en bytes */
+    uint32_t tamBloque = 0;
+    /** @brief Tamaño total del archivo en bytes */
+    uint64_t tamanio = 0;
+    /** @brief Resumen hexadecimal de cada bloque, en orden */
+    std::vector<std::string> bloques;
+    /** @brief Resumen hexadecimal de la raíz del árbol */
+    std::string raiz;
+};
+
+/**
+ * @struct RangoModificado
+ * @brief Rango de bytes [inicio, fin) de un archivo que pudo cambiar
+ */
+struct RangoModificado {
+    /** @brief Primer byte del rango */
+    uint64_t inicio = 0;
+    /** @brief Byte siguiente al último del rango */
+    uint64_t fin = 0;
+};
+
+/**
+ * @class Hash
+ * @brief Clase estática para calcular resúmenes SHA-1/SHA-256 de archivos y búferes
+ *
+ * Los archivos se leen mapeándolos en memoria; si el mapeo no es posible se
+ * recurre a lecturas con un búfer grande.
+ */
+class Hash {
+public:
+    /** @brief Tamaño de bloque por defecto del hash por bloques */
+    static const uint32_t TAM_BLOQUE_MERKLE = 1u << 20;
+
+    /**
+     * @brief Calcula el resumen de un búfer en memoria
+     * @param datos Puntero a los datos
+     * @param longitud Número de bytes
+     * @param algoritmo Algoritmo a utilizar
+     * @return Resumen en hexadecimal (minúsculas)
+     */
+    static std::string calcularBuffer(const uint8_t* datos, size_t longitud, AlgoritmoHash algoritmo);
+
+    /**
+     * @brief Calcula el resumen de un archivo completo
+     * @param rutaArchivo Ruta del archivo
+     * @param algoritmo Algoritmo a utilizar
+     * @param hexadecimal Salida: resumen en hexadecimal (minúsculas)
+     * @param tamanio Salida: tamaño del archivo en bytes
+     * @return true si el archivo pudo leerse, false en caso contrario
+     */
+    static bool calcularArchivo(const std::string& rutaArchivo, AlgoritmoHash algoritmo,
+        std::string& hexadecimal, uint64_t& tamanio);
+
+    /**
+     * @brief Calcula el hash por bloques (árbol de Merkle) de un archivo
+     * @param rutaArchivo Ruta del archivo
+     * @param algoritmo Algoritmo a utilizar
+     * @param tamBloque Tamaño de bloque en bytes
+     * @param resultado Salida: hojas y raíz del árbol
+     * @param hilos Número de hilos (0 = todos los núcleos disponibles)
+     * @return true si el archivo pudo leerse, false en caso contrario
+     */
+    static bool calcularMerkle(const std::string& rutaArchivo, AlgoritmoHash algoritmo, uint32_t tamBloque,
+        HashMerkle& resultado, unsigned int hilos = 0);
+
+    /**
+     * @brief Actualiza un hash por bloques con el contenido actual del archivo
+     * @param rutaArchivo Ruta del archivo
+     * @param hash Hash previo del archivo; se actualiza en el lugar
+     * @param bloquesCambiados Salida: índices de bloques distintos, nuevos o eliminados
+     * @param hilos Número de hilos (0 = todos los núcleos disponibles)
+     * @return true si el archivo pudo leerse, false en caso contrario
+     *
+     * Vuelve a resumir todos los bloques, de modo que detecta cambios en
+     * cualquier posición; se usa cuando no se sabe qué partes cambiaron.
+     */
+    static bool actualizarMerkle(const std::string& rutaArchivo, HashMerkle& hash,
+        std::vector<uint64_t>& bloquesCambiados, unsigned int hilos = 0);
+
+    /**
+     * @brief Actualiza un hash por bloques resumiendo solo los bloques que pudieron cambiar
+     * @param rutaArchivo Ruta del archivo
+     * @param hash Hash previo del archivo; se actualiza en el lugar
+     * @param rangos Rangos de bytes escritos desde que se calculó el hash; vacío si
+     *        el archivo solo creció o se acortó por el final
+     * @param bloquesCambiados Salida: índices de bloques distintos, nuevos o eliminados
+     * @param hilos Número de hilos (0 = todos los núcleos disponibles)
+     * @return true si el archivo pudo leerse, false en caso contrario
+     *
+     * Se resumen los bloques que tocan algún rango y, si el tamaño cambió, el
+     * bloque que contenía el final anterior y los siguientes. Los cambios fuera
+     * de los rangos indicados no se detectan. Si las hojas guardadas no
+     * corresponden al tamaño guardado se resumen todos los bloques.
+     */
+    static bool actualizarMerkle(const std::string& rutaArchivo, HashMerkle& hash,
+        const std::vector<RangoModificado>& rangos, std::vector<uint64_t>& bloquesCambiados,
+        unsigned int hilos = 0);
+
+    /**
+     * @brief Compara un archivo contra un hash por bloques guardado
+     * @param rutaArchivo Ruta del archivo
+     * @param esperado Hash por bloques de referencia
+     * @param bloquesAlterados Salida: índices de bloques que no coinciden, faltan o sobran
+     * @param hilos Número de hilos (0 = todos los núcleos disponibles)
+     * @return true si el archivo pudo leerse, false en caso contrario
+     */
+    static bool compararMerkle(const std::string& rutaArchivo, const HashMerkle& esperado,
+        std::vector<uint64_t>& bloquesAlterados, unsigned int hilos = 0);
+
+    /**
+     * @brief Calcula la raíz del árbol a partir de las hojas
+     * @param bloques Resúmenes hexadecimales de las hojas
+     * @param algoritmo Algoritmo de los nodos internos
+     * @return Resumen hexadecimal de la raíz (resumen de la entrada vacía si no hay hojas)
+     */
+    static std::string raizMerkle(const std::vector<std::string>& bloques, AlgoritmoHash algoritmo);
+
+    /**
+     * @brief Devuelve la etiqueta textual de un algoritmo ("SHA1" o "SHA256")
+     * @param algoritmo Algoritmo
+     * @return Etiqueta usada en los archivos .hash
+     */
+    static const char* nombreAlgoritmo(AlgoritmoHash algoritmo);
+
+    /**
+     * @brief Interpreta una etiqueta de algoritmo
+     * @param nombre Etiqueta ("SHA1" o "SHA256", sin distinguir mayúsculas)
+     * @param algoritmo Salida: algoritmo reconocido
+     * @return true si la etiqueta es válida, false en caso contrario
+     */
+    static bool algoritmoDesdeNombre(const std::string& nombre, AlgoritmoHash& algoritmo);
+
+    /**
+     * @brief Indica si se están usando las instrucciones SHA del procesador
+     * @return true si hay aceleración por hardware disponible
+     */
+    static bool aceleracionHardware();
+
+    /**
+     * @brief Elige la implementación de SHA-1 y SHA-256, para comparar su rendimiento
+     *
+     * Por omisión se usan las instrucciones SHA si el procesador las tiene. Un
+     * resumen que se esté calculando en otro hilo puede mezclar ambas, con el
+     * mismo resultado.
+     *
+     * @param hardware true para las instrucciones SHA, false para la implementación portable
+     * @return false si se pidió hardware y el procesador no lo tiene; no cambia nada
+     */
+    static bool usarAceleracionHardware(bool hardware);
+
+    /**
+     * @brief Convierte bytes a hexadecimal en minúsculas
+     * @param datos Bytes a convertir
+     * @param longitud Número de bytes
+     * @return Cadena hexadecimal
+     */
+    static std::string aHexadecimal(const uint8_t* datos, size_t longitud);
+};
+
+#endif // HASH_H
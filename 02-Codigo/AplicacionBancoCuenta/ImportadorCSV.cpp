@@ -0,0 +1,556 @@
+/**
+ * @file ImportadorCSV.cpp
+ * @brief Importación masiva de clientes desde CSV con validación en paralelo
+ */
+#include "ImportadorCSV.h"
+#include "Persona.h"
+#include "Validar.h"
+#include "Utilidades.h"
+#include "Fecha.h"
+#include "Paralelo.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+    /** @brief Códigos de sucursal válidos, en el orden de Persona::seleccionSucursal */
+    const char* const CODIGOS_SUCURSAL[ImportadorCSV::NUM_SUCURSALES] = { "210", "220", "480", "560" };
+
+    /** @brief Campos de cada línea */
+    const size_t NUM_CAMPOS = 9;
+
+    /** @brief Saldo máximo de una cuenta, en centavos */
+    const long long SALDO_MAXIMO_CENTAVOS = 1500000;
+
+    /** @brief Saldo inicial mínimo de una cuenta corriente, en centavos */
+    const long long SALDO_MINIMO_CORRIENTE_CENTAVOS = 25000;
+
+    /** @brief Bytes por cédula en el lote que se pasa a Validar::ValidarCedulasLote */
+    const size_t PASO_CEDULAS = 16;
+
+    /**
+     * @struct Linea
+     * @brief Posición de una línea de datos dentro del archivo
+     */
+    struct Linea {
+        size_t inicio;
+        size_t fin;      ///< Sin el salto de línea ni el '\r' final
+        size_t numero;   ///< Número de línea en el archivo, desde 1
+    };
+
+    /**
+     * @struct Registro
+     * @brief Resultado de interpretar una línea
+     */
+    struct Registro {
+        Persona* persona = nullptr;
+        Cuenta<double>* cuenta = nullptr;
+        /** @brief Cédula como número, clave del conjunto de duplicados */
+        uint64_t cedula = 0;
+        /** @brief Línea donde apareció antes la cédula (0 = cliente del banco) */
+        size_t lineaOriginal = 0;
+        MotivoRechazo motivo = MotivoRechazo::NINGUNO;
+        unsigned char sucursal = 0;
+    };
+
+    /**
+     * @struct Campo
+     * @brief Texto de un campo, sin comillas, apuntando al archivo leído
+     */
+    struct Campo {
+        const char* texto;
+        size_t longitud;
+
+        std::string str() const { return std::string(texto, longitud); }
+        bool es(const char* literal) const {
+            return longitud == std::strlen(literal) && std::memcmp(texto, literal, longitud) == 0;
+        }
+    };
+
+    /**
+     * @brief Separa una línea en sus nueve campos
+     *
+     * Los campos sin comillas dobles escapadas apuntan a la propia línea; los que
+     * tienen "" se copian a escapes, que se reserva una vez por línea para que los
+     * punteros no cambien.
+     *
+     * @return true si la línea tiene exactamente nueve campos bien formados
+     */
+    bool separarCampos(const char* inicio, const char* fin, Campo campos[NUM_CAMPOS], std::string& escapes) {
+        escapes.clear();
+        const char* p = inicio;
+        size_t n = 0;
+        while (true) {
+            if (n == NUM_CAMPOS) {
+                return false;
+            }
+            if (p < fin && *p == '"') {
+                ++p;
+                const char* desde = p;
+                size_t inicioEscape = std::string::npos;
+                while (true) {
+                    const char* comilla = static_cast<const char*>(std::memchr(p, '"', fin - p));
+                    if (!comilla) {
+                        return false;
+                    }
+                    if (comilla + 1 < fin && comilla[1] == '"') {
+                        if (escapes.empty()) {
+                            escapes.reserve(fin - inicio);
+                        }
+                        if (inicioEscape == std::string::npos) {
+                            inicioEscape = escapes.size();
+                        }
+                        escapes.append(p, comilla + 1);
+                        p = comilla + 2;
+                        continue;
+                    }
+                    if (inicioEscape != std::string::npos) {
+                        escapes.append(p, comilla);
+                        campos[n] = { escapes.data() + inicioEscape, escapes.size() - inicioEscape };
+                    }
+                    else {
+                        campos[n] = { desde, static_cast<size_t>(comilla - desde) };
+                    }
+                    p = comilla + 1;
+                    break;
+                }
+                ++n;
+                if (p == fin) {
+                    break;
+                }
+                if (*p != ',') {
+                    return false;
+                }
+                ++p;
+            }
+            else {
+                const char* coma = static_cast<const char*>(std::memchr(p, ',', fin - p));
+                const char* finCampo = coma ? coma : fin;
+                campos[n++] = { p, static_cast<size_t>(finCampo - p) };
+                if (!coma) {
+                    break;
+                }
+                p = coma + 1;
+            }
+        }
+        return n == NUM_CAMPOS;
+    }
+
+    /**
+     * @brief Aplica las reglas de Persona::ingresarDireccion
+     */
+    bool direccionValida(const Campo& direccion) {
+        if (direccion.longitud == 0 || direccion.longitud > 100) {
+            return false;
+        }
+        for (size_t i = 0; i < direccion.longitud; ++i) {
+            const char c = direccion.texto[i];
+            if (!((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') ||
+                c == ' ' || c == '.' || c == '-' || c == '#' || c == ',')) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Convierte un saldo ya validado con Validar::ValidarNumeroConDosDecimales a centavos
+     * @return Centavos, o -1 si la parte entera es demasiado larga para ser un saldo
+     */
+    long long saldoEnCentavos(const Campo& saldo) {
+        long long entero = 0;
+        size_t i = 0;
+        for (; i < saldo.longitud && saldo.texto[i] != '.'; ++i) {
+            if (i >= 9) {
+                return -1;
+            }
+            entero = entero * 10 + (saldo.texto[i] - '0');
+        }
+        long long centavos = 0;
+        if (i < saldo.longitud) {
+            centavos = (saldo.texto[i + 1] - '0') * 10;
+            if (i + 2 < saldo.longitud) {
+                centavos += saldo.texto[i + 2] - '0';
+            }
+        }
+        return entero * 100 + centavos;
+    }
+
+    /**
+     * @brief Cédula de 10 dígitos como número
+     * @return Valor, o 0 si no son 10 dígitos
+     */
+    uint64_t claveCedula(const char* texto, size_t longitud) {
+        if (longitud != 10) {
+            return 0;
+        }
+        uint64_t valor = 0;
+        for (size_t i = 0; i < 10; ++i) {
+            const unsigned digito = static_cast<unsigned char>(texto[i]) - static_cast<unsigned>('0');
+            if (digito > 9) {
+                return 0;
+            }
+            valor = valor * 10 + digito;
+        }
+        return valor;
+    }
+
+    /**
+     * @brief Índice de la sucursal de un número de cuenta y su secuencial
+     * @return Índice en CODIGOS_SUCURSAL, o -1 si el número no tiene el formato de crearNumeroCuenta
+     */
+    int sucursalDeCuenta(const std::string& numero, int& secuencial) {
+        if (numero.size() != 10 || claveCedula(numero.data(), 10) == 0) {
+            return -1;
+        }
+        for (int s = 0; s < ImportadorCSV::NUM_SUCURSALES; ++s) {
+            if (numero.compare(0, 3, CODIGOS_SUCURSAL[s]) == 0) {
+                secuencial = std::atoi(numero.substr(3, 6).c_str());
+                return s;
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Valida los campos de una línea ya separada y crea el cliente con su cuenta
+     *
+     * La cuenta queda con el número "0"; se asigna al enlazar, en orden de archivo.
+     */
+    void interpretarCampos(const Campo campos[NUM_CAMPOS], bool cedulaValida, const std::string& fechaApertura,
+        Registro& registro) {
+        if (!cedulaValida) {
+            registro.motivo = MotivoRechazo::CEDULA_INVALIDA;
+            return;
+        }
+
+        std::string nombres = campos[1].str();
+        std::string apellidos = campos[2].str();
+        std::string fechaNacimiento = campos[3].str();
+        std::string correo = campos[4].str();
+        const bool corriente = campos[6].es("Corriente");
+        int sucursal = -1;
+        for (int s = 0; s < ImportadorCSV::NUM_SUCURSALES; ++s) {
+            if (campos[7].es(CODIGOS_SUCURSAL[s])) sucursal = s;
+        }
+        const long long centavos = Validar::ValidarNumeroConDosDecimales(campos[8].str()) ? saldoEnCentavos(campos[8]) : -1;
+
+        if (!Validar::ValidarNombrePersona(nombres)) registro.motivo = MotivoRechazo::NOMBRES_INVALIDOS;
+        else if (!Validar::ValidarNombrePersona(apellidos)) registro.motivo = MotivoRechazo::APELLIDOS_INVALIDOS;
+        else if (!Validar::ValidarFecha(fechaNacimiento)) registro.motivo = MotivoRechazo::FECHA_INVALIDA;
+        else if (!Utilidades::EsCorreoValido(correo)) registro.motivo = MotivoRechazo::CORREO_INVALIDO;
+        else if (!direccionValida(campos[5])) registro.motivo = MotivoRechazo::DIRECCION_INVALIDA;
+        else if (!corriente && !campos[6].es("Ahorros")) registro.motivo = MotivoRechazo::TIPO_CUENTA_INVALIDO;
+        else if (sucursal < 0) registro.motivo = MotivoRechazo::SUCURSAL_INVALIDA;
+        else if (centavos < (corriente ? SALDO_MINIMO_CORRIENTE_CENTAVOS : 0) || centavos > SALDO_MAXIMO_CENTAVOS)
+            registro.motivo = MotivoRechazo::SALDO_INVALIDO;
+        if (registro.motivo != MotivoRechazo::NINGUNO) {
+            return;
+        }
+
+        registro.cedula = claveCedula(campos[0].texto, 10);
+        registro.sucursal = static_cast<unsigned char>(sucursal);
+        registro.persona = new Persona(campos[0].str(), nombres, apellidos, fechaNacimiento, correo, campos[5].str());
+        const double saldo = centavos / 100.0;
+        if (corriente) {
+            CuentaCorriente* cuenta = new CuentaCorriente("0", saldo, fechaApertura, "ACTIVA", 0.0);
+            registro.persona->setCabezaCorriente(cuenta);
+            registro.cuenta = cuenta;
+        }
+        else {
+            CuentaAhorros* cuenta = new CuentaAhorros("0", saldo, fechaApertura, "ACTIVA", 5.0);
+            registro.persona->setCabezaAhorros(cuenta);
+            registro.cuenta = cuenta;
+        }
+        registro.persona->setNumeCuentas(1);
+    }
+
+    /**
+     * @brief Interpreta, valida y convierte en objetos las líneas [desde, hasta)
+     *
+     * Las cédulas de la tarea se validan juntas con Validar::ValidarCedulasLote;
+     * las que no se pueden tomar directamente de la línea (entre comillas o de
+     * otra longitud) se validan en la segunda pasada con Validar::ValidarCedula.
+     */
+    void procesarLineas(const std::string& contenido, const std::vector<Linea>& lineas, size_t desde, size_t hasta,
+        const std::string& fechaApertura, std::vector<Registro>& registros) {
+        const size_t cantidad = hasta - desde;
+        std::vector<char> lote((cantidad + 1) * PASO_CEDULAS, '0');
+        std::vector<int> posicionLote(cantidad, -1);
+        size_t enLote = 0;
+        for (size_t i = 0; i < cantidad; ++i) {
+            const Linea& linea = lineas[desde + i];
+            if (linea.fin - linea.inicio > 10 && contenido[linea.inicio + 10] == ',') {
+                std::memcpy(&lote[enLote * PASO_CEDULAS], contenido.data() + linea.inicio, 10);
+                posicionLote[i] = static_cast<int>(enLote++);
+            }
+        }
+        std::vector<uint64_t> mapa((enLote + 63) / 64 + 1);
+        Validar::ValidarCedulasLote(lote.data(), enLote, PASO_CEDULAS, mapa.data());
+
+        std::string escapes;
+        Campo campos[NUM_CAMPOS];
+        for (size_t i = 0; i < cantidad; ++i) {
+            const Linea& linea = lineas[desde + i];
+            Registro& registro = registros[desde + i];
+            if (!separarCampos(contenido.data() + linea.inicio, contenido.data() + linea.fin, campos, escapes)) {
+                registro.motivo = MotivoRechazo::CAMPOS_INCORRECTOS;
+                continue;
+            }
+
+            const int posicion = posicionLote[i];
+            const bool cedulaValida = posicion >= 0 ? ((mapa[posicion / 64] >> (posicion % 64)) & 1) != 0
+                : campos[0].longitud == 10 && Validar::ValidarCedula(campos[0].str());
+            interpretarCampos(campos, cedulaValida, fechaApertura, registro);
+        }
+    }
+
+    double segundosDesde(std::chrono::steady_clock::time_point inicio) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    }
+}
+
+/**
+ * @brief Importa los clientes de un CSV a la lista del banco
+ *
+ * @param lista Primer nodo de la lista de personas
+ * @param rutaCSV Ruta del archivo CSV
+ * @param rutaRechazos Ruta del archivo de rechazos
+ * @param hilos Número de hilos (0 = todos los núcleos)
+ * @return ResumenImportacion Clientes importados, rechazados y tiempos
+ */
+ResumenImportacion ImportadorCSV::importar(NodoPersona*& lista, const std::string& rutaCSV,
+    const std::string& rutaRechazos, unsigned int hilos) {
+    ResumenImportacion resumen;
+    const auto inicio = std::chrono::steady_clock::now();
+
+    // ----- Lectura: el archivo completo en memoria y las posiciones de sus lineas
+    std::ifstream archivo(rutaCSV, std::ios::binary);
+    if (!archivo.is_open()) {
+        return resumen;
+    }
+    archivo.seekg(0, std::ios::end);
+    std::string contenido(static_cast<size_t>(archivo.tellg()), '\0');
+    archivo.seekg(0, std::ios::beg);
+    archivo.read(&contenido[0], contenido.size());
+    archivo.close();
+
+    std::vector<Linea> lineas;
+    lineas.reserve(contenido.size() / 64 + 1);
+    size_t posicion = contenido.compare(0, 3, "\xEF\xBB\xBF") == 0 ? 3 : 0;
+    for (size_t numero = 1; posicion < contenido.size(); ++numero) {
+        const char* salto = static_cast<const char*>(std::memchr(contenido.data() + posicion, '\n', contenido.size() - posicion));
+        size_t fin = salto ? static_cast<size_t>(salto - contenido.data()) : contenido.size();
+        const size_t siguiente = fin + 1;
+        if (fin > posicion && contenido[fin - 1] == '\r') {
+            --fin;
+        }
+        if (fin > posicion) {
+            const bool cabecera = lineas.empty() && fin - posicion >= 6 &&
+                std::equal(contenido.begin() + posicion, contenido.begin() + posicion + 6, "cedula",
+                    [](char a, char b) { return (a | 0x20) == b; });
+            if (!cabecera) {
+                lineas.push_back({ posicion, fin, numero });
+            }
+        }
+        posicion = siguiente;
+    }
+    resumen.lineas = lineas.size();
+    resumen.segundosLectura = segundosDesde(inicio);
+
+    // ----- Interpretacion, validacion y creacion de objetos en paralelo
+    auto fase = std::chrono::steady_clock::now();
+    const std::string fechaApertura = Fecha().obtenerFechaFormateada();
+    std::vector<Registro> registros(lineas.size());
+    const size_t tareas = (lineas.size() + LINEAS_POR_TAREA - 1) / LINEAS_POR_TAREA;
+    Paralelo::ejecutar(tareas, hilos, [&](size_t tarea) {
+        const size_t desde = tarea * LINEAS_POR_TAREA;
+        procesarLineas(contenido, lineas, desde, std::min(lineas.size(), desde + LINEAS_POR_TAREA),
+            fechaApertura, registros);
+        return true;
+    });
+    resumen.segundosValidacion = segundosDesde(fase);
+
+    // ----- Duplicados y numeros de cuenta, en orden de archivo
+    fase = std::chrono::steady_clock::now();
+    std::unordered_map<uint64_t, size_t> cedulas;
+    cedulas.reserve(lineas.size() + 1024);
+    for (NodoPersona* nodo = lista; nodo; nodo = nodo->siguiente) {
+        Persona* persona = nodo->persona;
+        if (!persona || !persona->isValidInstance()) {
+            continue;
+        }
+        const std::string cedula = persona->getCedula();
+        const uint64_t clave = claveCedula(cedula.data(), cedula.size());
+        if (clave != 0) {
+            cedulas.emplace(clave, 0);
+        }
+    }
+    int secuenciales[NUM_SUCURSALES];
+    secuencialesPorSucursal(lista, secuenciales);
+
+    for (size_t i = 0; i < registros.size(); ++i) {
+        Registro& registro = registros[i];
+        if (registro.motivo != MotivoRechazo::NINGUNO) {
+            continue;
+        }
+        auto insercion = cedulas.emplace(registro.cedula, lineas[i].numero);
+        if (!insercion.second) {
+            registro.lineaOriginal = insercion.first->second;
+            registro.motivo = registro.lineaOriginal == 0 ? MotivoRechazo::CEDULA_REGISTRADA : MotivoRechazo::CEDULA_DUPLICADA;
+        }
+        else if (secuenciales[registro.sucursal] >= SECUENCIAL_MAXIMO) {
+            registro.motivo = MotivoRechazo::SIN_NUMEROS_CUENTA;
+        }
+        if (registro.motivo != MotivoRechazo::NINGUNO) {
+            delete registro.persona;
+            registro.persona = nullptr;
+            continue;
+        }
+
+        registro.cuenta->setNumeroCuenta(numeroCuenta(registro.sucursal, ++secuenciales[registro.sucursal]));
+    }
+    resumen.segundosAsignacion = segundosDesde(fase);
+
+    // ----- Enlace a la lista del banco y archivo de rechazos
+    fase = std::chrono::steady_clock::now();
+    std::string rechazos = "linea,motivo,registro\n";
+    for (size_t i = 0; i < registros.size(); ++i) {
+        const Registro& registro = registros[i];
+        if (registro.persona) {
+            NodoPersona* nodo = new NodoPersona(registro.persona);
+            nodo->siguiente = lista;
+            lista = nodo;
+            ++resumen.importados;
+            continue;
+        }
+        ++resumen.rechazados;
+        rechazos += std::to_string(lineas[i].numero);
+        rechazos += ',';
+        rechazos += describirMotivo(registro.motivo);
+        if (registro.motivo == MotivoRechazo::CEDULA_DUPLICADA) {
+            rechazos += " en la linea ";
+            rechazos += std::to_string(registro.lineaOriginal);
+        }
+        rechazos += ',';
+        rechazos.append(contenido, lineas[i].inicio, lineas[i].fin - lineas[i].inicio);
+        rechazos += '\n';
+    }
+
+    std::ofstream salida(rutaRechazos, std::ios::binary | std::ios::trunc);
+    if (salida.is_open()) {
+        salida.write(rechazos.data(), rechazos.size());
+        resumen.exito = static_cast<bool>(salida);
+    }
+    resumen.segundosEnlace = segundosDesde(fase);
+    resumen.segundos = segundosDesde(inicio);
+    return resumen;
+}
+
+/**
+ * @brief Interpreta y valida una línea con el formato del CSV y crea el cliente con su cuenta
+ *
+ * @param linea Línea con los nueve campos, sin salto de línea
+ * @param fechaApertura Fecha de apertura de la cuenta (DD/MM/AAAA)
+ * @param persona Salida: cliente creado, o nullptr si la línea se rechaza
+ * @param cuenta Salida: cuenta del cliente, con número "0"
+ * @param sucursal Salida: índice de la sucursal en el orden 210, 220, 480, 560
+ * @return MotivoRechazo NINGUNO si la línea es válida
+ */
+MotivoRechazo ImportadorCSV::interpretarLinea(const std::string& linea, const std::string& fechaApertura,
+    Persona*& persona, Cuenta<double>*& cuenta, int& sucursal) {
+    Registro registro;
+    std::string escapes;
+    Campo campos[NUM_CAMPOS];
+    if (!separarCampos(linea.data(), linea.data() + linea.size(), campos, escapes)) {
+        registro.motivo = MotivoRechazo::CAMPOS_INCORRECTOS;
+    }
+    else {
+        const bool cedulaValida = campos[0].longitud == 10 && Validar::ValidarCedula(campos[0].str());
+        interpretarCampos(campos, cedulaValida, fechaApertura, registro);
+    }
+    persona = registro.persona;
+    cuenta = registro.cuenta;
+    sucursal = registro.sucursal;
+    return registro.motivo;
+}
+
+/**
+ * @brief Mayor secuencial usado por cada sucursal en las cuentas de una lista
+ *
+ * @param lista Primer nodo de la lista de personas
+ * @param secuenciales Salida: mayor secuencial de cada sucursal (0 si no tiene cuentas)
+ */
+void ImportadorCSV::secuencialesPorSucursal(NodoPersona* lista, int secuenciales[NUM_SUCURSALES]) {
+    std::fill(secuenciales, secuenciales + NUM_SUCURSALES, 0);
+    int secuencial = 0;
+    for (NodoPersona* nodo = lista; nodo; nodo = nodo->siguiente) {
+        Persona* persona = nodo->persona;
+        if (!persona || !persona->isValidInstance()) {
+            continue;
+        }
+        for (CuentaAhorros* c = persona->getCabezaAhorros(); c; c = c->getSiguiente()) {
+            const int s = sucursalDeCuenta(c->getNumeroCuenta(), secuencial);
+            if (s >= 0) secuenciales[s] = std::max(secuenciales[s], secuencial);
+        }
+        for (CuentaCorriente* c = persona->getCabezaCorriente(); c; c = c->getSiguiente()) {
+            const int s = sucursalDeCuenta(c->getNumeroCuenta(), secuencial);
+            if (s >= 0) secuenciales[s] = std::max(secuenciales[s], secuencial);
+        }
+    }
+}
+
+/**
+ * @brief Número de cuenta con el formato de Persona::crearNumeroCuenta
+ *
+ * Código de sucursal, secuencial de 6 dígitos y dígito verificador igual a la
+ * suma de los anteriores módulo 10.
+ *
+ * @param sucursal Índice de la sucursal
+ * @param secuencial Secuencial, de 1 a 999999
+ * @return std::string Número de 10 dígitos
+ */
+std::string ImportadorCSV::numeroCuenta(int sucursal, int secuencial) {
+    char numero[10];
+    std::memcpy(numero, CODIGOS_SUCURSAL[sucursal], 3);
+    for (int d = 8; d >= 3; --d, secuencial /= 10) {
+        numero[d] = static_cast<char>('0' + secuencial % 10);
+    }
+    int suma = 0;
+    for (int d = 0; d < 9; ++d) {
+        suma += numero[d] - '0';
+    }
+    numero[9] = static_cast<char>('0' + suma % 10);
+    return std::string(numero, 10);
+}
+
+/**
+ * @brief Texto de un motivo de rechazo para el archivo de rechazos
+ *
+ * @param motivo Motivo
+ * @return const char* Descripción corta, sin comas
+ */
+const char* ImportadorCSV::describirMotivo(MotivoRechazo motivo) {
+    switch (motivo) {
+    case MotivoRechazo::NINGUNO: return "importado";
+    case MotivoRechazo::CAMPOS_INCORRECTOS: return "se esperaban 9 campos";
+    case MotivoRechazo::CEDULA_INVALIDA: return "cedula invalida";
+    case MotivoRechazo::NOMBRES_INVALIDOS: return "nombres invalidos";
+    case MotivoRechazo::APELLIDOS_INVALIDOS: return "apellidos invalidos";
+    case MotivoRechazo::FECHA_INVALIDA: return "fecha de nacimiento invalida";
+    case MotivoRechazo::CORREO_INVALIDO: return "correo invalido";
+    case MotivoRechazo::DIRECCION_INVALIDA: return "direccion invalida";
+    case MotivoRechazo::TIPO_CUENTA_INVALIDO: return "tipo de cuenta invalido";
+    case MotivoRechazo::SUCURSAL_INVALIDA: return "sucursal invalida";
+    case MotivoRechazo::SALDO_INVALIDO: return "saldo inicial invalido";
+    case MotivoRechazo::CEDULA_DUPLICADA: return "cedula duplicada";
+    case MotivoRechazo::CEDULA_REGISTRADA: return "cedula ya registrada en el banco";
+    case MotivoRechazo::SIN_NUMEROS_CUENTA: return "sucursal sin numeros de cuenta disponibles";
+    }
+    return "desconocido";
+}
@@ -0,0 +1,141 @@
+#pragma once
+#ifndef IMPORTADORCSV_H
+#define IMPORTADORCSV_H
+
+#include <string>
+#include <cstddef>
+#include "NodoPersona.h"
+
+class Persona;
+template <typename T> class Cuenta;
+
+/**
+ * @enum MotivoRechazo
+ * @brief Causa por la que una línea del CSV no se importó
+ */
+enum class MotivoRechazo : unsigned char {
+    NINGUNO,               ///< La línea se importó
+    CAMPOS_INCORRECTOS,    ///< No tiene 9 campos o las comillas no están cerradas
+    CEDULA_INVALIDA,       ///< No pasa Validar::ValidarCedula
+    NOMBRES_INVALIDOS,     ///< No pasa Validar::ValidarNombrePersona
+    APELLIDOS_INVALIDOS,   ///< No pasa Validar::ValidarNombrePersona
+    FECHA_INVALIDA,        ///< No pasa Validar::ValidarFecha
+    CORREO_INVALIDO,       ///< No pasa Utilidades::EsCorreoValido
+    DIRECCION_INVALIDA,    ///< Vacía, de más de 100 caracteres o con caracteres no permitidos
+    TIPO_CUENTA_INVALIDO,  ///< No es "Ahorros" ni "Corriente"
+    SUCURSAL_INVALIDA,     ///< No es 210, 220, 480 ni 560
+    SALDO_INVALIDO,        ///< Formato incorrecto o fuera del rango del tipo de cuenta
+    CEDULA_DUPLICADA,      ///< La cédula ya apareció en una línea anterior del archivo
+    CEDULA_REGISTRADA,     ///< La cédula ya pertenece a un cliente del banco
+    SIN_NUMEROS_CUENTA     ///< La sucursal agotó sus 999999 números secuenciales
+};
+
+/**
+ * @struct ResumenImportacion
+ * @brief Resultado de una importación masiva de clientes
+ */
+struct ResumenImportacion {
+    /** @brief Líneas de datos leídas (sin la cabecera ni las líneas vacías) */
+    size_t lineas = 0;
+    /** @brief Clientes agregados al banco */
+    size_t importados = 0;
+    /** @brief Líneas escritas en el archivo de rechazos */
+    size_t rechazados = 0;
+    /** @brief Segundos en leer el archivo y separar las líneas */
+    double segundosLectura = 0.0;
+    /** @brief Segundos en interpretar, validar y crear los objetos, en paralelo */
+    double segundosValidacion = 0.0;
+    /** @brief Segundos en descartar duplicados y asignar números de cuenta */
+    double segundosAsignacion = 0.0;
+    /** @brief Segundos en enlazar los clientes y escribir los rechazos */
+    double segundosEnlace = 0.0;
+    /** @brief Duración total en segundos */
+    double segundos = 0.0;
+    /** @brief false si no se pudo abrir el CSV o escribir el archivo de rechazos */
+    bool exito = false;
+};
+
+/**
+ * @class ImportadorCSV
+ * @brief Clase estática para agregar clientes al banco en bloque desde un CSV
+ *
+ * Cada línea tiene nueve campos separados por comas: cédula, nombres, apellidos,
+ * fecha de nacimiento (DD/MM/AAAA), correo, dirección, tipo de cuenta
+ * (Ahorros o Corriente), sucursal (210, 220, 480 o 560) y saldo inicial. Un campo
+ * puede ir entre comillas dobles para contener comas, con "" para una comilla.
+ * Si la primera línea empieza con "cedula" se toma como cabecera.
+ *
+ * Se aplican las mismas reglas que en el ingreso por teclado: la cuenta de
+ * ahorros admite un saldo inicial de 0 a 15000.00 y la corriente de 250.00 a
+ * 15000.00. Cada cliente recibe una cuenta activa abierta en la fecha actual.
+ *
+ * La importación va por fases: las líneas se interpretan, validan y convierten
+ * en objetos en paralelo; luego, en orden de archivo, un conjunto hash descarta
+ * cédulas repetidas o ya registradas y se reparten los números de cuenta de cada
+ * sucursal a partir del mayor existente; al final los clientes se enlazan a la
+ * lista del banco en una sola pasada, como si se hubieran agregado uno a uno.
+ */
+class ImportadorCSV {
+public:
+    /**
+     * @brief Importa los clientes de un CSV a la lista del banco
+     * @param lista Primer nodo de la lista de personas del banco; se actualiza
+     * @param rutaCSV Ruta del archivo CSV
+     * @param rutaRechazos Ruta del CSV donde se escriben las líneas rechazadas
+     *        con su número de línea y su motivo
+     * @param hilos Número de hilos (0 = todos los núcleos disponibles)
+     * @return Resumen con los clientes importados y rechazados y el tiempo de cada fase
+     */
+    static ResumenImportacion importar(NodoPersona*& lista, const std::string& rutaCSV,
+        const std::string& rutaRechazos, unsigned int hilos = 0);
+
+    /**
+     * @brief Texto de un motivo de rechazo
+     * @param motivo Motivo
+     * @return Descripción corta, sin comas
+     */
+    static const char* describirMotivo(MotivoRechazo motivo);
+
+    /**
+     * @brief Interpreta y valida una sola línea con el formato del CSV
+     *
+     * Aplica las mismas reglas que importar, salvo las de duplicados, y crea el
+     * cliente con su cuenta. El número de cuenta queda en "0": lo asigna quien
+     * enlaza al cliente, con numeroCuenta.
+     *
+     * @param linea Línea con los nueve campos, sin salto de línea
+     * @param fechaApertura Fecha de apertura de la cuenta (DD/MM/AAAA)
+     * @param persona Salida: cliente creado (a cargo de quien llama), o nullptr si se rechaza
+     * @param cuenta Salida: cuenta del cliente
+     * @param sucursal Salida: índice de la sucursal en el orden 210, 220, 480, 560
+     * @return MotivoRechazo::NINGUNO si la línea es válida
+     */
+    static MotivoRechazo interpretarLinea(const std::string& linea, const std::string& fechaApertura,
+        Persona*& persona, Cuenta<double>*& cuenta, int& sucursal);
+
+    /** @brief Número de sucursales (210, 220, 480 y 560) */
+    static const int NUM_SUCURSALES = 4;
+
+    /**
+     * @brief Mayor secuencial de cada sucursal entre las cuentas de una lista
+     * @param lista Primer nodo de la lista de personas
+     * @param secuenciales Salida: un valor por sucursal, 0 si no tiene cuentas
+     */
+    static void secuencialesPorSucursal(NodoPersona* lista, int secuenciales[NUM_SUCURSALES]);
+
+    /**
+     * @brief Número de cuenta con el formato de Persona::crearNumeroCuenta
+     * @param sucursal Índice de la sucursal
+     * @param secuencial Secuencial de 1 a SECUENCIAL_MAXIMO
+     * @return Número de 10 dígitos
+     */
+    static std::string numeroCuenta(int sucursal, int secuencial);
+
+    /** @brief Mayor secuencial de 6 dígitos de un número de cuenta */
+    static const int SECUENCIAL_MAXIMO = 999999;
+
+    /** @brief Líneas que procesa cada tarea de la fase paralela */
+    static const size_t LINEAS_POR_TAREA = 4096;
+};
+
+#endif // IMPORTADORCSV_H
@@ -0,0 +1,596 @@
+/**
+ * @file InterpreteComandos.cpp
+ * @brief Modo sin consola: comandos de texto contra el banco con resultados JSON
+ */
+#include "InterpreteComandos.h"
+#include "Persona.h"
+#include "Validar.h"
+#include "Hash.h"
+#include "CodigoQR.h"
+#include "Fecha.h"
+#include "Estadisticas.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+    /**
+     * @class SilencioCout
+     * @brief Descarta lo que se escribe en std::cout mientras existe
+     *
+     * Las operaciones de las cuentas informan por consola; en este modo la
+     * consola es la salida JSON.
+     */
+    class SilencioCout {
+    public:
+        SilencioCout() : anterior(std::cout.rdbuf(nullptr)) {}
+        ~SilencioCout() { std::cout.rdbuf(anterior); }
+    private:
+        std::streambuf* anterior;
+    };
+
+    /**
+     * @brief Separa los argumentos de un comando; un argumento puede ir entre comillas dobles
+     * @return false si quedan comillas sin cerrar
+     */
+    bool separarArgumentos(const std::string& linea, size_t desde, std::vector<std::string>& argumentos) {
+        size_t i = desde;
+        while (true) {
+            while (i < linea.size() && (linea[i] == ' ' || linea[i] == '\t' || linea[i] == '\r')) ++i;
+            if (i >= linea.size()) {
+                return true;
+            }
+            if (linea[i] == '"') {
+                const size_t cierre = linea.find('"', i + 1);
+                if (cierre == std::string::npos) {
+                    return false;
+                }
+                argumentos.push_back(linea.substr(i + 1, cierre - i - 1));
+                i = cierre + 1;
+            }
+            else {
+                const size_t fin = linea.find_first_of(" \t\r", i);
+                argumentos.push_back(linea.substr(i, fin == std::string::npos ? std::string::npos : fin - i));
+                i = fin == std::string::npos ? linea.size() : fin;
+            }
+        }
+    }
+
+    /**
+     * @brief Agrega un texto a un JSON escapando comillas, barras y caracteres de control
+     */
+    void escribirTextoJSON(std::string& json, const std::string& texto) {
+        json += '"';
+        for (char c : texto) {
+            if (c == '"' || c == '\\') {
+                json += '\\';
+                json += c;
+            }
+            else if (static_cast<unsigned char>(c) < 0x20) {
+                char escape[8];
+                std::snprintf(escape, sizeof(escape), "\\u%04x", static_cast<unsigned>(c));
+                json += escape;
+            }
+            else {
+                json += c;
+            }
+        }
+        json += '"';
+    }
+
+    /** @brief Agrega ,"clave":"valor" */
+    void campoTexto(std::string& json, const char* clave, const std::string& valor) {
+        json += ",\"";
+        json += clave;
+        json += "\":";
+        escribirTextoJSON(json, valor);
+    }
+
+    /** @brief Agrega ,"clave":valor con los decimales indicados */
+    void campoNumero(std::string& json, const char* clave, double valor, int decimales) {
+        char numero[48];
+        std::snprintf(numero, sizeof(numero), "%.*f", decimales, valor);
+        json += ",\"";
+        json += clave;
+        json += "\":";
+        json += numero;
+    }
+
+    /** @brief Monto con dos decimales, como texto para no perder los centavos */
+    std::string montoTexto(double monto) {
+        char texto[48];
+        std::snprintf(texto, sizeof(texto), "%.2f", monto);
+        return texto;
+    }
+
+    /**
+     * @brief Convierte un monto positivo con hasta dos decimales
+     * @return false si el formato no es válido, es cero o es demasiado grande
+     */
+    bool leerMonto(const std::string& texto, double& monto) {
+        if (texto.size() > 12 || !Validar::ValidarNumeroConDosDecimales(texto)) {
+            return false;
+        }
+        monto = std::stod(texto);
+        return monto > 0;
+    }
+
+    /**
+     * @brief Agrega ,"cuentas":[...] con las cuentas de una persona
+     */
+    void campoCuentas(std::string& json, const Persona* persona) {
+        json += ",\"cuentas\":[";
+        bool primera = true;
+        auto agregar = [&](const Cuenta<double>* cuenta, const char* tipo) {
+            json += primera ? "{" : ",{";
+            primera = false;
+            json += "\"numero\":";
+            escribirTextoJSON(json, cuenta->getNumeroCuenta());
+            campoTexto(json, "tipo", tipo);
+            campoTexto(json, "saldo", montoTexto(cuenta->getSaldo()));
+            campoTexto(json, "estado", cuenta->consultarEstado());
+            json += '}';
+        };
+        for (const CuentaAhorros* c = persona->getCabezaAhorros(); c; c = c->getSiguiente()) {
+            agregar(c, "Ahorros");
+        }
+        for (const CuentaCorriente* c = persona->getCabezaCorriente(); c; c = c->getSiguiente()) {
+            agregar(c, "Corriente");
+        }
+        json += ']';
+    }
+}
+
+/**
+ * @brief Crea el intérprete e indexa los clientes del banco
+ *
+ * @param banco Banco sobre el que se ejecutan los comandos
+ */
+InterpreteComandos::InterpreteComandos(Banco& banco)
+    : banco(banco), fechaApertura(Fecha().obtenerFechaFormateada()) {
+    reconstruirIndices();
+}
+
+/**
+ * @brief Vuelve a indexar todos los clientes y cuentas del banco
+ */
+void InterpreteComandos::reconstruirIndices() {
+    porCedula.clear();
+    porCuenta.clear();
+    for (NodoPersona* nodo = banco.getListaPersonas(); nodo; nodo = nodo->siguiente) {
+        if (nodo->persona && nodo->persona->isValidInstance()) {
+            indexar(nodo->persona);
+        }
+    }
+    ImportadorCSV::secuencialesPorSucursal(banco.getListaPersonas(), secuenciales);
+}
+
+/**
+ * @brief Agrega a los índices un cliente y sus cuentas
+ *
+ * @param persona Cliente a indexar
+ */
+void InterpreteComandos::indexar(Persona* persona) {
+    porCedula.emplace(persona->getCedula(), persona);
+    for (CuentaAhorros* c = persona->getCabezaAhorros(); c; c = c->getSiguiente()) {
+        porCuenta.emplace(c->getNumeroCuenta(), UbicacionCuenta{ c, persona, true });
+    }
+    for (CuentaCorriente* c = persona->getCabezaCorriente(); c; c = c->getSiguiente()) {
+        porCuenta.emplace(c->getNumeroCuenta(), UbicacionCuenta{ c, persona, false });
+    }
+}
+
+/**
+ * @brief Ejecuta todos los comandos de un flujo
+ *
+ * @param entrada Guion o entrada estándar
+ * @param salida Destino de los resultados
+ * @return ResumenComandos Totales y tiempos por tipo de comando
+ */
+ResumenComandos InterpreteComandos::ejecutar(std::istream& entrada, std::ostream& salida) {
+    ResumenComandos resumen;
+    const auto inicio = std::chrono::steady_clock::now();
+    std::string linea;
+    for (size_t numero = 1; std::getline(entrada, linea); ++numero) {
+        ejecutarLinea(linea, numero, salida, resumen);
+    }
+    resumen.segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    std::string json = "{\"resumen\":{\"comandos\":" + std::to_string(resumen.comandos) +
+        ",\"errores\":" + std::to_string(resumen.errores);
+    campoNumero(json, "segundos", resumen.segundos, 6);
+    json += ",\"por_comando\":{";
+    bool primero = true;
+    for (const auto& tiempo : resumen.porComando) {
+        if (!primero) json += ',';
+        primero = false;
+        escribirTextoJSON(json, tiempo.first);
+        json += ":{\"veces\":" + std::to_string(tiempo.second.veces) +
+            ",\"errores\":" + std::to_string(tiempo.second.errores);
+        campoNumero(json, "us_total", tiempo.second.microsegundos, 1);
+        campoNumero(json, "us_promedio", tiempo.second.microsegundos / tiempo.second.veces, 2);
+        json += '}';
+    }
+    json += "}}}\n";
+    salida << json;
+    salida.flush();
+    return resumen;
+}
+
+/**
+ * @brief Ejecuta un solo comando y escribe su resultado
+ *
+ * @param linea Texto del comando
+ * @param numeroLinea Número de línea que se informa
+ * @param salida Destino del resultado
+ * @param resumen Totales que se actualizan
+ * @return bool true si el comando terminó bien o la línea se ignoró
+ */
+bool InterpreteComandos::ejecutarLinea(const std::string& linea, size_t numeroLinea, std::ostream& salida,
+    ResumenComandos& resumen) {
+    const size_t inicio = linea.find_first_not_of(" \t\r");
+    if (inicio == std::string::npos || linea[inicio] == '#') {
+        return true;
+    }
+    size_t finComando = linea.find_first_of(" \t\r", inicio);
+    if (finComando == std::string::npos) {
+        finComando = linea.size();
+    }
+    const std::string comando = linea.substr(inicio, finComando - inicio);
+
+    std::string datos;
+    std::string error;
+    const auto comienzo = std::chrono::steady_clock::now();
+    {
+        SilencioCout silencio;
+        try {
+            if (comando == "create") {
+                const size_t desde = linea.find_first_not_of(" \t", finComando);
+                error = crear(desde == std::string::npos ? std::string() : linea.substr(desde), datos);
+            }
+            else {
+                std::vector<std::string> argumentos;
+                if (!separarArgumentos(linea, finComando, argumentos)) error = "comillas sin cerrar";
+                else if (comando == "deposit") error = depositar(argumentos, datos);
+                else if (comando == "withdraw") error = retirar(argumentos, datos);
+                else if (comando == "transfer") error = transferir(argumentos, datos);
+                else if (comando == "search") error = buscar(argumentos, datos);
+                else if (comando == "save") error = guardar(argumentos, datos);
+                else if (comando == "load") error = cargar(argumentos, datos);
+                else if (comando == "hash") error = calcularHash(argumentos, datos);
+                else if (comando == "qr") error = generarQR(argumentos, datos);
+                else if (comando == "stats") error = estadisticas(argumentos, datos);
+                else error = "comando desconocido";
+            }
+        }
+        catch (const std::exception& e) {
+            error = e.what();
+        }
+    }
+    const double microsegundos =
+        std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - comienzo).count();
+
+    const bool ok = error.empty();
+    ++resumen.comandos;
+    TiempoComando& tiempo = resumen.porComando[comando];
+    ++tiempo.veces;
+    tiempo.microsegundos += microsegundos;
+    if (!ok) {
+        ++resumen.errores;
+        ++tiempo.errores;
+    }
+
+    std::string json = "{\"linea\":" + std::to_string(numeroLinea);
+    campoTexto(json, "comando", comando);
+    json += ok ? ",\"ok\":true" : ",\"ok\":false";
+    campoNumero(json, "us", microsegundos, 1);
+    if (ok) json += datos;
+    else campoTexto(json, "error", error);
+    json += "}\n";
+    salida << json;
+    return ok;
+}
+
+/**
+ * @brief create: agrega un cliente con su cuenta, con las reglas de ImportadorCSV
+ *
+ * @param registro Nueve campos separados por comas
+ * @param datos Salida: campos JSON del resultado
+ * @return std::string Mensaje de error, vacío si terminó bien
+ */
+std::string InterpreteComandos::crear(const std::string& registro, std::string& datos) {
+    Persona* persona = nullptr;
+    Cuenta<double>* cuenta = nullptr;
+    int sucursal = 0;
+    const MotivoRechazo motivo = ImportadorCSV::interpretarLinea(registro, fechaApertura, persona, cuenta, sucursal);
+    if (motivo != MotivoRechazo::NINGUNO) {
+        return ImportadorCSV::describirMotivo(motivo);
+    }
+    const bool registrada = porCedula.count(persona->getCedula()) != 0;
+    if (registrada || secuenciales[sucursal] >= ImportadorCSV::SECUENCIAL_MAXIMO) {
+        delete persona;
+        return ImportadorCSV::describirMotivo(registrada ? MotivoRechazo::CEDULA_REGISTRADA : MotivoRechazo::SIN_NUMEROS_CUENTA);
+    }
+    cuenta->setNumeroCuenta(ImportadorCSV::numeroCuenta(sucursal, ++secuenciales[sucursal]));
+
+    NodoPersona* nodo = new NodoPersona(persona);
+    nodo->siguiente = banco.getListaPersonas();
+    banco.setListaPersonas(nodo);
+    indexar(persona);
+
+    campoTexto(datos, "cedula", persona->getCedula());
+    campoTexto(datos, "cuenta", cuenta->getNumeroCuenta());
+    campoTexto(datos, "tipo", persona->getCabezaAhorros() ? "Ahorros" : "Corriente");
+    campoTexto(datos, "saldo", montoTexto(cuenta->getSaldo()));
+    return "";
+}
+
+/**
+ * @brief deposit: deposita en una cuenta con Cuenta::depositar
+ *
+ * @param argumentos Número de cuenta y monto
+ * @param datos Salida: saldo resultante
+ * @return std::string Mensaje de error, vacío si terminó bien
+ */
+std::string InterpreteComandos::depositar(const std::vector<std::string>& argumentos, std::string& datos) {
+    double monto = 0;
+    if (argumentos.size() != 2) return "uso: deposit <cuenta> <monto>";
+    auto ubicacion = porCuenta.find(argumentos[0]);
+    if (ubicacion == porCuenta.end()) return "cuenta no encontrada";
+    if (!leerMonto(argumentos[1], monto)) return "monto invalido";
+
+    Cuenta<double>* cuenta = ubicacion->second.cuenta;
+    const double saldoAnterior = cuenta->getSaldo();
+    cuenta->depositar(monto);
+    if (cuenta->getSaldo() == saldoAnterior) return "el saldo excederia el limite de la cuenta";
+    campoTexto(datos, "cuenta", argumentos[0]);
+    campoTexto(datos, "saldo", montoTexto(cuenta->getSaldo()));
+    return "";
+}
+
+/**
+ * @brief withdraw: retira de una cuenta con Cuenta::retirar
+ *
+ * @param argumentos Número de cuenta y monto
+ * @param datos Salida: saldo resultante
+ * @return std::string Mensaje de error, vacío si terminó bien
+ */
+std::string InterpreteComandos::retirar(const std::vector<std::string>& argumentos, std::string& datos) {
+    double monto = 0;
+    if (argumentos.size() != 2) return "uso: withdraw <cuenta> <monto>";
+    auto ubicacion = porCuenta.find(argumentos[0]);
+    if (ubicacion == porCuenta.end()) return "cuenta no encontrada";
+    if (!leerMonto(argumentos[1], monto)) return "monto invalido";
+
+    Cuenta<double>* cuenta = ubicacion->second.cuenta;
+    if (monto > cuenta->getSaldo()) return "fondos insuficientes";
+    cuenta->retirar(monto);
+    campoTexto(datos, "cuenta", argumentos[0]);
+    campoTexto(datos, "saldo", montoTexto(cuenta->getSaldo()));
+    return "";
+}
+
+/**
+ * @brief transfer: mueve un monto entre dos cuentas
+ *
+ * Si la cuenta destino rechaza el depósito, el saldo de origen se restituye.
+ *
+ * @param argumentos Cuenta origen, cuenta destino y monto
+ * @param datos Salida: saldos resultantes
+ * @return std::string Mensaje de error, vacío si terminó bien
+ */
+std::string InterpreteComandos::transferir(const std::vector<std::string>& argumentos, std::string& datos) {
+    double monto = 0;
+    if (argumentos.size() != 3) return "uso: transfer <origen> <destino> <monto>";
+    auto origen = porCuenta.find(argumentos[0]);
+    auto destino = porCuenta.find(argumentos[1]);
+    if (origen == porCuenta.end()) return "cuenta de origen no encontrada";
+    if (destino == porCuenta.end()) return "cuenta de destino no encontrada";
+    if (origen == destino) return "las cuentas de origen y destino son la misma";
+    if (!leerMonto(argumentos[2], monto)) return "monto invalido";
+
+    Cuenta<double>* cuentaOrigen = origen->second.cuenta;
+    Cuenta<double>* cuentaDestino = destino->second.cuenta;
+    const double saldoOrigen = cuentaOrigen->getSaldo();
+    if (monto > saldoOrigen) return "fondos insuficientes";
+    {
+        MEDIR_OPERACION(Operacion::Transferir);
+        cuentaOrigen->retirar(monto);
+        const double saldoDestino = cuentaDestino->getSaldo();
+        cuentaDestino->depositar(monto);
+        if (cuentaDestino->getSaldo() == saldoDestino) {
+            cuentaOrigen->setSaldo(saldoOrigen);
+            return "el saldo de la cuenta destino excederia su limite";
+        }
+    }
+    campoTexto(datos, "saldo_origen", montoTexto(cuentaOrigen->getSaldo()));
+    campoTexto(datos, "saldo_destino", montoTexto(cuentaDestino->getSaldo()));
+    return "";
+}
+
+/**
+ * @brief search: busca un cliente por cédula o por número de cuenta
+ *
+ * @param argumentos Cédula o número de cuenta
+ * @param datos Salida: datos del cliente y de sus cuentas
+ * @return std::string Mensaje de error, vacío si terminó bien
+ */
+std::string InterpreteComandos::buscar(const std::vector<std::string>& argumentos, std::string& datos) {
+    if (argumentos.size() != 1) return "uso: search <cedula|cuenta>";
+    const Persona* persona = nullptr;
+    bool porNumeroCuenta = false;
+    {
+        MEDIR_OPERACION(Operacion::BuscarCuenta);
+        auto ubicacion = porCuenta.find(argumentos[0]);
+        if (ubicacion != porCuenta.end()) {
+            persona = ubicacion->second.titular;
+            porNumeroCuenta = true;
+        }
+    }
+    if (persona == nullptr) {
+        MEDIR_OPERACION(Operacion::BuscarCedula);
+        auto cliente = porCedula.find(argumentos[0]);
+        if (cliente == porCedula.end()) return "no se encontro la cedula ni la cuenta";
+        persona = cliente->second;
+    }
+    campoTexto(datos, "por", porNumeroCuenta ? "cuenta" : "cedula");
+    campoTexto(datos, "cedula", persona->getCedula());
+    campoTexto(datos, "nombres", persona->getNombres());
+    campoTexto(datos, "apellidos", persona->getApellidos());
+    campoTexto(datos, "correo", persona->getCorreo());
+    campoCuentas(datos, persona);
+    return "";
+}
+
+/**
+ * @brief save: escribe el respaldo del banco con Banco::guardarCuentasEnRuta
+ *
+ * @param argumentos Ruta del respaldo
+ * @param datos Salida: personas guardadas
+ * @return std::string Mensaje de error, vacío si terminó bien
+ */
+std::string InterpreteComandos::guardar(const std::vector<std::string>& argumentos, std::string& datos) {
+    if (argumentos.size() != 1) return "uso: save <ruta>";
+    const int personas = banco.guardarCuentasEnRuta(argumentos[0]);
+    if (personas < 0) return "no se pudo escribir el archivo";
+    campoNumero(datos, "personas", personas, 0);
+    return "";
+}
+
+/**
+ * @brief load: reemplaza los clientes con un respaldo y vuelve a indexarlos
+ *
+ * @param argumentos Ruta del respaldo
+ * @param datos Salida: personas y cuentas cargadas
+ * @return std::string Mensaje de error, vacío si terminó bien
+ */
+std::string InterpreteComandos::cargar(const std::vector<std::string>& argumentos, std::string& datos) {
+    if (argumentos.size() != 1) return "uso: load <ruta>";
+    const int personas = banco.cargarCuentasDesdeRuta(argumentos[0]);
+    if (personas == -1) return "no se pudo abrir el archivo";
+    if (personas == -2) return "el archivo no es un respaldo del banco";
+    reconstruirIndices();
+    campoNumero(datos, "personas", personas, 0);
+    campoNumero(datos, "cuentas", static_cast<double>(porCuenta.size()), 0);
+    return "";
+}
+
+/**
+ * @brief hash: resumen SHA-1 o SHA-256 de un archivo con Hash::calcularArchivo
+ *
+ * @param argumentos Ruta y, opcionalmente, el algoritmo (SHA-256 por defecto)
+ * @param datos Salida: algoritmo, resumen y tamaño
+ * @return std::string Mensaje de error, vacío si terminó bien
+ */
+std::string InterpreteComandos::calcularHash(const std::vector<std::string>& argumentos, std::string& datos) {
+    if (argumentos.empty() || argumentos.size() > 2) return "uso: hash <ruta> [sha1|sha256]";
+    AlgoritmoHash algoritmo = AlgoritmoHash::SHA256;
+    if (argumentos.size() == 2 && !Hash::algoritmoDesdeNombre(argumentos[1], algoritmo)) return "algoritmo desconocido";
+
+    std::string hexadecimal;
+    uint64_t tamanio = 0;
+    bool leido;
+    {
+        MEDIR_OPERACION(Operacion::CalcularHash);
+        leido = Hash::calcularArchivo(argumentos[0], algoritmo, hexadecimal, tamanio);
+    }
+    if (!leido) return "no se pudo leer el archivo";
+    campoTexto(datos, "algoritmo", Hash::nombreAlgoritmo(algoritmo));
+    campoTexto(datos, "hash", hexadecimal);
+    campoNumero(datos, "bytes", static_cast<double>(tamanio), 0);
+    return "";
+}
+
+/**
+ * @brief qr: genera el código QR de una cuenta con el texto de GeneradorQRTextoPlano
+ *
+ * @param argumentos Número de cuenta y, opcionalmente, la ruta del archivo de texto
+ * @param datos Salida: versión y tamaño del código
+ * @return std::string Mensaje de error, vacío si terminó bien
+ */
+std::string InterpreteComandos::generarQR(const std::vector<std::string>& argumentos, std::string& datos) {
+    if (argumentos.empty() || argumentos.size() > 2) return "uso: qr <cuenta> [ruta]";
+    auto ubicacion = porCuenta.find(argumentos[0]);
+    if (ubicacion == porCuenta.end()) return "cuenta no encontrada";
+
+    const Persona* titular = ubicacion->second.titular;
+    const std::string texto = CodigoQR::GeneradorQRTextoPlano::formatearDatos(
+        titular->getNombres() + " " + titular->getApellidos(), argumentos[0]);
+    std::shared_ptr<const CodigoQR::QrCode> codigo =
+        CodigoQR::CacheCodigosQR::compartida().obtener(texto, CodigoQR::QrCode::Ecc::LOW);
+    if (argumentos.size() == 2) {
+        if (!CodigoQR::RenderizadorTextoQR::guardar(*codigo, argumentos[1], CodigoQR::ModoTextoQR::MEDIOS_BLOQUES)) {
+            return "no se pudo escribir el archivo";
+        }
+        campoTexto(datos, "archivo", argumentos[1]);
+    }
+    campoNumero(datos, "version", codigo->getVersion(), 0);
+    campoNumero(datos, "modulos", codigo->getSize(), 0);
+    return "";
+}
+
+/**
+ * @brief stats: latencias registradas por Estadisticas desde el inicio del programa
+ *
+ * Sin argumentos las devuelve en el resultado; con una ruta las escribe en un
+ * CSV con Estadisticas::guardarEnRuta.
+ *
+ * @param argumentos Opcional: ruta del CSV
+ * @param datos Salida: operaciones con cantidad y nanosegundos p50, p99 y máximo, o cuántas se escribieron
+ * @return std::string Mensaje de error, vacío si terminó bien
+ */
+std::string InterpreteComandos::estadisticas(const std::vector<std::string>& argumentos, std::string& datos) {
+    if (argumentos.size() > 1) return "uso: stats [ruta]";
+    if (!Estadisticas::activas()) return "estadisticas desactivadas en esta compilacion";
+    if (argumentos.size() == 1) {
+        const int operaciones = Estadisticas::guardarEnRuta(argumentos[0]);
+        if (operaciones < 0) return "no se pudo escribir el archivo";
+        campoNumero(datos, "operaciones", operaciones, 0);
+        return "";
+    }
+
+    const std::vector<ResumenOperacion> operaciones = Estadisticas::resumen();
+    datos += ",\"operaciones\":[";
+    for (size_t i = 0; i < operaciones.size(); ++i) {
+        const ResumenOperacion& o = operaciones[i];
+        datos += i == 0 ? "{\"nombre\":" : ",{\"nombre\":";
+        escribirTextoJSON(datos, o.nombre);
+        campoNumero(datos, "cantidad", static_cast<double>(o.cantidad), 0);
+        campoNumero(datos, "ns_p50", static_cast<double>(o.nsP50), 0);
+        campoNumero(datos, "ns_p99", static_cast<double>(o.nsP99), 0);
+        campoNumero(datos, "ns_max", static_cast<double>(o.nsMaximo), 0);
+        datos += '}';
+    }
+    datos += ']';
+    return "";
+}
+
+/**
+ * @brief Punto de entrada del modo sin consola
+ *
+ * @param argc Número de argumentos
+ * @param argv Argumentos; argv[1] es el guion (o "-" para la entrada estándar)
+ * @return int 0 sin errores, 1 si algún comando falló, 2 si no se pudo abrir el guion
+ */
+int InterpreteComandos::principal(int argc, char* argv[]) {
+    std::ios::sync_with_stdio(false);
+    std::ifstream guion;
+    const bool desdeArchivo = argc > 1 && std::string(argv[1]) != "-";
+    if (desdeArchivo) {
+        guion.open(argv[1]);
+        if (!guion.is_open()) {
+            std::cerr << "No se pudo abrir el guion: " << argv[1] << "\n";
+            return 2;
+        }
+    }
+
+    // Los resultados van por el mismo búfer que std::cout, que se silencia en cada comando
+    std::ostream resultados(std::cout.rdbuf());
+    Banco banco;
+    InterpreteComandos interprete(banco);
+    const ResumenComandos resumen = interprete.ejecutar(desdeArchivo ? static_cast<std::istream&>(guion) : std::cin, resultados);
+    return resumen.errores == 0 ? 0 : 1;
+}
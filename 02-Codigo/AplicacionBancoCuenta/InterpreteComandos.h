@@ -0,0 +1,158 @@
+#pragma once
+#ifndef INTERPRETECOMANDOS_H
+#define INTERPRETECOMANDOS_H
+
+#include <string>
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include "Banco.h"
+#include "ImportadorCSV.h"
+
+/**
+ * @struct TiempoComando
+ * @brief Tiempo acumulado de un tipo de comando
+ */
+struct TiempoComando {
+    /** @brief Veces que se ejecutó */
+    size_t veces = 0;
+    /** @brief Veces que terminó con error */
+    size_t errores = 0;
+    /** @brief Suma de sus duraciones en microsegundos */
+    double microsegundos = 0.0;
+};
+
+/**
+ * @struct ResumenComandos
+ * @brief Resultado de ejecutar un guion de comandos
+ */
+struct ResumenComandos {
+    /** @brief Comandos ejecutados (sin comentarios ni líneas vacías) */
+    size_t comandos = 0;
+    /** @brief Comandos que terminaron con error */
+    size_t errores = 0;
+    /** @brief Duración total en segundos, incluida la escritura de resultados */
+    double segundos = 0.0;
+    /** @brief Tiempo por tipo de comando, ordenado por nombre */
+    std::map<std::string, TiempoComando> porComando;
+};
+
+/**
+ * @class InterpreteComandos
+ * @brief Ejecuta comandos de texto contra un Banco, sin menús ni consola interactiva
+ *
+ * Cada línea es un comando; las vacías y las que empiezan con # se ignoran. Los
+ * argumentos se separan con espacios y pueden ir entre comillas dobles:
+ *
+ *     create <línea con el formato de ImportadorCSV>
+ *     deposit <cuenta> <monto>
+ *     withdraw <cuenta> <monto>
+ *     transfer <cuenta origen> <cuenta destino> <monto>
+ *     search <cédula o número de cuenta>
+ *     save <ruta del respaldo>
+ *     load <ruta del respaldo>
+ *     hash <ruta> [sha1|sha256]
+ *     qr <cuenta> [ruta del .txt]
+ *     stats [ruta del .csv]
+ *
+ * Los montos van en dólares con hasta dos decimales. Por cada comando se escribe
+ * una línea JSON con el número de línea, el comando, "ok", la duración en
+ * microsegundos ("us") y los datos del resultado o el "error"; al final, una línea
+ * "resumen" con los totales y el tiempo acumulado de cada tipo de comando.
+ *
+ * Las cédulas y los números de cuenta se indexan en tablas hash al construir el
+ * intérprete y después de cada load, para no recorrer la lista en cada comando.
+ * Los mensajes que las clases del banco escriben en std::cout se descartan
+ * mientras corre cada comando, para que la salida sea solo JSON.
+ */
+class InterpreteComandos {
+public:
+    /**
+     * @brief Crea el intérprete e indexa los clientes que ya tiene el banco
+     * @param banco Banco sobre el que se ejecutan los comandos
+     */
+    explicit InterpreteComandos(Banco& banco);
+
+    /**
+     * @brief Ejecuta todos los comandos de un flujo
+     * @param entrada Guion o entrada estándar
+     * @param salida Destino de los resultados JSON
+     * @return Totales y tiempos por tipo de comando
+     */
+    ResumenComandos ejecutar(std::istream& entrada, std::ostream& salida);
+
+    /**
+     * @brief Ejecuta un solo comando y escribe su resultado
+     * @param linea Texto del comando
+     * @param numeroLinea Número de línea que se informa en el resultado
+     * @param salida Destino del resultado JSON
+     * @param resumen Totales que se actualizan
+     * @return true si el comando se ejecutó sin error o la línea se ignoró
+     */
+    bool ejecutarLinea(const std::string& linea, size_t numeroLinea, std::ostream& salida, ResumenComandos& resumen);
+
+    /**
+     * @brief Punto de entrada del modo sin consola
+     *
+     * Uso: programa [guion] (sin guion o con "-" se lee la entrada estándar).
+     *
+     * @param argc Número de argumentos
+     * @param argv Argumentos; argv[0] es el nombre del programa
+     * @return 0 si todos los comandos terminaron bien, 1 si alguno falló, 2 si no se pudo abrir el guion
+     */
+    static int principal(int argc, char* argv[]);
+
+private:
+    /**
+     * @struct UbicacionCuenta
+     * @brief Cuenta indexada y su titular
+     */
+    struct UbicacionCuenta {
+        Cuenta<double>* cuenta;
+        Persona* titular;
+        bool ahorros;
+    };
+
+    /** @brief Banco sobre el que se ejecutan los comandos */
+    Banco& banco;
+    /** @brief Clientes por cédula */
+    std::unordered_map<std::string, Persona*> porCedula;
+    /** @brief Cuentas por número */
+    std::unordered_map<std::string, UbicacionCuenta> porCuenta;
+    /** @brief Mayor secuencial de cada sucursal */
+    int secuenciales[ImportadorCSV::NUM_SUCURSALES];
+    /** @brief Fecha de apertura de las cuentas creadas (la del inicio) */
+    std::string fechaApertura;
+
+    /**
+     * @brief Vuelve a indexar todos los clientes y cuentas del banco
+     */
+    void reconstruirIndices();
+
+    /**
+     * @brief Agrega a los índices un cliente y sus cuentas
+     * @param persona Cliente a indexar
+     */
+    void indexar(Persona* persona);
+
+    /** @name Comandos
+     *  Cada uno devuelve el mensaje de error (vacío si terminó bien) y agrega a
+     *  datos los campos JSON de su resultado.
+     *  @{ */
+    std::string crear(const std::string& registro, std::string& datos);
+    std::string depositar(const std::vector<std::string>& argumentos, std::string& datos);
+    std::string retirar(const std::vector<std::string>& argumentos, std::string& datos);
+    std::string transferir(const std::vector<std::string>& argumentos, std::string& datos);
+    std::string buscar(const std::vector<std::string>& argumentos, std::string& datos);
+    std::string guardar(const std::vector<std::string>& argumentos, std::string& datos);
+    std::string cargar(const std::vector<std::string>& argumentos, std::string& datos);
+    std::string calcularHash(const std::vector<std::string>& argumentos, std::string& datos);
+    std::string generarQR(const std::vector<std::string>& argumentos, std::string& datos);
+    std::string estadisticas(const std::vector<std::string>& argumentos, std::string& datos);
+    /** @} */
+};
+
+#endif // INTERPRETECOMANDOS_H
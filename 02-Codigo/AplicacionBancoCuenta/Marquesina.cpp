@@ -11,7 +11,7 @@
 #include <iostream>
 #include <chrono>
 #include <thread>
-#include <regex>
+#include <cstring>
 #include <string>
 
  /**
@@ -26,9 +26,8 @@
 Marquesina::Marquesina(int x, int y, int ancho, const std::string& archivoHTML, int velocidad)
 	: posX(x), posY(y), ancho(ancho), archivoHTML(archivoHTML), velocidad(velocidad),
 	ejecutando(false), pausado(false), bloqueado(false), operacionCritica(false),
-	bufferActualizado(false)
+	bufferActualizado(false), posicionTexto(0), fotogramasDesdeRedibujo(0)
 {
-	ZeroMemory(&ultimaModificacion, sizeof(FILETIME));
 	cargarDesdeHTML();
 	actualizarBuffer();
 }
@@ -54,7 +53,9 @@ void Marquesina::iniciar()
 		pausado = false;
 		bloqueado = false;
 		operacionCritica = false;
+		vigilante.reset(new VigilanteArchivo(archivoHTML));
 		hiloMarquesina = std::thread(&Marquesina::ejecutarMarquesina, this);
+		hiloVigilante = std::thread(&Marquesina::vigilarArchivo, this);
 	}
 }
 
@@ -65,11 +66,20 @@ void Marquesina::detener()
 {
 	if (ejecutando)
 	{
-		ejecutando = false;
+		cambiarEstado(ejecutando, false, false);
+		if (vigilante)
+		{
+			vigilante->cancelar();
+		}
 		if (hiloMarquesina.joinable())
 		{
 			hiloMarquesina.join();
 		}
+		if (hiloVigilante.joinable())
+		{
+			hiloVigilante.join();
+		}
+		vigilante.reset();
 	}
 }
 
@@ -78,7 +88,7 @@ void Marquesina::detener()
  */
 void Marquesina::pausar()
 {
-	pausado = true;
+	cambiarEstado(pausado, true, false);
 }
 
 /**
@@ -86,7 +96,7 @@ void Marquesina::pausar()
  */
 void Marquesina::reanudar()
 {
-	pausado = false;
+	cambiarEstado(pausado, false, true); // La pantalla pudo limpiarse durante la pausa
 }
 
 /**
@@ -94,7 +104,7 @@ void Marquesina::reanudar()
  */
 void Marquesina::bloquear()
 {
-	bloqueado = true;
+	cambiarEstado(bloqueado, true, false);
 }
 
 /**
@@ -102,15 +112,18 @@ void Marquesina::bloquear()
  */
 void Marquesina::desbloquear()
 {
-	bloqueado = false;
+	cambiarEstado(bloqueado, false, true); // La pantalla pudo limpiarse durante el bloqueo
 }
 
 /**
  * @brief Marca el inicio de una operación crítica que no debe ser interrumpida
+ *
+ * Al volver, la marquesina ya no está escribiendo en la consola: si había un
+ * fotograma en curso, se espera a que termine.
  */
 void Marquesina::marcarOperacionCritica()
 {
-	operacionCritica = true;
+	cambiarEstado(operacionCritica, true, false);
 }
 
 /**
@@ -118,7 +131,27 @@ void Marquesina::marcarOperacionCritica()
  */
 void Marquesina::finalizarOperacionCritica()
 {
-	operacionCritica = false;
+	cambiarEstado(operacionCritica, false, true); // La operación suele limpiar la pantalla
+}
+
+/**
+ * @brief Cambia una bandera de estado y despierta al hilo de la marquesina
+ *
+ * @param bandera Bandera a cambiar
+ * @param valor Nuevo valor
+ * @param redibujar true si al volver a dibujar hay que escribir la línea completa
+ */
+void Marquesina::cambiarEstado(std::atomic<bool>& bandera, bool valor, bool redibujar)
+{
+	{
+		std::lock_guard<std::mutex> lock(mtxPlanificador);
+		if (redibujar)
+		{
+			bufferActualizado = true;
+		}
+		bandera = valor;
+	}
+	condicionPlanificador.notify_one();
 }
 
 /**
@@ -211,59 +244,23 @@ void Marquesina::cargarDesdeHTML()
 		{
 			contenido += linea + "\n";
 		}
-		elementos = parsearHTML(contenido);
-
-		std::wstring wArchivoHTML = stringToWideString(archivoHTML);
-		HANDLE hFile = CreateFileW(
-			wArchivoHTML.c_str(),
-			GENERIC_READ,
-			FILE_SHARE_READ,
-			NULL,
-			OPEN_EXISTING,
-			FILE_ATTRIBUTE_NORMAL,
-			NULL);
-
-		if (hFile != INVALID_HANDLE_VALUE)
-		{
-			GetFileTime(hFile, NULL, NULL, &ultimaModificacion);
-			CloseHandle(hFile);
-		}
+		elementos = AnalizadorMarquesina::parsearHTML(contenido);
 	}
 }
 
 /**
- * @brief Verifica si el archivo HTML ha sido modificado desde la última carga
+ * @brief Espera los cambios del archivo HTML y recarga el contenido
  *
- * @return bool true si el archivo ha sido modificado, false en caso contrario
+ * Se ejecuta en su propio hilo y duerme en el sistema hasta que el archivo
+ * cambia; la marquesina ya no consulta el archivo en cada fotograma. La nueva
+ * tira de celdas sustituye a la anterior de una vez, entre dos fotogramas.
  */
-bool Marquesina::archivoModificado()
+void Marquesina::vigilarArchivo()
 {
-	FILETIME nuevoTiempo;
-	ZeroMemory(&nuevoTiempo, sizeof(FILETIME));
-
-	std::wstring wArchivoHTML = stringToWideString(archivoHTML);
-	HANDLE hFile = CreateFileW(
-		wArchivoHTML.c_str(),
-		GENERIC_READ,
-		FILE_SHARE_READ,
-		NULL,
-		OPEN_EXISTING,
-		FILE_ATTRIBUTE_NORMAL,
-		NULL);
-
-	if (hFile != INVALID_HANDLE_VALUE)
+	while (vigilante->esperarCambio())
 	{
-		GetFileTime(hFile, NULL, NULL, &nuevoTiempo);
-		CloseHandle(hFile);
-
-		if (CompareFileTime(&nuevoTiempo, &ultimaModificacion) > 0)
-		{
-			ultimaModificacion = nuevoTiempo;
-			return true;
-		}
+		forzarActualizacion();
 	}
-
-	return false;
 }
 
 /**
@@ -278,206 +275,205 @@ bool Marquesina::esSafeZone(int fila) const
 }
 
 /**
- * @brief Actualiza el buffer interno con el contenido actual de la marquesina
+ * @brief Calcula el atributo de consola de un elemento
  *
- * Thread-safe: utiliza un mutex para evitar problemas de concurrencia
+ * Los códigos de color de parsearHTML siguen el orden de bits de la consola
+ * (azul = 1, verde = 2, rojo = 4), así que se usan directamente.
+ *
+ * @param elemento Elemento con sus colores y estilo
+ * @return WORD Atributo de consola
  */
-void Marquesina::actualizarBuffer()
+WORD Marquesina::calcularAtributo(const ElementoMarquesina& elemento)
 {
-	std::lock_guard<std::mutex> lock(mtx);
-	bufferMarquesina = "   ";
-	for (const auto& elem : elementos)
+	WORD atributo = static_cast<WORD>((elemento.colorTexto & 0x7) | ((elemento.colorFondo & 0x7) << 4));
+	if (elemento.negrita)
 	{
-		bufferMarquesina += elem.texto + "   ";
+		atributo |= FOREGROUND_INTENSITY;
 	}
-	bufferActualizado = true;
+	return atributo;
 }
 
 /**
- * @brief Renderiza la marquesina en la consola
+ * @brief Actualiza el buffer interno con el contenido actual de la marquesina
+ *
+ * Genera la tira de celdas con el color de cada elemento; los separadores usan
+ * el color turquesa de la marquesina. El texto se convierte a UTF-16 una sola
+ * vez aquí, no en cada fotograma.
  *
- * Utiliza las APIs de Windows para escribir directamente en el buffer de la consola
+ * Thread-safe: la tira se sustituye bajo mtxPantalla
  */
-void Marquesina::renderizarMarquesina()
+void Marquesina::actualizarBuffer()
 {
-	HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
-	CONSOLE_SCREEN_BUFFER_INFO csbi;
-
-	// Verificar estado de la consola antes de proceder
-	if (!GetConsoleScreenBufferInfo(hConsole, &csbi))
-		return;
-
-	// Crear buffer local para evitar conflictos
-	std::string textoBuffer;
+	const WORD colorSeparador = FOREGROUND_GREEN | FOREGROUND_BLUE | FOREGROUND_INTENSITY;
+	std::vector<CHAR_INFO> celdas;
+	auto agregar = [&celdas](const std::wstring& texto, WORD atributo)
 	{
-		std::lock_guard<std::mutex> lock(mtx);
-		textoBuffer = bufferMarquesina;
-	}
-
-	if (textoBuffer.empty())
-		return;
+		for (wchar_t caracter : texto)
+		{
+			CHAR_INFO celda;
+			celda.Char.UnicodeChar = caracter;
+			celda.Attributes = atributo;
+			celdas.push_back(celda);
+		}
+	};
 
-	// Operación completamente atómica
-	COORD marquesinaPos = { (SHORT)posX, (SHORT)posY };
-
-	// Usar API de Windows más eficiente
-	DWORD caracteresEscritos;
-	std::string lineaLimpia(ancho, ' ');
-
-	// Escribir línea completa en una sola operación
-	WriteConsoleOutputCharacterA(
-		hConsole,
-		lineaLimpia.c_str(),
-		ancho,
-		marquesinaPos,
-		&caracteresEscritos
-	);
-
-	// Preparar texto visible
-	static int posicionTexto = 0;
-	std::string textoVisible = textoBuffer.substr(posicionTexto, ancho);
-	if (textoVisible.length() < ancho)
+	const std::wstring separador = L"   ";
+	agregar(separador, colorSeparador);
+	for (const auto& elem : elementos)
 	{
-		textoVisible += textoBuffer.substr(0, ancho - textoVisible.length());
+		agregar(stringToWideString(elem.texto), calcularAtributo(elem));
+		agregar(separador, colorSeparador);
 	}
 
-	// Escribir texto con color
-	WORD colorTurquesa = FOREGROUND_GREEN | FOREGROUND_BLUE | FOREGROUND_INTENSITY;
-
-	for (size_t i = 0; i < textoVisible.length() && i < ancho; ++i)
+	std::lock_guard<std::mutex> lock(mtxPantalla);
+	celdasMarquesina.swap(celdas);
+	if (posicionTexto >= celdasMarquesina.size())
 	{
-		COORD charPos = { (SHORT)(posX + i), (SHORT)posY };
-		WriteConsoleOutputCharacterA(hConsole, &textoVisible[i], 1, charPos, &caracteresEscritos);
-		WriteConsoleOutputAttribute(hConsole, &colorTurquesa, 1, charPos, &caracteresEscritos);
+		posicionTexto = 0;
 	}
-
-	posicionTexto = (static_cast<unsigned long long>(posicionTexto) + 1) % textoBuffer.length();
+	bufferActualizado = true;
 }
 
 /**
- * @brief Analiza el contenido HTML y extrae los elementos de la marquesina
+ * @brief Obtiene los contadores de coste del renderizado
  *
- * Procesa etiquetas de color y formato para convertirlas en elementos visuales
+ * @return EstadisticasMarquesina Copia de las estadísticas acumuladas
+ */
+EstadisticasMarquesina Marquesina::obtenerEstadisticas()
+{
+	std::lock_guard<std::mutex> lock(mtxPantalla);
+	return estadisticas;
+}
+
+/**
+ * @brief Renderiza la marquesina en la consola
  *
- * @param contenido Contenido HTML a analizar
- * @return std::vector<ElementoMarquesina> Lista de elementos extraídos del HTML
+ * El fotograma se compone en memoria tomando una ventana circular de la tira de
+ * celdas, sin copias de subcadenas. Se compara con el fotograma anterior y solo
+ * se escribe el tramo entre la primera y la última celda distintas, con una única
+ * llamada a WriteConsoleOutputW que envía caracteres y atributos a la vez; si no
+ * cambió nada, no se llama a la consola. Cada FOTOGRAMAS_ENTRE_REDIBUJOS
+ * fotogramas, o tras actualizar el contenido, se escribe la línea completa.
  */
-std::vector<ElementoMarquesina> Marquesina::parsearHTML(const std::string& contenido)
+void Marquesina::renderizarMarquesina()
 {
-	std::vector<ElementoMarquesina> resultado;
+	auto inicio = std::chrono::steady_clock::now();
+	HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
+	if (hConsole == INVALID_HANDLE_VALUE || ancho <= 0)
+		return;
 
-	std::regex marquesinaRegex("<marquesina>[\\s\\S]*?</marquesina>");
-	std::regex colorRegex("<color=([a-z]+)(?:\\s+bg=([a-z]+))?>(.*?)</color>");
-	std::regex boldRegex("<b>(.*?)</b>");
+	std::lock_guard<std::mutex> lock(mtxPantalla);
+	if (celdasMarquesina.empty())
+		return;
 
-	std::smatch matchMarquesina;
-	if (std::regex_search(contenido, matchMarquesina, marquesinaRegex))
+	// Componer el fotograma
+	size_t total = celdasMarquesina.size();
+	size_t anchoFotograma = static_cast<size_t>(ancho);
+	fotogramaActual.resize(anchoFotograma);
+	size_t origenTira = posicionTexto;
+	for (size_t i = 0; i < anchoFotograma; ++i)
 	{
-		std::string textoMarquesina = matchMarquesina.str();
-		textoMarquesina = std::regex_replace(textoMarquesina, std::regex("<marquesina>"), "");
-		textoMarquesina = std::regex_replace(textoMarquesina, std::regex("</marquesina>"), "");
-
-		std::string::const_iterator searchStart(textoMarquesina.cbegin());
-		std::string::const_iterator end(textoMarquesina.cend());
-		std::smatch match;
+		fotogramaActual[i] = celdasMarquesina[origenTira];
+		if (++origenTira == total)
+			origenTira = 0;
+	}
+	posicionTexto = (posicionTexto + 1) % total;
 
-		while (std::regex_search(searchStart, end, match, colorRegex))
+	// Buscar el tramo que cambió respecto al fotograma anterior
+	auto iguales = [](const CHAR_INFO& a, const CHAR_INFO& b)
+	{
+		return a.Char.UnicodeChar == b.Char.UnicodeChar && a.Attributes == b.Attributes;
+	};
+	size_t primero = 0;
+	size_t ultimo = anchoFotograma - 1;
+	bool completo = bufferActualizado.exchange(false) || fotogramaAnterior.size() != anchoFotograma ||
+		++fotogramasDesdeRedibujo >= FOTOGRAMAS_ENTRE_REDIBUJOS;
+	if (completo)
+	{
+		fotogramasDesdeRedibujo = 0;
+	}
+	else
+	{
+		while (primero < anchoFotograma && iguales(fotogramaActual[primero], fotogramaAnterior[primero]))
+			++primero;
+		if (primero < anchoFotograma)
 		{
-			ElementoMarquesina elem;
-
-			std::string colorTexto = match[1].str();
-			if (colorTexto == "black") elem.colorTexto = 0;
-			else if (colorTexto == "blue") elem.colorTexto = 1;
-			else if (colorTexto == "green") elem.colorTexto = 2;
-			else if (colorTexto == "cyan") elem.colorTexto = 3;
-			else if (colorTexto == "red") elem.colorTexto = 4;
-			else if (colorTexto == "magenta") elem.colorTexto = 5;
-			else if (colorTexto == "yellow") elem.colorTexto = 6;
-			else if (colorTexto == "white") elem.colorTexto = 7;
-			else elem.colorTexto = 7;
-
-			elem.colorFondo = 0;
-			if (match[2].matched)
-			{
-				std::string colorFondo = match[2].str();
-				if (colorFondo == "black") elem.colorFondo = 0;
-				else if (colorFondo == "blue") elem.colorFondo = 1;
-				else if (colorFondo == "green") elem.colorFondo = 2;
-				else if (colorFondo == "cyan") elem.colorFondo = 3;
-				else if (colorFondo == "red") elem.colorFondo = 4;
-				else if (colorFondo == "magenta") elem.colorFondo = 5;
-				else if (colorFondo == "yellow") elem.colorFondo = 6;
-				else if (colorFondo == "white") elem.colorFondo = 7;
-			}
-
-			std::string contenidoColor = match[3].str();
-			std::smatch boldMatch;
-			if (std::regex_search(contenidoColor, boldMatch, boldRegex))
-			{
-				elem.negrita = true;
-				elem.texto = boldMatch[1].str();
-			}
-			else
-			{
-				elem.negrita = false;
-				elem.texto = contenidoColor;
-			}
-
-			resultado.push_back(elem);
-			searchStart = match.suffix().first;
+			while (iguales(fotogramaActual[ultimo], fotogramaAnterior[ultimo]))
+				--ultimo;
 		}
+	}
 
-		if (resultado.empty())
-		{
-			ElementoMarquesina elem;
-			elem.colorTexto = 7;
-			elem.colorFondo = 0;
-			elem.negrita = false;
-			elem.texto = textoMarquesina;
-			resultado.push_back(elem);
-		}
+	if (primero < anchoFotograma)
+	{
+		// Escribir caracteres y atributos del tramo en una sola operación
+		COORD tamanioTramo = { (SHORT)(ultimo - primero + 1), 1 };
+		COORD origenTramo = { 0, 0 };
+		SMALL_RECT region = { (SHORT)(posX + primero), (SHORT)posY, (SHORT)(posX + ultimo), (SHORT)posY };
+		WriteConsoleOutputW(hConsole, fotogramaActual.data() + primero, tamanioTramo, origenTramo, &region);
+		++estadisticas.escrituras;
+		estadisticas.celdasEscritas += ultimo - primero + 1;
 	}
+	fotogramaActual.swap(fotogramaAnterior);
 
-	return resultado;
+	++estadisticas.fotogramas;
+	estadisticas.microsegundos += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - inicio).count();
 }
 
 /**
  * @brief Función principal que ejecuta la marquesina en un hilo separado
  *
- * Se ejecuta continuamente mientras la marquesina esté activa, manejando
- * actualizaciones y renderizado con medidas de seguridad
+ * Avanza el desplazamiento en plazos fijos de `velocidad` milisegundos medidos con
+ * un reloj monótono, de modo que el tiempo de dibujo no se suma al periodo. Mientras
+ * la marquesina está pausada, bloqueada o en una operación crítica, el hilo duerme
+ * en la variable de condición sin plazo y solo despierta cuando cambia el estado.
+ * Si se pierden plazos (por ejemplo, con el sistema suspendido) no se dibujan
+ * fotogramas atrasados: el siguiente plazo se cuenta desde ese momento.
  */
 void Marquesina::ejecutarMarquesina()
 {
+	typedef std::chrono::steady_clock Reloj;
+	const Reloj::duration periodo = std::chrono::milliseconds(velocidad > 0 ? velocidad : 1);
+	Reloj::time_point plazo = Reloj::now();
+	unsigned long long despertares = 0;
+
+	std::unique_lock<std::mutex> lock(mtxPlanificador);
+	auto detenida = [this]() { return bloqueado || pausado || operacionCritica; };
 	while (ejecutando)
 	{
-		// Verificaciones múltiples antes de renderizar
-		if (bloqueado || pausado || operacionCritica || elementos.empty())
+		if (detenida())
 		{
-			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+			condicionPlanificador.wait(lock, [&]() { return !ejecutando || !detenida(); });
+			++despertares;
+			plazo = Reloj::now(); // Al reanudar se dibuja enseguida
 			continue;
 		}
 
-		// Verificar actualización de archivo
-		if (archivoModificado())
-		{
-			cargarDesdeHTML();
-			actualizarBuffer();
-		}
+		// Esperar el plazo; un cambio de estado interrumpe la espera
+		bool aviso = condicionPlanificador.wait_until(lock, plazo, [&]() { return !ejecutando || detenida(); });
+		++despertares;
+		if (aviso)
+			continue;
 
-		// Renderizar solo si es completamente seguro
+		// El fotograma se dibuja con mtxPlanificador tomado: pausar o marcar una
+		// operación crítica espera a que termine
 		try
 		{
 			renderizarMarquesina();
+			plazo += periodo;
 		}
 		catch (...)
 		{
-			// Si hay cualquier error, pausar brevemente y continuar
-			std::this_thread::sleep_for(std::chrono::milliseconds(200));
-			continue;
+			// Si hay cualquier error, esperar un poco más antes del siguiente intento
+			plazo += std::chrono::milliseconds(200);
+		}
+
+		Reloj::time_point ahora = Reloj::now();
+		if (plazo < ahora)
+		{
+			plazo = ahora + periodo;
 		}
 
-		// Velocidad controlada
-		std::this_thread::sleep_for(std::chrono::milliseconds(velocidad));
+		std::lock_guard<std::mutex> lockPantalla(mtxPantalla);
+		estadisticas.despertares = despertares;
 	}
 }
\ No newline at end of file
@@ -9,23 +9,26 @@
 #include <atomic>
 #include <windows.h>
 #include <mutex>
+#include <condition_variable>
+#include <memory>
+#include "VigilanteArchivo.h"
+#include "AnalizadorMarquesina.h"
 
 /**
- * @struct ElementoMarquesina
- * @brief Estructura que representa un elemento individual en la marquesina
- *
- * Contiene información sobre el texto a mostrar y sus atributos de formato
- * como color, fondo y estilo.
+ * @struct EstadisticasMarquesina
+ * @brief Contadores de coste del renderizado de la marquesina
  */
-struct ElementoMarquesina {
-    /** @brief Texto a mostrar en la marquesina */
-    std::string texto;
-    /** @brief Código de color del texto */
-    int colorTexto;
-    /** @brief Código de color del fondo */
-    int colorFondo;
-    /** @brief Indica si el texto debe mostrarse en negrita */
-    bool negrita;
+struct EstadisticasMarquesina {
+    /** @brief Fotogramas compuestos */
+    unsigned long long fotogramas = 0;
+    /** @brief Llamadas de escritura a la consola */
+    unsigned long long escrituras = 0;
+    /** @brief Celdas (carácter y atributo) enviadas a la consola */
+    unsigned long long celdasEscritas = 0;
+    /** @brief Tiempo total de composición y escritura, en microsegundos */
+    double microsegundos = 0.0;
+    /** @brief Veces que el hilo de la marquesina despertó (plazos cumplidos y avisos) */
+    unsigned long long despertares = 0;
 };
 
 /**
@@ -38,12 +41,18 @@ struct ElementoMarquesina {
  */
 class Marquesina {
 private:
-    /** @brief Vector de elementos que se mostrarán en la marquesina */
+    /** @brief Vector de elementos que se mostrarán en la marquesina, protegido por mtx */
     std::vector<ElementoMarquesina> elementos;
 
     /** @brief Hilo donde se ejecuta la marquesina */
     std::thread hiloMarquesina;
 
+    /** @brief Hilo que espera los cambios del archivo HTML y recarga el contenido */
+    std::thread hiloVigilante;
+
+    /** @brief Notificación de cambios del archivo HTML */
+    std::unique_ptr<VigilanteArchivo> vigilante;
+
     /** @brief Bandera atómica que controla la ejecución del hilo */
     std::atomic<bool> ejecutando;
 
@@ -56,6 +65,18 @@ private:
     /** @brief Bandera para indicar operaciones críticas de posicionamiento de cursor */
     std::atomic<bool> operacionCritica;
 
+    /**
+     * @brief Mutex del planificador
+     *
+     * Las banderas de estado se cambian con él tomado y el hilo de la marquesina
+     * lo mantiene mientras dibuja un fotograma, así que cambiar una bandera espera
+     * a que termine el fotograma en curso.
+     */
+    std::mutex mtxPlanificador;
+
+    /** @brief Avisa al hilo de la marquesina de un cambio de estado */
+    std::condition_variable condicionPlanificador;
+
     /** @brief Posición X en la consola donde inicia la marquesina */
     int posX;
 
@@ -77,14 +98,46 @@ private:
     /** @brief Mutex específico para operaciones de salida en pantalla */
     std::mutex mtxPantalla;
 
-    /** @brief Buffer interno para evitar interferencias en la visualización */
-    std::string bufferMarquesina;
+    /**
+     * @brief Tira completa de celdas (carácter y atributo) que se desplaza
+     *
+     * Se genera al cargar el contenido, con los colores de cada elemento, y cada
+     * fotograma toma una ventana circular de ella. Protegida por mtxPantalla.
+     */
+    std::vector<CHAR_INFO> celdasMarquesina;
 
-    /** @brief Indica si el buffer ha sido actualizado y necesita redibujarse */
+    /** @brief Indica si el buffer ha sido actualizado y necesita redibujarse completo */
     std::atomic<bool> bufferActualizado;
 
-    /** @brief Timestamp de la última modificación del archivo HTML */
-    FILETIME ultimaModificacion;
+    /** @brief Posición de la tira donde empieza el siguiente fotograma */
+    size_t posicionTexto;
+
+    /** @brief Fotograma en composición (se reutiliza para no reservar memoria) */
+    std::vector<CHAR_INFO> fotogramaActual;
+
+    /** @brief Último fotograma escrito en la consola */
+    std::vector<CHAR_INFO> fotogramaAnterior;
+
+    /** @brief Fotogramas escritos desde el último redibujado completo */
+    int fotogramasDesdeRedibujo;
+
+    /** @brief Contadores de coste, protegidos por mtxPantalla */
+    EstadisticasMarquesina estadisticas;
+
+    /**
+     * @brief Cada cuántos fotogramas se redibuja la línea completa
+     *
+     * Repara la marquesina si otra parte del programa borró la pantalla (por
+     * ejemplo con system("cls")) sin que el fotograma anterior lo sepa.
+     */
+    static const int FOTOGRAMAS_ENTRE_REDIBUJOS = 20;
+
+    /**
+     * @brief Calcula el atributo de consola de un elemento
+     * @param elemento Elemento con sus colores y estilo
+     * @return Atributo con color de texto, color de fondo e intensidad si es negrita
+     */
+    static WORD calcularAtributo(const ElementoMarquesina& elemento);
 
     /**
      * @brief Carga el contenido de la marquesina desde un archivo HTML
@@ -97,17 +150,17 @@ private:
     void ejecutarMarquesina();
 
     /**
-     * @brief Analiza el contenido HTML y lo convierte en elementos de marquesina
-     * @param contenido Cadena con el contenido HTML a analizar
-     * @return Vector de elementos de marquesina formateados
+     * @brief Cambia una bandera de estado y despierta al hilo de la marquesina
+     * @param bandera Bandera a cambiar
+     * @param valor Nuevo valor
+     * @param redibujar true si al volver a dibujar hay que escribir la línea completa
      */
-    std::vector<ElementoMarquesina> parsearHTML(const std::string& contenido);
+    void cambiarEstado(std::atomic<bool>& bandera, bool valor, bool redibujar);
 
     /**
-     * @brief Verifica si el archivo HTML ha sido modificado desde la última lectura
-     * @return true si el archivo ha sido modificado, false en caso contrario
+     * @brief Función del hilo vigilante: recarga el contenido cada vez que el archivo cambia
      */
-    bool archivoModificado();
+    void vigilarArchivo();
 
     /**
      * @brief Verifica si es seguro escribir en una posición específica de la consola
@@ -123,6 +176,9 @@ private:
 
     /**
      * @brief Renderiza el contenido del buffer en la consola
+     *
+     * Compone el fotograma completo (caracteres y atributos) y escribe con una
+     * sola llamada el tramo que cambió respecto al fotograma anterior.
      */
     void renderizarMarquesina();
 
@@ -206,6 +262,12 @@ public:
      */
     void mostrarRutaArchivo();
 
+    /**
+     * @brief Obtiene los contadores de coste del renderizado
+     * @return Copia de las estadísticas acumuladas
+     */
+    EstadisticasMarquesina obtenerEstadisticas();
+
     /**
      * @brief Verifica si la marquesina está visible
      * @return true si la marquesina está ejecutándose y es visible, false en caso contrario
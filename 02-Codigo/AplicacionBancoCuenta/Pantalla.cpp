@@ -0,0 +1,489 @@
+/**
+ * @file Pantalla.cpp
+ * @brief Compositor de pantalla con doble buffer, salidas de consola y en memoria, y menús
+ */
+#include "Pantalla.h"
+#include <algorithm>
+#include <cstdio>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <conio.h>
+#else
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    /** @brief Filas reservadas para la marquesina en la parte superior */
+    const int FILAS_MARQUESINA = 2;
+
+    /** @brief Celda en blanco */
+    const CeldaPantalla CELDA_VACIA = { L' ', CompositorPantalla::ATRIBUTO_NORMAL };
+
+    /**
+     * @brief Lee el siguiente carácter UTF-8 de un texto
+     *
+     * Las secuencias inválidas y los caracteres fuera del plano básico se
+     * sustituyen por '?'.
+     *
+     * @param texto Texto
+     * @param posicion Posición del primer byte; avanza tras el carácter
+     * @return Carácter en UTF-16
+     */
+    wchar_t leerUTF8(const std::string& texto, size_t& posicion) {
+        unsigned char c = static_cast<unsigned char>(texto[posicion++]);
+        if (c < 0x80) {
+            return static_cast<wchar_t>(c);
+        }
+        int continuaciones = c >= 0xF0 ? 3 : c >= 0xE0 ? 2 : c >= 0xC0 ? 1 : 0;
+        unsigned int valor = c & (0x3F >> continuaciones);
+        for (int i = 0; i < continuaciones; i++) {
+            if (posicion >= texto.size() || (static_cast<unsigned char>(texto[posicion]) & 0xC0) != 0x80) {
+                return L'?';
+            }
+            valor = (valor << 6) | (static_cast<unsigned char>(texto[posicion++]) & 0x3F);
+        }
+        return continuaciones == 0 || valor > 0xFFFF ? L'?' : static_cast<wchar_t>(valor);
+    }
+
+    /**
+     * @brief Añade un carácter UTF-16 del plano básico a un texto UTF-8
+     */
+    template <typename Destino>
+    void agregarUTF8(Destino& destino, wchar_t caracter) {
+        unsigned int c = static_cast<unsigned int>(caracter) & 0xFFFF;
+        if (c < 0x80) {
+            destino.push_back(static_cast<char>(c));
+        }
+        else if (c < 0x800) {
+            destino.push_back(static_cast<char>(0xC0 | (c >> 6)));
+            destino.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+        }
+        else {
+            destino.push_back(static_cast<char>(0xE0 | (c >> 12)));
+            destino.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+            destino.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+        }
+    }
+
+    /** @brief Teclas que entiende MenuConsola */
+    enum class Tecla { ARRIBA, ABAJO, ENTER, ESCAPE, OTRA };
+
+    /**
+     * @brief Espera una tecla y la traduce
+     */
+    Tecla leerTecla() {
+#ifdef _WIN32
+        int tecla = _getch();
+        if (tecla == 224 || tecla == 0) { // Teclas especiales
+            tecla = _getch();
+            if (tecla == 72) return Tecla::ARRIBA;
+            if (tecla == 80) return Tecla::ABAJO;
+            return Tecla::OTRA;
+        }
+        if (tecla == 13) return Tecla::ENTER;
+        if (tecla == 27) return Tecla::ESCAPE;
+        return Tecla::OTRA;
+#else
+        int tecla = std::getchar();
+        if (tecla == '\n' || tecla == '\r') return Tecla::ENTER;
+        if (tecla == 27) { // ESC o secuencia ESC [ A / ESC [ B
+            int siguiente = std::getchar();
+            if (siguiente != '[') return Tecla::ESCAPE;
+            siguiente = std::getchar();
+            if (siguiente == 'A') return Tecla::ARRIBA;
+            if (siguiente == 'B') return Tecla::ABAJO;
+        }
+        return Tecla::OTRA;
+#endif
+    }
+
+    /**
+     * @brief Divide un texto en filas
+     *
+     * Un '\n' final no abre una fila vacía más, igual que al imprimirlo con cout.
+     */
+    std::vector<std::string> dividirFilas(const std::string& texto) {
+        std::vector<std::string> filas;
+        size_t inicio = 0;
+        while (inicio < texto.size()) {
+            size_t fin = texto.find('\n', inicio);
+            if (fin == std::string::npos) {
+                filas.push_back(texto.substr(inicio));
+                break;
+            }
+            filas.push_back(texto.substr(inicio, fin - inicio));
+            inicio = fin + 1;
+        }
+        return filas;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// SalidaConsola
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Escribe un rectángulo de celdas en la consola con una sola llamada
+ */
+void SalidaConsola::escribir(const CeldaPantalla* celdas, int paso, int x, int y, int columnas, int filas) {
+#ifdef _WIN32
+    bufferSalida.resize(static_cast<size_t>(columnas) * filas * sizeof(CHAR_INFO));
+    CHAR_INFO* destino = reinterpret_cast<CHAR_INFO*>(bufferSalida.data());
+    for (int f = 0; f < filas; f++) {
+        const CeldaPantalla* origen = celdas + static_cast<size_t>(f) * paso;
+        for (int c = 0; c < columnas; c++) {
+            destino->Char.UnicodeChar = origen[c].caracter;
+            destino->Attributes = origen[c].atributo;
+            ++destino;
+        }
+    }
+    COORD tamanio = { static_cast<SHORT>(columnas), static_cast<SHORT>(filas) };
+    COORD inicio = { 0, 0 };
+    SMALL_RECT region = { static_cast<SHORT>(x), static_cast<SHORT>(y),
+        static_cast<SHORT>(x + columnas - 1), static_cast<SHORT>(y + filas - 1) };
+    WriteConsoleOutputW(GetStdHandle(STD_OUTPUT_HANDLE), reinterpret_cast<CHAR_INFO*>(bufferSalida.data()),
+        tamanio, inicio, &region);
+#else
+    // Secuencias ANSI: posición al inicio de cada fila y color solo cuando cambia
+    static const int ANSI_DESDE_CONSOLA[8] = { 0, 4, 2, 6, 1, 5, 3, 7 };
+    bufferSalida.clear();
+    int atributoActual = -1;
+    char control[32];
+    for (int f = 0; f < filas; f++) {
+        int longitud = std::snprintf(control, sizeof(control), "\x1b[%d;%dH", y + f + 1, x + 1);
+        bufferSalida.insert(bufferSalida.end(), control, control + longitud);
+        const CeldaPantalla* origen = celdas + static_cast<size_t>(f) * paso;
+        for (int c = 0; c < columnas; c++) {
+            if (origen[c].atributo != atributoActual) {
+                atributoActual = origen[c].atributo;
+                int texto = ANSI_DESDE_CONSOLA[atributoActual & 7] + ((atributoActual & 8) ? 90 : 30);
+                int fondo = ANSI_DESDE_CONSOLA[(atributoActual >> 4) & 7] + ((atributoActual & 0x80) ? 100 : 40);
+                longitud = std::snprintf(control, sizeof(control), "\x1b[0;%d;%dm", texto, fondo);
+                bufferSalida.insert(bufferSalida.end(), control, control + longitud);
+            }
+            agregarUTF8(bufferSalida, origen[c].caracter);
+        }
+    }
+    static const char RESTABLECER[] = "\x1b[0m";
+    bufferSalida.insert(bufferSalida.end(), RESTABLECER, RESTABLECER + sizeof(RESTABLECER) - 1);
+    std::fwrite(bufferSalida.data(), 1, bufferSalida.size(), stdout);
+    std::fflush(stdout);
+#endif
+}
+
+/**
+ * @brief Limpia la consola desde una fila y lleva la ventana al principio
+ *
+ * Sustituye a system("cls") sin crear un proceso y sin borrar la marquesina.
+ */
+void SalidaConsola::limpiarDesde(int fila) {
+#ifdef _WIN32
+    HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
+    CONSOLE_SCREEN_BUFFER_INFO csbi;
+    if (!GetConsoleScreenBufferInfo(hConsole, &csbi)) {
+        return;
+    }
+    if (csbi.srWindow.Top != 0) {
+        SMALL_RECT ventana = { 0, 0, static_cast<SHORT>(csbi.srWindow.Right - csbi.srWindow.Left),
+            static_cast<SHORT>(csbi.srWindow.Bottom - csbi.srWindow.Top) };
+        SetConsoleWindowInfo(hConsole, TRUE, &ventana);
+    }
+    COORD inicio = { 0, static_cast<SHORT>(fila) };
+    DWORD celdas = static_cast<DWORD>(csbi.dwSize.X) * (csbi.dwSize.Y > fila ? csbi.dwSize.Y - fila : 0);
+    DWORD escritas;
+    FillConsoleOutputCharacterW(hConsole, L' ', celdas, inicio, &escritas);
+    FillConsoleOutputAttribute(hConsole, CompositorPantalla::ATRIBUTO_NORMAL, celdas, inicio, &escritas);
+#else
+    std::printf("\x1b[%d;1H\x1b[J", fila + 1);
+    std::fflush(stdout);
+#endif
+}
+
+/**
+ * @brief Coloca el cursor de la consola
+ */
+void SalidaConsola::colocarCursor(int x, int y) {
+#ifdef _WIN32
+    COORD posicion = { static_cast<SHORT>(x), static_cast<SHORT>(y) };
+    SetConsoleCursorPosition(GetStdHandle(STD_OUTPUT_HANDLE), posicion);
+#else
+    std::printf("\x1b[%d;%dH", y + 1, x + 1);
+    std::fflush(stdout);
+#endif
+}
+
+/**
+ * @brief Tamaño de la ventana visible; 80x25 si no hay consola
+ */
+void SalidaConsola::obtenerTamanio(int& ancho, int& alto) {
+    ancho = 80;
+    alto = 25;
+#ifdef _WIN32
+    CONSOLE_SCREEN_BUFFER_INFO csbi;
+    if (GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &csbi)) {
+        ancho = csbi.srWindow.Right - csbi.srWindow.Left + 1;
+        alto = csbi.srWindow.Bottom - csbi.srWindow.Top + 1;
+    }
+#else
+    struct winsize ventana;
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &ventana) == 0 && ventana.ws_col > 0 && ventana.ws_row > 0) {
+        ancho = ventana.ws_col;
+        alto = ventana.ws_row;
+    }
+#endif
+}
+
+// ---------------------------------------------------------------------------
+// SalidaMemoria
+// ---------------------------------------------------------------------------
+
+SalidaMemoria::SalidaMemoria(int ancho, int alto)
+    : ancho(ancho), alto(alto), pantalla(static_cast<size_t>(ancho) * alto, CELDA_VACIA),
+      escrituras(0), celdas(0), cursorX(0), cursorY(0) {
+}
+
+void SalidaMemoria::escribir(const CeldaPantalla* origen, int paso, int x, int y, int columnas, int filas) {
+    for (int f = 0; f < filas; f++) {
+        if (y + f < 0 || y + f >= alto) continue;
+        std::copy(origen + static_cast<size_t>(f) * paso, origen + static_cast<size_t>(f) * paso + columnas,
+            pantalla.begin() + static_cast<size_t>(y + f) * ancho + x);
+    }
+    ++escrituras;
+    celdas += static_cast<unsigned long long>(columnas) * filas;
+}
+
+void SalidaMemoria::limpiarDesde(int fila) {
+    if (fila < alto) {
+        std::fill(pantalla.begin() + static_cast<size_t>(std::max(fila, 0)) * ancho, pantalla.end(), CELDA_VACIA);
+    }
+}
+
+void SalidaMemoria::colocarCursor(int x, int y) {
+    cursorX = x;
+    cursorY = y;
+}
+
+std::string SalidaMemoria::texto(int fila) const {
+    std::string resultado;
+    if (fila < 0 || fila >= alto) return resultado;
+    const CeldaPantalla* inicio = &pantalla[static_cast<size_t>(fila) * ancho];
+    int fin = ancho;
+    while (fin > 0 && inicio[fin - 1].caracter == L' ') --fin;
+    for (int i = 0; i < fin; i++) {
+        agregarUTF8(resultado, inicio[i].caracter);
+    }
+    return resultado;
+}
+
+// ---------------------------------------------------------------------------
+// CompositorPantalla
+// ---------------------------------------------------------------------------
+
+CompositorPantalla::CompositorPantalla(SalidaPantalla& salida, int ancho, int alto, int filaOrigen)
+    : salida(salida), ancho(ancho > 0 ? ancho : 1), alto(alto > 0 ? alto : 1), filaOrigen(filaOrigen),
+      frenteDesconocido(true), cursorPendiente(false), cursorX(0), cursorY(0) {
+    fondo.assign(static_cast<size_t>(this->ancho) * this->alto, CELDA_VACIA);
+    frente = fondo;
+    filaSucia.assign(this->alto, 0);
+    filasSucias.reserve(this->alto);
+}
+
+/**
+ * @brief Compositor de la consola de la aplicación
+ *
+ * Ocupa la ventana visible menos las filas de la marquesina; se crea al primer uso.
+ */
+CompositorPantalla& CompositorPantalla::consola() {
+    static SalidaConsola salida;
+    static CompositorPantalla compositor = []() {
+        int ancho, alto;
+        SalidaConsola::obtenerTamanio(ancho, alto);
+        return CompositorPantalla(salida, ancho, alto - FILAS_MARQUESINA, FILAS_MARQUESINA);
+    }();
+    return compositor;
+}
+
+void CompositorPantalla::marcarFila(int y) {
+    if (!filaSucia[y]) {
+        filaSucia[y] = 1;
+        filasSucias.push_back(y);
+    }
+}
+
+void CompositorPantalla::limpiar() {
+    for (int y = 0; y < alto; y++) {
+        std::fill(fondo.begin() + static_cast<size_t>(y) * ancho, fondo.begin() + static_cast<size_t>(y + 1) * ancho, CELDA_VACIA);
+        marcarFila(y);
+    }
+}
+
+void CompositorPantalla::escribir(int x, int y, const std::string& texto, unsigned short atributo) {
+    if (y < 0 || y >= alto || x >= ancho) return;
+    CeldaPantalla* fila = &fondo[static_cast<size_t>(y) * ancho];
+    size_t posicion = 0;
+    while (posicion < texto.size() && x < ancho) {
+        wchar_t caracter = leerUTF8(texto, posicion);
+        if (x >= 0) {
+            fila[x].caracter = caracter;
+            fila[x].atributo = atributo;
+        }
+        ++x;
+    }
+    marcarFila(y);
+}
+
+void CompositorPantalla::escribirFila(int y, const std::string& texto, unsigned short atributo) {
+    if (y < 0 || y >= alto) return;
+    std::fill(fondo.begin() + static_cast<size_t>(y) * ancho, fondo.begin() + static_cast<size_t>(y + 1) * ancho, CELDA_VACIA);
+    escribir(0, y, texto, atributo);
+}
+
+void CompositorPantalla::colocarCursor(int x, int y) {
+    cursorX = std::min(std::max(x, 0), ancho - 1);
+    cursorY = std::min(std::max(y, 0), alto - 1);
+    cursorPendiente = true;
+}
+
+void CompositorPantalla::invalidar() {
+    frenteDesconocido = true;
+}
+
+/**
+ * @brief Envía a la salida el rectángulo mínimo que contiene todos los cambios
+ *
+ * Solo se recorren las filas tocadas desde el último fotograma. Si la salida
+ * estaba invalidada, primero se limpia y se compara con una pantalla en blanco.
+ */
+void CompositorPantalla::presentar() {
+    ++estadisticas.fotogramas;
+    if (frenteDesconocido) {
+        salida.limpiarDesde(filaOrigen);
+        std::fill(frente.begin(), frente.end(), CELDA_VACIA);
+        for (int y = 0; y < alto; y++) {
+            marcarFila(y);
+        }
+        frenteDesconocido = false;
+    }
+
+    int izquierda = ancho, derecha = -1, arriba = alto, abajo = -1;
+    for (int y : filasSucias) {
+        filaSucia[y] = 0;
+        const CeldaPantalla* nueva = &fondo[static_cast<size_t>(y) * ancho];
+        const CeldaPantalla* actual = &frente[static_cast<size_t>(y) * ancho];
+        int primera = 0;
+        while (primera < ancho && nueva[primera] == actual[primera]) ++primera;
+        if (primera == ancho) continue;
+        int ultima = ancho - 1;
+        while (nueva[ultima] == actual[ultima]) --ultima;
+
+        izquierda = std::min(izquierda, primera);
+        derecha = std::max(derecha, ultima);
+        arriba = std::min(arriba, y);
+        abajo = std::max(abajo, y);
+    }
+    filasSucias.clear();
+
+    if (derecha >= 0) {
+        int columnas = derecha - izquierda + 1;
+        int filas = abajo - arriba + 1;
+        size_t inicio = static_cast<size_t>(arriba) * ancho + izquierda;
+        salida.escribir(&fondo[inicio], ancho, izquierda, filaOrigen + arriba, columnas, filas);
+        for (int f = 0; f < filas; f++) {
+            size_t desplazamiento = inicio + static_cast<size_t>(f) * ancho;
+            std::copy(fondo.begin() + desplazamiento, fondo.begin() + desplazamiento + columnas, frente.begin() + desplazamiento);
+        }
+        ++estadisticas.escrituras;
+        estadisticas.celdasEscritas += static_cast<unsigned long long>(columnas) * filas;
+    }
+
+    if (cursorPendiente) {
+        salida.colocarCursor(cursorX, filaOrigen + cursorY);
+        cursorPendiente = false;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// MenuConsola
+// ---------------------------------------------------------------------------
+
+MenuConsola::MenuConsola(const std::string& encabezado, const std::vector<std::string>& opciones, const std::string& pie)
+    : encabezado(dividirFilas(encabezado)), opciones(opciones), pie(dividirFilas(pie)), seleccion(0) {
+}
+
+void MenuConsola::setSeleccion(int indice) {
+    if (indice >= 0 && indice < static_cast<int>(opciones.size())) {
+        seleccion = indice;
+    }
+}
+
+int MenuConsola::getFilaSiguiente() const {
+    return static_cast<int>(encabezado.size() + opciones.size() + pie.size());
+}
+
+void MenuConsola::dibujarOpcion(CompositorPantalla& pantalla, int indice) const {
+    int fila = static_cast<int>(encabezado.size()) + indice;
+    pantalla.escribirFila(fila, (indice == seleccion ? " > " : "   ") + opciones[indice]);
+}
+
+void MenuConsola::dibujar(CompositorPantalla& pantalla) const {
+    pantalla.limpiar();
+    int fila = 0;
+    for (const std::string& linea : encabezado) {
+        pantalla.escribir(0, fila++, linea);
+    }
+    for (size_t i = 0; i < opciones.size(); i++) {
+        dibujarOpcion(pantalla, static_cast<int>(i));
+    }
+    fila += static_cast<int>(opciones.size());
+    for (const std::string& linea : pie) {
+        pantalla.escribir(0, fila++, linea);
+    }
+}
+
+void MenuConsola::mover(CompositorPantalla& pantalla, int desplazamiento) {
+    int total = static_cast<int>(opciones.size());
+    if (total == 0) return;
+    int anterior = seleccion;
+    seleccion = ((seleccion + desplazamiento) % total + total) % total;
+    dibujarOpcion(pantalla, anterior);
+    dibujarOpcion(pantalla, seleccion);
+}
+
+/**
+ * @brief Muestra el menú y espera la elección
+ *
+ * La primera presentación limpia el área bajo la marquesina (lo que antes hacía
+ * system("cls")); cada flecha redibuja dos filas y presenta un fotograma de una
+ * sola escritura.
+ */
+int MenuConsola::seleccionar(int resultadoEscape, CompositorPantalla& pantalla) {
+    pantalla.invalidar();
+    dibujar(pantalla);
+    pantalla.presentar();
+
+    int resultado = seleccion;
+    while (true) {
+        Tecla tecla = leerTecla();
+        if (tecla == Tecla::ARRIBA || tecla == Tecla::ABAJO) {
+            mover(pantalla, tecla == Tecla::ARRIBA ? -1 : 1);
+            pantalla.presentar();
+        }
+        else if (tecla == Tecla::ENTER) {
+            resultado = seleccion;
+            break;
+        }
+        else if (tecla == Tecla::ESCAPE && resultadoEscape != ESCAPE_IGNORADO) {
+            resultado = resultadoEscape;
+            break;
+        }
+    }
+
+    pantalla.colocarCursor(0, getFilaSiguiente());
+    pantalla.presentar();
+    return resultado;
+}
@@ -0,0 +1,301 @@
+#pragma once
+#ifndef PANTALLA_H
+#define PANTALLA_H
+
+#include <string>
+#include <vector>
+
+/**
+ * @struct CeldaPantalla
+ * @brief Un carácter de la pantalla con su atributo de color
+ *
+ * El atributo sigue el formato de la consola de Windows: bits 0-3 color del
+ * texto, bits 4-7 color del fondo (azul = 1, verde = 2, rojo = 4, intensidad = 8).
+ */
+struct CeldaPantalla {
+    /** @brief Carácter en UTF-16 */
+    wchar_t caracter;
+    /** @brief Atributo de color */
+    unsigned short atributo;
+
+    bool operator==(const CeldaPantalla& otra) const {
+        return caracter == otra.caracter && atributo == otra.atributo;
+    }
+    bool operator!=(const CeldaPantalla& otra) const { return !(*this == otra); }
+};
+
+/**
+ * @struct EstadisticasPantalla
+ * @brief Contadores de coste de un compositor
+ */
+struct EstadisticasPantalla {
+    /** @brief Llamadas a presentar() */
+    unsigned long long fotogramas = 0;
+    /** @brief Escrituras enviadas a la salida (como máximo una por fotograma) */
+    unsigned long long escrituras = 0;
+    /** @brief Celdas enviadas a la salida */
+    unsigned long long celdasEscritas = 0;
+};
+
+/**
+ * @class SalidaPantalla
+ * @brief Destino de los fotogramas de un CompositorPantalla
+ *
+ * Las coordenadas son absolutas (fila 0 = primera fila de la consola).
+ */
+class SalidaPantalla {
+public:
+    virtual ~SalidaPantalla() {}
+
+    /**
+     * @brief Escribe un rectángulo de celdas en una sola operación
+     * @param celdas Celda superior izquierda del rectángulo dentro del buffer de origen
+     * @param paso Celdas por fila del buffer de origen
+     * @param x Columna de destino
+     * @param y Fila de destino
+     * @param columnas Ancho del rectángulo
+     * @param filas Alto del rectángulo
+     */
+    virtual void escribir(const CeldaPantalla* celdas, int paso, int x, int y, int columnas, int filas) = 0;
+
+    /**
+     * @brief Deja en blanco todo lo que hay desde una fila hacia abajo
+     * @param fila Primera fila a limpiar
+     */
+    virtual void limpiarDesde(int fila) = 0;
+
+    /**
+     * @brief Coloca el cursor de texto
+     * @param x Columna
+     * @param y Fila
+     */
+    virtual void colocarCursor(int x, int y) = 0;
+};
+
+/**
+ * @class SalidaConsola
+ * @brief Salida a la consola real
+ *
+ * En Windows usa WriteConsoleOutputW, que no mueve el cursor ni interfiere con
+ * la marquesina; en otros sistemas emite secuencias ANSI con un solo fwrite.
+ */
+class SalidaConsola : public SalidaPantalla {
+public:
+    void escribir(const CeldaPantalla* celdas, int paso, int x, int y, int columnas, int filas) override;
+    void limpiarDesde(int fila) override;
+    void colocarCursor(int x, int y) override;
+
+    /**
+     * @brief Tamaño de la ventana visible de la consola
+     * @param ancho Columnas
+     * @param alto Filas
+     */
+    static void obtenerTamanio(int& ancho, int& alto);
+
+private:
+    /** @brief Memoria reutilizada para convertir las celdas al formato de salida */
+    std::vector<char> bufferSalida;
+};
+
+/**
+ * @class SalidaMemoria
+ * @brief Salida sin terminal: guarda las celdas en memoria
+ *
+ * Permite dibujar y medir los menús en Linux o en pruebas sin consola.
+ */
+class SalidaMemoria : public SalidaPantalla {
+public:
+    /**
+     * @brief Crea una pantalla en blanco
+     * @param ancho Columnas
+     * @param alto Filas
+     */
+    SalidaMemoria(int ancho, int alto);
+
+    void escribir(const CeldaPantalla* celdas, int paso, int x, int y, int columnas, int filas) override;
+    void limpiarDesde(int fila) override;
+    void colocarCursor(int x, int y) override;
+
+    /**
+     * @brief Texto de una fila, sin los espacios finales
+     * @param fila Fila
+     * @return Texto en UTF-8
+     */
+    std::string texto(int fila) const;
+
+    /** @brief Escrituras recibidas */
+    unsigned long long getEscrituras() const { return escrituras; }
+
+    /** @brief Celdas recibidas */
+    unsigned long long getCeldas() const { return celdas; }
+
+    int getCursorX() const { return cursorX; }
+    int getCursorY() const { return cursorY; }
+
+private:
+    int ancho;
+    int alto;
+    std::vector<CeldaPantalla> pantalla;
+    unsigned long long escrituras;
+    unsigned long long celdas;
+    int cursorX;
+    int cursorY;
+};
+
+/**
+ * @class CompositorPantalla
+ * @brief Pantalla con doble buffer que solo envía lo que cambió
+ *
+ * Se dibuja sobre un buffer fuera de pantalla; presentar() compara las filas
+ * modificadas con lo que ya está en la salida y envía el rectángulo mínimo que
+ * cubre las diferencias en una sola escritura. El coste de presentar depende de
+ * las filas tocadas desde el fotograma anterior, no del tamaño de la pantalla.
+ *
+ * Las coordenadas de dibujo son relativas a filaOrigen, de modo que la fila 0
+ * queda debajo de la marquesina, igual que en Utilidades::gotoxy.
+ */
+class CompositorPantalla {
+public:
+    /**
+     * @brief Crea un compositor
+     * @param salida Destino de los fotogramas
+     * @param ancho Columnas
+     * @param alto Filas disponibles desde filaOrigen
+     * @param filaOrigen Fila absoluta donde empieza el área del compositor
+     */
+    CompositorPantalla(SalidaPantalla& salida, int ancho, int alto, int filaOrigen = 0);
+
+    /**
+     * @brief Compositor de la consola de la aplicación, debajo de la marquesina
+     */
+    static CompositorPantalla& consola();
+
+    /** @brief Atributo normal (gris sobre negro) */
+    static const unsigned short ATRIBUTO_NORMAL = 0x07;
+
+    /** @brief Deja en blanco el buffer fuera de pantalla */
+    void limpiar();
+
+    /**
+     * @brief Escribe texto en el buffer fuera de pantalla
+     * @param x Columna
+     * @param y Fila
+     * @param texto Texto en UTF-8; se recorta al ancho
+     * @param atributo Atributo de color
+     */
+    void escribir(int x, int y, const std::string& texto, unsigned short atributo = ATRIBUTO_NORMAL);
+
+    /**
+     * @brief Escribe una fila completa: el texto desde la columna 0 y blancos hasta el final
+     * @param y Fila
+     * @param texto Texto en UTF-8
+     * @param atributo Atributo de color
+     */
+    void escribirFila(int y, const std::string& texto, unsigned short atributo = ATRIBUTO_NORMAL);
+
+    /**
+     * @brief Indica dónde debe quedar el cursor tras el siguiente presentar()
+     */
+    void colocarCursor(int x, int y);
+
+    /**
+     * @brief Indica que otro código escribió en la salida
+     *
+     * El siguiente presentar() limpia la salida desde filaOrigen y escribe todo lo
+     * que no esté en blanco, en lugar de comparar con el fotograma anterior.
+     */
+    void invalidar();
+
+    /**
+     * @brief Envía a la salida las diferencias con el fotograma anterior
+     */
+    void presentar();
+
+    int getAncho() const { return ancho; }
+    int getAlto() const { return alto; }
+    const EstadisticasPantalla& getEstadisticas() const { return estadisticas; }
+
+private:
+    SalidaPantalla& salida;
+    int ancho;
+    int alto;
+    int filaOrigen;
+
+    /** @brief Buffer donde se dibuja */
+    std::vector<CeldaPantalla> fondo;
+    /** @brief Lo que la salida muestra actualmente */
+    std::vector<CeldaPantalla> frente;
+    /** @brief Marca por fila de si se tocó desde el último fotograma */
+    std::vector<char> filaSucia;
+    /** @brief Filas tocadas desde el último fotograma, sin repetir */
+    std::vector<int> filasSucias;
+
+    bool frenteDesconocido;
+    bool cursorPendiente;
+    int cursorX;
+    int cursorY;
+    EstadisticasPantalla estadisticas;
+
+    /** @brief Registra una fila como modificada */
+    void marcarFila(int y);
+};
+
+/**
+ * @class MenuConsola
+ * @brief Menú de opciones navegable con las flechas, dibujado con un compositor
+ *
+ * Al mover la selección solo se redibujan la opción anterior y la nueva, así
+ * que el coste de cada tecla no depende del número de opciones.
+ */
+class MenuConsola {
+public:
+    /** @brief Valor de resultadoEscape para que ESC no haga nada */
+    static const int ESCAPE_IGNORADO = -2;
+
+    /**
+     * @brief Crea un menú
+     * @param encabezado Texto sobre las opciones; cada '\n' inicia una fila
+     * @param opciones Opciones seleccionables
+     * @param pie Texto bajo las opciones (opcional)
+     */
+    MenuConsola(const std::string& encabezado, const std::vector<std::string>& opciones, const std::string& pie = "");
+
+    /**
+     * @brief Dibuja el menú completo en el buffer del compositor
+     */
+    void dibujar(CompositorPantalla& pantalla) const;
+
+    /**
+     * @brief Mueve la selección y redibuja solo las dos filas afectadas
+     * @param pantalla Compositor
+     * @param desplazamiento -1 para subir, 1 para bajar (con vuelta al otro extremo)
+     */
+    void mover(CompositorPantalla& pantalla, int desplazamiento);
+
+    /**
+     * @brief Muestra el menú y espera a que el usuario elija con Enter
+     * @param resultadoEscape Valor devuelto si se pulsa ESC (ESCAPE_IGNORADO = ignorar ESC)
+     * @param pantalla Compositor sobre el que se dibuja
+     * @return Índice de la opción elegida, o resultadoEscape
+     *
+     * Al volver, el cursor queda en la fila siguiente al menú.
+     */
+    int seleccionar(int resultadoEscape = ESCAPE_IGNORADO, CompositorPantalla& pantalla = CompositorPantalla::consola());
+
+    int getSeleccion() const { return seleccion; }
+    void setSeleccion(int indice);
+
+    /** @brief Fila del compositor siguiente a la última que ocupa el menú */
+    int getFilaSiguiente() const;
+
+private:
+    std::vector<std::string> encabezado;
+    std::vector<std::string> opciones;
+    std::vector<std::string> pie;
+    int seleccion;
+
+    /** @brief Dibuja la fila de una opción, con o sin marca de selección */
+    void dibujarOpcion(CompositorPantalla& pantalla, int indice) const;
+};
+
+#endif // PANTALLA_H
@@ -0,0 +1,71 @@
+#pragma once
+#ifndef PARALELO_H
+#define PARALELO_H
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstddef>
+
+/**
+ * @class Paralelo
+ * @brief Clase estática con utilidades para repartir trabajo entre hilos
+ *
+ * Reparte un rango de índices entre varios hilos, cada uno tomando el siguiente
+ * índice libre. Se usa en el cifrado por bloques, en el hash por bloques y en
+ * los procesos por lotes.
+ */
+class Paralelo {
+public:
+    /**
+     * @brief Número de hilos a usar
+     * @param hilos Hilos solicitados (0 = todos los núcleos disponibles)
+     * @return Número de hilos, al menos 1
+     */
+    static unsigned int resolverHilos(unsigned int hilos) {
+        if (hilos == 0) hilos = std::thread::hardware_concurrency();
+        return hilos == 0 ? 1 : hilos;
+    }
+
+    /**
+     * @brief Ejecuta una tarea para cada índice de [0, total) repartida entre hilos
+     * @param total Número de índices
+     * @param hilos Número de hilos (0 = todos los núcleos disponibles)
+     * @param tarea Función bool(size_t); si devuelve false se detiene el reparto
+     * @return Índice más bajo que falló, o total si todos tuvieron éxito
+     *
+     * El hilo que llama también trabaja, por lo que con un solo hilo no se crea ninguno.
+     */
+    template <typename Tarea>
+    static size_t ejecutar(size_t total, unsigned int hilos, Tarea tarea) {
+        std::atomic<size_t> siguiente(0);
+        std::atomic<size_t> primerFallo(total);
+        std::atomic<bool> fallo(false);
+
+        auto trabajador = [&]() {
+            while (!fallo.load(std::memory_order_relaxed)) {
+                size_t i = siguiente.fetch_add(1);
+                if (i >= total) break;
+                if (!tarea(i)) {
+                    size_t actual = primerFallo.load();
+                    while (i < actual && !primerFallo.compare_exchange_weak(actual, i)) {}
+                    fallo = true;
+                }
+            }
+        };
+
+        hilos = resolverHilos(hilos);
+        size_t usados = total < hilos ? total : hilos;
+        std::vector<std::thread> grupo;
+        for (size_t h = 1; h < usados; ++h) {
+            grupo.emplace_back(trabajador);
+        }
+        trabajador();
+        for (auto& hilo : grupo) {
+            hilo.join();
+        }
+        return primerFallo.load();
+    }
+};
+
+#endif // PARALELO_H
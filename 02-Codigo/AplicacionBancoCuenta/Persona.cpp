@@ -10,18 +10,21 @@
 #include <fstream>
 #include <string>
 #include <sstream>
-#include <regex>
 #include <vector>
 #include <algorithm>
 #include <iomanip>
+#ifdef _WIN32
 #include <conio.h> // Para _getch()
 #include <windows.h>
+#endif
 #include <functional>
 #include <iterator>
 #include "Validar.h"
 #include "Fecha.h"
 #include "Persona.h"
+#include "Estadisticas.h"
 
+#ifdef _WIN32 // Captura por teclado con la consola de Windows; sin ella solo queda el modelo
  /**
   * @namespace PersonaUI
   * @brief Proporciona elementos de interfaz de usuario para la clase Persona
@@ -151,9 +154,11 @@ namespace PersonaUI {
 		return 0.0; // En caso de error
 		};
 }
+#endif
 
 using namespace std;
 
+#ifdef _WIN32
 /**
  * @brief Inicia el proceso de ingreso de datos para una persona
  *
@@ -742,6 +747,7 @@ bool Persona::corregirDatos()
 		return true; // Si selecciona "No", retorna true para repetir el ingreso de datos
 	}
 }
+#endif
 
 /**
  * @brief Muestra en pantalla los datos actuales de la persona
@@ -980,17 +986,19 @@ int Persona::buscarPersonaPorCuentas(const string& numeroCuenta) const {
  * @return int Número de cuentas guardadas
  */
 int Persona::guardarCuentas(std::ofstream& archivo, std::string tipo) const {
+	MEDIR_OPERACION(Operacion::GuardarCuentasPersona);
 	if (!archivo.is_open() || !isValidInstance()) {
 		return 0;
 	}
 	int contador = 0;
 
+	// Mismas marcas que espera Banco::cargarCuentasDesdeRuta (CUENTA_AHORRO_INICIO, ...)
 	auto guardarLista = [&](Cuenta<double>* actual, const std::string& tipo) -> void {
 		while (actual) {
 			if (actual->getNumeroCuenta() != "") { // Asegurarse de que la cuenta no sea nula
-				archivo << tipo << "_INICIO\n";
+				archivo << "CUENTA_" << tipo << "_INICIO\n";
 				archivo << "NUMERO_CUENTA:" << actual->getNumeroCuenta() << "\n";
-				archivo << "SALDO:" << actual->consultarSaldo() << "\n";
+				archivo << "SALDO:" << std::fixed << std::setprecision(2) << actual->consultarSaldo() << "\n";
 				archivo << "FECHA_APERTURA:" << actual->getFechaApertura().toString() << "\n";
 				archivo << "ESTADO:" << actual->consultarEstado() << "\n";
 				// Aqui se podrian añadir otros campos especificos de cada tipo de cuenta
@@ -1002,7 +1010,7 @@ int Persona::guardarCuentas(std::ofstream& archivo, std::string tipo) const {
 		};
 
 	if (tipo == "AHORROS") { // Si es tipo Ahorros
-		guardarLista(cabezaAhorros, "AHORROS"); // Guardar cuentas de ahorro
+		guardarLista(cabezaAhorros, "AHORRO"); // Guardar cuentas de ahorro
 	}
 	else if (tipo == "CORRIENTE") // Si es tipo Corriente
 	{
@@ -1012,6 +1020,7 @@ int Persona::guardarCuentas(std::ofstream& archivo, std::string tipo) const {
 	return contador;
 }
 
+#ifdef _WIN32
 /**
  * @brief Crea y agrega una cuenta de ahorros para la persona
  *
@@ -1308,6 +1317,7 @@ bool Persona::crearSoloCuentaCorriente(CuentaCorriente* nuevaCuenta, const std::
 		return false;
 	}
 }
+#endif
 
 /**
  * @brief Genera un número de cuenta único para una nueva cuenta
@@ -1320,6 +1330,7 @@ bool Persona::crearSoloCuentaCorriente(CuentaCorriente* nuevaCuenta, const std::
  * @return std::string Número de cuenta generado
  */
 std::string Persona::crearNumeroCuenta(Cuenta<double>* nuevaCuenta, const std::string& sucursal) {
+	MEDIR_OPERACION(Operacion::CrearNumeroCuenta);
 	// Validar que la sucursal esté entre las permitidas
 	if (sucursal != "210" && sucursal != "220" && sucursal != "480" && sucursal != "560") {
 		std::cerr << "Error: Código de sucursal no válido. Use 210, 220, 480 o 560." << std::endl;
@@ -1393,6 +1404,7 @@ std::string Persona::crearNumeroCuenta(Cuenta<double>* nuevaCuenta, const std::s
 	return numeroCuentaStr;
 }
 
+#ifdef _WIN32
 /**
  * @brief Presenta un selector de sucursal bancaria
  *
@@ -1462,6 +1474,7 @@ std::string Persona::seleccionSucursal() {
 		}
 	}
 }
+#endif
 
 /**
  * @brief Genera un mensaje estándar para el ingreso de datos
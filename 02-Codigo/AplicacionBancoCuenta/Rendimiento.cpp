@@ -0,0 +1,130 @@
+/**
+ * @file Rendimiento.cpp
+ * @brief Medición de operaciones con calentamiento, repeticiones y percentiles
+ */
+#include "Rendimiento.h"
+#include "Fecha.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+
+/**
+ * @brief Mide una operación
+ *
+ * @param nombre Nombre de la medición
+ * @param tamano Tamaño de los datos
+ * @param operaciones Operaciones por repetición
+ * @param configuracion Calentamiento y repeticiones
+ * @param repeticion Lote cronometrado
+ * @param preparar Paso previo a cada repetición, sin cronometrar
+ * @return ResultadoRendimiento Tiempos por operación
+ */
+ResultadoRendimiento Rendimiento::medir(const std::string& nombre, size_t tamano, size_t operaciones,
+    const ConfiguracionRendimiento& configuracion, const std::function<void()>& repeticion,
+    const std::function<void()>& preparar) {
+    typedef std::chrono::steady_clock Reloj;
+
+    ResultadoRendimiento resultado;
+    resultado.nombre = nombre;
+    resultado.tamano = tamano;
+    resultado.operaciones = operaciones == 0 ? 1 : operaciones;
+    resultado.repeticiones = configuracion.repeticiones == 0 ? 1 : configuracion.repeticiones;
+
+    for (size_t i = 0; i < configuracion.calentamiento; ++i) {
+        if (preparar) preparar();
+        repeticion();
+    }
+
+    std::vector<double> tiempos;
+    tiempos.reserve(resultado.repeticiones);
+    for (size_t i = 0; i < resultado.repeticiones; ++i) {
+        if (preparar) preparar();
+        const Reloj::time_point inicio = Reloj::now();
+        repeticion();
+        const double ns = std::chrono::duration<double, std::nano>(Reloj::now() - inicio).count();
+        tiempos.push_back(ns / static_cast<double>(resultado.operaciones));
+    }
+
+    std::sort(tiempos.begin(), tiempos.end());
+    double suma = 0.0;
+    for (double t : tiempos) suma += t;
+    resultado.nsMinimo = tiempos.front();
+    resultado.nsP50 = percentil(tiempos, 50.0);
+    resultado.nsP90 = percentil(tiempos, 90.0);
+    resultado.nsP99 = percentil(tiempos, 99.0);
+    resultado.nsMaximo = tiempos.back();
+    resultado.nsMedia = suma / static_cast<double>(tiempos.size());
+    return resultado;
+}
+
+/**
+ * @brief Percentil por rango más cercano
+ *
+ * @param ordenados Valores ordenados
+ * @param percentil Percentil de 0 a 100
+ * @return double Valor del percentil
+ */
+double Rendimiento::percentil(const std::vector<double>& ordenados, double percentil) {
+    const double rango = std::ceil(percentil / 100.0 * static_cast<double>(ordenados.size()));
+    size_t indice = rango < 1.0 ? 0 : static_cast<size_t>(rango) - 1;
+    if (indice >= ordenados.size()) indice = ordenados.size() - 1;
+    return ordenados[indice];
+}
+
+namespace {
+    /** @brief Nanosegundos con un decimal */
+    std::string numero(double valor) {
+        char texto[48];
+        std::snprintf(texto, sizeof(texto), "%.1f", valor);
+        return texto;
+    }
+
+    /** @brief Compilador con el que se generó el programa */
+    std::string compilador() {
+#if defined(_MSC_VER)
+        return "MSVC " + std::to_string(_MSC_VER);
+#elif defined(__clang__)
+        return "clang " __clang_version__;
+#elif defined(__GNUC__)
+        return "gcc " __VERSION__;
+#else
+        return "desconocido";
+#endif
+    }
+}
+
+/**
+ * @brief Escribe los resultados en JSON, un resultado por línea
+ *
+ * @param salida Destino
+ * @param resultados Mediciones
+ * @param configuracion Configuración usada
+ */
+void Rendimiento::escribirJSON(std::ostream& salida, const std::vector<ResultadoRendimiento>& resultados,
+    const ConfiguracionRendimiento& configuracion) {
+    salida << "{\n";
+    salida << "  \"formato\": 1,\n";
+    salida << "  \"fecha\": \"" << Fecha().obtenerFechaFormateada() << "\",\n";
+    salida << "  \"compilador\": \"" << compilador() << "\",\n";
+#ifdef NDEBUG
+    salida << "  \"optimizado\": true,\n";
+#else
+    salida << "  \"optimizado\": false,\n";
+#endif
+    salida << "  \"nucleos\": " << std::thread::hardware_concurrency() << ",\n";
+    salida << "  \"calentamiento\": " << configuracion.calentamiento << ",\n";
+    salida << "  \"repeticiones\": " << configuracion.repeticiones << ",\n";
+    salida << "  \"resultados\": [\n";
+    for (size_t i = 0; i < resultados.size(); ++i) {
+        const ResultadoRendimiento& r = resultados[i];
+        salida << "    {\"nombre\": \"" << r.nombre << "\", \"tamano\": " << r.tamano
+            << ", \"repeticiones\": " << r.repeticiones << ", \"operaciones\": " << r.operaciones
+            << ", \"ns_min\": " << numero(r.nsMinimo) << ", \"ns_p50\": " << numero(r.nsP50)
+            << ", \"ns_p90\": " << numero(r.nsP90) << ", \"ns_p99\": " << numero(r.nsP99)
+            << ", \"ns_max\": " << numero(r.nsMaximo) << ", \"ns_media\": " << numero(r.nsMedia) << "}"
+            << (i + 1 < resultados.size() ? ",\n" : "\n");
+    }
+    salida << "  ]\n}\n";
+}
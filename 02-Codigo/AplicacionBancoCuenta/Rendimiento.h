@@ -0,0 +1,88 @@
+#pragma once
+#ifndef RENDIMIENTO_H
+#define RENDIMIENTO_H
+
+#include <string>
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <vector>
+
+/**
+ * @struct ConfiguracionRendimiento
+ * @brief Parámetros comunes de todas las mediciones
+ */
+struct ConfiguracionRendimiento {
+    /** @brief Repeticiones que se ejecutan y se descartan antes de medir */
+    size_t calentamiento = 3;
+    /** @brief Repeticiones medidas */
+    size_t repeticiones = 20;
+};
+
+/**
+ * @struct ResultadoRendimiento
+ * @brief Tiempos de una medición, en nanosegundos por operación
+ *
+ * Cada repetición ejecuta un lote de operaciones; los percentiles se calculan
+ * sobre el tiempo por operación de cada repetición.
+ */
+struct ResultadoRendimiento {
+    /** @brief Nombre de la medición */
+    std::string nombre;
+    /** @brief Tamaño de los datos (clientes, bytes o elementos, según la medición) */
+    size_t tamano = 0;
+    /** @brief Repeticiones medidas */
+    size_t repeticiones = 0;
+    /** @brief Operaciones de cada repetición */
+    size_t operaciones = 0;
+    double nsMinimo = 0.0;
+    double nsP50 = 0.0;
+    double nsP90 = 0.0;
+    double nsP99 = 0.0;
+    double nsMaximo = 0.0;
+    double nsMedia = 0.0;
+};
+
+/**
+ * @class Rendimiento
+ * @brief Clase estática para medir operaciones con calentamiento, repeticiones y percentiles
+ */
+class Rendimiento {
+public:
+    /**
+     * @brief Mide una operación
+     * @param nombre Nombre de la medición
+     * @param tamano Tamaño de los datos, solo para el informe
+     * @param operaciones Operaciones que ejecuta cada llamada a repeticion
+     * @param configuracion Calentamiento y repeticiones
+     * @param repeticion Ejecuta un lote de operaciones; es lo único que se cronometra
+     * @param preparar Opcional: se ejecuta antes de cada repetición, fuera del cronómetro
+     * @return Tiempos por operación
+     */
+    static ResultadoRendimiento medir(const std::string& nombre, size_t tamano, size_t operaciones,
+        const ConfiguracionRendimiento& configuracion, const std::function<void()>& repeticion,
+        const std::function<void()>& preparar = std::function<void()>());
+
+    /**
+     * @brief Percentil por rango más cercano
+     * @param ordenados Valores ordenados de menor a mayor, al menos uno
+     * @param percentil Percentil de 0 a 100
+     * @return Valor del percentil
+     */
+    static double percentil(const std::vector<double>& ordenados, double percentil);
+
+    /**
+     * @brief Escribe los resultados en JSON
+     *
+     * Incluye el compilador, el tipo de compilación, los núcleos y la
+     * configuración, para poder comparar resultados entre versiones.
+     *
+     * @param salida Destino
+     * @param resultados Mediciones en el orden en que se hicieron
+     * @param configuracion Configuración usada
+     */
+    static void escribirJSON(std::ostream& salida, const std::vector<ResultadoRendimiento>& resultados,
+        const ConfiguracionRendimiento& configuracion);
+};
+
+#endif // RENDIMIENTO_H
@@ -8,19 +8,25 @@
  */
 #include "NodoPersona.h"
 #include "Persona.h"
+#ifdef _WIN32
 #include <windows.h>
 #include <conio.h>
+#endif
 #include <iostream>
 #include <fstream>
 #include <iomanip>
 #include <sstream>
-#include <regex>
+#include <algorithm>
 #include <string>
 #include <ctime>
 #include <chrono>
 #include <queue>
+#ifdef _WIN32
 #include "Marquesina.h"
+#endif
 #include "Utilidades.h"
+#include "Pantalla.h"
+#include "Estadisticas.h"
 
  /**
   * @class NodoArbolB
@@ -246,6 +252,7 @@ public:
 };
 
 
+#ifdef _WIN32 // Consola de Windows y marquesina de la aplicación interactiva
 // Variable externa para acceso a la marquesina global
 extern Marquesina* marquesinaGlobal;
 
@@ -333,6 +340,7 @@ void Utilidades::limpiarPantallaPreservandoMarquesina(int lineasMarquesina)
 
 	finalizarOperacionCritica();
 }
+#endif
 
 
 /**
@@ -403,6 +411,7 @@ double Utilidades::ConvertirADouble(const std::string& texto) {
  * @return std::string Valor formateado como texto
  */
 std::string Utilidades::FormatearMonto(double monto, int decimales) {
+	MEDIR_OPERACION(Operacion::FormatearMonto);
 	std::ostringstream oss;
 	oss << std::fixed << std::setprecision(decimales) << monto;
 
@@ -481,16 +490,68 @@ bool Utilidades::EsNumerico(const std::string& texto) {
 	return tieneDigito;
 }
 
+/**
+ * @brief Indica si un carácter es de palabra, igual que \\w en una expresión regular
+ *
+ * @param c Carácter a comprobar
+ * @return bool true si es una letra o dígito ASCII o '_'
+ */
+static bool esCaracterPalabra(char c) {
+	return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
 /**
  * @brief Valida si una cadena es un correo electrónico válido
  *
+ * Acepta lo mismo que la expresión (\\w+)(\\.|_)?(\\w*)@(\\w+)(\\.(\\w+))+ :
+ * un usuario de caracteres de palabra con como máximo un punto (no al inicio)
+ * y un dominio de dos o más palabras separadas por puntos.
+ *
  * @param correo Cadena a validar
  * @return bool true si es un correo válido, false en caso contrario
  */
 bool Utilidades::EsCorreoValido(const std::string& correo) {
-	// Expresion regular simple para validar correos electronicos
-	const std::regex pattern("(\\w+)(\\.|_)?(\\w*)@(\\w+)(\\.(\\w+))+");
-	return std::regex_match(correo, pattern);
+	const size_t longitud = correo.size();
+	size_t i = 0;
+
+	// Usuario
+	while (i < longitud && esCaracterPalabra(correo[i])) {
+		i++;
+	}
+	if (i == 0) {
+		return false;
+	}
+	if (i < longitud && correo[i] == '.') {
+		i++;
+		while (i < longitud && esCaracterPalabra(correo[i])) {
+			i++;
+		}
+	}
+	if (i == longitud || correo[i] != '@') {
+		return false;
+	}
+	i++;
+
+	// Dominio: palabras no vacias separadas por puntos, al menos dos
+	int palabras = 0;
+	while (true) {
+		const size_t inicio = i;
+		while (i < longitud && esCaracterPalabra(correo[i])) {
+			i++;
+		}
+		if (i == inicio) {
+			return false;
+		}
+		palabras++;
+		if (i == longitud) {
+			break;
+		}
+		if (correo[i] != '.') {
+			return false;
+		}
+		i++;
+	}
+	return palabras >= 2;
 }
 
 /**
@@ -542,6 +603,7 @@ std::string Utilidades::Regresar() {
 	return "Regresar al menu principal";
 }
 
+#ifdef _WIN32
 /**
  * @brief Muestra el menú de ayuda del sistema
  *
@@ -572,16 +634,18 @@ void Utilidades::mostrarMenuAyuda() {
 		std::cerr << "Error al abrir el menu de ayuda. Codigo: " << (int)resultado << std::endl;
 	}
 }
+#endif
 
 /**
- * @brief Calcula un hash simplificado de un archivo
+ * @brief Calcula el hash simplificado usado por los archivos .hash anteriores
  *
- * Implementación didáctica de un algoritmo de hash para archivos
+ * Implementación didáctica que se conserva solo para poder verificar los
+ * archivos .hash generados antes de incorporar SHA1/SHA256 reales.
  *
  * @param rutaArchivo Ruta al archivo a procesar
- * @return std::string Hash generado
+ * @return std::string Hash generado con el formato "hexadecimal-tamaño"
  */
-std::string Utilidades::calcularSHA1(const std::string& rutaArchivo) {
+static std::string calcularHashLegado(const std::string& rutaArchivo) {
 	std::ifstream archivo(rutaArchivo, std::ios::binary);
 	if (!archivo) {
 		return "ERROR_ARCHIVO_NO_ENCONTRADO";
@@ -650,19 +714,94 @@ std::string Utilidades::calcularSHA1(const std::string& rutaArchivo) {
 	return ss.str() + "-" + std::to_string(totalBytes);
 }
 
+/**
+ * @brief Calcula el hash de un archivo con el algoritmo indicado
+ *
+ * El resultado incluye la etiqueta del algoritmo para que la verificación
+ * sepa con qué algoritmo recalcularlo.
+ *
+ * @param rutaArchivo Ruta al archivo a procesar
+ * @param algoritmo Algoritmo de resumen
+ * @return std::string Hash con el formato "ALGORITMO:hexadecimal-tamaño"
+ */
+std::string Utilidades::calcularHash(const std::string& rutaArchivo, AlgoritmoHash algoritmo) {
+	MEDIR_OPERACION(Operacion::CalcularHash);
+	std::string hexadecimal;
+	uint64_t tamanio = 0;
+	if (!Hash::calcularArchivo(rutaArchivo, algoritmo, hexadecimal, tamanio)) {
+		return "ERROR_ARCHIVO_NO_ENCONTRADO";
+	}
+	return std::string(Hash::nombreAlgoritmo(algoritmo)) + ":" + hexadecimal + "-" + std::to_string(tamanio);
+}
+
+/**
+ * @brief Calcula el hash SHA1 de un archivo
+ *
+ * @param rutaArchivo Ruta al archivo a procesar
+ * @return std::string Hash con el formato "SHA1:hexadecimal-tamaño"
+ */
+std::string Utilidades::calcularSHA1(const std::string& rutaArchivo) {
+	return calcularHash(rutaArchivo, AlgoritmoHash::SHA1);
+}
+
+/**
+ * @brief Calcula el hash SHA256 de un archivo
+ *
+ * @param rutaArchivo Ruta al archivo a procesar
+ * @return std::string Hash con el formato "SHA256:hexadecimal-tamaño"
+ */
+std::string Utilidades::calcularSHA256(const std::string& rutaArchivo) {
+	return calcularHash(rutaArchivo, AlgoritmoHash::SHA256);
+}
+
+/**
+ * @brief Calcula el hash actual de un archivo con el mismo formato que el esperado
+ *
+ * @param rutaArchivo Ruta al archivo
+ * @param hashEsperado Hash de referencia; su etiqueta indica el algoritmo
+ * @param cache Caché opcional de hashes
+ * @param desdeCache Salida: true si el resultado vino de la caché
+ * @return std::string Hash actual o "ERROR_ARCHIVO_NO_ENCONTRADO"
+ */
+static std::string calcularHashComparable(const std::string& rutaArchivo, const std::string& hashEsperado,
+	CacheHash* cache, bool& desdeCache) {
+	desdeCache = false;
+	AlgoritmoHash algoritmo;
+	size_t separador = hashEsperado.find(':');
+	bool etiquetado = separador != std::string::npos &&
+		Hash::algoritmoDesdeNombre(hashEsperado.substr(0, separador), algoritmo);
+
+	auto calcular = [&]() {
+		return etiquetado ? Utilidades::calcularHash(rutaArchivo, algoritmo) : calcularHashLegado(rutaArchivo);
+	};
+	if (!cache) {
+		return calcular();
+	}
+
+	std::string etiqueta = etiquetado ? Hash::nombreAlgoritmo(algoritmo) : "LEGADO";
+	std::string hash = cache->obtener(rutaArchivo, etiqueta, calcular, &desdeCache);
+	return hash.empty() ? "ERROR_ARCHIVO_NO_ENCONTRADO" : hash;
+}
+
 /**
  * @brief Verifica si el hash de un archivo coincide con uno esperado
  *
+ * El algoritmo se toma de la etiqueta del hash esperado; si no tiene etiqueta
+ * se trata como un hash del formato anterior. Con caché, un archivo cuya ruta,
+ * tamaño y fecha no cambiaron no se vuelve a leer.
+ *
  * @param rutaArchivo Ruta al archivo a verificar
  * @param hashEsperado Hash esperado para comparación
+ * @param cache Caché de hashes opcional
  * @return bool true si los hashes coinciden, false en caso contrario
  */
-bool Utilidades::verificarSHA1(const std::string& rutaArchivo, const std::string& hashEsperado) {
-	std::string hashActual = calcularSHA1(rutaArchivo);
+bool Utilidades::verificarHash(const std::string& rutaArchivo, const std::string& hashEsperado, CacheHash* cache) {
+	bool desdeCache = false;
+	std::string hashActual = calcularHashComparable(rutaArchivo, hashEsperado, cache, desdeCache);
 
 	// Informe detallado para fines educativos
 	if (hashActual == hashEsperado) {
-		std::cout << "Hash verificado exitosamente." << std::endl;
+		std::cout << "Hash verificado exitosamente." << (desdeCache ? " (desde cache)" : "") << std::endl;
 		std::cout << "  • Hash esperado/recibido: " << hashEsperado << std::endl;
 		std::cout << "  • Hash actual/calculado: " << hashActual << std::endl;
 		return true;
@@ -688,14 +827,13 @@ void Utilidades::guardarHashArchivo(const std::string& rutaArchivo, const std::s
 	if (archivoHash) {
 		// Añadimos cabecera informativa con fecha
 		time_t tiempoActual = time(nullptr);
-		struct tm timeinfo;
-		localtime_s(&timeinfo, &tiempoActual);  // Version segura
+		struct tm timeinfo = Fecha::horaLocal(tiempoActual);
 		char buffer[128];
 		std::strftime(buffer, sizeof(buffer), "%d/%m/%Y %H:%M:%S", &timeinfo);
 
 		archivoHash << "# Hash de integridad del archivo: " << rutaArchivo << std::endl;
 		archivoHash << "# Generado: " << buffer << std::endl;
-		archivoHash << "# Formato: [hash-tamaño_bytes]" << std::endl;
+		archivoHash << "# Formato: [ALGORITMO:hash-tamaño_bytes] (ALGORITMO = SHA1 | SHA256)" << std::endl;
 		archivoHash << hash;
 		archivoHash.close();
 		std::cout << "Hash guardado en: " << rutaHash << std::endl;
@@ -733,6 +871,260 @@ std::string Utilidades::leerHashArchivo(const std::string& rutaHashArchivo) {
 }
 
 
+/**
+ * @brief Guarda un hash por bloques en el archivo .hash
+ *
+ * La primera línea sin comentario es la raíz con la etiqueta MERKLE-ALGORITMO;
+ * le siguen el tamaño de bloque y el resumen de cada bloque.
+ *
+ * @param rutaArchivo Ruta al archivo original
+ * @param hash Hash por bloques a guardar
+ */
+void Utilidades::guardarHashMerkle(const std::string& rutaArchivo, const HashMerkle& hash) {
+	std::string rutaHash = rutaArchivo + ".hash";
+	std::ofstream archivoHash(rutaHash);
+
+	if (archivoHash) {
+		time_t tiempoActual = time(nullptr);
+		struct tm timeinfo = Fecha::horaLocal(tiempoActual);
+		char buffer[128];
+		std::strftime(buffer, sizeof(buffer), "%d/%m/%Y %H:%M:%S", &timeinfo);
+
+		archivoHash << "# Hash de integridad del archivo: " << rutaArchivo << std::endl;
+		archivoHash << "# Generado: " << buffer << std::endl;
+		archivoHash << "# Formato: [MERKLE-ALGORITMO:raiz-tamaño_bytes], TAM_BLOQUE y un BLOQUE:indice:hash por bloque" << std::endl;
+		archivoHash << "MERKLE-" << Hash::nombreAlgoritmo(hash.algoritmo) << ":" << hash.raiz << "-" << hash.tamanio << "\n";
+		archivoHash << "TAM_BLOQUE:" << hash.tamBloque << "\n";
+		for (size_t i = 0; i < hash.bloques.size(); ++i) {
+			archivoHash << "BLOQUE:" << i << ":" << hash.bloques[i] << "\n";
+		}
+		archivoHash.close();
+		std::cout << "Hash por bloques guardado en: " << rutaHash << std::endl;
+	}
+	else {
+		std::cerr << "Error al guardar el hash" << std::endl;
+	}
+}
+
+/**
+ * @brief Lee un hash por bloques desde un archivo .hash
+ *
+ * Se rechaza el archivo si los índices de BLOQUE no van de 0 a n-1 en orden,
+ * si n no corresponde al tamaño y al tamaño de bloque, o si la raíz guardada
+ * no es la que resulta de las hojas.
+ *
+ * @param rutaHashArchivo Ruta al archivo de hash
+ * @param hash Salida: hash leído
+ * @return bool true si el archivo tiene un hash por bloques completo y coherente
+ */
+bool Utilidades::leerHashMerkle(const std::string& rutaHashArchivo, HashMerkle& hash) {
+	std::ifstream archivoHash(rutaHashArchivo);
+	if (!archivoHash) {
+		return false;
+	}
+
+	HashMerkle leido;
+	bool cabeceraLeida = false;
+	std::string linea;
+	while (std::getline(archivoHash, linea)) {
+		if (linea.empty() || linea[0] == '#') {
+			continue;
+		}
+
+		if (!cabeceraLeida) {
+			// MERKLE-ALGORITMO:raiz-tamaño
+			size_t dosPuntos = linea.find(':');
+			size_t guion = linea.rfind('-');
+			if (linea.compare(0, 7, "MERKLE-") != 0 || dosPuntos == std::string::npos ||
+				guion == std::string::npos || guion < dosPuntos ||
+				!Hash::algoritmoDesdeNombre(linea.substr(7, dosPuntos - 7), leido.algoritmo)) {
+				return false;
+			}
+			leido.raiz = linea.substr(dosPuntos + 1, guion - dosPuntos - 1);
+			try {
+				leido.tamanio = std::stoull(linea.substr(guion + 1));
+			}
+			catch (...) {
+				return false;
+			}
+			cabeceraLeida = true;
+		}
+		else if (linea.compare(0, 11, "TAM_BLOQUE:") == 0) {
+			try {
+				leido.tamBloque = static_cast<uint32_t>(std::stoul(linea.substr(11)));
+			}
+			catch (...) {
+				return false;
+			}
+		}
+		else if (linea.compare(0, 7, "BLOQUE:") == 0) {
+			// BLOQUE:indice:hash, con los índices en orden desde 0
+			size_t separador = linea.find(':', 7);
+			if (separador == std::string::npos ||
+				linea.compare(7, separador - 7, std::to_string(leido.bloques.size())) != 0) {
+				return false;
+			}
+			leido.bloques.push_back(linea.substr(separador + 1));
+		}
+	}
+
+	if (!cabeceraLeida || leido.tamBloque == 0) {
+		return false;
+	}
+	uint64_t bloquesEsperados = (leido.tamanio + leido.tamBloque - 1) / leido.tamBloque;
+	if (leido.bloques.size() != bloquesEsperados ||
+		Hash::raizMerkle(leido.bloques, leido.algoritmo) != leido.raiz) {
+		return false;
+	}
+
+	hash = std::move(leido);
+	return true;
+}
+
+/**
+ * @brief Verifica un archivo contra un hash por bloques
+ *
+ * Los bloques se resumen en paralelo y los que no coinciden se agrupan en
+ * rangos de bytes contiguos para informar exactamente qué partes cambiaron.
+ *
+ * @param rutaArchivo Ruta al archivo a verificar
+ * @param esperado Hash por bloques de referencia
+ * @return bool true si todos los bloques coinciden
+ */
+bool Utilidades::verificarHashMerkle(const std::string& rutaArchivo, const HashMerkle& esperado) {
+	std::vector<uint64_t> alterados;
+	if (!Hash::compararMerkle(rutaArchivo, esperado, alterados)) {
+		std::cout << "Error: El archivo no existe." << std::endl;
+		return false;
+	}
+
+	if (alterados.empty()) {
+		std::cout << "Hash verificado exitosamente." << std::endl;
+		std::cout << "  • Raiz: " << esperado.raiz << std::endl;
+		std::cout << "  • Bloques verificados: " << esperado.bloques.size()
+			<< " de " << esperado.tamBloque << " bytes" << std::endl;
+		return true;
+	}
+
+	std::cout << "¡ADVERTENCIA! " << alterados.size() << " bloque(s) no coinciden." << std::endl;
+	// Los bloques sobrantes o faltantes están en el archivo más largo de los dos
+	std::ifstream archivo(rutaArchivo, std::ios::binary | std::ios::ate);
+	uint64_t tamanioActual = archivo ? static_cast<uint64_t>(archivo.tellg()) : 0;
+	mostrarRangosBloques(alterados, esperado.tamBloque, std::max(tamanioActual, esperado.tamanio));
+	return false;
+}
+
+/**
+ * @brief Muestra bloques como rangos de bytes, agrupando los consecutivos
+ *
+ * @param bloques Índices de bloque en orden creciente
+ * @param tamBloque Tamaño de bloque en bytes
+ * @param tamanio Tamaño del archivo; el último bloque suele ser más corto
+ */
+void Utilidades::mostrarRangosBloques(const std::vector<uint64_t>& bloques, uint32_t tamBloque, uint64_t tamanio) {
+	size_t i = 0;
+	while (i < bloques.size()) {
+		// Agrupar bloques consecutivos en un solo rango
+		size_t j = i;
+		while (j + 1 < bloques.size() && bloques[j + 1] == bloques[j] + 1) {
+			++j;
+		}
+		uint64_t inicio = bloques[i] * tamBloque;
+		uint64_t fin = std::min<uint64_t>((bloques[j] + 1) * tamBloque, tamanio);
+		std::cout << "  • Bloques " << bloques[i] << "-" << bloques[j]
+			<< ": bytes " << inicio << " a " << fin - 1 << std::endl;
+		i = j + 1;
+	}
+}
+
+/**
+ * @brief Verifica todos los archivos de un directorio que tienen un archivo .hash
+ *
+ * Admite hashes simples y por bloques. Los archivos cuya ruta, tamaño y fecha
+ * coinciden con la caché se verifican sin leerlos; el resto se recalcula y se
+ * agrega a la caché.
+ *
+ * @param directorio Directorio con los respaldos
+ * @param cache Caché de hashes
+ * @return size_t Número de archivos alterados o que no pudieron verificarse
+ */
+size_t Utilidades::verificarDirectorio(const std::string& directorio, CacheHash& cache) {
+	MEDIR_OPERACION(Operacion::VerificarDirectorio);
+	auto inicio = std::chrono::steady_clock::now();
+	size_t aciertosIniciales = cache.getAciertos();
+	size_t fallosIniciales = cache.getFallos();
+
+	std::vector<std::string> archivos = CacheHash::listarArchivosConHash(directorio);
+	if (archivos.empty()) {
+		std::cout << "No hay archivos con hash en: " << directorio << std::endl;
+		return 0;
+	}
+
+	size_t correctos = 0;
+	size_t problemas = 0;
+	for (const auto& rutaArchivo : archivos) {
+		std::string nombre = rutaArchivo.substr(rutaArchivo.find_last_of("\\/") + 1);
+		std::string hashGuardado = leerHashArchivo(rutaArchivo + ".hash");
+		std::string estado;
+		bool desdeCache = false;
+
+		if (hashGuardado.empty()) {
+			estado = "SIN HASH";
+		}
+		else if (hashGuardado.compare(0, 7, "MERKLE-") == 0) {
+			HashMerkle esperado;
+			if (!leerHashMerkle(rutaArchivo + ".hash", esperado)) {
+				estado = "HASH INVALIDO";
+			}
+			else {
+				// Solo se guarda la raiz: si coincide, todos los bloques coinciden
+				std::string etiqueta = std::string("MERKLE-") + Hash::nombreAlgoritmo(esperado.algoritmo) +
+					"/" + std::to_string(esperado.tamBloque);
+				std::string actual = cache.obtener(rutaArchivo, etiqueta, [&]() {
+					HashMerkle calculado;
+					if (!Hash::calcularMerkle(rutaArchivo, esperado.algoritmo, esperado.tamBloque, calculado)) {
+						return std::string();
+					}
+					return calculado.raiz + "-" + std::to_string(calculado.tamanio);
+				}, &desdeCache);
+				if (actual.empty()) {
+					estado = "NO ENCONTRADO";
+				}
+				else {
+					estado = actual == esperado.raiz + "-" + std::to_string(esperado.tamanio) ? "OK" : "ALTERADO";
+				}
+			}
+		}
+		else {
+			std::string actual = calcularHashComparable(rutaArchivo, hashGuardado, &cache, desdeCache);
+			if (actual == "ERROR_ARCHIVO_NO_ENCONTRADO") {
+				estado = "NO ENCONTRADO";
+			}
+			else {
+				estado = actual == hashGuardado ? "OK" : "ALTERADO";
+			}
+		}
+
+		if (estado == "OK") {
+			++correctos;
+		}
+		else {
+			++problemas;
+		}
+		std::cout << "  [" << estado << "] " << nombre << (desdeCache ? " (cache)" : "") << std::endl;
+	}
+
+	auto duracion = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - inicio);
+	std::cout << std::endl;
+	std::cout << "Archivos verificados: " << archivos.size() << " (" << correctos << " correctos, "
+		<< problemas << " con problemas)" << std::endl;
+	std::cout << "Cache: " << cache.getAciertos() - aciertosIniciales << " aciertos, "
+		<< cache.getFallos() - fallosIniciales << " recalculados" << std::endl;
+	std::cout << "Tiempo: " << duracion.count() << " ms" << std::endl;
+	return problemas;
+}
+
+#ifdef _WIN32
 /**
  * @brief Presenta datos usando una estructura de árbol B para visualización
  *
@@ -767,40 +1159,10 @@ void Utilidades::PorArbolB(NodoPersona* cabeza) {
 		return;
 	}
 
-	// Función local para mostrar menú sin parpadeo
-	auto mostrarMenuCriterios = [&criterios, &selCriterio]() {
-		system("cls");
-		std::cout << "=== ARBOL B DIDACTICO ===" << std::endl;
-		std::cout << "Seleccione criterio de ordenamiento:" << std::endl;
-
-		for (size_t i = 0; i < criterios.size(); i++) {
-			if (i == selCriterio)
-				std::cout << " > " << criterios[i] << std::endl;
-			else
-				std::cout << "   " << criterios[i] << std::endl;
-		}
-		};
-
-	// Menú inicial
-	mostrarMenuCriterios();
-
-	// Navegación del menú
-	while (true) {
-		int tecla = _getch();
-
-		if (tecla == 224) {
-			tecla = _getch();
-			if (tecla == 72) // Flecha arriba
-				selCriterio = (static_cast<unsigned long long>(selCriterio) - 1 + criterios.size()) % criterios.size();
-			else if (tecla == 80) // Flecha abajo
-				selCriterio = (static_cast<unsigned long long>(selCriterio) + 1) % criterios.size();
-
-			// Redibujar todo el menú
-			mostrarMenuCriterios();
-		}
-		else if (tecla == 13) break; // Enter
-		else if (tecla == 27) return; // ESC
-	}
+	// Menú de criterios: cada flecha redibuja solo las dos opciones afectadas
+	MenuConsola menuCriterios("=== ARBOL B DIDACTICO ===\nSeleccione criterio de ordenamiento:\n", criterios);
+	selCriterio = menuCriterios.seleccionar(-1);
+	if (selCriterio < 0) return; // ESC
 
 	// Resto del código para definir comparadores, construir árbol, etc...
 	std::function<bool(const Persona*, const Persona*)> criterioOrdenamiento;
@@ -978,11 +1340,23 @@ bool Utilidades::generarQR(const Persona& persona, const std::string& numeroCuen
 		// Opciones para el QR
 		std::string opcionesQRGen[] = {
 			"Generar PDF del QR",
+			"Guardar QR como texto",
 			"Volver al menu principal"
 		};
 		int numOpcionesQRGen = sizeof(opcionesQRGen) / sizeof(opcionesQRGen[0]);
 		int seleccionQRGen = 0;
 
+		// Crear nombre del archivo
+		std::string nombreArchivo = "QR_" +
+			persona.getNombres() + "_" +
+			persona.getApellidos();
+
+		// Reemplazar espacios con guiones bajos
+		std::replace(nombreArchivo.begin(), nombreArchivo.end(), ' ', '_');
+
+		// Ruta especifica para guardar
+		std::string rutaBase = "C:\\Users\\Uriel Andrade\\Desktop\\BancoApp\\Codigos QR";
+
 		while (true) {
 			std::cout << "\n=== OPCIONES ===\n";
 			for (int i = 0; i < numOpcionesQRGen; i++) {
@@ -1001,22 +1375,13 @@ bool Utilidades::generarQR(const Persona& persona, const std::string& numeroCuen
 					seleccionQRGen = (seleccionQRGen + 1) % numOpcionesQRGen;
 			}
 			else if (teclaQRGen == 13) { // ENTER
-				if (seleccionQRGen == 0) { // Generar PDF
-					// Crear nombre del archivo
-					std::string nombreArchivo = "QR_" +
-						persona.getNombres() + "_" +
-						persona.getApellidos();
-
-					// Reemplazar espacios con guiones bajos
-					std::replace(nombreArchivo.begin(), nombreArchivo.end(), ' ', '_');
-
-					// Ruta especifica para guardar
-					std::string rutaBase = "C:\\Users\\Uriel Andrade\\Desktop\\BancoApp\\Codigos QR";
-
+				if (seleccionQRGen == 0 || seleccionQRGen == 1) {
 					// Crear directorio si no existe
 					std::string comando = "mkdir \"" + rutaBase + "\" 2>nul";
 					system(comando.c_str());
+				}
 
+				if (seleccionQRGen == 0) { // Generar PDF
 					// Ruta completa del archivo
 					std::string rutaCompleta = rutaBase + "\\" + nombreArchivo + ".pdf";
 
@@ -1026,6 +1391,15 @@ bool Utilidades::generarQR(const Persona& persona, const std::string& numeroCuen
 					std::cout << "\nArchivo PDF guardado exitosamente en:\n" << rutaCompleta << std::endl;
 					system("pause");
 				}
+				else if (seleccionQRGen == 1) { // Guardar como texto
+					// Medios bloques sin colores: se ve igual en cualquier editor con UTF-8
+					std::string rutaCompleta = rutaBase + "\\" + nombreArchivo + ".txt";
+					if (CodigoQR::RenderizadorTextoQR::guardar(qr.qr, rutaCompleta, CodigoQR::ModoTextoQR::MEDIOS_BLOQUES))
+						std::cout << "\nArchivo de texto guardado exitosamente en:\n" << rutaCompleta << std::endl;
+					else
+						std::cout << "\nNo se pudo guardar el archivo:\n" << rutaCompleta << std::endl;
+					system("pause");
+				}
 				else { // Volver al menu
 					return true;
 				}
@@ -1044,6 +1418,7 @@ bool Utilidades::generarQR(const Persona& persona, const std::string& numeroCuen
 
 	return true;
 }
+#endif
 
 
 
@@ -1082,31 +1457,14 @@ static std::string formatearCentavosAMonetario(int valorEnCentavos) {
 template<typename T>
 void mostrarMenuOrdenar(std::vector<T*>& vec, const std::vector<std::string>& opciones, const std::vector<std::function<bool(const T*, const T*)>>& criterios, std::function<void(const std::vector<T*>&)> mostrarDatos)
 {
-	int seleccion = 0;
+	MenuConsola menu("Ordenar por:\n", opciones, "\nESC para salir\n");
 	while (true) {
-		system("cls");
-		std::cout << "Ordenar por:\n";
-		for (size_t i = 0; i < opciones.size(); ++i) {
-			if (i == seleccion)
-				std::cout << " > " << opciones[i] << "\n";
-			else
-				std::cout << "   " << opciones[i] << "\n";
-		}
-		std::cout << "\nESC para salir\n";
-
-		int tecla = _getch();
-		if (tecla == 224) {
-			tecla = _getch();
-			if (tecla == 72) seleccion = (static_cast<unsigned long long>(seleccion) - 1 + opciones.size()) % opciones.size();
-			else if (tecla == 80) seleccion = (static_cast<unsigned long long>(seleccion) + 1) % opciones.size();
-		}
-		else if (tecla == 13) {
-			Utilidades::burbuja<T>(vec, criterios[seleccion]);
-			mostrarDatos(vec);
-			system("pause");
-		}
-		else if (tecla == 27) {
+		int seleccion = menu.seleccionar(-1);
+		if (seleccion < 0) { // ESC
 			break;
 		}
+		Utilidades::burbuja<T>(vec, criterios[seleccion]);
+		mostrarDatos(vec);
+		system("pause");
 	}
 }
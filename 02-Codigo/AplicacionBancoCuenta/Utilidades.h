@@ -9,6 +9,8 @@
 #include <sstream>
 #include <iomanip>
 #include "CodigoQR.h"
+#include "Hash.h"
+#include "CacheHash.h"
 
 
 class NodoPersona;
@@ -147,17 +149,35 @@ public:
 	/**
 	 * @brief Calcula el hash SHA1 de un archivo
 	 * @param rutaArchivo Ruta del archivo
-	 * @return Hash SHA1 calculado como cadena hexadecimal
+	 * @return Hash etiquetado con el formato "SHA1:hexadecimal-tamao"
 	 */
 	static std::string calcularSHA1(const std::string& rutaArchivo);
 
 	/**
-	 * @brief Verifica si un archivo tiene el hash SHA1 esperado
+	 * @brief Calcula el hash SHA256 de un archivo
+	 * @param rutaArchivo Ruta del archivo
+	 * @return Hash etiquetado con el formato "SHA256:hexadecimal-tamao"
+	 */
+	static std::string calcularSHA256(const std::string& rutaArchivo);
+
+	/**
+	 * @brief Calcula el hash de un archivo con el algoritmo indicado
+	 * @param rutaArchivo Ruta del archivo
+	 * @param algoritmo Algoritmo de resumen a utilizar
+	 * @return Hash etiquetado "ALGORITMO:hexadecimal-tamao" o "ERROR_ARCHIVO_NO_ENCONTRADO"
+	 */
+	static std::string calcularHash(const std::string& rutaArchivo, AlgoritmoHash algoritmo);
+
+	/**
+	 * @brief Verifica si un archivo tiene el hash esperado (SHA-1 o SHA-256)
 	 * @param rutaArchivo Ruta del archivo a verificar
-	 * @param hashEsperado Hash SHA1 esperado
+	 * @param hashEsperado Hash esperado; su etiqueta ("SHA1:" o "SHA256:") indica el algoritmo a usar
+	 * @param cache Cach de hashes opcional; si el archivo no cambi no se vuelve a leer
 	 * @return true si el hash coincide, false en caso contrario
+	 *
+	 * Los hashes sin etiqueta (formato anterior) se verifican con el algoritmo antiguo.
 	 */
-	static bool verificarSHA1(const std::string& rutaArchivo, const std::string& hashEsperado);
+	static bool verificarHash(const std::string& rutaArchivo, const std::string& hashEsperado, CacheHash* cache = nullptr);
 
 	/**
 	 * @brief Guarda el hash de un archivo en otro archivo
@@ -173,6 +193,46 @@ public:
 	 */
 	static std::string leerHashArchivo(const std::string& rutaHashArchivo);
 
+	/**
+	 * @brief Guarda un hash por bloques (rbol de Merkle) en el archivo .hash
+	 * @param rutaArchivo Ruta del archivo cuyo hash se guarda
+	 * @param hash Hash por bloques con la raz y la lista de bloques
+	 */
+	static void guardarHashMerkle(const std::string& rutaArchivo, const HashMerkle& hash);
+
+	/**
+	 * @brief Lee un hash por bloques desde un archivo .hash
+	 * @param rutaHashArchivo Ruta del archivo que contiene el hash
+	 * @param hash Salida: hash por bloques ledo
+	 * @return true si el archivo contiene un hash por bloques vlido: ndices 0..n-1 en
+	 *         orden, n acorde al tamao y una raz que coincide con las hojas
+	 */
+	static bool leerHashMerkle(const std::string& rutaHashArchivo, HashMerkle& hash);
+
+	/**
+	 * @brief Verifica un archivo contra un hash por bloques e informa los rangos alterados
+	 * @param rutaArchivo Ruta del archivo a verificar
+	 * @param esperado Hash por bloques de referencia
+	 * @return true si todos los bloques coinciden, false en caso contrario
+	 */
+	static bool verificarHashMerkle(const std::string& rutaArchivo, const HashMerkle& esperado);
+
+	/**
+	 * @brief Muestra bloques como rangos de bytes, agrupando los consecutivos
+	 * @param bloques ndices de bloque en orden creciente
+	 * @param tamBloque Tamao de bloque en bytes
+	 * @param tamanio Tamao del archivo; el ltimo rango no pasa de l
+	 */
+	static void mostrarRangosBloques(const std::vector<uint64_t>& bloques, uint32_t tamBloque, uint64_t tamanio);
+
+	/**
+	 * @brief Verifica todos los archivos de un directorio que tienen un archivo .hash
+	 * @param directorio Directorio con los respaldos
+	 * @param cache Cach de hashes usada para no releer los archivos sin cambios
+	 * @return Nmero de archivos alterados o sin poder verificar
+	 */
+	static size_t verificarDirectorio(const std::string& directorio, CacheHash& cache);
+
 	/**
 	 * @brief Muestra una demostracin didctica de rbol B con personas
 	 * @param cabeza Puntero al primer nodo de personas
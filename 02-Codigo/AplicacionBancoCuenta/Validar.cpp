@@ -7,14 +7,250 @@
  * Las validaciones estn organizadas por categoras para facilitar su uso.
  */
 #include "Validar.h"
-#include <regex>
+#include <algorithm>
 #include <cctype>
+#include "Fecha.h"
 #include <iostream>
+#ifdef _WIN32
 #include <conio.h>
 #include <Windows.h>
+#endif
 #include <sstream>
 #include <iomanip>
 #include <fstream>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define VALIDAR_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace {
+    /**
+     * @brief Indica si un carcter es un dgito ASCII, igual que [0-9] en una expresin regular
+     */
+    inline bool esDigitoAscii(char c) {
+        return c >= '0' && c <= '9';
+    }
+
+    /**
+     * @brief Comprueba el formato ^[0-9]+(\\.[0-9]{1,2})?$ recorriendo la cadena una vez
+     *
+     * @param texto Cadena a comprobar
+     * @return bool true si son dgitos seguidos opcionalmente de un punto y uno o dos decimales
+     */
+    bool tieneFormatoDosDecimales(const std::string& texto) {
+        const size_t longitud = texto.size();
+        size_t i = 0;
+        while (i < longitud && esDigitoAscii(texto[i])) {
+            ++i;
+        }
+        if (i == 0) {
+            return false;
+        }
+        if (i == longitud) {
+            return true;
+        }
+        if (texto[i] != '.') {
+            return false;
+        }
+        const size_t decimales = longitud - i - 1;
+        if (decimales < 1 || decimales > 2) {
+            return false;
+        }
+        for (++i; i < longitud; ++i) {
+            if (!esDigitoAscii(texto[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Lee un campo numrico de una fecha a partir de la posicin indicada
+     *
+     * @param texto Cadena que contiene la fecha
+     * @param posicion Posicin de inicio; al volver queda tras el ltimo dgito ledo
+     * @param minimoDigitos Cantidad mnima de dgitos del campo
+     * @param maximoDigitos Cantidad mxima de dgitos del campo
+     * @param valor Valor ledo
+     * @return bool true si el campo tiene entre minimoDigitos y maximoDigitos dgitos
+     */
+    bool leerCampoFecha(const std::string& texto, size_t& posicion, size_t minimoDigitos, size_t maximoDigitos, int& valor) {
+        const size_t inicio = posicion;
+        valor = 0;
+        while (posicion < texto.size() && esDigitoAscii(texto[posicion])) {
+            if (posicion - inicio == maximoDigitos) {
+                return false;
+            }
+            valor = valor * 10 + (texto[posicion] - '0');
+            ++posicion;
+        }
+        return posicion - inicio >= minimoDigitos;
+    }
+
+    // ----- Reglas de cdula y nmero de cuenta sobre un registro de 10 caracteres -----
+
+    /**
+     * @brief Aplica las reglas de ValidarCedula a 10 caracteres, sin reservar memoria
+     */
+    bool cedulaValidaEscalar(const unsigned char* registro) {
+        int suma = 0;
+        bool iguales = true;
+        for (int i = 0; i < 10; ++i) {
+            const unsigned digito = registro[i] - static_cast<unsigned>('0');
+            if (digito > 9) {
+                return false;
+            }
+            iguales = iguales && registro[i] == registro[0];
+            if (i < 9) {
+                // Coeficientes 2, 1, 2, 1...; si el producto es de dos cifras se resta 9
+                int producto = (i % 2 == 0) ? static_cast<int>(digito) * 2 : static_cast<int>(digito);
+                suma += producto >= 10 ? producto - 9 : producto;
+            }
+        }
+        const int provincia = (registro[0] - '0') * 10 + (registro[1] - '0');
+        const int resultado = suma % 10;
+        const int verificador = resultado == 0 ? 0 : 10 - resultado;
+        return !iguales && provincia >= 1 && provincia <= 24 && registro[2] <= '5' && verificador == registro[9] - '0';
+    }
+
+    /**
+     * @brief Comprueba 10 dgitos y el verificador de nmero de cuenta, sin reservar memoria
+     */
+    bool cuentaValidaEscalar(const unsigned char* registro) {
+        int suma = 0;
+        for (int i = 0; i < 10; ++i) {
+            const unsigned digito = registro[i] - static_cast<unsigned>('0');
+            if (digito > 9) {
+                return false;
+            }
+            if (i < 9) {
+                suma += static_cast<int>(digito);
+            }
+        }
+        return suma % 10 == registro[9] - '0';
+    }
+
+#ifdef VALIDAR_SSE2
+    /**
+     * @brief Resta '0' a los 16 bytes ledos y marca cules de los 10 primeros son dgitos
+     * @param registro Registro del que se pueden leer 16 bytes
+     * @param digitos Valor de cada byte menos '0'
+     * @return Mscara de 10 bits con un 1 por cada dgito
+     */
+    inline int cargarDigitosSSE2(const unsigned char* registro, __m128i& digitos) {
+        digitos = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(registro)), _mm_set1_epi8('0'));
+        // Es dgito si, como byte sin signo, no supera 9
+        const __m128i esDigito = _mm_cmpeq_epi8(_mm_min_epu8(digitos, _mm_set1_epi8(9)), digitos);
+        return _mm_movemask_epi8(esDigito) & 0x3FF;
+    }
+
+    /**
+     * @brief Suma los bytes de las nueve primeras posiciones
+     */
+    inline int sumarNueveSSE2(__m128i valores) {
+        const __m128i nueve = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0);
+        const __m128i sumas = _mm_sad_epu8(_mm_and_si128(valores, nueve), _mm_setzero_si128());
+        return _mm_cvtsi128_si32(sumas) + _mm_extract_epi16(sumas, 4);
+    }
+
+    /**
+     * @brief cedulaValidaEscalar con los 10 dgitos en un registro SSE2
+     *
+     * Comprueba los dgitos, los productos por los coeficientes y la igualdad con
+     * el primer dgito en paralelo; exige poder leer 16 bytes desde el registro.
+     */
+    inline bool cedulaValidaSSE2(const unsigned char* registro) {
+        __m128i digitos;
+        const int mascaraDigitos = cargarDigitosSSE2(registro, digitos);
+
+        // Coeficiente 2 en las posiciones pares: se suma el dgito consigo mismo
+        const __m128i pares = _mm_setr_epi8(-1, 0, -1, 0, -1, 0, -1, 0, -1, 0, 0, 0, 0, 0, 0, 0);
+        __m128i productos = _mm_add_epi8(digitos, _mm_and_si128(digitos, pares));
+        const __m128i nueve = _mm_set1_epi8(9);
+        productos = _mm_sub_epi8(productos, _mm_and_si128(_mm_cmpgt_epi8(productos, nueve), nueve));
+        const int suma = sumarNueveSSE2(productos);
+
+        const __m128i iguales = _mm_cmpeq_epi8(digitos, _mm_set1_epi8(static_cast<char>(registro[0] - '0')));
+        const int mascaraIguales = _mm_movemask_epi8(iguales) & 0x3FF;
+
+        const int provincia = (registro[0] - '0') * 10 + (registro[1] - '0');
+        const int resultado = suma % 10;
+        const int verificador = resultado == 0 ? 0 : 10 - resultado;
+        return mascaraDigitos == 0x3FF && mascaraIguales != 0x3FF && provincia >= 1 && provincia <= 24 &&
+            registro[2] <= '5' && verificador == registro[9] - '0';
+    }
+
+    /**
+     * @brief cuentaValidaEscalar con los 10 dgitos en un registro SSE2
+     */
+    inline bool cuentaValidaSSE2(const unsigned char* registro) {
+        __m128i digitos;
+        const int mascaraDigitos = cargarDigitosSSE2(registro, digitos);
+        return mascaraDigitos == 0x3FF && sumarNueveSSE2(digitos) % 10 == registro[9] - '0';
+    }
+#endif
+
+    /**
+     * @brief Recorre un lote de registros de ancho fijo y llena el mapa de resultados
+     *
+     * Los registros de los que se pueden leer 16 bytes sin salir del lote usan la
+     * versin SSE2; los ltimos, la escalar. Cada palabra del mapa se arma en un
+     * registro y se escribe una sola vez.
+     */
+    template <bool (*Escalar)(const unsigned char*), bool (*Vectorial)(const unsigned char*)>
+    size_t validarLote(const char* datos, size_t cantidad, size_t paso, uint64_t* mapa) {
+        const unsigned char* registro = reinterpret_cast<const unsigned char*>(datos);
+        const size_t ultimosEscalares = (6 + paso - 1) / paso;
+        const size_t vectoriales = cantidad > ultimosEscalares ? cantidad - ultimosEscalares : 0;
+        size_t validos = 0;
+
+        for (size_t inicio = 0; inicio < cantidad; inicio += 64) {
+            const size_t fin = std::min(cantidad, inicio + 64);
+            uint64_t palabra = 0;
+            for (size_t i = inicio; i < fin; ++i, registro += paso) {
+                const bool valido = i < vectoriales ? Vectorial(registro) : Escalar(registro);
+                palabra |= static_cast<uint64_t>(valido) << (i - inicio);
+                validos += valido;
+            }
+            mapa[inicio / 64] = palabra;
+        }
+        return validos;
+    }
+
+    /**
+     * @brief Valida un vector de cadenas copindolas en bloques de 64 registros de 16 bytes
+     *
+     * Las cadenas que no tienen 10 caracteres quedan como invlidas sin copiarse.
+     */
+    template <bool (*Escalar)(const unsigned char*), bool (*Vectorial)(const unsigned char*)>
+    std::vector<uint64_t> validarLoteCadenas(const std::vector<std::string>& cadenas) {
+        std::vector<uint64_t> mapa((cadenas.size() + 63) / 64, 0);
+        char bloque[65 * 16] = {};
+        size_t posiciones[64];
+
+        for (size_t inicio = 0; inicio < cadenas.size(); inicio += 64) {
+            const size_t fin = std::min(cadenas.size(), inicio + 64);
+            size_t copiados = 0;
+            for (size_t i = inicio; i < fin; ++i) {
+                if (cadenas[i].size() == 10) {
+                    std::memcpy(bloque + copiados * 16, cadenas[i].data(), 10);
+                    posiciones[copiados++] = i - inicio;
+                }
+            }
+            // Un registro de relleno al final permite leer 16 bytes del ltimo copiado
+            uint64_t resultados[2];
+            validarLote<Escalar, Vectorial>(bloque, copiados + 1, 16, resultados);
+            uint64_t palabra = 0;
+            for (size_t j = 0; j < copiados; ++j) {
+                palabra |= ((resultados[0] >> j) & 1) << posiciones[j];
+            }
+            mapa[inicio / 64] = palabra;
+        }
+        return mapa;
+    }
+}
 
  /**
   * @brief Valida que un nmero de cuenta tenga el formato correcto
@@ -46,8 +282,7 @@ bool Validar::ValidarNumeroCuenta(const std::string numero) {
  * @return bool true si el saldo es vlido, false en caso contrario
  */
 bool Validar::ValidarSaldo(const std::string& saldoStr) {
-    std::regex regex("^[0-9]+(\\.[0-9]{1,2})?$");
-    if (!std::regex_match(saldoStr, regex)) {
+    if (!tieneFormatoDosDecimales(saldoStr)) {
         return false;
     }
     try {
@@ -71,8 +306,7 @@ bool Validar::ValidarSaldo(const std::string& saldoStr) {
  * @return bool true si el estado es vlido, false en caso contrario
  */
 bool Validar::ValidarEstadoCuenta(const std::string& estado) {
-    std::regex regex("^(Activa|Inactiva)$");
-    return std::regex_match(estado, regex);
+    return estado == "Activa" || estado == "Inactiva";
 }
 
 /**
@@ -84,8 +318,7 @@ bool Validar::ValidarEstadoCuenta(const std::string& estado) {
  * @return bool true si el tipo es vlido, false en caso contrario
  */
 bool Validar::ValidarTipoCuenta(const std::string& tipo) {
-    std::regex regex("^(Ahorros|Corriente)$");
-    return std::regex_match(tipo, regex);
+    return tipo == "Ahorros" || tipo == "Corriente";
 }
 
 /**
@@ -97,8 +330,7 @@ bool Validar::ValidarTipoCuenta(const std::string& tipo) {
  * @return bool true si el tipo es vlido, false en caso contrario
  */
 bool Validar::ValidarTipoTransaccion(const std::string& tipo) {
-    std::regex regex("^(Retiro|Deposito)$");
-    return std::regex_match(tipo, regex);
+    return tipo == "Retiro" || tipo == "Deposito";
 }
 
 /**
@@ -123,17 +355,16 @@ bool Validar::ValidarMontoTransaccion(int saldo) {
  * @return bool true si la fecha es vlida, false en caso contrario
  */
 bool Validar::ValidarFecha(const std::string& fecha) {
-    // Validar formato dd/mm/aaaa
-    std::regex regex("^([0]?[1-9]|[12][0-9]|3[01])/([0]?[1-9]|1[0-2])/([0-9]{4})$");
-    if (!std::regex_match(fecha, regex)) {
-        return false;
-    }
-
-    // Extraer dia, mes y ao
+    // Validar formato dd/mm/aaaa y extraer dia, mes y ao en una sola pasada:
+    // dia y mes de uno o dos digitos, ao de cuatro
     int dia, mes, anio;
-    if (sscanf_s(fecha.c_str(), "%d/%d/%d", &dia, &mes, &anio) != 3) {
+    size_t posicion = 0;
+    if (!leerCampoFecha(fecha, posicion, 1, 2, dia) || posicion == fecha.size() || fecha[posicion++] != '/' ||
+        !leerCampoFecha(fecha, posicion, 1, 2, mes) || posicion == fecha.size() || fecha[posicion++] != '/' ||
+        !leerCampoFecha(fecha, posicion, 4, 4, anio) || posicion != fecha.size()) {
         return false;
     }
+    if (dia < 1 || dia > 31) return false;
 
     // Validar ao razonable
     if (anio < 1900) return false;
@@ -150,11 +381,10 @@ bool Validar::ValidarFecha(const std::string& fecha) {
     if (dia < 1 || dia > diasMes[mes - 1]) return false;
 
     // Obtener fecha actual del sistema
-    SYSTEMTIME st;
-    GetLocalTime(&st);
-    int diaActual = st.wDay;
-    int mesActual = st.wMonth;
-    int anioActual = st.wYear;
+    std::tm hoy = Fecha::horaLocal(std::time(nullptr));
+    int diaActual = hoy.tm_mday;
+    int mesActual = hoy.tm_mon + 1;
+    int anioActual = hoy.tm_year + 1900;
 
     // Comparar con la fecha actual
     if (anio > anioActual) return false;
@@ -175,8 +405,7 @@ bool Validar::ValidarFecha(const std::string& fecha) {
  */
 bool Validar::ValidarNumeroConDosDecimales(const std::string& monto) {
     // Permite numeros positivos, opcionalmente con hasta dos decimales
-    std::regex regex("^[0-9]+(\\.[0-9]{1,2})?$");
-    return std::regex_match(monto, regex);
+    return tieneFormatoDosDecimales(monto);
 }
 
 /**
@@ -187,6 +416,9 @@ bool Validar::ValidarNumeroConDosDecimales(const std::string& monto) {
  * @return std::string Texto contenido en el portapapeles o cadena vaca si hay error
  */
 std::string Validar::leerDesdePortapapeles() {
+#ifndef _WIN32
+    return ""; // Sin portapapeles fuera de Windows
+#else
     if (!OpenClipboard(nullptr)) return "";
     HANDLE hData = GetClipboardData(CF_TEXT);
     if (hData == nullptr) {
@@ -204,8 +436,10 @@ std::string Validar::leerDesdePortapapeles() {
     GlobalUnlock(hData);
     CloseClipboard();
     return text;
+#endif
 }
 
+#ifdef _WIN32
 /**
  * @brief Lee y valida interactivamente un nmero de cuenta
  *
@@ -237,6 +471,7 @@ std::string Validar::ValidarLeerNumeroCuenta() {
     }
     return numeroCuenta;
 }
+#endif
 
 #pragma region VALIDACIONES PARA PERSONA 
 
@@ -249,8 +484,15 @@ std::string Validar::ValidarLeerNumeroCuenta() {
  * @return bool true si el nombre es vlido, false en caso contrario
  */
 bool Validar::ValidarNombrePersona(const std::string& nombre) {
-    std::regex regex("^[a-zA-Z ]+$");
-    return std::regex_match(nombre, regex);
+    if (nombre.empty()) {
+        return false;
+    }
+    for (char c : nombre) {
+        if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == ' ')) {
+            return false;
+        }
+    }
+    return true;
 }
 
 // Validar el numero de cedula de 10 digitos, solo numeros para Ecuador 
@@ -266,46 +508,14 @@ bool Validar::ValidarNombrePersona(const std::string& nombre) {
  * @return bool true si la cdula es vlida, false en caso contrario
  */
 bool Validar::ValidarCedula(const std::string& cedula) {
-    // Paso 1: longitud y solo digitos
-    if (cedula.length() != 10 || !std::all_of(cedula.begin(), cedula.end(), ::isdigit)) {
-        return false;
-    }
-
-    // Paso 2: todos los digitos iguales (ej. 0000000000, 1111111111)
-    if (todosLosDigitosIguales(cedula)) {
+    // Paso 1: longitud; el resto de pasos se aplica sobre los 10 caracteres:
+    // solo digitos, no todos iguales (ej. 0000000000, 2222222222), codigo de
+    // provincia entre 01 y 24, tercer digito entre 0 y 5 para personas naturales
+    // y digito verificador con el algoritmo oficial
+    if (cedula.length() != 10) {
         return false;
     }
-
-    // Paso 3: validar codigo de provincia
-    int provincia = std::stoi(cedula.substr(0, 2));
-    if (provincia < 1 || provincia > 24) { // 00 no es valido
-        return false;
-    }
-
-    // Paso 4: tercer digito debe estar entre 0 y 5 para personas naturales
-    int tercerDigito = cedula[2] - '0';
-    if (tercerDigito < 0 || tercerDigito > 5) {
-        return false;
-    }
-
-    // Paso 5: validacion del digito verificador con el algoritmo oficial
-    int coeficientes[9] = { 2, 1, 2, 1, 2, 1, 2, 1, 2 };
-    int suma = 0;
-
-    for (int i = 0; i < 9; ++i) {
-        int digito = cedula[i] - '0';
-        int producto = digito * coeficientes[i];
-        if (producto >= 10) {
-            producto -= 9;
-        }
-        suma += producto;
-    }
-
-    int digitoVerificador = cedula[9] - '0';
-    int resultado = suma % 10;
-    int comparacion = (resultado == 0) ? 0 : 10 - resultado;
-
-    return comparacion == digitoVerificador;
+    return cedulaValidaEscalar(reinterpret_cast<const unsigned char*>(cedula.data()));
 } 
 
 
@@ -332,6 +542,97 @@ bool Validar::todosLosDigitosIguales(const std::string& cedula) {
 
 
 
+#pragma endregion
+
+#pragma region VALIDACIONES POR LOTES
+
+/**
+ * @brief Verifica el dgito verificador de un nmero de cuenta
+ *
+ * Debe ser la suma de los nueve primeros dgitos mdulo 10, igual que en
+ * Persona::crearNumeroCuenta.
+ *
+ * @param numero Nmero de cuenta a verificar
+ * @return bool true si tiene 10 dgitos y el verificador es correcto, false en caso contrario
+ */
+bool Validar::ValidarDigitoVerificadorCuenta(const std::string& numero) {
+    if (numero.length() != 10) {
+        return false;
+    }
+    return cuentaValidaEscalar(reinterpret_cast<const unsigned char*>(numero.data()));
+}
+
+/**
+ * @brief Valida un lote de cdulas de ancho fijo
+ *
+ * Pensado para importaciones masivas: no reserva memoria y, en x86, revisa los
+ * 10 dgitos de cada cdula a la vez con SSE2.
+ *
+ * @param datos Primer carcter del primer registro
+ * @param cantidad Nmero de registros
+ * @param paso Bytes entre el inicio de un registro y el siguiente
+ * @param mapa Mapa de resultados, un bit por registro
+ * @return size_t Nmero de cdulas vlidas
+ */
+size_t Validar::ValidarCedulasLote(const char* datos, size_t cantidad, size_t paso, uint64_t* mapa) {
+    if (paso < 10) {
+        throw std::invalid_argument("El paso entre cedulas debe ser de al menos 10 caracteres");
+    }
+#ifdef VALIDAR_SSE2
+    return validarLote<cedulaValidaEscalar, cedulaValidaSSE2>(datos, cantidad, paso, mapa);
+#else
+    return validarLote<cedulaValidaEscalar, cedulaValidaEscalar>(datos, cantidad, paso, mapa);
+#endif
+}
+
+/**
+ * @brief Valida un lote de cdulas dadas como cadenas
+ *
+ * @param cedulas Cdulas a validar
+ * @return std::vector<uint64_t> Mapa de resultados, un bit por cdula
+ */
+std::vector<uint64_t> Validar::ValidarCedulasLote(const std::vector<std::string>& cedulas) {
+#ifdef VALIDAR_SSE2
+    return validarLoteCadenas<cedulaValidaEscalar, cedulaValidaSSE2>(cedulas);
+#else
+    return validarLoteCadenas<cedulaValidaEscalar, cedulaValidaEscalar>(cedulas);
+#endif
+}
+
+/**
+ * @brief Valida un lote de nmeros de cuenta de ancho fijo
+ *
+ * @param datos Primer carcter del primer registro
+ * @param cantidad Nmero de registros
+ * @param paso Bytes entre el inicio de un registro y el siguiente
+ * @param mapa Mapa de resultados, un bit por registro
+ * @return size_t Nmero de cuentas vlidas
+ */
+size_t Validar::ValidarNumerosCuentaLote(const char* datos, size_t cantidad, size_t paso, uint64_t* mapa) {
+    if (paso < 10) {
+        throw std::invalid_argument("El paso entre numeros de cuenta debe ser de al menos 10 caracteres");
+    }
+#ifdef VALIDAR_SSE2
+    return validarLote<cuentaValidaEscalar, cuentaValidaSSE2>(datos, cantidad, paso, mapa);
+#else
+    return validarLote<cuentaValidaEscalar, cuentaValidaEscalar>(datos, cantidad, paso, mapa);
+#endif
+}
+
+/**
+ * @brief Valida un lote de nmeros de cuenta dados como cadenas
+ *
+ * @param numeros Nmeros de cuenta a validar
+ * @return std::vector<uint64_t> Mapa de resultados, un bit por nmero
+ */
+std::vector<uint64_t> Validar::ValidarNumerosCuentaLote(const std::vector<std::string>& numeros) {
+#ifdef VALIDAR_SSE2
+    return validarLoteCadenas<cuentaValidaEscalar, cuentaValidaSSE2>(numeros);
+#else
+    return validarLoteCadenas<cuentaValidaEscalar, cuentaValidaEscalar>(numeros);
+#endif
+}
+
 #pragma endregion
 
 /**
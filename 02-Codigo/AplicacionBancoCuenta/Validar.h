@@ -6,9 +6,12 @@
 // Validar.h de cabecera de la clase Validar
 #include <iostream>
 #include <string>
-#include <regex>
+#include <vector>
+#include <cstdint>
 #include <stdexcept>
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 
 /**
  * @enum TipoEntrada
@@ -143,6 +146,70 @@ public:
     static std::string ValidarLeerNumeroCuenta();
 #pragma endregion
 
+#pragma region VALIDACIONES POR LOTES
+    /**
+     * @brief Verifica el dgito verificador de un nmero de cuenta
+     *
+     * El ltimo dgito debe ser la suma de los nueve anteriores mdulo 10,
+     * como lo genera Persona::crearNumeroCuenta.
+     *
+     * @param numero Nmero de cuenta de 10 dgitos
+     * @return true si tiene 10 dgitos y el verificador es correcto, false en caso contrario
+     */
+    static bool ValidarDigitoVerificadorCuenta(const std::string& numero);
+
+    /**
+     * @brief Valida un lote de cdulas guardadas con ancho fijo
+     *
+     * Aplica a cada registro las mismas reglas que ValidarCedula.
+     *
+     * @param datos Primer carcter del primer registro
+     * @param cantidad Nmero de registros
+     * @param paso Bytes entre el inicio de un registro y el siguiente (al menos 10)
+     * @param mapa Mapa de resultados de (cantidad + 63) / 64 palabras; el bit i % 64
+     *             de mapa[i / 64] queda en 1 si el registro i es vlido
+     * @return Nmero de registros vlidos
+     */
+    static size_t ValidarCedulasLote(const char* datos, size_t cantidad, size_t paso, uint64_t* mapa);
+
+    /**
+     * @brief Valida un lote de cdulas
+     * @param cedulas Cdulas a validar
+     * @return Mapa de resultados con un bit por cdula (ver ValidarCedulasLote)
+     */
+    static std::vector<uint64_t> ValidarCedulasLote(const std::vector<std::string>& cedulas);
+
+    /**
+     * @brief Valida un lote de nmeros de cuenta guardados con ancho fijo
+     *
+     * Aplica a cada registro las mismas reglas que ValidarDigitoVerificadorCuenta.
+     *
+     * @param datos Primer carcter del primer registro
+     * @param cantidad Nmero de registros
+     * @param paso Bytes entre el inicio de un registro y el siguiente (al menos 10)
+     * @param mapa Mapa de resultados de (cantidad + 63) / 64 palabras
+     * @return Nmero de registros vlidos
+     */
+    static size_t ValidarNumerosCuentaLote(const char* datos, size_t cantidad, size_t paso, uint64_t* mapa);
+
+    /**
+     * @brief Valida un lote de nmeros de cuenta
+     * @param numeros Nmeros de cuenta a validar
+     * @return Mapa de resultados con un bit por nmero (ver ValidarNumerosCuentaLote)
+     */
+    static std::vector<uint64_t> ValidarNumerosCuentaLote(const std::vector<std::string>& numeros);
+
+    /**
+     * @brief Consulta un resultado de un mapa de validacin por lotes
+     * @param mapa Mapa devuelto por una validacin por lotes
+     * @param indice ndice del registro
+     * @return true si el registro es vlido
+     */
+    static bool esValidoEnLote(const std::vector<uint64_t>& mapa, size_t indice) {
+        return (mapa[indice / 64] >> (indice % 64)) & 1;
+    }
+#pragma endregion
+
     /**
      * @brief Verifica si un archivo existe en el sistema
      * @param rutaArchivo Ruta completa del archivo
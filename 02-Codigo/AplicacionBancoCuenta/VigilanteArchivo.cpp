@@ -0,0 +1,229 @@
+/**
+ * @file VigilanteArchivo.cpp
+ * @brief Notificación de cambios de un archivo con inotify, FindFirstChangeNotification o consulta periódica
+ */
+#include "VigilanteArchivo.h"
+#include <chrono>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#include <fcntl.h>
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <poll.h>
+#include <cerrno>
+#include <cstring>
+#endif
+#endif
+
+/**
+ * @brief Prepara las notificaciones sobre el directorio del archivo
+ *
+ * Si no se pueden obtener, el vigilante queda en modo de consulta periódica.
+ *
+ * @param ruta Ruta del archivo
+ * @param intervaloSondeoMs Intervalo de la consulta periódica
+ */
+VigilanteArchivo::VigilanteArchivo(const std::string& ruta, int intervaloSondeoMs)
+    : ruta(ruta), intervaloSondeoMs(intervaloSondeoMs > 0 ? intervaloSondeoMs : 1000),
+      ultimaModificacion(0), notificaciones(false), cancelado(false), despertares(0) {
+    size_t separador = ruta.find_last_of("\\/");
+    std::string directorio = separador == std::string::npos ? "." : ruta.substr(0, separador + 1);
+    nombre = separador == std::string::npos ? ruta : ruta.substr(separador + 1);
+    ultimaModificacion = leerModificacion();
+
+#ifdef _WIN32
+    manejadorCambios = INVALID_HANDLE_VALUE;
+    eventoCancelar = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+    if (eventoCancelar) {
+        manejadorCambios = FindFirstChangeNotificationA(directorio.c_str(), FALSE,
+            FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME);
+        notificaciones = manejadorCambios != INVALID_HANDLE_VALUE;
+    }
+#else
+    descriptorInotify = -1;
+    tuberiaCancelar[0] = tuberiaCancelar[1] = -1;
+#ifdef __linux__
+    descriptorInotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (descriptorInotify >= 0 &&
+        inotify_add_watch(descriptorInotify, directorio.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_DELETE) >= 0 &&
+        pipe(tuberiaCancelar) == 0) {
+        fcntl(tuberiaCancelar[0], F_SETFD, FD_CLOEXEC);
+        fcntl(tuberiaCancelar[1], F_SETFD, FD_CLOEXEC);
+        notificaciones = true;
+    }
+    else if (descriptorInotify >= 0) {
+        close(descriptorInotify);
+        descriptorInotify = -1;
+    }
+#endif
+#endif
+}
+
+/**
+ * @brief Cierra los descriptores o manejadores de notificación
+ */
+VigilanteArchivo::~VigilanteArchivo() {
+#ifdef _WIN32
+    if (manejadorCambios != INVALID_HANDLE_VALUE) FindCloseChangeNotification(manejadorCambios);
+    if (eventoCancelar) CloseHandle(eventoCancelar);
+#else
+    if (descriptorInotify >= 0) close(descriptorInotify);
+    if (tuberiaCancelar[0] >= 0) close(tuberiaCancelar[0]);
+    if (tuberiaCancelar[1] >= 0) close(tuberiaCancelar[1]);
+#endif
+}
+
+/**
+ * @brief Bloquea hasta que el archivo cambie o se cancele la espera
+ *
+ * Con notificaciones el hilo duerme en el sistema sin consumir CPU y solo se
+ * despierta cuando algo cambia en el directorio.
+ *
+ * @return true si el archivo cambió, false si se llamó a cancelar()
+ */
+bool VigilanteArchivo::esperarCambio() {
+    if (!notificaciones) {
+        return esperarSondeo();
+    }
+
+#ifdef _WIN32
+    HANDLE esperas[2] = { eventoCancelar, manejadorCambios };
+    while (!cancelado) {
+        DWORD resultado = WaitForMultipleObjects(2, esperas, FALSE, INFINITE);
+        if (resultado != WAIT_OBJECT_0 + 1) {
+            return false;
+        }
+        ++despertares;
+        FindNextChangeNotification(manejadorCambios);
+        if (comprobarModificacion()) {
+            return true;
+        }
+    }
+    return false;
+#elif defined(__linux__)
+    alignas(struct inotify_event) char eventos[4096];
+    while (!cancelado) {
+        struct pollfd esperas[2] = { { tuberiaCancelar[0], POLLIN, 0 }, { descriptorInotify, POLLIN, 0 } };
+        if (poll(esperas, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue; // Interrumpido por una señal
+            }
+            // Sin poll el bucle giraría sin dormir: se sigue con la consulta periódica
+            close(descriptorInotify);
+            descriptorInotify = -1;
+            notificaciones = false;
+            return esperarSondeo();
+        }
+        if (esperas[0].revents != 0) {
+            return false;
+        }
+        ++despertares;
+
+        // Vaciar la cola y ver si algún evento es del archivo vigilado
+        bool esDelArchivo = false;
+        ssize_t leidos;
+        while ((leidos = read(descriptorInotify, eventos, sizeof(eventos))) > 0) {
+            for (char* p = eventos; p < eventos + leidos;) {
+                const struct inotify_event* evento = reinterpret_cast<const struct inotify_event*>(p);
+                if (evento->len > 0 && std::strcmp(evento->name, nombre.c_str()) == 0) {
+                    esDelArchivo = true;
+                }
+                p += sizeof(struct inotify_event) + evento->len;
+            }
+        }
+        if (esDelArchivo && comprobarModificacion()) {
+            return true;
+        }
+    }
+    return false;
+#else
+    return esperarSondeo();
+#endif
+}
+
+/**
+ * @brief Libera al hilo que espera
+ */
+void VigilanteArchivo::cancelar() {
+    cancelado = true;
+#ifdef _WIN32
+    if (eventoCancelar) SetEvent(eventoCancelar);
+#else
+    if (tuberiaCancelar[1] >= 0) {
+        char senal = 1;
+        ssize_t escritos = write(tuberiaCancelar[1], &senal, 1);
+        (void)escritos;
+    }
+#endif
+    std::lock_guard<std::mutex> lock(mtxSondeo);
+    condicionSondeo.notify_all();
+}
+
+/**
+ * @brief Lee la fecha de modificación del archivo con una sola llamada al sistema
+ *
+ * @return Marca de tiempo, o 0 si el archivo no existe
+ */
+unsigned long long VigilanteArchivo::leerModificacion() const {
+#ifdef _WIN32
+    WIN32_FILE_ATTRIBUTE_DATA atributos;
+    if (!GetFileAttributesExA(ruta.c_str(), GetFileExInfoStandard, &atributos)) {
+        return 0;
+    }
+    return (static_cast<unsigned long long>(atributos.ftLastWriteTime.dwHighDateTime) << 32) |
+        atributos.ftLastWriteTime.dwLowDateTime;
+#else
+    struct stat info;
+    if (stat(ruta.c_str(), &info) != 0) {
+        return 0;
+    }
+#ifdef __linux__
+    return static_cast<unsigned long long>(info.st_mtim.tv_sec) * 1000000000ull + info.st_mtim.tv_nsec;
+#else
+    return static_cast<unsigned long long>(info.st_mtime);
+#endif
+#endif
+}
+
+/**
+ * @brief Comprueba si la fecha de modificación cambió y la actualiza
+ *
+ * Se compara por desigualdad: un archivo reemplazado puede tener una fecha anterior.
+ *
+ * @return true si cambió
+ */
+bool VigilanteArchivo::comprobarModificacion() {
+    unsigned long long actual = leerModificacion();
+    if (actual == ultimaModificacion) {
+        return false;
+    }
+    ultimaModificacion = actual;
+    return true;
+}
+
+/**
+ * @brief Espera consultando la fecha de modificación cada intervaloSondeoMs
+ *
+ * @return true si el archivo cambió, false si se canceló la espera
+ */
+bool VigilanteArchivo::esperarSondeo() {
+    std::unique_lock<std::mutex> lock(mtxSondeo);
+    while (!cancelado) {
+        if (condicionSondeo.wait_for(lock, std::chrono::milliseconds(intervaloSondeoMs),
+            [this]() { return cancelado.load(); })) {
+            break;
+        }
+        ++despertares;
+        if (comprobarModificacion()) {
+            return true;
+        }
+    }
+    return false;
+}
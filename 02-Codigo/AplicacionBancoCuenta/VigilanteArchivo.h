@@ -0,0 +1,115 @@
+#pragma once
+#ifndef VIGILANTEARCHIVO_H
+#define VIGILANTEARCHIVO_H
+
+#include <string>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+
+/**
+ * @class VigilanteArchivo
+ * @brief Espera a que un archivo cambie sin consultarlo periódicamente
+ *
+ * Usa las notificaciones del sistema sobre el directorio del archivo: inotify en
+ * Linux y FindFirstChangeNotification en Windows. Cuando el directorio cambia se
+ * compara la fecha de modificación del archivo, de modo que los cambios de otros
+ * archivos no despiertan a quien espera. Si el sistema no ofrece notificaciones
+ * se consulta la fecha de modificación cada cierto intervalo.
+ *
+ * Un hilo llama a esperarCambio() en bucle; cualquier otro puede llamar a
+ * cancelar() para liberarlo.
+ */
+class VigilanteArchivo {
+public:
+    /**
+     * @brief Empieza a vigilar un archivo
+     * @param ruta Ruta del archivo (puede no existir todavía)
+     * @param intervaloSondeoMs Intervalo de consulta si no hay notificaciones del sistema
+     */
+    explicit VigilanteArchivo(const std::string& ruta, int intervaloSondeoMs = 1000);
+
+    /** @brief Libera los recursos de notificación */
+    ~VigilanteArchivo();
+
+    VigilanteArchivo(const VigilanteArchivo&) = delete;
+    VigilanteArchivo& operator=(const VigilanteArchivo&) = delete;
+
+    /**
+     * @brief Bloquea hasta que el archivo cambie o se cancele la espera
+     * @return true si el archivo cambió, false si se llamó a cancelar()
+     */
+    bool esperarCambio();
+
+    /**
+     * @brief Libera al hilo que espera; las esperas siguientes terminan enseguida
+     */
+    void cancelar();
+
+    /**
+     * @brief Indica si se usan notificaciones del sistema o la consulta periódica
+     * @return true si hay notificaciones del sistema
+     */
+    bool usaNotificaciones() const { return notificaciones; }
+
+    /**
+     * @brief Veces que el sistema despertó al hilo que espera
+     * @return Despertares, incluidos los que no correspondían al archivo vigilado
+     */
+    unsigned long long getDespertares() const { return despertares; }
+
+private:
+    /** @brief Ruta del archivo vigilado */
+    std::string ruta;
+
+    /** @brief Nombre del archivo sin directorio, para filtrar los eventos */
+    std::string nombre;
+
+    /** @brief Intervalo de la consulta periódica, en milisegundos */
+    int intervaloSondeoMs;
+
+    /** @brief Última fecha de modificación conocida (0 si el archivo no existe) */
+    unsigned long long ultimaModificacion;
+
+    /** @brief true si se obtuvieron notificaciones del sistema; pasa a false si poll deja de funcionar */
+    std::atomic<bool> notificaciones;
+
+    /** @brief Bandera de cancelación */
+    std::atomic<bool> cancelado;
+
+    /** @brief Contador de despertares */
+    std::atomic<unsigned long long> despertares;
+
+    /** @brief Mutex y condición de la consulta periódica */
+    std::mutex mtxSondeo;
+    std::condition_variable condicionSondeo;
+
+#ifdef _WIN32
+    /** @brief Manejador de FindFirstChangeNotification */
+    void* manejadorCambios;
+    /** @brief Evento que se señala al cancelar */
+    void* eventoCancelar;
+#else
+    /** @brief Descriptor de inotify */
+    int descriptorInotify;
+    /** @brief Tubería cuyo extremo de escritura se usa para cancelar */
+    int tuberiaCancelar[2];
+#endif
+
+    /**
+     * @brief Lee la fecha de modificación del archivo
+     * @return Marca de tiempo, o 0 si el archivo no existe
+     */
+    unsigned long long leerModificacion() const;
+
+    /**
+     * @brief Comprueba si la fecha de modificación cambió y la actualiza
+     * @return true si cambió
+     */
+    bool comprobarModificacion();
+
+    /** @brief Espera por consulta periódica */
+    bool esperarSondeo();
+};
+
+#endif // VIGILANTEARCHIVO_H
@@ -21,35 +21,44 @@
 #include <algorithm>
 #include "Marquesina.h"
 #include "CodigoQR.h"
+#include "ExportadorQR.h"
+#include "ImportadorCSV.h"
+#include "Pantalla.h"
+#include "InterpreteComandos.h"
+#include "Estadisticas.h"
+#include <sstream>
 
- /**
-  * @brief Muestra el menú principal en la consola sin parpadeo
-  *
-  * Utiliza técnicas para evitar parpadeo al actualizar la interfaz, realizando
-  * operaciones críticas y limpiando líneas completas.
-  *
-  * @param seleccion Índice de la opción seleccionada actualmente
-  * @param opciones Arreglo con las opciones del menú
-  * @param numOpciones Número total de opciones disponibles
-  * @param x Posición X donde comenzar a mostrar las opciones
-  * @param y Posición Y donde comenzar a mostrar las opciones
-  */
-static void mostrarMenu(int seleccion, std::string opciones[], int numOpciones, int x, int y) {
-	Utilidades::limpiarPantallaPreservandoMarquesina(); // Ya maneja las operaciones críticas
-	Utilidades::iniciarOperacionCritica(); // Iniciar operación crítica para evitar parpadeo
-	const int anchoLinea = 80;
-	for (int i = 0; i < numOpciones; i++) {
-		Utilidades::gotoxy(0, y + i); // Ya thread-safe
-		std::cout << std::string(anchoLinea, ' ');
-		Utilidades::gotoxy(x, y + i);
-		if (i == seleccion)
-			std::cout << " > " << opciones[i] << "   ";
-		else
-			std::cout << "   " << opciones[i] << "   ";
+/**
+ * @brief Lee una frase clave desde el teclado sin mostrarla en pantalla
+ *
+ * Muestra un asterisco por cada carácter, admite retroceso y termina con Enter.
+ *
+ * @param mensaje Texto que se muestra antes de leer la clave
+ * @return La frase clave ingresada (puede estar vacía si se presiona Enter directamente)
+ */
+static std::string leerClaveCifrado(const std::string& mensaje) {
+	std::cout << mensaje;
+	std::string clave;
+	while (true) {
+		int tecla = _getch();
+		if (tecla == 13) // Enter
+			break;
+		if (tecla == 0 || tecla == 224) { // Teclas especiales: se descarta el segundo codigo
+			(void)_getch();
+			continue;
+		}
+		if (tecla == 8) { // Retroceso
+			if (!clave.empty()) {
+				clave.pop_back();
+				std::cout << "\b \b";
+			}
+			continue;
+		}
+		clave += static_cast<char>(tecla);
+		std::cout << '*';
 	}
-	Utilidades::gotoxy(0, y + numOpciones);
-	std::cout << std::string(anchoLinea, ' ');
-	Utilidades::finalizarOperacionCritica(); // Finalizar operación crítica
+	std::cout << "\n";
+	return clave;
 }
 
 /**
@@ -65,32 +74,14 @@ static void mostrarMenu(int seleccion, std::string opciones[], int numOpciones,
  * @return bool true si se encontró una cuenta válida, false en caso contrario
  */
 static bool buscarCuentaParaOperacion(Banco& banco, CuentaAhorros*& cuentaAhorros, CuentaCorriente*& cuentaCorriente, std::string& cedula) {
-	system("cls");
-	std::cout << "\n===== OPERACIONES DE CUENTA =====\n\n";
-
 	// Menu de seleccion: buscar por cedula o numero
 	std::string opciones[] = { "Buscar por cedula", "Buscar por numero de cuenta", "Cancelar" };
 	int numOpciones = sizeof(opciones) / sizeof(opciones[0]);
 	int seleccion = 0;
 
-	while (true) {
-		system("cls");
-		std::cout << "Seleccione metodo de busqueda:\n\n";
-		for (int i = 0; i < numOpciones; i++) {
-			if (i == seleccion)
-				std::cout << " > " << opciones[i] << std::endl;
-			else
-				std::cout << "   " << opciones[i] << std::endl;
-		}
-		int tecla = _getch();
-		if (tecla == 224) {
-			tecla = _getch();
-			if (tecla == 72) seleccion = (seleccion - 1 + numOpciones) % numOpciones;
-			else if (tecla == 80) seleccion = (seleccion + 1) % numOpciones;
-		}
-		else if (tecla == 13) break; // ENTER
-		else if (tecla == 27) return false; // ESC
-	}
+	MenuConsola menuBusqueda("\n===== OPERACIONES DE CUENTA =====\n\nSeleccione metodo de busqueda:\n\n", std::vector<std::string>(opciones, opciones + numOpciones));
+	seleccion = menuBusqueda.seleccionar(-1);
+	if (seleccion < 0) return false; // ESC
 
 	if (seleccion == 2) return false; // Cancelar
 
@@ -287,10 +278,18 @@ Marquesina* marquesinaGlobal = nullptr;
  *
  * Configura la interfaz de usuario, crea la marquesina, y gestiona el
  * menú principal y sus submenús para realizar todas las operaciones bancarias.
+ * Con --comandos ejecuta un guion sin consola (ver InterpreteComandos).
  *
+ * @param argc Número de argumentos
+ * @param argv Argumentos: [--comandos [guion]]
  * @return int Código de salida del programa (0 si termina correctamente)
  */
-int main() {
+int main(int argc, char* argv[]) {
+	// Modo sin consola: main --comandos [guion]
+	if (argc > 1 && std::string(argv[1]) == "--comandos") {
+		return InterpreteComandos::principal(argc - 1, argv + 1);
+	}
+
 	SetConsoleOutputCP(CP_UTF8);
 	SetConsoleCP(CP_UTF8);
 
@@ -307,12 +306,13 @@ int main() {
 		"Gestion de Hash",
 		"Arbol B",
 		"Generar QR",
+		"Importar clientes (CSV)",
+		"Estadisticas",
 		"Salir"
 	};
 
 	int numOpciones = sizeof(opciones) / sizeof(opciones[0]);
 	int seleccion = 0;
-	int x = 0, y = 0;
 
 	Banco banco;
 
@@ -335,19 +335,11 @@ int main() {
 
 
 
+	MenuConsola menuPrincipal("", std::vector<std::string>(opciones, opciones + numOpciones));
 	while (true) {
-		mostrarMenu(seleccion, opciones, numOpciones, x, y);
-		int tecla = _getch();
-
-		if (tecla == 224) { // Tecla especial
-			tecla = _getch();
-			if (tecla == 72) // Flecha arriba
-				seleccion = (seleccion - 1 + numOpciones) % numOpciones;
-			else if (tecla == 80) // Flecha abajo
-				seleccion = (seleccion + 1) % numOpciones;
-		}
-		else if (tecla == 13) { // Enter
-			Utilidades::gotoxy(0, y + numOpciones + 1);
+		seleccion = menuPrincipal.seleccionar(-1);
+		if (seleccion >= 0) { // Enter
+			Utilidades::gotoxy(0, menuPrincipal.getFilaSiguiente() + 1);
 			std::cout << "Has seleccionado: " << opciones[seleccion] << std::endl;
 
 			// Switch para manejar la opcion seleccionada
@@ -375,31 +367,8 @@ int main() {
 				int numOpcionesCuenta = sizeof(opcionesCuenta) / sizeof(opcionesCuenta[0]);
 				int selCuenta = 0;
 
-				while (true) {
-					system("cls");
-					std::cout << "Seleccione la operacion a realizar:\n\n";
-					for (int i = 0; i < numOpcionesCuenta; i++) {
-						if (i == selCuenta)
-							std::cout << " > " << opcionesCuenta[i] << std::endl;
-						else
-							std::cout << "   " << opcionesCuenta[i] << std::endl;
-					}
-
-					int teclaCuenta = _getch();
-					if (teclaCuenta == 224) {
-						teclaCuenta = _getch();
-						if (teclaCuenta == 72) // Flecha arriba
-							selCuenta = (selCuenta - 1 + numOpcionesCuenta) % numOpcionesCuenta;
-						else if (teclaCuenta == 80) // Flecha abajo
-							selCuenta = (selCuenta + 1) % numOpcionesCuenta;
-					}
-					else if (teclaCuenta == 13) // Enter
-						break;
-					else if (teclaCuenta == 27) { // ESC
-						selCuenta = 3; // Cancelar
-						break;
-					}
-				}
+				MenuConsola menuCuenta("Seleccione la operacion a realizar:\n\n", std::vector<std::string>(opcionesCuenta, opcionesCuenta + numOpcionesCuenta));
+				selCuenta = menuCuenta.seleccionar(3);
 
 				if (selCuenta == 3) { // Cancelar
 					break;
@@ -571,27 +540,8 @@ int main() {
 				int numOpcionesGuardado = sizeof(opcionesGuardado) / sizeof(opcionesGuardado[0]);
 				int selGuardado = 0;
 
-				while (true) {
-					system("cls");
-					std::cout << "Seleccione el tipo de guardado:\n\n";
-					for (int i = 0; i < numOpcionesGuardado; i++) {
-						if (i == selGuardado)
-							std::cout << " > " << opcionesGuardado[i] << std::endl;
-						else
-							std::cout << "   " << opcionesGuardado[i] << std::endl;
-					}
-
-					int teclaGuardado = _getch();
-					if (teclaGuardado == 224) {
-						teclaGuardado = _getch();
-						if (teclaGuardado == 72) // Flecha arriba
-							selGuardado = (selGuardado - 1 + numOpcionesGuardado) % numOpcionesGuardado;
-						else if (teclaGuardado == 80) // Flecha abajo
-							selGuardado = (selGuardado + 1) % numOpcionesGuardado;
-					}
-					else if (teclaGuardado == 13) // Enter
-						break;
-				}
+				MenuConsola menuGuardado("Seleccione el tipo de guardado:\n\n", std::vector<std::string>(opcionesGuardado, opcionesGuardado + numOpcionesGuardado));
+				selGuardado = menuGuardado.seleccionar();
 
 				if (selGuardado == 2) { // Cancelar
 					break;
@@ -612,9 +562,7 @@ int main() {
 					std::cout << "Ingrese el nombre del archivo (sin extension): ";
 					std::string nombreArchivo;
 					std::cin >> nombreArchivo;
-					std::cout << "Ingrese una clave para cifrar (un solo caracter): ";
-					char clave = _getch();
-					std::cout << "*\n"; // Ocultar la clave
+					std::string clave = leerClaveCifrado("Ingrese una clave para cifrar: ");
 					Cifrado::cifrarYGuardarDatos(banco, nombreArchivo, clave);
 				}
 			}
@@ -627,27 +575,8 @@ int main() {
 				int numOpcionesCarga = sizeof(opcionesCarga) / sizeof(opcionesCarga[0]);
 				int selCarga = 0;
 				Utilidades::limpiarPantallaPreservandoMarquesina();
-				while (true) {
-					system("cls");
-					std::cout << "\n\nSeleccione el tipo de archivo a cargar:\n\n";
-					for (int i = 0; i < numOpcionesCarga; i++) {
-						if (i == selCarga)
-							std::cout << " > " << opcionesCarga[i] << std::endl;
-						else
-							std::cout << "   " << opcionesCarga[i] << std::endl;
-					}
-
-					int teclaCarga = _getch();
-					if (teclaCarga == 224) {
-						teclaCarga = _getch();
-						if (teclaCarga == 72)      // Flecha arriba
-							selCarga = (selCarga - 1 + numOpcionesCarga) % numOpcionesCarga;
-						else if (teclaCarga == 80) // Flecha abajo
-							selCarga = (selCarga + 1) % numOpcionesCarga;
-					}
-					else if (teclaCarga == 13) // Enter
-						break;
-				}
+				MenuConsola menuCarga("\n\nSeleccione el tipo de archivo a cargar:\n\n", std::vector<std::string>(opcionesCarga, opcionesCarga + numOpcionesCarga));
+				selCarga = menuCarga.seleccionar();
 
 				// Si se selecciona la opcion "Cancelar" (indice 2), finaliza
 				if (selCarga == 2) {
@@ -665,9 +594,7 @@ int main() {
 					break;
 				}
 				case 1: { // Archivo cifrado (.bin)
-					std::cout << "Ingrese la clave de descifrado (un solo caracter): ";
-					char clave = _getch();
-					std::cout << "*\n"; // Ocultar la clave
+					std::string clave = leerClaveCifrado("Ingrese la clave de descifrado: ");
 					if (!Cifrado::descifrarYCargarDatos(banco, nombreArchivo, clave)) {
 						std::cout << "No se pudo cargar el archivo cifrado. Verifique la clave.\n";
 					}
@@ -684,28 +611,8 @@ int main() {
 				int numOpcionesDescifrado = sizeof(opcionesDescifrado) / sizeof(opcionesDescifrado[0]);
 				int selDescifrado = 0;
 
-				while (true) {
-					system("cls");
-					std::cout << "Seleccione a que descifrar:\n\n";
-					for (int i = 0; i < numOpcionesDescifrado; i++) {
-						if (i == selDescifrado)
-							std::cout << " > " << opcionesDescifrado[i] << std::endl;
-						else
-							std::cout << "   " << opcionesDescifrado[i] << std::endl;
-					}
-
-					int teclaDescifrado = _getch();
-					if (teclaDescifrado == 224) {
-						teclaDescifrado = _getch();
-						if (teclaDescifrado == 72) // Flecha arriba
-							selDescifrado = (selDescifrado - 1 + numOpcionesDescifrado) % numOpcionesDescifrado;
-						else if (teclaDescifrado == 80) // Flecha abajo
-							selDescifrado = (selDescifrado + 1) % numOpcionesDescifrado;
-					}
-					else if (teclaDescifrado == 13) {
-						break;
-					}
-				}
+				MenuConsola menuDescifrado("Seleccione a que descifrar:\n\n", std::vector<std::string>(opcionesDescifrado, opcionesDescifrado + numOpcionesDescifrado));
+				selDescifrado = menuDescifrado.seleccionar();
 
 				if (selDescifrado == 1) { // Cancelar
 					break;
@@ -720,28 +627,8 @@ int main() {
 				int numSubOpcionesDescifrado = sizeof(subOpcionesDescifrado) / sizeof(subOpcionesDescifrado[0]);
 				int selSubDescifrado = 0;
 
-				while (true) {
-					system("cls");
-					std::cout << "Seleccione el tipo de descifrado:\n\n";
-					for (int i = 0; i < numSubOpcionesDescifrado; i++) {
-						if (i == selSubDescifrado)
-							std::cout << " > " << subOpcionesDescifrado[i] << std::endl;
-						else
-							std::cout << "   " << subOpcionesDescifrado[i] << std::endl;
-					}
-
-					int teclaSubDescifrado = _getch();
-					if (teclaSubDescifrado == 224) {
-						teclaSubDescifrado = _getch();
-						if (teclaSubDescifrado == 72) // Flecha arriba
-							selSubDescifrado = (selSubDescifrado - 1 + numSubOpcionesDescifrado) % numSubOpcionesDescifrado;
-						else if (teclaSubDescifrado == 80) // Flecha abajo
-							selSubDescifrado = (selSubDescifrado + 1) % numSubOpcionesDescifrado;
-					}
-					else if (teclaSubDescifrado == 13) {
-						break;
-					}
-				}
+				MenuConsola menuTipoDescifrado("Seleccione el tipo de descifrado:\n\n", std::vector<std::string>(subOpcionesDescifrado, subOpcionesDescifrado + numSubOpcionesDescifrado));
+				selSubDescifrado = menuTipoDescifrado.seleccionar();
 
 				// Manejar opcion "Cancelar" del segundo submenu
 				if (selSubDescifrado == 2) {
@@ -755,18 +642,14 @@ int main() {
 
 				switch (selSubDescifrado) {
 				case 0: { // Archivo cifrado (.bin) -> Respaldo (.bak)
-					std::cout << "Ingrese la clave de descifrado (un solo caracter): ";
-					char clave = _getch();
-					std::cout << "*\n"; // Ocultar la clave
+					std::string clave = leerClaveCifrado("Ingrese la clave de descifrado: ");
 					if (!Cifrado::descifrarSinCargarDatos(banco, nombreArchivo, clave, 0)) {
 						std::cout << "No se pudo cargar el archivo cifrado. Verifique la clave.\n";
 					}
 					break;
 				}
 				case 1: { // Archivo cifrado (.bin) -> Texto (.txt)
-					std::cout << "Ingrese la clave de descifrado (un solo caracter): ";
-					char clave = _getch();
-					std::cout << "*\n"; // Ocultar la clave
+					std::string clave = leerClaveCifrado("Ingrese la clave de descifrado: ");
 					if (!Cifrado::descifrarSinCargarDatos(banco, nombreArchivo, clave, 1)) {
 						std::cout << "No se pudo cargar el archivo cifrado. Verifique la clave.\n";
 					}
@@ -876,42 +759,33 @@ int main() {
 			case 9: // Gestion de Hash
 			{
 				// Submenu para gestion de hash
-				std::string opcionesHash[] = { "Crear Hash", "Verificar Hash", "Cancelar" };
+				std::string opcionesHash[] = { "Crear Hash", "Crear Hash por bloques", "Verificar Hash", "Actualizar Hash por bloques", "Verificar directorio (con cache)", "Cancelar" };
 				int numOpcionesHash = sizeof(opcionesHash) / sizeof(opcionesHash[0]);
 				int seleccionHash = 0;
 
-				while (true) {
-					system("cls");
-					std::cout << "GESTIoN DE HASH DE ARCHIVOS\n\n";
-					std::cout << "Seleccione una operacion:\n\n";
-					for (int i = 0; i < numOpcionesHash; i++) {
-						if (i == seleccionHash)
-							std::cout << " > " << opcionesHash[i] << std::endl;
-						else
-							std::cout << "   " << opcionesHash[i] << std::endl;
-					}
+				MenuConsola menuHash("GESTIoN DE HASH DE ARCHIVOS\n\n" "Seleccione una operacion:\n\n", std::vector<std::string>(opcionesHash, opcionesHash + numOpcionesHash));
+				seleccionHash = menuHash.seleccionar(5);
 
-					int teclaHash = _getch();
-					if (teclaHash == 224) {
-						teclaHash = _getch();
-						if (teclaHash == 72) // Flecha arriba
-							seleccionHash = (seleccionHash - 1 + numOpcionesHash) % numOpcionesHash;
-						else if (teclaHash == 80) // Flecha abajo
-							seleccionHash = (seleccionHash + 1) % numOpcionesHash;
-					}
-					else if (teclaHash == 13) // Enter
-						break;
-					else if (teclaHash == 27) { // ESC
-						seleccionHash = 2; // Cancelar
-						break;
-					}
+				if (seleccionHash == 5) { // Cancelar
+					break;
 				}
 
-				if (seleccionHash == 2) { // Cancelar
+				// Indice de hashes ya calculados, por ruta, tamano y fecha de modificacion
+				CacheHash cacheHash(banco.obtenerRutaEscritorio() + "hash_cache.idx");
+				cacheHash.cargar();
+
+				system("cls");
+				if (seleccionHash == 4) { // Verificar directorio (con cache)
+					std::cout << "VERIFICACION DE RESPALDOS EN: " << banco.obtenerRutaEscritorio() << "\n\n";
+					size_t problemas = Utilidades::verificarDirectorio(banco.obtenerRutaEscritorio(), cacheHash);
+					if (problemas > 0) {
+						std::cout << "¡ADVERTENCIA! " << problemas << " archivo(s) no superaron la verificacion." << std::endl;
+					}
+					cacheHash.guardar();
+					system("pause");
 					break;
 				}
 
-				system("cls");
 				std::cout << "Ingrese el nombre del archivo (sin extension): ";
 				std::string nombreArchivo;
 				std::cin >> nombreArchivo;
@@ -921,7 +795,7 @@ int main() {
 				std::string rutaArchivo = rutaEscritorio + nombreArchivo + ".bak";
 
 				if (seleccionHash == 0) { // Crear Hash
-					std::string hash = Utilidades::calcularSHA1(rutaArchivo);
+					std::string hash = Utilidades::calcularSHA256(rutaArchivo);
 					if (hash == "ERROR_ARCHIVO_NO_ENCONTRADO") {
 						std::cout << "Error: El archivo no existe." << std::endl;
 					}
@@ -930,15 +804,38 @@ int main() {
 						Utilidades::guardarHashArchivo(rutaArchivo, hash);
 					}
 				}
-				else if (seleccionHash == 1) { // Verificar Hash
+				else if (seleccionHash == 1) { // Crear Hash por bloques
+					HashMerkle hash;
+					if (!Hash::calcularMerkle(rutaArchivo, AlgoritmoHash::SHA256, Hash::TAM_BLOQUE_MERKLE, hash)) {
+						std::cout << "Error: El archivo no existe." << std::endl;
+					}
+					else {
+						std::cout << "Raiz calculada: " << hash.raiz << " (" << hash.bloques.size() << " bloques)" << std::endl;
+						Utilidades::guardarHashMerkle(rutaArchivo, hash);
+					}
+				}
+				else if (seleccionHash == 2) { // Verificar Hash
 					std::string rutaHash = rutaArchivo + ".hash";
 					std::string hashGuardado = Utilidades::leerHashArchivo(rutaHash);
+					HashMerkle hashBloques;
 
 					if (hashGuardado.empty()) {
 						std::cout << "Error: No se encontro un archivo de hash para este backup." << std::endl;
 					}
+					else if (hashGuardado.compare(0, 7, "MERKLE-") == 0) {
+						if (!Utilidades::leerHashMerkle(rutaHash, hashBloques)) {
+							std::cout << "Error: El archivo de hash por bloques esta incompleto o danado." << std::endl;
+						}
+						else if (Utilidades::verificarHashMerkle(rutaArchivo, hashBloques)) {
+							std::cout << "¡Verificacion exitosa! El archivo es legitimo y no ha sido modificado." << std::endl;
+						}
+						else {
+							std::cout << "¡ADVERTENCIA! Los rangos indicados fueron modificados." << std::endl;
+						}
+					}
 					else {
-						bool valido = Utilidades::verificarSHA1(rutaArchivo, hashGuardado);
+						bool valido = Utilidades::verificarHash(rutaArchivo, hashGuardado, &cacheHash);
+						cacheHash.guardar();
 						if (valido) {
 							std::cout << "¡Verificacion exitosa! El archivo es legitimo y no ha sido modificado." << std::endl;
 						}
@@ -947,6 +844,30 @@ int main() {
 						}
 					}
 				}
+				else if (seleccionHash == 3) { // Actualizar Hash por bloques
+					// Los respaldos se reescriben completos, así que no hay rangos modificados
+					// que indicar: se vuelven a resumir todos los bloques y se informan los que cambiaron
+					std::string rutaHash = rutaArchivo + ".hash";
+					HashMerkle hash;
+					if (!Utilidades::leerHashMerkle(rutaHash, hash)) {
+						std::cout << "Error: No hay un hash por bloques previo para este backup." << std::endl;
+					}
+					else {
+						uint64_t tamanioAnterior = hash.tamanio;
+						std::vector<uint64_t> cambiados;
+						if (!Hash::actualizarMerkle(rutaArchivo, hash, cambiados)) {
+							std::cout << "Error: El archivo no existe." << std::endl;
+						}
+						else {
+							std::cout << "Bloques cambiados: " << cambiados.size()
+								<< " de " << hash.bloques.size() << std::endl;
+							Utilidades::mostrarRangosBloques(cambiados, hash.tamBloque,
+								tamanioAnterior > hash.tamanio ? tamanioAnterior : hash.tamanio);
+							std::cout << "Raiz actualizada: " << hash.raiz << std::endl;
+							Utilidades::guardarHashMerkle(rutaArchivo, hash);
+						}
+					}
+				}
 				system("pause");
 				break;
 			}
@@ -972,6 +893,42 @@ int main() {
 					break;
 				}
 
+				// Submenu: QR de una cuenta o exportacion de todas las cuentas
+				std::string opcionesQR[] = { "QR de una cuenta", "Exportar QR de todas las cuentas (SVG)", "Exportar QR de todas las cuentas (PBM)", "Cancelar" };
+				int numOpcionesQR = sizeof(opcionesQR) / sizeof(opcionesQR[0]);
+				int seleccionQR = 0;
+
+				MenuConsola menuQR("=== CODIGOS QR ===\n\n", std::vector<std::string>(opcionesQR, opcionesQR + numOpcionesQR));
+				seleccionQR = menuQR.seleccionar(3);
+
+				if (seleccionQR == 3) { // Cancelar
+					break;
+				}
+
+				if (seleccionQR == 1 || seleccionQR == 2) { // Exportar todas las cuentas
+					Utilidades::limpiarPantallaPreservandoMarquesina();
+					std::vector<CuentaQR> cuentasQR = ExportadorQR::recolectarCuentas(banco.getListaPersonas());
+					std::string directorioQR = banco.obtenerRutaEscritorio() + "Codigos QR";
+					std::cout << "Exportando " << cuentasQR.size() << " codigos QR a: " << directorioQR << "\n\n";
+
+					ResumenExportacionQR resumen = ExportadorQR::exportarTodas(cuentasQR, directorioQR,
+						seleccionQR == 1 ? FormatoQR::SVG : FormatoQR::PBM);
+
+					std::cout << "Generados: " << resumen.generados << "\n";
+					std::cout << "Sin cambios (omitidos): " << resumen.omitidos << "\n";
+					std::cout << "Con error: " << resumen.errores << "\n";
+					std::cout << "Tiempo: " << std::fixed << std::setprecision(3) << resumen.segundos << " s";
+					if (resumen.generados > 0 && resumen.segundos > 0) {
+						std::cout << " (" << std::setprecision(1) << resumen.generados / resumen.segundos << " codigos/s)";
+					}
+					std::cout << std::defaultfloat << "\n";
+					const CodigoQR::CacheCodigosQR& cacheQR = CodigoQR::CacheCodigosQR::compartida();
+					std::cout << "Cache de codigos: " << cacheQR.getAciertos() << " aciertos, "
+						<< cacheQR.getFallos() << " fallos, " << cacheQR.getEntradas() << " en memoria\n";
+					system("pause");
+					break;
+				}
+
 				// Recolectar todas las personas validas
 				std::vector<Persona*> personasOrdenadas;
 				NodoPersona* nodoActual = banco.getListaPersonas();
@@ -1182,7 +1139,95 @@ int main() {
 				}
 				break;
 			}
-			case 12: // Salir			
+			case 12: // Importar clientes (CSV)
+			{
+				system("cls");
+				std::cout << "\n\nColumnas: cedula,nombres,apellidos,fecha nacimiento,correo,direccion,tipo cuenta,sucursal,saldo inicial\n";
+				std::cout << "Ingrese el nombre del archivo CSV del escritorio (sin extension): ";
+				std::string nombreArchivo;
+				std::cin >> nombreArchivo;
+
+				std::string rutaCSV = banco.obtenerRutaEscritorio() + nombreArchivo + ".csv";
+				std::string rutaRechazos = banco.obtenerRutaEscritorio() + nombreArchivo + "_rechazos.csv";
+				NodoPersona* lista = banco.getListaPersonas();
+				ResumenImportacion resumen = ImportadorCSV::importar(lista, rutaCSV, rutaRechazos);
+				banco.setListaPersonas(lista);
+
+				if (resumen.lineas == 0 && !resumen.exito) {
+					std::cout << "No se pudo abrir el archivo: " << rutaCSV << "\n";
+					system("pause");
+					break;
+				}
+				std::cout << "\nLineas leidas: " << resumen.lineas << "\n";
+				std::cout << "Clientes importados: " << resumen.importados << "\n";
+				std::cout << "Lineas rechazadas: " << resumen.rechazados;
+				if (resumen.exito) {
+					std::cout << " (detalle en " << rutaRechazos << ")";
+				}
+				else {
+					std::cout << " (no se pudo escribir " << rutaRechazos << ")";
+				}
+				std::cout << "\n" << std::fixed << std::setprecision(3);
+				std::cout << "Tiempo: " << resumen.segundos << " s (lectura " << resumen.segundosLectura
+					<< ", validacion " << resumen.segundosValidacion << ", cuentas " << resumen.segundosAsignacion
+					<< ", enlace " << resumen.segundosEnlace << ")";
+				if (resumen.lineas > 0 && resumen.segundos > 0) {
+					std::cout << " - " << std::setprecision(0) << resumen.lineas / resumen.segundos << " lineas/s";
+				}
+				std::cout << std::defaultfloat << "\n";
+				system("pause");
+				break;
+			}
+			case 13: // Estadisticas
+			{
+				if (!Estadisticas::activas()) {
+					system("cls");
+					std::cout << "\n\nEsta version se compilo sin medir las operaciones (BANCO_ESTADISTICAS en 0).\n";
+					system("pause");
+					break;
+				}
+
+				std::string opcionesEstadisticas[] = { "Guardar en archivo (.csv)", "Reiniciar", "Volver" };
+				int numOpcionesEstadisticas = sizeof(opcionesEstadisticas) / sizeof(opcionesEstadisticas[0]);
+				int selEstadisticas = 0;
+				while (selEstadisticas != 2) {
+					// Latencias de las operaciones desde el inicio del programa o el ultimo reinicio
+					std::ostringstream tabla;
+					tabla << "Estadisticas de operaciones\n\n";
+					std::vector<ResumenOperacion> operaciones = Estadisticas::resumen();
+					if (operaciones.empty()) {
+						tabla << "Todavia no hay operaciones registradas.\n";
+					}
+					else {
+						Estadisticas::escribirTabla(tabla, operaciones);
+					}
+					tabla << "\n";
+
+					MenuConsola menuEstadisticas(tabla.str(), std::vector<std::string>(opcionesEstadisticas, opcionesEstadisticas + numOpcionesEstadisticas));
+					selEstadisticas = menuEstadisticas.seleccionar(2);
+
+					if (selEstadisticas == 0) { // Guardar en archivo (.csv)
+						system("cls");
+						std::cout << "\n\nIngrese el nombre del archivo CSV del escritorio (sin extension): ";
+						std::string nombreArchivo;
+						std::cin >> nombreArchivo;
+						std::string rutaCSV = banco.obtenerRutaEscritorio() + nombreArchivo + ".csv";
+						int escritas = Estadisticas::guardarEnRuta(rutaCSV);
+						if (escritas < 0) {
+							std::cout << "No se pudo escribir el archivo: " << rutaCSV << "\n";
+						}
+						else {
+							std::cout << escritas << " operaciones guardadas en " << rutaCSV << "\n";
+						}
+						system("pause");
+					}
+					else if (selEstadisticas == 1) { // Reiniciar
+						Estadisticas::reiniciar();
+					}
+				}
+				break;
+			}
+			case 14: // Salir
 			{
 				system("cls");
 				std::cout << "Saliendo del sistema...\n";
@@ -1194,13 +1239,13 @@ int main() {
 				break;
 			}
 			// Limpiar la linea
-			Utilidades::gotoxy(0, y + numOpciones + 1);
+			Utilidades::gotoxy(0, menuPrincipal.getFilaSiguiente() + 1);
 			std::cout << std::string(40, ' ') << std::endl;
 			}
 		}
-		else if (tecla == 27) // ESC
+		else // ESC
 		{
-			Utilidades::gotoxy(0, y + numOpciones + 1);
+			Utilidades::gotoxy(0, menuPrincipal.getFilaSiguiente() + 1);
 			std::cout << "Saliendo con ESC..." << std::endl;
 			break;
 		}